@@ -11,24 +11,34 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/select.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <sys/types.h>
 #include <syslog.h>
+#include <time.h>
 #include <unistd.h>
 
+#include <myst/clock.h>
 #include <myst/gcov.h>
 #include <myst/libc.h>
 #include <myst/syscall.h>
 #include <myst/syscallext.h>
 #include <myst/tee.h>
 
+/* number of kernel threads that carry out AIO requests (io_submit) */
+#define AIO_WORKER_THREADS 4
+
 void _dlstart_c(size_t* sp, size_t* dynv);
 
 typedef long (*syscall_callback_t)(long n, long params[6]);
 
 static syscall_callback_t _syscall_callback;
 
+/* clock state shared with the target (null if not provided) */
+static struct myst_clock_page* _clock_page;
+
 void myst_trace_ptr(const char* msg, const void* ptr);
 
 void myst_trace(const char* msg);
@@ -39,14 +49,101 @@ void myst_dump_argv(int argc, const char* argv[]);
 
 static void _create_itimer_thread(void);
 
+static void _create_msync_flusher_thread(void);
+
+static void _create_aio_worker_threads(void);
+
+/* Answer the clock syscalls from the clock page without entering the kernel.
+ * Returns false if the kernel must handle the syscall.
+ */
+static bool _clock_syscall(long n, long params[6], long* ret)
+{
+    long nanoseconds;
+
+    if (n == SYS_clock_gettime)
+    {
+        clockid_t clk_id = (clockid_t)params[0];
+        struct timespec* tp = (struct timespec*)params[1];
+
+        if (!tp)
+            return false;
+
+        switch (clk_id)
+        {
+            case CLOCK_MONOTONIC_COARSE:
+            case CLOCK_MONOTONIC:
+            case CLOCK_BOOTTIME:
+                nanoseconds = myst_clock_page_monotime(_clock_page);
+                break;
+            case CLOCK_REALTIME_COARSE:
+            case CLOCK_REALTIME:
+                nanoseconds = myst_clock_page_realtime(_clock_page);
+                break;
+            default:
+                return false;
+        }
+
+        if (nanoseconds < 0)
+            return false;
+
+        tp->tv_sec = nanoseconds / NANO_IN_SECOND;
+        tp->tv_nsec = nanoseconds % NANO_IN_SECOND;
+        *ret = 0;
+        return true;
+    }
+
+    if (n == SYS_gettimeofday)
+    {
+        struct timeval* tv = (struct timeval*)params[0];
+
+        if (tv)
+        {
+            if ((nanoseconds = myst_clock_page_realtime(_clock_page)) < 0)
+                return false;
+
+            tv->tv_sec = nanoseconds / NANO_IN_SECOND;
+            tv->tv_usec = (nanoseconds % NANO_IN_SECOND) / 1000;
+        }
+
+        *ret = 0;
+        return true;
+    }
+
+    if (n == SYS_time)
+    {
+        time_t* tloc = (time_t*)params[0];
+
+        if ((nanoseconds = myst_clock_page_realtime(_clock_page)) < 0)
+            return false;
+
+        if (tloc)
+            *tloc = nanoseconds / NANO_IN_SECOND;
+
+        *ret = nanoseconds / NANO_IN_SECOND;
+        return true;
+    }
+
+    return false;
+}
+
 long myst_syscall(long n, long params[6])
 {
     static pthread_once_t _once = PTHREAD_ONCE_INIT;
+    static pthread_once_t _msync_once = PTHREAD_ONCE_INIT;
+    static pthread_once_t _aio_once = PTHREAD_ONCE_INIT;
 
     /* create the itimer thread on demand (only if needed) */
     if (n == SYS_setitimer)
         pthread_once(&_once, _create_itimer_thread);
 
+    /* create the msync flusher thread on the first MS_ASYNC request */
+    if (n == SYS_msync && (params[2] & MS_ASYNC))
+        pthread_once(&_msync_once, _create_msync_flusher_thread);
+
+    /* create the AIO worker threads when the first context is set up */
+    if (n == SYS_io_setup)
+        pthread_once(&_aio_once, _create_aio_worker_threads);
+
     if (n == SYS_fork)
     {
         /* fork is implemented in the CRT rather than the kernel.
@@ -60,6 +157,14 @@ long myst_syscall(long n, long params[6])
         return ret;
     }
 
+    if (_clock_page)
+    {
+        long ret;
+
+        if (_clock_syscall(n, params, &ret))
+            return ret;
+    }
+
     return (*_syscall_callback)(n, params);
 }
 
@@ -146,6 +251,16 @@ int __clone(int (*fn)(void*), void* child_stack, int flags, void* arg, ...)
 void myst_enter_crt(void* stack, void* dynv, syscall_callback_t callback)
 {
     _syscall_callback = callback;
+
+    /* get the clock page for serving clock syscalls in user space */
+    {
+        long params[6] = {0};
+        long ret = (*_syscall_callback)(SYS_myst_get_clock_page, params);
+
+        if (ret > 0)
+            _clock_page = (struct myst_clock_page*)ret;
+    }
+
     _dlstart_c((size_t*)stack, (size_t*)dynv);
 }
 
@@ -160,15 +275,46 @@ static void* _itimer_thread(void* arg)
     return NULL;
 }
 
-// Create the itimer thread in user-space and then enter the kernel with the
-// SYS_myst_run_itimer syscall. We create a user-space thread since
-// kernel-space threads are not supported. Two complications include aligning
-// with pthread struct and having a place to land on thread exit.
-static void _create_itimer_thread(void)
+static void* _msync_flusher_thread(void* arg)
+{
+    (void)arg;
+
+    /* Enter the kernel on the msync flusher thread, which returns from the
+     * syscall only to handle signals */
+    for (;;)
+    {
+        long params[6] = {0};
+        myst_syscall(SYS_myst_run_msync_flusher, params);
+    }
+
+    return NULL;
+}
+
+static void* _aio_worker_thread(void* arg)
+{
+    (void)arg;
+
+    /* Enter the kernel on the AIO worker thread, which returns from the
+     * syscall only to handle signals */
+    for (;;)
+    {
+        long params[6] = {0};
+        myst_syscall(SYS_myst_run_aio_worker, params);
+    }
+
+    return NULL;
+}
+
+// Create a detached user-space thread that enters the kernel with a
+// long-running syscall. We create a user-space thread since kernel-space
+// threads are not supported. Two complications include aligning with pthread
+// struct and having a place to land on thread exit.
+static void _create_kernel_service_thread(
+    void* (*start_routine)(void*),
+    const char* func)
 {
     pthread_attr_t attr;
     pthread_t thread;
-    const char* func = __FUNCTION__;
 
     if (pthread_attr_init(&attr) != 0)
     {
@@ -182,9 +328,31 @@ static void _create_itimer_thread(void)
         abort();
     }
 
-    if (pthread_create(&thread, &attr, _itimer_thread, NULL) != 0)
+    if (pthread_create(&thread, &attr, start_routine, NULL) != 0)
     {
         fprintf(stderr, "%s(): pthread_create() failed\n", func);
         abort();
     }
 }
+
+// Create the itimer thread, which enters the kernel with the
+// SYS_myst_run_itimer syscall.
+static void _create_itimer_thread(void)
+{
+    _create_kernel_service_thread(_itimer_thread, __FUNCTION__);
+}
+
+// Create the msync flusher thread, which enters the kernel with the
+// SYS_myst_run_msync_flusher syscall and performs MS_ASYNC write-backs.
+static void _create_msync_flusher_thread(void)
+{
+    _create_kernel_service_thread(_msync_flusher_thread, __FUNCTION__);
+}
+
+// Create the AIO worker threads, which enter the kernel with the
+// SYS_myst_run_aio_worker syscall and carry out io_submit() requests.
+static void _create_aio_worker_threads(void)
+{
+    for (size_t i = 0; i < AIO_WORKER_THREADS; i++)
+        _create_kernel_service_thread(_aio_worker_thread, __FUNCTION__);
+}
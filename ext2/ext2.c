@@ -27,6 +27,9 @@
 #define EXT2_DOUBLE_INDIRECT_BLOCK 13
 #define EXT2_TRIPLE_INDIRECT_BLOCK 14
 
+/* maximum number of contiguous blocks read by ext2_read() at a time */
+#define EXT2_MAX_READ_RUN 256
+
 /* limit the stack size of the functions below */
 #pragma GCC diagnostic error "-Wstack-usage=512"
 
@@ -243,6 +246,28 @@ done:
     return ret;
 }
 
+/* read whole blocks of file data, bypassing the block cache if the device
+ * supports it (metadata is read with _read() so that it stays cached) */
+static ssize_t _read_data(
+    myst_blkdev_t* dev,
+    size_t offset,
+    void* data,
+    size_t size)
+{
+    const size_t blksz = MYST_BLKSIZE;
+
+    if (!dev || !data)
+        return -1;
+
+    if (!dev->getn || (offset % blksz) != 0 || (size % blksz) != 0)
+        return _read(dev, offset, data, size);
+
+    if (dev->getn(dev, offset / blksz, data, size / blksz) != 0)
+        return -1;
+
+    return size;
+}
+
 static ssize_t _write(
     myst_blkdev_t* dev,
     size_t offset,
@@ -3446,6 +3471,55 @@ int64_t ext2_read(myst_fs_t* fs, myst_file_t* file, void* data, uint64_t size)
 
         ECHECK(_inode_get_blkno(ext2, &file->inode, i, &blkno));
 
+        /* Read runs of physically contiguous whole blocks directly into the
+         * caller's buffer with a single device read */
+        if (blkno && (file->offset % ext2->block_size) == 0)
+        {
+            const uint64_t fsize = _inode_get_size(&file->inode);
+            uint64_t avail = fsize > file->offset ? fsize - file->offset : 0;
+            uint64_t max = _min_size(r, avail) / ext2->block_size;
+            uint32_t count = 0;
+
+            if (max > EXT2_MAX_READ_RUN)
+                max = EXT2_MAX_READ_RUN;
+
+            while (count < max && i + count < num_blocks)
+            {
+                uint32_t next = blkno;
+
+                if (count)
+                {
+                    ECHECK(_inode_get_blkno(
+                        ext2, &file->inode, i + count, &next));
+                }
+
+                if (next != blkno + count)
+                    break;
+
+                count++;
+            }
+
+            if (count)
+            {
+                const size_t n = (size_t)count * ext2->block_size;
+
+                if (_read_data(
+                        ext2->dev,
+                        _blk_offset(blkno, ext2->block_size),
+                        end,
+                        n) != (ssize_t)n)
+                {
+                    ERAISE(-EIO);
+                }
+
+                r -= n;
+                end += n;
+                file->offset += n;
+                i += count - 1;
+                continue;
+            }
+        }
+
         /* handle holes */
         if (blkno == 0)
             _init_block(block, ext2->block_size);
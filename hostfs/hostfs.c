@@ -354,11 +354,14 @@ static ssize_t _fs_readv(
     hostfs_t* hostfs = (hostfs_t*)fs;
     ssize_t ret = 0;
 
-    if (!_hostfs_valid(hostfs) || !file)
+    if (!_hostfs_valid(hostfs) || !_file_valid(file))
+        ERAISE(-EINVAL);
+
+    if ((!iov && iovcnt) || iovcnt < 0 || iovcnt > IOV_MAX)
         ERAISE(-EINVAL);
 
-    ret = myst_fdops_readv(&fs->fdops, file, iov, iovcnt);
-    ECHECK(ret);
+    long params[6] = {file->fd, (long)iov, iovcnt};
+    ECHECK((ret = myst_tcall(SYS_readv, params)));
 
 done:
     return ret;
@@ -373,11 +376,14 @@ static ssize_t _fs_writev(
     hostfs_t* hostfs = (hostfs_t*)fs;
     ssize_t ret = 0;
 
-    if (!_hostfs_valid(hostfs) || !file)
+    if (!_hostfs_valid(hostfs) || !_file_valid(file))
+        ERAISE(-EINVAL);
+
+    if ((!iov && iovcnt) || iovcnt < 0 || iovcnt > IOV_MAX)
         ERAISE(-EINVAL);
 
-    ret = myst_fdops_writev(&fs->fdops, file, iov, iovcnt);
-    ECHECK(ret);
+    long params[6] = {file->fd, (long)iov, iovcnt};
+    ECHECK((ret = myst_tcall(SYS_writev, params)));
 
 done:
     return ret;
@@ -1222,6 +1228,52 @@ done:
     return ret;
 }
 
+static ssize_t _fs_preadv(
+    myst_fs_t* fs,
+    myst_file_t* file,
+    const struct iovec* iov,
+    int iovcnt,
+    off_t offset)
+{
+    hostfs_t* hostfs = (hostfs_t*)fs;
+    ssize_t ret = 0;
+
+    if (!_hostfs_valid(hostfs) || !_file_valid(file))
+        ERAISE(-EINVAL);
+
+    if ((!iov && iovcnt) || iovcnt < 0 || iovcnt > IOV_MAX)
+        ERAISE(-EINVAL);
+
+    long params[6] = {file->fd, (long)iov, iovcnt, offset};
+    ECHECK((ret = myst_tcall(SYS_preadv, params)));
+
+done:
+    return ret;
+}
+
+static ssize_t _fs_pwritev(
+    myst_fs_t* fs,
+    myst_file_t* file,
+    const struct iovec* iov,
+    int iovcnt,
+    off_t offset)
+{
+    hostfs_t* hostfs = (hostfs_t*)fs;
+    ssize_t ret = 0;
+
+    if (!_hostfs_valid(hostfs) || !_file_valid(file))
+        ERAISE(-EINVAL);
+
+    if ((!iov && iovcnt) || iovcnt < 0 || iovcnt > IOV_MAX)
+        ERAISE(-EINVAL);
+
+    long params[6] = {file->fd, (long)iov, iovcnt, offset};
+    ECHECK((ret = myst_tcall(SYS_pwritev, params)));
+
+done:
+    return ret;
+}
+
 int myst_init_hostfs(myst_fs_t** fs_out)
 {
     int ret = 0;
@@ -1284,6 +1336,8 @@ int myst_init_hostfs(myst_fs_t** fs_out)
         .fs_fchmod = _fs_fchmod,
         .fs_fdatasync = _fs_fdatasync,
         .fs_fsync = _fs_fsync,
+        .fs_preadv = _fs_preadv,
+        .fs_pwritev = _fs_pwritev,
     };
     // clang-format on
 
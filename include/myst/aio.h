@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef _MYST_AIO_H
+#define _MYST_AIO_H
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <time.h>
+
+#include <myst/defs.h>
+
+/*
+**==============================================================================
+**
+** Linux AIO (io_setup, io_submit, io_getevents, io_cancel, io_destroy):
+**
+**     Requests are queued on the context and carried out by kernel worker
+**     threads, which the CRT starts on the first io_setup() call (in the same
+**     way as the itimer thread). Completions are appended to a ring with the
+**     Linux layout, which user space may also consume directly (as libaio
+**     does), and an eventfd is signaled for requests with IOCB_FLAG_RESFD.
+**
+**     The definitions below follow the Linux ABI (see <linux/aio_abi.h>).
+**
+**==============================================================================
+*/
+
+typedef unsigned long myst_aio_context_t;
+
+enum
+{
+    MYST_IOCB_CMD_PREAD = 0,
+    MYST_IOCB_CMD_PWRITE = 1,
+    MYST_IOCB_CMD_FSYNC = 2,
+    MYST_IOCB_CMD_FDSYNC = 3,
+    MYST_IOCB_CMD_POLL = 5,
+    MYST_IOCB_CMD_NOOP = 6,
+    MYST_IOCB_CMD_PREADV = 7,
+    MYST_IOCB_CMD_PWRITEV = 8,
+};
+
+/* signal the eventfd given by aio_resfd on completion */
+#define MYST_IOCB_FLAG_RESFD (1 << 0)
+
+/* aio_reqprio is valid (it is ignored) */
+#define MYST_IOCB_FLAG_IOPRIO (1 << 1)
+
+struct myst_iocb
+{
+    uint64_t aio_data;
+    uint32_t aio_key;
+    uint32_t aio_rw_flags;
+    uint16_t aio_lio_opcode;
+    int16_t aio_reqprio;
+    uint32_t aio_fildes;
+    uint64_t aio_buf;
+    uint64_t aio_nbytes;
+    int64_t aio_offset;
+    uint64_t aio_reserved2;
+    uint32_t aio_flags;
+    uint32_t aio_resfd;
+};
+
+MYST_STATIC_ASSERT(sizeof(struct myst_iocb) == 64);
+
+struct myst_io_event
+{
+    uint64_t data;
+    uint64_t obj;
+    int64_t res;
+    int64_t res2;
+};
+
+MYST_STATIC_ASSERT(sizeof(struct myst_io_event) == 32);
+
+#define MYST_AIO_RING_MAGIC 0xa10a10a1
+#define MYST_AIO_RING_COMPAT_FEATURES 1
+
+/* the completion ring (the context id is its address) */
+struct myst_aio_ring
+{
+    uint32_t id;
+    uint32_t nr;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t magic;
+    uint32_t compat_features;
+    uint32_t incompat_features;
+    uint32_t header_length;
+    struct myst_io_event io_events[];
+};
+
+MYST_STATIC_ASSERT(sizeof(struct myst_aio_ring) == 32);
+
+/* the maximum number of events of all contexts (/proc/sys/fs/aio-max-nr) */
+#define MYST_AIO_MAX_NR 65536
+
+long myst_syscall_io_setup(unsigned int nr_events, myst_aio_context_t* ctx_idp);
+
+long myst_syscall_io_destroy(myst_aio_context_t ctx_id);
+
+long myst_syscall_io_submit(
+    myst_aio_context_t ctx_id,
+    long nr,
+    struct myst_iocb** iocbpp);
+
+long myst_syscall_io_cancel(
+    myst_aio_context_t ctx_id,
+    struct myst_iocb* iocb,
+    struct myst_io_event* result);
+
+long myst_syscall_io_getevents(
+    myst_aio_context_t ctx_id,
+    long min_nr,
+    long nr,
+    struct myst_io_event* events,
+    const struct timespec* timeout);
+
+/* run an AIO worker on the calling thread (returns when signaled) */
+long myst_syscall_run_aio_worker(void);
+
+/* release the contexts of an exiting process */
+void myst_aio_release(pid_t pid);
+
+#endif /* _MYST_AIO_H */
@@ -4,7 +4,9 @@
 #ifndef _MYST_BITS_H
 #define _MYST_BITS_H
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include <myst/defs.h>
 
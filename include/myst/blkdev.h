@@ -21,6 +21,9 @@ struct myst_blkdev
     int (*get)(myst_blkdev_t* dev, uint64_t blkno, void* data);
 
     int (*put)(myst_blkdev_t* dev, uint64_t blkno, const void* data);
+
+    /* read NBLOCKS contiguous blocks (optional: may be null) */
+    int (*getn)(myst_blkdev_t* dev, uint64_t blkno, void* data, size_t nblocks);
 };
 
 int myst_rawblkdev_open(
@@ -4,6 +4,10 @@
 #ifndef _MYST_CLOCK_H
 #define _MYST_CLOCK_H
 
+#include <stdbool.h>
+
+#include <myst/defs.h>
+
 #define NANO_IN_SECOND 1000000000
 #define MICRO_IN_SECOND 1000000
 
@@ -18,4 +22,72 @@ struct clock_ctrl
 
 int myst_setup_clock(struct clock_ctrl*);
 
+/* Clock state shared by the target and the C runtime. The C runtime reads
+ * it to answer clock_gettime(), gettimeofday() and time() without entering
+ * the kernel (like the Linux vDSO). It is obtained with the
+ * SYS_myst_get_clock_page syscall, which returns null when the target does
+ * not provide it.
+ */
+struct myst_clock_page
+{
+    /* host address of the monotonic time (updated by the host clock thread) */
+    volatile long* monotime_now;
+
+    /* real and monotonic time (nanoseconds) when the clock was set up */
+    long realtime0;
+    long monotime0;
+
+    /* adjustment made by clock_settime(CLOCK_REALTIME) */
+    long realtime_delta;
+
+    /* last monotonic time returned (keeps the clock from going backward) */
+    long monotime_prev;
+};
+
+struct myst_clock_page* myst_get_clock_page(void);
+
+/* Return the monotonic time in nanoseconds. The host may change the value
+ * at monotime_now arbitrarily, so never return a value less than or equal
+ * to the one returned before.
+ */
+MYST_INLINE long myst_clock_page_monotime(struct myst_clock_page* page)
+{
+    long prev = __atomic_load_n(&page->monotime_prev, __ATOMIC_RELAXED);
+    long now = *page->monotime_now;
+    long next;
+
+    do
+    {
+        // maintain monotonicity.
+        // TODO: issue a warning. Host might be playing tricks.
+        next = (now > prev) ? now : prev + 1;
+    } while (!__atomic_compare_exchange_n(
+        &page->monotime_prev,
+        &prev,
+        next,
+        true,
+        __ATOMIC_RELAXED,
+        __ATOMIC_RELAXED));
+
+    return next;
+}
+
+/* Return the real time in nanoseconds since the epoch (or -1 on overflow) */
+MYST_INLINE long myst_clock_page_realtime(struct myst_clock_page* page)
+{
+    // Derive the realtime clock from the monotonic clock.
+    // Any adjustment to the system clock is invisible to the
+    // enclave application once it is launched.
+    long ret = myst_clock_page_monotime(page) - page->monotime0;
+    long delta = __atomic_load_n(&page->realtime_delta, __ATOMIC_RELAXED);
+
+    if (__builtin_saddl_overflow(ret, page->realtime0, &ret) ||
+        __builtin_saddl_overflow(ret, delta, &ret))
+    {
+        return -1;
+    }
+
+    return ret;
+}
+
 #endif /* _MYST_CLOCK_H */
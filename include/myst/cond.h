@@ -15,6 +15,7 @@ typedef struct _posix_cond
 {
     myst_spinlock_t lock;
     myst_thread_queue_t queue;
+    uint32_t spin_estimate; /* running average of spins before a wake-up */
 } myst_cond_t;
 
 int myst_cond_init(myst_cond_t* c);
@@ -28,6 +29,13 @@ int myst_cond_timedwait(
     myst_mutex_t* mutex,
     const struct timespec* timeout);
 
+/* Like myst_cond_timedwait() but fails with -EINTR if the calling thread
+ * has unblocked signals pending (on return, the mutex is locked again) */
+int myst_cond_timedwait_interruptible(
+    myst_cond_t* c,
+    myst_mutex_t* mutex,
+    const struct timespec* timeout);
+
 int myst_cond_signal(myst_cond_t* c);
 
 int myst_cond_signal_thread(myst_cond_t* c, myst_thread_t* thread);
@@ -163,6 +163,15 @@ int myst_fdtable_get_any(
     void** device,
     void** object);
 
+/* get a reference to the object of fd that remains valid after fd is closed
+ * or reused (release it with the fd_close() operation of the device) */
+int myst_fdtable_get_ref(
+    myst_fdtable_t* fdtable,
+    int fd,
+    myst_fdtable_type_t* type,
+    void** device,
+    void** object);
+
 /* get the fdtable for the current thread */
 myst_fdtable_t* myst_fdtable_current(void);
 
@@ -179,6 +179,21 @@ struct myst_fs
     int (*fs_fdatasync)(myst_fs_t* fs, myst_file_t* file);
 
     int (*fs_fsync)(myst_fs_t* fs, myst_file_t* file);
+
+    /* optional: if null, preadv() and pwritev() use fs_pread and fs_pwrite */
+    ssize_t (*fs_preadv)(
+        myst_fs_t* fs,
+        myst_file_t* file,
+        const struct iovec* iov,
+        int iovcnt,
+        off_t offset);
+
+    ssize_t (*fs_pwritev)(
+        myst_fs_t* fs,
+        myst_file_t* file,
+        const struct iovec* iov,
+        int iovcnt,
+        off_t offset);
 };
 
 int myst_remove_fd_link(int fd);
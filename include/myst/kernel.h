@@ -5,8 +5,10 @@
 #define _MYST_KERNEL_H
 
 #include <limits.h>
+#include <myst/clock.h>
 #include <myst/kstack.h>
 #include <myst/syscallext.h>
+#include <myst/syscallstr.h>
 #include <myst/tcall.h>
 #include <myst/types.h>
 #include <myst/uid_gid.h>
@@ -144,6 +146,11 @@ typedef struct myst_kernel_args
     bool trace_syscalls;
     bool have_syscall_instruction;
 
+    /* From --strace-binary=<file>: host file descriptor of the binary
+     * syscall trace file (see myst/tracering.h) */
+    bool strace_binary;
+    int strace_binary_fd;
+
     /* The event object for the main thread */
     uint64_t event;
 
@@ -169,6 +176,18 @@ typedef struct myst_kernel_args
     // CPUs reported by sched_getaffinity().
     size_t max_affinity_cpus;
 
+    // From the --thread-pool-size=<num> option. This is the maximum number
+    // of exited host threads that are kept for reuse by new threads.
+    size_t thread_pool_size;
+
+    // From the "MaxKernelStacks" setting. This is the maximum number of
+    // kernel stacks (zero selects MYST_DEFAULT_KSTACKS_LIMIT).
+    size_t max_kstacks;
+
+    // Clock state that the C runtime reads directly (null if the target
+    // does not provide it).
+    struct myst_clock_page* clock_page;
+
     // mode the fork implementation uses.
     // selection between a fork/exec model,
     // or a more traditional fork model with limits
@@ -195,6 +214,13 @@ typedef struct myst_malloc_stats
 {
     size_t usage;
     size_t peak_usage;
+    size_t cache_hits;       /* allocations served from a thread cache */
+    size_t cache_misses;     /* allocations that refilled a thread cache */
+    size_t cache_bypasses;   /* allocations too large to be cached */
+    size_t cache_contention; /* operations that found their cache locked */
+    size_t cache_refills;    /* batched allocations from dlmalloc */
+    size_t cache_flushes;    /* batched frees to dlmalloc */
+    size_t cache_bytes;      /* bytes currently held by the caches */
 } myst_malloc_stats_t;
 
 int myst_get_malloc_stats(myst_malloc_stats_t* stats);
@@ -203,6 +229,4 @@ int myst_find_leaks(void);
 
 void myst_start_shell(const char* msg);
 
-const char* myst_syscall_str(long n);
-
 #endif /* _MYST_KERNEL_H */
@@ -4,11 +4,20 @@
 #ifndef _MYST_KSTACK_H
 #define _MYST_KSTACK_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <myst/defs.h>
 
+/* number of kernel stacks preallocated in the kernel stacks region */
 #define MYST_MAX_KSTACKS 1024
+
+/* default limit on the number of kernel stacks (grown on demand) */
+#define MYST_DEFAULT_KSTACKS_LIMIT (4 * MYST_MAX_KSTACKS)
+
+/* absolute limit on the number of kernel stacks */
+#define MYST_KSTACKS_LIMIT 16384
+
 #define MYST_KSTACK_SIZE (64 * 1024)
 #define MYST_ENTER_KSTACK_SIZE (128 * 1024)
 
@@ -16,23 +25,32 @@
 typedef struct myst_kstack
 {
     uint8_t guard[4096]; /* overlaid onto non-accessible memory */
-    union {
-        struct myst_kstack* next; /* used only when on the free list */
-        uint8_t __data[MYST_KSTACK_SIZE - 4096];
-    } u;
+    uint8_t __data[MYST_KSTACK_SIZE - 4096];
 } myst_kstack_t;
 
 MYST_STATIC_ASSERT(sizeof(myst_kstack_t) == MYST_KSTACK_SIZE);
 
+typedef struct myst_kstack_stats
+{
+    size_t total;      /* number of kernel stacks allocated so far */
+    size_t in_use;     /* number of kernel stacks currently in use */
+    size_t high_water; /* maximum number of kernel stacks ever in use */
+    size_t limit;      /* maximum number of kernel stacks */
+} myst_kstack_stats_t;
+
 /* put all the kernel stacks onto the free list */
 void myst_init_kstacks(void);
 
-/* get a kernel stack from the free list; time complexity is O(1)  */
+/* get a kernel stack from the free list, growing the free list if it is
+ * empty; returns null if the limit is reached; lock free in the common case
+ */
 myst_kstack_t* myst_get_kstack(void);
 
-/* put a kernel stack onto the free list; time complexity is O(1) */
+/* put a kernel stack onto the free list; lock free */
 void myst_put_kstack(myst_kstack_t* kstack);
 
+void myst_get_kstack_stats(myst_kstack_stats_t* stats);
+
 MYST_INLINE void* myst_kstack_end(myst_kstack_t* kstack)
 {
     return (uint8_t*)kstack + sizeof(myst_kstack_t);
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef _MYST_LATENCY_H
+#define _MYST_LATENCY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <myst/buf.h>
+
+/* syscall and tcall numbers are below this limit */
+#define MYST_LATENCY_MAX_NUM 3000
+
+/* bucket i counts latencies in [2^(i-1), 2^i) ticks (the last is open) */
+#define MYST_LATENCY_BUCKETS 40
+
+/* number of independently updated copies of each histogram */
+#define MYST_LATENCY_SHARDS 8
+
+/* number of distinct syscall and tcall numbers that can be recorded */
+#define MYST_LATENCY_MAX_HISTOGRAMS 256
+
+typedef enum myst_latency_kind
+{
+    MYST_LATENCY_SYSCALL,
+    MYST_LATENCY_TCALL,
+} myst_latency_kind_t;
+
+/* record the latency (in ticks) of one call */
+void myst_latency_record(myst_latency_kind_t kind, long num, long ticks);
+
+/* get the number of calls and their total latency (in ticks) */
+void myst_latency_get_totals(
+    myst_latency_kind_t kind,
+    long num,
+    size_t* ncalls,
+    long* ticks);
+
+/* clear all histograms */
+void myst_latency_reset(void);
+
+/* format the histograms as a table (one line per call) into buf */
+int myst_latency_format(myst_buf_t* buf);
+
+#endif /* _MYST_LATENCY_H */
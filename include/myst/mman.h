@@ -28,6 +28,10 @@
 
 #define MYST_MREMAP_MAYMOVE 1
 
+#define MYST_MADV_NORMAL 0
+#define MYST_MADV_DONTNEED 4
+#define MYST_MADV_FREE 8
+
 #define MYST_MMAN_ERROR_SIZE 256
 
 /* Virtual Address Descriptor */
@@ -39,6 +43,12 @@ typedef struct myst_vad
     /* Pointer to previous myst_vad_t on linked list */
     struct myst_vad* prev;
 
+    /* Pointer to left child in the VAD tree (lower addresses) */
+    struct myst_vad* left;
+
+    /* Pointer to right child in the VAD tree (higher addresses) */
+    struct myst_vad* right;
+
     /* Address of this memory region */
     uintptr_t addr;
 
@@ -50,9 +60,18 @@ typedef struct myst_vad
 
     /* Mapping flags for this region: MYST_MAP_???? */
     uint16_t flags;
+
+    /* Largest right-hand gap of any VAD in the subtree rooted here */
+    uint64_t max_gap;
+
+    /* Height of the subtree rooted here (leaves have height 1) */
+    uint32_t height;
+
+    /* Padding */
+    uint32_t padding;
 } myst_vad_t;
 
-_Static_assert(sizeof(myst_vad_t) == 32, "");
+_Static_assert(sizeof(myst_vad_t) == 64, "");
 
 #define MYST_MMAN_MAGIC 0xcc8e1732ebd80b0b
 
@@ -76,7 +95,22 @@ typedef struct myst_mman
     /* Page permission prot vector */
     uint8_t* prot_vector;
 
-    /* Start of heap (immediately after VADs array and prot vector) */
+    /* Bitmap of pages released by madvise() (one bit per page) */
+    uint8_t* released_bitmap;
+
+    /* Number of bits set in released_bitmap */
+    size_t released_pages;
+
+    /* Bitmap of unmapped pages known to contain only zeros */
+    uint8_t* zero_bitmap;
+
+    /* Bitmap of pages that hold file contents (one bit per page) */
+    uint8_t* file_bitmap;
+
+    /* Number of bits set in file_bitmap */
+    size_t file_pages;
+
+    /* Start of heap (after VADs array, prot vector and page bitmaps) */
     uintptr_t start;
 
     /* End of heap (points to first page after end of heap) */
@@ -100,12 +134,24 @@ typedef struct myst_mman
     /* Linked list of VADs (sorted by address and doubly linked) */
     myst_vad_t* vad_list;
 
+    /* Root of the AVL tree of VADs (keyed by address, augmented by gap) */
+    myst_vad_t* vad_tree;
+
     /* Whether sanity checks are enabled: see MYST_HeapEnableSanityChecks() */
     bool sanity;
 
     /* Whether to scrub memory when it is unmapped (fill with 0xDD) */
     bool scrub;
 
+    /* Number of mprotect tcalls issued to the host */
+    size_t mprotect_tcalls_issued;
+
+    /* Number of mprotect requests satisfied by prot_vector (no tcall) */
+    size_t mprotect_tcalls_elided;
+
+    /* Number of newly mapped pages not zero-filled (see zero_bitmap) */
+    size_t zero_fill_pages_elided;
+
     /* Heap locking */
     myst_spinlock_t lock;
 
@@ -116,6 +162,8 @@ typedef struct myst_mman
 
 int myst_mman_init(myst_mman_t* heap, uintptr_t base, size_t size);
 
+void myst_mman_set_zero_filled(myst_mman_t* mman);
+
 int myst_mman_mmap(
     myst_mman_t* heap,
     void* addr,
@@ -159,4 +207,12 @@ int myst_mman_get_prot(
     int* prot,
     bool* consistent);
 
+int myst_mman_madvise(myst_mman_t* mman, void* addr, size_t len, int advice);
+
+int myst_mman_set_file_pages(myst_mman_t* mman, void* addr, size_t len);
+
+int myst_mman_reserved_size(myst_mman_t* mman, size_t* size);
+
+int myst_mman_released_size(myst_mman_t* mman, size_t* size);
+
 #endif /* _MYST_INTERNAL_MMAN_H */
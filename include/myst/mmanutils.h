@@ -37,6 +37,10 @@ int myst_get_total_ram(size_t* size);
 
 int myst_get_free_ram(size_t* size);
 
+int myst_get_reserved_ram(size_t* size);
+
+int myst_get_released_ram(size_t* size);
+
 int myst_register_process_mapping(
     pid_t pid,
     void* addr,
@@ -49,6 +53,8 @@ int myst_release_process_mappings(pid_t pid);
 
 int myst_msync(void* addr, size_t length, int flags);
 
+int myst_madvise(void* addr, size_t length, int advice);
+
 void myst_mman_close_notify(int fd);
 
 typedef struct myst_mman_stats
@@ -58,6 +64,12 @@ typedef struct myst_mman_stats
     size_t free_size;
     size_t used_size;
     size_t total_size;
+    size_t reserved_size; /* break memory plus mapped pages */
+    size_t resident_size; /* reserved pages not released by madvise() */
+    size_t released_size; /* reserved pages released by madvise() */
+    size_t mprotect_tcalls_issued;
+    size_t mprotect_tcalls_elided;
+    size_t zero_fill_pages_elided;
 } myst_mman_stats_t;
 
 void myst_mman_stats(myst_mman_stats_t* buf);
@@ -12,12 +12,24 @@
 
 typedef struct _myst_mutex myst_mutex_t;
 
+/* contention statistics (per mutex or summed over all mutexes) */
+typedef struct myst_mutex_stats
+{
+    uint64_t locks;     /* number of times the mutex was acquired */
+    uint64_t contended; /* acquisitions that found the mutex locked */
+    uint64_t spun;      /* contended acquisitions obtained by spinning */
+    uint64_t blocked;   /* contended acquisitions that waited on the host */
+    uint64_t spins;     /* total spin iterations */
+} myst_mutex_stats_t;
+
 struct _myst_mutex
 {
     myst_spinlock_t lock;
     uint64_t refs;
     myst_thread_t* owner;
     myst_thread_queue_t queue;
+    uint32_t spin_estimate; /* running average of spins needed to acquire */
+    myst_mutex_stats_t stats;
 };
 
 int myst_mutex_init(myst_mutex_t* mutex);
@@ -34,6 +46,23 @@ myst_thread_t* myst_mutex_owner(myst_mutex_t* m);
 
 int __myst_mutex_trylock(myst_mutex_t* m, myst_thread_t* self);
 
+/* get the statistics of one mutex (or the sum over all mutexes if null) */
+int myst_mutex_get_stats(myst_mutex_t* m, myst_mutex_stats_t* stats);
+
+void myst_mutex_dump_stats(myst_mutex_t* m, const char* name);
+
+/* Spin for up to *SPINS iterations waiting for a wake-up posted to EVENT.
+ * On success, consume the wake-up so that waiting on the host is unnecessary.
+ * On return, *SPINS holds the number of iterations performed.
+ */
+bool myst_spin_wait_event(uint64_t event, size_t* spins);
+
+/* Get the number of iterations to spin for the given running estimate */
+size_t myst_spin_limit(uint32_t estimate);
+
+/* Move the running estimate toward the number of spins just observed */
+void myst_spin_update(uint32_t* estimate, size_t spins);
+
 int __myst_mutex_unlock(myst_mutex_t* mutex, myst_thread_t** waiter);
 
 #endif /* _MYST_MUTEX_H */
@@ -19,7 +19,10 @@ typedef struct myst_options
     bool memcheck;
     bool perf;
     bool report_native_tids;
+    bool strace_binary;
+    int strace_binary_fd;
     size_t max_affinity_cpus;
+    size_t thread_pool_size;
     char rootfs[PATH_MAX];
     myst_fork_mode_t fork_mode;
 
@@ -57,6 +57,13 @@ int myst_ramfs_set_buf(
     const void* buf,
     size_t buf_size);
 
+/* get the myst_ramfs_set_buf() data that still backs this file (if any) */
+int myst_ramfs_get_buf(
+    myst_fs_t* fs,
+    myst_file_t* file,
+    const void** buf,
+    size_t* buf_size);
+
 int myst_create_virtual_file(
     myst_fs_t* fs,
     const char* pathname,
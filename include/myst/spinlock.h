@@ -86,4 +86,10 @@ MYST_INLINE void myst_spin_unlock(myst_spinlock_t* spinlock)
 
 #endif /* MYST_SPINLOCK_ASSEMBLY */
 
+/* Acquire the spinlock without waiting: return true if acquired */
+MYST_INLINE bool myst_spin_trylock(myst_spinlock_t* spinlock)
+{
+    return *spinlock == 0 && __sync_lock_test_and_set(spinlock, 1) == 0;
+}
+
 #endif /* _MYST_SPINLOCK_H */
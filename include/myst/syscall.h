@@ -147,6 +147,20 @@ long myst_syscall_readv(int fd, const struct iovec* iov, int iovcnt);
 
 long myst_syscall_writev(int fd, const struct iovec* iov, int iovcnt);
 
+ssize_t myst_syscall_preadv2(
+    int fd,
+    const struct iovec* iov,
+    int iovcnt,
+    off_t offset,
+    int flags);
+
+ssize_t myst_syscall_pwritev2(
+    int fd,
+    const struct iovec* iov,
+    int iovcnt,
+    off_t offset,
+    int flags);
+
 long myst_syscall_stat(const char* pathname, struct stat* statbuf);
 
 long myst_syscall_lstat(const char* pathname, struct stat* statbuf);
@@ -269,6 +283,8 @@ long myst_syscall_umask(mode_t mask);
 
 long myst_syscall_run_itimer(void);
 
+long myst_syscall_run_msync_flusher(void);
+
 long myst_syscall_setitimer(
     int which,
     const struct itimerval* new_value,
@@ -278,6 +294,8 @@ int myst_syscall_getitimer(int which, struct itimerval* curr_value);
 
 long myst_syscall_fsync(int fd);
 
+long myst_syscall_fdatasync(int fd);
+
 long myst_syscall_uname(struct utsname* buf);
 
 long myst_syscall_getuid();
@@ -28,6 +28,9 @@ enum
     SYS_myst_kill_wait_child_forks,
     SYS_get_process_thread_stack,
     SYS_fork_wait_exec_exit,
+    SYS_myst_run_msync_flusher,
+    SYS_myst_get_clock_page,
+    SYS_myst_run_aio_worker,
 };
 
 /* Used for SYS_myst_get_fork_info parameter */
@@ -0,0 +1,10 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef _MYST_SYSCALLSTR_H
+#define _MYST_SYSCALLSTR_H
+
+/* return the name of the given syscall number (e.g., "SYS_read") */
+const char* myst_syscall_str(long n);
+
+#endif /* _MYST_SYSCALLSTR_H */
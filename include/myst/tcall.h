@@ -34,6 +34,7 @@ typedef enum myst_tcall_number
     MYST_TCALL_WAIT,
     MYST_TCALL_WAKE,
     MYST_TCALL_WAKE_WAIT,
+    MYST_TCALL_WAKE_MANY,
     MYST_TCALL_SET_RUN_THREAD_FUNCTION,
     MYST_TCALL_TARGET_STAT,
     MYST_TCALL_SET_TSD,
@@ -60,6 +61,9 @@ typedef enum myst_tcall_number
 
 long myst_tcall(long n, long params[6]);
 
+/* return the name of the given tcall number */
+const char* myst_tcall_str(long n);
+
 typedef long (*myst_tcall_t)(long n, long params[6]);
 
 long myst_tcall_random(void* data, size_t size);
@@ -90,6 +94,13 @@ long myst_tcall_wake_wait(
     uint64_t self_event,
     const struct timespec* timeout);
 
+/* maximum number of events passed to a single myst_tcall_wake_many() */
+#define MYST_WAKE_MANY_MAX 64
+
+/* wakes each event in turn with a single host call; returns the number of
+ * waiters that were woken up or -errno */
+long myst_tcall_wake_many(const uint64_t* events, size_t count);
+
 long myst_tcall_add_symbol_file(
     const void* file_data,
     size_t file_size,
@@ -48,6 +48,11 @@ struct myst_td
     int padding; /* unused by Open Enclave */
 };
 
+/* offset of myst_td_t.tsd (read directly through gsbase) */
+#define MYST_TD_TSD_OFFSET 48
+
+MYST_STATIC_ASSERT(MYST_OFFSETOF(myst_td_t, tsd) == MYST_TD_TSD_OFFSET);
+
 bool myst_valid_td(const void* td);
 
 extern myst_spinlock_t myst_process_list_lock;
@@ -107,14 +112,17 @@ struct myst_thread
     /* Terminating signal value */
     unsigned terminating_signum;
 
-    /* Timespec at process creation */
-    struct timespec start_ts;
+    /* Ticks (see myst_times_ticks()) at thread creation */
+    long start_ticks;
+
+    /* Ticks at when the thread last entered the kernel */
+    long enter_kernel_ticks;
 
-    /* Timespec at when the thread last entered userspace */
-    struct timespec enter_kernel_ts;
+    /* Ticks at when the thread last crossed over to userspace */
+    long leave_kernel_ticks;
 
-    /* Timespec at when the thread last crossed over to userspace */
-    struct timespec leave_kernel_ts;
+    /* Ring of binary syscall trace records (see myst/tracering.h) */
+    struct myst_trace_ring* trace_ring;
 
     /* the C-runtime thread descriptor */
     myst_td_t* crt_td;
@@ -393,6 +401,18 @@ MYST_INLINE myst_thread_t* myst_find_process_thread(myst_thread_t* thread)
 
 long myst_run_thread(uint64_t cookie, uint64_t event, pid_t target_tid);
 
+typedef struct myst_thread_pool_stats
+{
+    size_t hits;   /* threads started on a parked host thread */
+    size_t misses; /* threads that needed a new host thread */
+    size_t parked; /* host threads currently parked in the pool */
+} myst_thread_pool_stats_t;
+
+void myst_get_thread_pool_stats(myst_thread_pool_stats_t* stats);
+
+/* let parked host threads return to the target (called on shutdown) */
+void myst_release_thread_pool(void);
+
 pid_t myst_generate_tid(void);
 
 pid_t myst_gettid(void);
@@ -403,6 +423,12 @@ size_t myst_get_num_threads(void);
 
 myst_thread_t* myst_find_thread(int tid);
 
+/* add the thread to the tid table once it has a thread id */
+void myst_add_thread_tid(myst_thread_t* thread);
+
+/* find a running thread in any process by its tid (null if not found) */
+myst_thread_t* myst_lookup_thread_tid(pid_t tid);
+
 void myst_fork_exec_futex_wake(myst_thread_t* thread);
 
 size_t myst_kill_thread_group();
@@ -8,6 +8,15 @@
 
 long myst_lapsed_nsecs(const struct timespec* t0, const struct timespec* t1);
 
+/* Calibrate the tick counter (called once at kernel startup) */
+void myst_times_init(void);
+
+/* Return the tick counter used for CPU time accounting */
+long myst_times_ticks(void);
+
+/* Convert ticks (or an interval of ticks) to nanoseconds */
+long myst_times_ticks_to_nsecs(long ticks);
+
 /* Start tracking time for current thread */
 void myst_times_start();
 
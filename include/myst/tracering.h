@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef _MYST_TRACERING_H
+#define _MYST_TRACERING_H
+
+#include <stdint.h>
+
+#include <myst/defs.h>
+
+/*
+**==============================================================================
+**
+** Binary syscall traces:
+**
+**     With --strace-binary=<file>, every syscall is recorded into a ring of
+**     fixed-size records owned by the calling thread. The rings are written
+**     to the host file on demand (by writing to /proc/mystikos/strace_dump)
+**     and at exit. The file is a sequence of dumps, each made up of a header
+**     followed by its records. "myst trace-decode" renders the file.
+**
+**==============================================================================
+*/
+
+/* number of records in each thread's ring (a power of two) */
+#define MYST_TRACE_RING_SIZE 1024
+
+#define MYST_TRACE_MAGIC 0x454341525453594d /* "MYSTRACE" */
+#define MYST_TRACE_VERSION 1
+
+typedef struct myst_trace_record
+{
+    uint32_t tid;
+    uint32_t num;
+    int64_t params[6];
+    int64_t ret;
+    uint64_t enter_ticks;
+    uint64_t leave_ticks;
+} myst_trace_record_t;
+
+MYST_STATIC_ASSERT(sizeof(myst_trace_record_t) == 80);
+
+typedef struct myst_trace_header
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t nrecords;
+    uint32_t pid;
+    uint32_t reserved;
+    /* ticks are converted to nanoseconds with (ticks * mul) / div */
+    uint64_t nsecs_mul;
+    uint64_t nsecs_div;
+} myst_trace_header_t;
+
+MYST_STATIC_ASSERT(sizeof(myst_trace_header_t) == 48);
+
+struct myst_thread;
+
+/* record a completed syscall in the ring of the calling thread */
+void myst_tracering_record(
+    struct myst_thread* thread,
+    long n,
+    const long params[6],
+    long ret);
+
+/* return the ring of an exiting thread so it can be reused */
+void myst_tracering_release(struct myst_thread* thread);
+
+/* write the records not yet written to the host trace file */
+int myst_tracering_dump(void);
+
+#endif /* _MYST_TRACERING_H */
@@ -0,0 +1,862 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include <myst/aio.h>
+#include <myst/cond.h>
+#include <myst/eraise.h>
+#include <myst/fdtable.h>
+#include <myst/mutex.h>
+#include <myst/process.h>
+#include <myst/signal.h>
+#include <myst/syscall.h>
+#include <myst/thread.h>
+
+/*
+**==============================================================================
+**
+** Each context has a queue of submitted requests and a completion ring.
+** Workers take requests from the queues of contexts that belong to their
+** own process and carry them out without holding the lock. Until a process
+** has a worker, io_submit() carries out its requests before returning.
+**
+** As on Linux, io_submit() takes references to the file and the eventfd, so
+** closing (or reusing) the descriptors does not redirect pending requests.
+**
+** The ring holds one more slot than the number of events requested, so it
+** is never full. Since user space may consume events directly (by advancing
+** the ring head), the number of events a context may still accept is
+** computed from the ring rather than counted as events are read.
+**
+** All the state is guarded by a single mutex.
+**
+**==============================================================================
+*/
+
+typedef struct aio_request
+{
+    struct aio_request* next;
+
+    /* a copy of the submitted iocb */
+    struct myst_iocb iocb;
+
+    /* the user address of the iocb (returned in the event) */
+    uint64_t obj;
+
+    /* references to the objects of aio_fildes and aio_resfd */
+    myst_fdtable_type_t type;
+    void* device;
+    void* object;
+    void* resfd_device;
+    void* resfd_object;
+} aio_request_t;
+
+typedef struct aio_context
+{
+    struct aio_context* next;
+    pid_t pid;
+    struct myst_aio_ring* ring;
+
+    /* the number of events requested with io_setup() */
+    unsigned int max_events;
+
+    /* the tail of the ring (user space may not move it) */
+    uint32_t tail;
+
+    /* requests waiting for a worker */
+    aio_request_t* head;
+    aio_request_t* last;
+
+    /* requests queued or being carried out */
+    size_t inflight;
+
+    /* threads in io_submit() or io_getevents() that use the context */
+    size_t users;
+
+    bool destroyed;
+
+    /* signaled when an event is added or the context is destroyed */
+    myst_cond_t cond;
+} aio_context_t;
+
+/* the workers started by a process */
+typedef struct aio_workers
+{
+    struct aio_workers* next;
+    pid_t pid;
+    size_t count;
+
+    /* signaled when the process queues a request */
+    myst_cond_t cond;
+} aio_workers_t;
+
+static struct
+{
+    myst_mutex_t mutex;
+    aio_context_t* contexts;
+    aio_workers_t* workers;
+
+    /* the number of events of all contexts */
+    size_t nr_events;
+} _aio;
+
+/* find a context of the calling process (the caller holds the mutex) */
+static aio_context_t* _find_context(myst_aio_context_t ctx_id)
+{
+    const pid_t pid = myst_getpid();
+
+    for (aio_context_t* p = _aio.contexts; p; p = p->next)
+    {
+        if ((myst_aio_context_t)p->ring == ctx_id && p->pid == pid &&
+            !p->destroyed)
+        {
+            return p;
+        }
+    }
+
+    return NULL;
+}
+
+static aio_workers_t* _find_workers(pid_t pid)
+{
+    for (aio_workers_t* p = _aio.workers; p; p = p->next)
+    {
+        if (p->pid == pid)
+            return p;
+    }
+
+    return NULL;
+}
+
+/* the number of events in the ring not yet consumed */
+static size_t _ring_count(const aio_context_t* ctx)
+{
+    const uint32_t nr = ctx->ring->nr;
+    const uint32_t head = __atomic_load_n(&ctx->ring->head, __ATOMIC_ACQUIRE);
+
+    return (ctx->tail + nr - head % nr) % nr;
+}
+
+static void _post_event(aio_context_t* ctx, const aio_request_t* req, long res)
+{
+    struct myst_aio_ring* ring = ctx->ring;
+    struct myst_io_event* event = &ring->io_events[ctx->tail];
+
+    event->data = req->iocb.aio_data;
+    event->obj = req->obj;
+    event->res = res;
+    event->res2 = 0;
+
+    ctx->tail = (ctx->tail + 1) % ring->nr;
+    __atomic_store_n(&ring->tail, ctx->tail, __ATOMIC_RELEASE);
+
+    myst_cond_broadcast(&ctx->cond, SIZE_MAX);
+}
+
+/* read or write each buffer in turn (for file systems without preadv) */
+static long _preadv_pwritev(
+    myst_fs_t* fs,
+    myst_file_t* file,
+    bool write,
+    const struct iovec* iov,
+    int iovcnt,
+    off_t offset)
+{
+    long total = 0;
+
+    for (int i = 0; i < iovcnt; i++)
+    {
+        void* base = iov[i].iov_base;
+        const size_t len = iov[i].iov_len;
+        const off_t off = offset + total;
+        ssize_t n;
+
+        if (write)
+            n = (*fs->fs_pwrite)(fs, file, base, len, off);
+        else
+            n = (*fs->fs_pread)(fs, file, base, len, off);
+
+        if (n < 0)
+            return total ? total : n;
+
+        total += n;
+
+        if ((size_t)n < len)
+            break;
+    }
+
+    return total;
+}
+
+static long _perform(const aio_request_t* req)
+{
+    const struct myst_iocb* iocb = &req->iocb;
+    myst_fs_t* fs = req->device;
+    myst_file_t* file = req->object;
+    void* buf = (void*)iocb->aio_buf;
+    const size_t nbytes = iocb->aio_nbytes;
+    const off_t offset = (off_t)iocb->aio_offset;
+    const int iovcnt = (int)nbytes;
+
+    if (iocb->aio_lio_opcode == MYST_IOCB_CMD_NOOP)
+        return 0;
+
+    /* only files support positioned I/O and syncing */
+    if (req->type != MYST_FDTABLE_TYPE_FILE)
+    {
+        switch (iocb->aio_lio_opcode)
+        {
+            case MYST_IOCB_CMD_FSYNC:
+            case MYST_IOCB_CMD_FDSYNC:
+                return -EROFS;
+            default:
+                return req->type == MYST_FDTABLE_TYPE_PIPE ? -ESPIPE : -ENOENT;
+        }
+    }
+
+    if (offset < 0 && iocb->aio_lio_opcode != MYST_IOCB_CMD_FSYNC &&
+        iocb->aio_lio_opcode != MYST_IOCB_CMD_FDSYNC)
+    {
+        return -EINVAL;
+    }
+
+    switch (iocb->aio_lio_opcode)
+    {
+        case MYST_IOCB_CMD_PREAD:
+            return (*fs->fs_pread)(fs, file, buf, nbytes, offset);
+        case MYST_IOCB_CMD_PWRITE:
+            return (*fs->fs_pwrite)(fs, file, buf, nbytes, offset);
+        case MYST_IOCB_CMD_PREADV:
+        {
+            if (fs->fs_preadv)
+                return (*fs->fs_preadv)(fs, file, buf, iovcnt, offset);
+
+            return _preadv_pwritev(fs, file, false, buf, iovcnt, offset);
+        }
+        case MYST_IOCB_CMD_PWRITEV:
+        {
+            if (fs->fs_pwritev)
+                return (*fs->fs_pwritev)(fs, file, buf, iovcnt, offset);
+
+            return _preadv_pwritev(fs, file, true, buf, iovcnt, offset);
+        }
+        case MYST_IOCB_CMD_FSYNC:
+            return (*fs->fs_fsync)(fs, file);
+        case MYST_IOCB_CMD_FDSYNC:
+            return (*fs->fs_fdatasync)(fs, file);
+        default:
+            return -EINVAL;
+    }
+}
+
+static void _signal_eventfd(const aio_request_t* req)
+{
+    if (req->resfd_object)
+    {
+        myst_fdops_t* fdops = req->resfd_device;
+        const uint64_t one = 1;
+
+        (*fdops->fd_write)(
+            req->resfd_device, req->resfd_object, &one, sizeof(one));
+    }
+}
+
+/* drop the references taken by io_submit() and free the request */
+static void _free_request(aio_request_t* req)
+{
+    if (req->object)
+    {
+        myst_fdops_t* fdops = req->device;
+        (*fdops->fd_close)(req->device, req->object);
+    }
+
+    if (req->resfd_object)
+    {
+        myst_fdops_t* fdops = req->resfd_device;
+        (*fdops->fd_close)(req->resfd_device, req->resfd_object);
+    }
+
+    free(req);
+}
+
+/* carry out a request and post its event (the caller holds the mutex) */
+static void _complete(aio_context_t* ctx, aio_request_t* req)
+{
+    long res;
+
+    myst_mutex_unlock(&_aio.mutex);
+    res = _perform(req);
+    myst_mutex_lock(&_aio.mutex);
+
+    _post_event(ctx, req, res);
+    ctx->inflight--;
+
+    /* the eventfd is signaled after the event is visible */
+    myst_mutex_unlock(&_aio.mutex);
+    _signal_eventfd(req);
+    _free_request(req);
+    myst_mutex_lock(&_aio.mutex);
+}
+
+/* take the oldest request queued by the given process */
+static aio_request_t* _take_request(pid_t pid, aio_context_t** ctx_out)
+{
+    for (aio_context_t* p = _aio.contexts; p; p = p->next)
+    {
+        aio_request_t* req;
+
+        if (p->pid == pid && (req = p->head))
+        {
+            if (!(p->head = req->next))
+                p->last = NULL;
+
+            *ctx_out = p;
+            return req;
+        }
+    }
+
+    return NULL;
+}
+
+/* remove the queued requests of a context and post them as canceled */
+static void _cancel_queued(aio_context_t* ctx)
+{
+    aio_request_t* req;
+
+    while ((req = ctx->head))
+    {
+        ctx->head = req->next;
+        _post_event(ctx, req, -ECANCELED);
+        ctx->inflight--;
+        _free_request(req);
+    }
+
+    ctx->last = NULL;
+}
+
+/* drop a reference taken by io_submit() or io_getevents() */
+static void _put_context(aio_context_t* ctx)
+{
+    /* io_destroy() waits for the last user */
+    if (--ctx->users == 0 && ctx->destroyed)
+        myst_cond_broadcast(&ctx->cond, SIZE_MAX);
+}
+
+static void _free_context(aio_context_t* ctx)
+{
+    _aio.nr_events -= ctx->max_events;
+    free(ctx->ring);
+    free(ctx);
+}
+
+long myst_syscall_io_setup(unsigned int nr_events, myst_aio_context_t* ctx_idp)
+{
+    long ret = 0;
+    aio_context_t* ctx = NULL;
+    struct myst_aio_ring* ring = NULL;
+    const uint32_t nr = nr_events + 1;
+    bool locked = false;
+
+    if (!ctx_idp || *ctx_idp != 0)
+        ERAISE(-EINVAL);
+
+    if (nr_events == 0 || nr_events > MYST_AIO_MAX_NR)
+        ERAISE(nr_events ? -EAGAIN : -EINVAL);
+
+    if (!(ctx = calloc(1, sizeof(aio_context_t))))
+        ERAISE(-ENOMEM);
+
+    if (!(ring = calloc(1, sizeof(*ring) + nr * sizeof(struct myst_io_event))))
+        ERAISE(-ENOMEM);
+
+    ring->nr = nr;
+    ring->magic = MYST_AIO_RING_MAGIC;
+    ring->compat_features = MYST_AIO_RING_COMPAT_FEATURES;
+    ring->header_length = sizeof(*ring);
+
+    ctx->pid = myst_getpid();
+    ctx->ring = ring;
+    ctx->max_events = nr_events;
+
+    myst_mutex_lock(&_aio.mutex);
+    locked = true;
+
+    if (_aio.nr_events + nr_events > MYST_AIO_MAX_NR)
+        ERAISE(-EAGAIN);
+
+    _aio.nr_events += nr_events;
+    ctx->next = _aio.contexts;
+    _aio.contexts = ctx;
+
+    *ctx_idp = (myst_aio_context_t)ring;
+    ring = NULL;
+    ctx = NULL;
+
+done:
+
+    if (locked)
+        myst_mutex_unlock(&_aio.mutex);
+
+    if (ring)
+        free(ring);
+
+    if (ctx)
+        free(ctx);
+
+    return ret;
+}
+
+long myst_syscall_io_destroy(myst_aio_context_t ctx_id)
+{
+    long ret = 0;
+    aio_context_t* ctx;
+
+    myst_mutex_lock(&_aio.mutex);
+
+    if (!(ctx = _find_context(ctx_id)))
+        ERAISE(-EINVAL);
+
+    ctx->destroyed = true;
+    _cancel_queued(ctx);
+
+    /* wait for the workers and for io_submit() and io_getevents() */
+    while (ctx->inflight || ctx->users)
+    {
+        myst_cond_broadcast(&ctx->cond, SIZE_MAX);
+        myst_cond_wait(&ctx->cond, &_aio.mutex);
+    }
+
+    for (aio_context_t** pp = &_aio.contexts; *pp; pp = &(*pp)->next)
+    {
+        if (*pp == ctx)
+        {
+            *pp = ctx->next;
+            break;
+        }
+    }
+
+    _free_context(ctx);
+
+done:
+    myst_mutex_unlock(&_aio.mutex);
+    return ret;
+}
+
+/* check an iocb and take references to its file and eventfd */
+static long _prepare_request(aio_request_t* req)
+{
+    long ret = 0;
+    const struct myst_iocb* iocb = &req->iocb;
+    myst_fdtable_t* fdtable = myst_fdtable_current();
+    myst_fdtable_type_t type;
+
+    if (iocb->aio_reserved2 ||
+        (iocb->aio_flags & ~(MYST_IOCB_FLAG_RESFD | MYST_IOCB_FLAG_IOPRIO)))
+    {
+        ERAISE(-EINVAL);
+    }
+
+    switch (iocb->aio_lio_opcode)
+    {
+        case MYST_IOCB_CMD_PREAD:
+        case MYST_IOCB_CMD_PWRITE:
+        {
+            if (iocb->aio_nbytes > SSIZE_MAX)
+                ERAISE(-EINVAL);
+
+            break;
+        }
+        case MYST_IOCB_CMD_PREADV:
+        case MYST_IOCB_CMD_PWRITEV:
+        {
+            if (iocb->aio_nbytes > IOV_MAX)
+                ERAISE(-EINVAL);
+
+            break;
+        }
+        case MYST_IOCB_CMD_FSYNC:
+        case MYST_IOCB_CMD_FDSYNC:
+        case MYST_IOCB_CMD_NOOP:
+            break;
+        default:
+            ERAISE(-EINVAL);
+    }
+
+    if (iocb->aio_flags & MYST_IOCB_FLAG_RESFD)
+    {
+        ECHECK(myst_fdtable_get_ref(
+            fdtable,
+            (int)iocb->aio_resfd,
+            &type,
+            &req->resfd_device,
+            &req->resfd_object));
+
+        if (type != MYST_FDTABLE_TYPE_EVENTFD)
+            ERAISE(-EINVAL);
+    }
+
+    ECHECK(myst_fdtable_get_ref(
+        fdtable,
+        (int)iocb->aio_fildes,
+        &req->type,
+        &req->device,
+        &req->object));
+
+done:
+    return ret;
+}
+
+long myst_syscall_io_submit(
+    myst_aio_context_t ctx_id,
+    long nr,
+    struct myst_iocb** iocbpp)
+{
+    long ret = 0;
+    aio_context_t* ctx;
+    aio_workers_t* workers;
+    long i;
+
+    if (nr < 0 || (nr && !iocbpp))
+        return -EINVAL;
+
+    myst_mutex_lock(&_aio.mutex);
+
+    if (!(ctx = _find_context(ctx_id)))
+        ERAISE(-EINVAL);
+
+    workers = _find_workers(ctx->pid);
+
+    /* keep the context while the mutex is released to carry out requests */
+    ctx->users++;
+
+    for (i = 0; i < nr; i++)
+    {
+        struct myst_iocb* iocb = iocbpp[i];
+        aio_request_t* req;
+        long r;
+
+        if (ctx->destroyed)
+        {
+            ret = -EINVAL;
+            break;
+        }
+
+        if (!iocb)
+        {
+            ret = -EFAULT;
+            break;
+        }
+
+        if (ctx->inflight + _ring_count(ctx) >= ctx->max_events)
+        {
+            ret = -EAGAIN;
+            break;
+        }
+
+        if (!(req = calloc(1, sizeof(aio_request_t))))
+        {
+            ret = -ENOMEM;
+            break;
+        }
+
+        req->iocb = *iocb;
+        req->obj = (uint64_t)iocb;
+
+        if ((r = _prepare_request(req)) != 0)
+        {
+            _free_request(req);
+            ret = r;
+            break;
+        }
+
+        ctx->inflight++;
+
+        if (workers && workers->count)
+        {
+            if (ctx->last)
+                ctx->last->next = req;
+            else
+                ctx->head = req;
+
+            ctx->last = req;
+            myst_cond_signal(&workers->cond);
+        }
+        else
+        {
+            _complete(ctx, req);
+        }
+    }
+
+    _put_context(ctx);
+
+    /* report the number submitted unless the first one failed */
+    if (i > 0)
+        ret = i;
+
+done:
+    myst_mutex_unlock(&_aio.mutex);
+    return ret;
+}
+
+long myst_syscall_io_cancel(
+    myst_aio_context_t ctx_id,
+    struct myst_iocb* iocb,
+    struct myst_io_event* result)
+{
+    long ret = 0;
+    aio_context_t* ctx;
+    aio_request_t* prev = NULL;
+    aio_request_t* req;
+
+    /* like Linux, the result is posted to the ring rather than returned */
+    (void)result;
+
+    if (!iocb)
+        return -EFAULT;
+
+    myst_mutex_lock(&_aio.mutex);
+
+    if (!(ctx = _find_context(ctx_id)))
+        ERAISE(-EINVAL);
+
+    /* only requests that no worker has taken can be canceled */
+    for (req = ctx->head; req; prev = req, req = req->next)
+    {
+        if (req->obj == (uint64_t)iocb)
+            break;
+    }
+
+    if (!req)
+        ERAISE(-EINVAL);
+
+    if (prev)
+        prev->next = req->next;
+    else
+        ctx->head = req->next;
+
+    if (ctx->last == req)
+        ctx->last = prev;
+
+    _post_event(ctx, req, -ECANCELED);
+    ctx->inflight--;
+
+    myst_mutex_unlock(&_aio.mutex);
+    _signal_eventfd(req);
+    _free_request(req);
+
+    return -EINPROGRESS;
+
+done:
+    myst_mutex_unlock(&_aio.mutex);
+    return ret;
+}
+
+static long _timespec_to_nsec(const struct timespec* ts)
+{
+    return ts->tv_sec * 1000000000L + ts->tv_nsec;
+}
+
+long myst_syscall_io_getevents(
+    myst_aio_context_t ctx_id,
+    long min_nr,
+    long nr,
+    struct myst_io_event* events,
+    const struct timespec* timeout)
+{
+    long ret = 0;
+    aio_context_t* ctx = NULL;
+    long deadline = 0;
+    long count = 0;
+    bool interrupted = false;
+
+    if (min_nr < 0 || nr < 0 || min_nr > nr || (nr && !events))
+        return -EINVAL;
+
+    if (timeout)
+    {
+        struct timespec now;
+
+        if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+            timeout->tv_nsec >= 1000000000L)
+        {
+            return -EINVAL;
+        }
+
+        ECHECK(myst_syscall_clock_gettime(CLOCK_MONOTONIC, &now));
+        deadline = _timespec_to_nsec(&now) + _timespec_to_nsec(timeout);
+    }
+
+    myst_mutex_lock(&_aio.mutex);
+
+    if (!(ctx = _find_context(ctx_id)))
+    {
+        myst_mutex_unlock(&_aio.mutex);
+        ERAISE(-EINVAL);
+    }
+
+    ctx->users++;
+
+    while ((long)_ring_count(ctx) < min_nr && !ctx->destroyed)
+    {
+        struct timespec buf;
+        struct timespec* to = NULL;
+
+        if (timeout)
+        {
+            struct timespec now;
+            long rem;
+
+            myst_syscall_clock_gettime(CLOCK_MONOTONIC, &now);
+
+            if ((rem = deadline - _timespec_to_nsec(&now)) <= 0)
+                break;
+
+            buf.tv_sec = rem / 1000000000L;
+            buf.tv_nsec = rem % 1000000000L;
+            to = &buf;
+        }
+
+        if (myst_cond_timedwait_interruptible(&ctx->cond, &_aio.mutex, to) ==
+            -EINTR)
+        {
+            interrupted = true;
+            break;
+        }
+    }
+
+    /* copy out the oldest events and advance the head past them */
+    if (!ctx->destroyed)
+    {
+        struct myst_aio_ring* ring = ctx->ring;
+        uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+        head %= ring->nr;
+
+        while (count < nr && head != ctx->tail)
+        {
+            events[count++] = ring->io_events[head];
+            head = (head + 1) % ring->nr;
+        }
+
+        __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+    }
+
+    /* as on Linux, a signal only fails the call if no events were read */
+    if (ctx->destroyed)
+        ret = -EINVAL;
+    else if (interrupted && count == 0)
+        ret = -EINTR;
+    else
+        ret = count;
+
+    _put_context(ctx);
+
+    myst_mutex_unlock(&_aio.mutex);
+
+done:
+    return ret;
+}
+
+long myst_syscall_run_aio_worker(void)
+{
+    long ret = 0;
+    const pid_t pid = myst_getpid();
+    myst_thread_t* self = myst_thread_self();
+    aio_workers_t* workers;
+
+    myst_mutex_lock(&_aio.mutex);
+
+    if (!(workers = _find_workers(pid)))
+    {
+        if (!(workers = calloc(1, sizeof(aio_workers_t))))
+        {
+            myst_mutex_unlock(&_aio.mutex);
+            ERAISE(-ENOMEM);
+        }
+
+        workers->pid = pid;
+        workers->next = _aio.workers;
+        _aio.workers = workers;
+    }
+
+    workers->count++;
+
+    /* return to user mode to handle signals (the CRT calls back) */
+    while (!myst_signal_has_active_signals(self))
+    {
+        aio_context_t* ctx;
+        aio_request_t* req;
+
+        if ((req = _take_request(pid, &ctx)))
+        {
+            _complete(ctx, req);
+        }
+        else
+        {
+            /* sleep until a request is submitted or a signal arrives */
+            myst_cond_timedwait_interruptible(
+                &workers->cond, &_aio.mutex, NULL);
+        }
+    }
+
+    workers->count--;
+
+    /* pass on a wakeup that this worker may have taken from another one */
+    myst_cond_signal(&workers->cond);
+    myst_mutex_unlock(&_aio.mutex);
+
+    ret = -EINTR;
+
+done:
+    return ret;
+}
+
+void myst_aio_release(pid_t pid)
+{
+    myst_mutex_lock(&_aio.mutex);
+
+    for (aio_context_t** pp = &_aio.contexts; *pp;)
+    {
+        aio_context_t* ctx = *pp;
+
+        if (ctx->pid == pid)
+        {
+            aio_request_t* req;
+
+            /* the process threads have exited so nothing is in progress */
+            while ((req = ctx->head))
+            {
+                ctx->head = req->next;
+                _free_request(req);
+            }
+
+            *pp = ctx->next;
+            _free_context(ctx);
+        }
+        else
+        {
+            pp = &ctx->next;
+        }
+    }
+
+    for (aio_workers_t** pp = &_aio.workers; *pp; pp = &(*pp)->next)
+    {
+        aio_workers_t* workers = *pp;
+
+        if (workers->pid == pid)
+        {
+            *pp = workers->next;
+            free(workers);
+            break;
+        }
+    }
+
+    myst_mutex_unlock(&_aio.mutex);
+}
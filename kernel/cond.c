@@ -11,9 +11,44 @@
 #include <myst/cond.h>
 #include <myst/mutex.h>
 #include <myst/printf.h>
+#include <myst/signal.h>
 #include <myst/strings.h>
 #include <myst/tcall.h>
 
+/* events per myst_tcall_wake_many() (bounded by the stack usage limit) */
+#define WAKE_BATCH_SIZE 32
+
+MYST_STATIC_ASSERT(WAKE_BATCH_SIZE <= MYST_WAKE_MANY_MAX);
+
+/* wake the threads on this (private) queue, batching the host calls */
+static size_t _wake_queue(myst_thread_queue_t* queue)
+{
+    uint64_t events[WAKE_BATCH_SIZE];
+    size_t n = 0;
+    size_t num_awoken = 0;
+    myst_thread_t* next = NULL;
+
+    for (myst_thread_t* p = queue->front; p; p = next)
+    {
+        next = p->qnext;
+        events[n++] = p->event;
+        num_awoken++;
+
+        if (n == WAKE_BATCH_SIZE)
+        {
+            myst_tcall_wake_many(events, n);
+            n = 0;
+        }
+    }
+
+    if (n == 1)
+        myst_tcall_wake(events[0]);
+    else if (n > 1)
+        myst_tcall_wake_many(events, n);
+
+    return num_awoken;
+}
+
 int myst_cond_init(myst_cond_t* c)
 {
     if (!c)
@@ -44,10 +79,11 @@ int myst_cond_destroy(myst_cond_t* c)
     return 0;
 }
 
-int myst_cond_timedwait(
+static int _cond_timedwait(
     myst_cond_t* c,
     myst_mutex_t* mutex,
-    const struct timespec* timeout)
+    const struct timespec* timeout,
+    bool interruptible)
 {
     myst_thread_t* self = myst_thread_self();
     int ret = 0;
@@ -80,10 +116,32 @@ int myst_cond_timedwait(
 
         for (;;)
         {
+            size_t spins = myst_spin_limit(c->spin_estimate);
+            bool spun = false;
+            bool woken = false;
+            bool interrupted = false;
+
             myst_spin_unlock(&c->lock);
             {
                 self->signal.waiting_on_event = true;
-                if (waiter)
+
+                /* signals raised from here on wake self->event */
+                if (interruptible)
+                {
+                    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+                    interrupted = myst_signal_has_active_signals(self);
+                }
+
+                if (interrupted)
+                {
+                    /* pass on the wake-up owed to the mutex waiter */
+                    if (waiter)
+                        myst_tcall_wake(waiter->event);
+
+                    waiter = NULL;
+                    ret = -EINTR;
+                }
+                else if (waiter)
                 {
                     ret = (int)myst_tcall_wake_wait(
                         waiter->event, self->event, timeout);
@@ -92,12 +150,21 @@ int myst_cond_timedwait(
                 }
                 else
                 {
-                    ret = (int)myst_tcall_wait(self->event, timeout);
+                    /* if woken while spinning, skip waiting on the host */
+                    if ((woken = myst_spin_wait_event(self->event, &spins)))
+                        ret = 0;
+                    else
+                        ret = (int)myst_tcall_wait(self->event, timeout);
+
+                    spun = true;
                 }
                 self->signal.waiting_on_event = false;
             }
             myst_spin_lock(&c->lock);
 
+            if (spun)
+                myst_spin_update(&c->spin_estimate, woken ? spins : 0);
+
             /* If self is no longer in the queue, then it was selected by the
              * myst_signal_xyz() calls. Break out of the loop to unblock the
              * thread. If self is still in the queue, and ret=0, host-side might
@@ -105,7 +172,13 @@ int myst_cond_timedwait(
              * maliciously. Stay in the loop to wait again.
              */
             if (!myst_thread_queue_contains(&c->queue, self))
+            {
+                /* report the wake-up rather than the signal */
+                if (interrupted)
+                    ret = 0;
+
                 break;
+            }
 
             /* Remove self from the queue on error returns such as ETIMEOUT, and
              * break out of the loop to report error to the calling function.
@@ -125,6 +198,22 @@ int myst_cond_timedwait(
     return ret;
 }
 
+int myst_cond_timedwait(
+    myst_cond_t* c,
+    myst_mutex_t* mutex,
+    const struct timespec* timeout)
+{
+    return _cond_timedwait(c, mutex, timeout, false);
+}
+
+int myst_cond_timedwait_interruptible(
+    myst_cond_t* c,
+    myst_mutex_t* mutex,
+    const struct timespec* timeout)
+{
+    return _cond_timedwait(c, mutex, timeout, true);
+}
+
 int myst_cond_wait(myst_cond_t* c, myst_mutex_t* mutex)
 {
     return myst_cond_timedwait(c, mutex, NULL);
@@ -191,14 +280,7 @@ int myst_cond_broadcast(myst_cond_t* c, size_t n)
     }
     myst_spin_unlock(&c->lock);
 
-    myst_thread_t* next = NULL;
-
-    for (myst_thread_t* p = waiters.front; p; p = next)
-    {
-        next = p->qnext;
-        myst_tcall_wake(p->event);
-        num_awoken++;
-    }
+    num_awoken = _wake_queue(&waiters);
 
     return num_awoken;
 }
@@ -243,15 +325,7 @@ int myst_cond_requeue(
     myst_spin_unlock(&c1->lock);
 
     /* Wake the threads in the wakers queue */
-    {
-        myst_thread_t* next = NULL;
-
-        for (myst_thread_t* p = wakers.front; p; p = next)
-        {
-            next = p->qnext;
-            myst_tcall_wake(p->event);
-        }
-    }
+    _wake_queue(&wakers);
 
     /* Requeue the threads in the requeues queue */
     myst_spin_lock(&c2->lock);
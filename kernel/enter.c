@@ -5,6 +5,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <myst/aio.h>
 #include <myst/atexit.h>
 #include <myst/clock.h>
 #include <myst/cpio.h>
@@ -23,6 +24,7 @@
 #include <myst/id.h>
 #include <myst/initfini.h>
 #include <myst/kernel.h>
+#include <myst/latency.h>
 #include <myst/mmanutils.h>
 #include <myst/mount.h>
 #include <myst/options.h>
@@ -38,6 +40,7 @@
 #include <myst/thread.h>
 #include <myst/time.h>
 #include <myst/times.h>
+#include <myst/tracering.h>
 #include <myst/tlscert.h>
 #include <myst/trace.h>
 #include <myst/ttydev.h>
@@ -55,8 +58,11 @@ long myst_tcall(long n, long params[6])
         myst_set_fsbase(myst_get_gsbase());
     }
 
+    const long ticks = myst_times_ticks();
     long ret = (__myst_kernel_args.tcall)(n, params);
 
+    myst_latency_record(MYST_LATENCY_TCALL, n, myst_times_ticks() - ticks);
+
     if (fs)
         myst_set_fsbase(fs);
 
@@ -509,6 +515,9 @@ static int _create_main_thread(
     /* bind this thread to the target */
     myst_assume(myst_tcall_set_tsd((uint64_t)thread) == 0);
 
+    /* make the thread visible to myst_find_thread() */
+    myst_add_thread_tid(thread);
+
     *thread_out = thread;
     thread = NULL;
 
@@ -657,6 +666,37 @@ static void _print_boottime(void)
     }
 }
 
+static void _print_thread_pool_stats(void)
+{
+    myst_thread_pool_stats_t stats;
+    static const char yellow[] = "\e[33m";
+    static const char reset[] = "\e[0m";
+
+    myst_get_thread_pool_stats(&stats);
+
+    myst_eprintf("%s", yellow);
+    myst_eprintf(
+        "=== thread pool: hits=%zu misses=%zu", stats.hits, stats.misses);
+    myst_eprintf("%s\n", reset);
+}
+
+static void _print_kstack_stats(void)
+{
+    myst_kstack_stats_t stats;
+    static const char yellow[] = "\e[33m";
+    static const char reset[] = "\e[0m";
+
+    myst_get_kstack_stats(&stats);
+
+    myst_eprintf("%s", yellow);
+    myst_eprintf(
+        "=== kernel stacks: total=%zu high_water=%zu limit=%zu",
+        stats.total,
+        stats.high_water,
+        stats.limit);
+    myst_eprintf("%s\n", reset);
+}
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wstack-usage="
 int myst_enter_kernel(myst_kernel_args_t* args)
@@ -685,6 +725,7 @@ int myst_enter_kernel(myst_kernel_args_t* args)
     {
         args->trace_errors = false;
         args->trace_syscalls = false;
+        args->strace_binary = false;
         args->shell_mode = false;
         args->memcheck = false;
         args->perf = false;
@@ -693,6 +734,10 @@ int myst_enter_kernel(myst_kernel_args_t* args)
         args->report_native_tids = false;
     }
 
+    /* parked host threads count against the maximum number of threads */
+    if (args->thread_pool_size > args->max_threads)
+        args->thread_pool_size = args->max_threads;
+
     /* ATTN: it seems __options can be eliminated */
     __options.trace_syscalls = args->trace_syscalls;
     __options.have_syscall_instruction = args->have_syscall_instruction;
@@ -817,6 +862,7 @@ int myst_enter_kernel(myst_kernel_args_t* args)
     /* Set the 'run-proc' which is called by the target to run new threads */
     ECHECK(myst_tcall_set_run_thread_function(myst_run_thread));
 
+    myst_times_init();
     myst_times_start();
 
     if (args->shell_mode)
@@ -874,6 +920,9 @@ int myst_enter_kernel(myst_kernel_args_t* args)
         if (__myst_kernel_args.perf)
             myst_print_syscall_times("kernel shutdown", SIZE_MAX);
 
+        /* write the remaining binary syscall trace records */
+        myst_tracering_dump();
+
         /* release the kernel stack that was passed to SYS_exit if any */
         if (thread->kstack)
             myst_put_kstack(thread->kstack);
@@ -909,6 +958,15 @@ int myst_enter_kernel(myst_kernel_args_t* args)
         /* now all the threads have shutdown we can retrieve the exit status */
         exit_status = thread->exit_status;
 
+        /* let the host threads parked in the thread pool exit */
+        myst_release_thread_pool();
+
+        if (__myst_kernel_args.perf)
+        {
+            _print_thread_pool_stats();
+            _print_kstack_stats();
+        }
+
         if (args->shell_mode)
             myst_start_shell("\nMystikos shell (exit)\n");
 
@@ -942,6 +1000,9 @@ int myst_enter_kernel(myst_kernel_args_t* args)
         /* Free CWD */
         free(thread->main.cwd);
         thread->main.cwd = NULL;
+
+        /* release any AIO contexts the process did not destroy */
+        myst_aio_release(thread->pid);
     }
 
     /* Tear down the temporary file systems */
@@ -33,6 +33,8 @@ struct myst_eventfd
     uint64_t counter;
     myst_mutex_t mutex;
     myst_cond_t cond;
+    /* dup() shares the eventfd (so the counter is shared, as on Linux) */
+    _Atomic(size_t) use_count;
 };
 
 MYST_INLINE bool _valid_eventfd(const myst_eventfd_t* eventfd)
@@ -74,6 +76,7 @@ static int _eventfd(
 
         eventfd->magic = MAGIC;
         eventfd->counter = initval;
+        eventfd->use_count = 1;
 
         if (flags & EFD_CLOEXEC)
             eventfd->fdflags = FD_CLOEXEC;
@@ -410,7 +413,6 @@ static int _dup(
     myst_eventfd_t** eventfd_out)
 {
     int ret = 0;
-    myst_eventfd_t* new_eventfd = NULL;
 
     if (eventfd_out)
         *eventfd_out = NULL;
@@ -418,24 +420,11 @@ static int _dup(
     if (!eventfddev || !_valid_eventfd(eventfd) || !eventfd_out)
         ERAISE(-EINVAL);
 
-    if (!(new_eventfd = calloc(1, sizeof(myst_eventfd_t))))
-        ERAISE(-ENOMEM);
-
-    /* do not dup fdflags, cond, and mutex */
-    _lock((myst_eventfd_t*)eventfd);
-    new_eventfd->magic = eventfd->magic;
-    new_eventfd->flags = eventfd->flags;
-    new_eventfd->counter = eventfd->counter;
-    _unlock((myst_eventfd_t*)eventfd);
-
-    *eventfd_out = new_eventfd;
-    new_eventfd = NULL;
+    *eventfd_out = (myst_eventfd_t*)eventfd;
+    (*eventfd_out)->use_count++;
 
 done:
 
-    if (new_eventfd)
-        free(new_eventfd);
-
     return ret;
 }
 
@@ -446,6 +435,10 @@ static int _close(myst_eventfddev_t* eventfddev, myst_eventfd_t* eventfd)
     if (!eventfddev || !_valid_eventfd(eventfd))
         ERAISE(-EBADF);
 
+    /* release only the last reference */
+    if (--eventfd->use_count != 0)
+        goto done;
+
     /* signal any threads blocked on read or write */
     _lock(eventfd);
     myst_cond_signal(&eventfd->cond);
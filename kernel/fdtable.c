@@ -480,6 +480,53 @@ done:
     return ret;
 }
 
+int myst_fdtable_get_ref(
+    myst_fdtable_t* fdtable,
+    int fd,
+    myst_fdtable_type_t* type,
+    void** device,
+    void** object)
+{
+    int ret = 0;
+
+    if (type)
+        *type = MYST_FDTABLE_TYPE_NONE;
+
+    if (!fdtable || !type || !device || !object)
+        ERAISE(-EINVAL);
+
+    if (!(fd >= 0 && fd < MYST_FDTABLE_SIZE))
+        ERAISE(-EBADF);
+
+    /* dup the object while holding the lock so fd cannot be closed first */
+    myst_spin_lock(&fdtable->lock);
+    {
+        myst_fdtable_entry_t* entry = &fdtable->entries[fd];
+        myst_fdops_t* fdops = entry->device;
+        int r;
+
+        if (entry->type == MYST_FDTABLE_TYPE_NONE)
+        {
+            myst_spin_unlock(&fdtable->lock);
+            ERAISE(-EBADF);
+        }
+
+        if ((r = (fdops->fd_dup)(entry->device, entry->object, object)) != 0)
+        {
+            myst_spin_unlock(&fdtable->lock);
+            ERAISE(r);
+        }
+
+        *type = entry->type;
+        *device = entry->device;
+    }
+    myst_spin_unlock(&fdtable->lock);
+
+done:
+
+    return ret;
+}
+
 myst_fdtable_t* myst_fdtable_current(void)
 {
     myst_thread_t* thread = myst_thread_self();
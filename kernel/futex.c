@@ -8,6 +8,7 @@
 #include <myst/cond.h>
 #include <myst/eraise.h>
 #include <myst/futex.h>
+#include <myst/once.h>
 #include <myst/strings.h>
 #include <myst/thread.h>
 
@@ -16,10 +17,28 @@
 **
 ** local definitions:
 **
+**     The futex table hashes each futex address to a bucket, where each
+**     bucket has its own spinlock and chain of futex_t entries. The table
+**     doubles in size when it holds more than MAX_LOAD entries per bucket.
+**
+**     A thread locks a bucket by loading the table pointer, locking the
+**     bucket, and checking that the table pointer has not changed. Resizing
+**     holds every bucket lock of the current table while it moves the
+**     entries and publishes the new table, so a thread holding a bucket lock
+**     of the current table excludes resizing. A thread may still lock a
+**     bucket of a replaced table (and then retry), so replaced tables are
+**     retired rather than freed until exit.
+**
+**     An entry is freed when its reference count drops to zero and no thread
+**     is waiting on its condition variable (FUTEX_REQUEUE may move waiters
+**     onto a futex that no thread references).
+**
 **==============================================================================
 */
 
-#define NUM_CHAINS 64
+#define MIN_BUCKETS_SHIFT 6
+#define MAX_BUCKETS_SHIFT 16
+#define MAX_LOAD 4
 
 #if 0
 #define DEBUG_TRACE
@@ -36,61 +55,162 @@ struct futex
     myst_mutex_t mutex;
 };
 
-static futex_t* _chains[NUM_CHAINS];
-static bool _installed_free_futexes;
+typedef struct futex_bucket
+{
+    myst_spinlock_t lock;
+    futex_t* chain;
+} futex_bucket_t;
+
+typedef struct futex_table futex_table_t;
+
+struct futex_table
+{
+    futex_table_t* retired; /* the table that this table replaced */
+    size_t shift;
+    futex_bucket_t* buckets;
+};
+
+static futex_bucket_t _initial_buckets[1 << MIN_BUCKETS_SHIFT];
 
-#if 1
-static myst_spinlock_t _spin = MYST_SPINLOCK_INITIALIZER;
-static void _lock(void)
+static futex_table_t _initial_table = {
+    .shift = MIN_BUCKETS_SHIFT,
+    .buckets = _initial_buckets,
+};
+
+static futex_table_t* _table = &_initial_table;
+static size_t _num_futexes;
+static myst_spinlock_t _resize_lock = MYST_SPINLOCK_INITIALIZER;
+static myst_once_t _free_futexes_once;
+
+static void _free_futexes(void* arg)
 {
-    myst_spin_lock(&_spin);
+    futex_table_t* table = _table;
+
+    (void)arg;
+
+    for (size_t i = 0; i < ((size_t)1 << table->shift); i++)
+    {
+        for (futex_t* p = table->buckets[i].chain; p;)
+        {
+            futex_t* next = p->next;
+            free(p);
+            p = next;
+        }
+    }
+
+    while (table != &_initial_table)
+    {
+        futex_table_t* retired = table->retired;
+        free(table->buckets);
+        free(table);
+        table = retired;
+    }
 }
-static void _unlock(void)
+
+static void _install_free_futexes(void)
 {
-    myst_spin_unlock(&_spin);
+    myst_atexit(_free_futexes, NULL);
 }
-#else
-static myst_mutex_t _mutex;
-static void _lock(void)
+
+static size_t _hash(volatile int* uaddr, size_t shift)
 {
-    myst_mutex_lock(&_mutex);
+    /* Fibonacci hashing: use the top bits of the product as the index */
+    return (((uint64_t)uaddr >> 2) * 0x9e3779b97f4a7c15) >> (64 - shift);
 }
-static void _unlock(void)
+
+static futex_bucket_t* _lock_bucket(volatile int* uaddr)
 {
-    myst_mutex_unlock(&_mutex);
+    for (;;)
+    {
+        futex_table_t* table = __atomic_load_n(&_table, __ATOMIC_ACQUIRE);
+        futex_bucket_t* bucket = &table->buckets[_hash(uaddr, table->shift)];
+
+        myst_spin_lock(&bucket->lock);
+
+        /* if the table was not replaced while locking the bucket */
+        if (__atomic_load_n(&_table, __ATOMIC_ACQUIRE) == table)
+            return bucket;
+
+        myst_spin_unlock(&bucket->lock);
+    }
 }
-#endif
 
-static void _free_futexes(void* arg)
+static void _unlock_bucket(futex_bucket_t* bucket)
 {
-    (void)arg;
+    myst_spin_unlock(&bucket->lock);
+}
+
+/* double the size of the table if it is overloaded */
+static void _resize(void)
+{
+    futex_table_t* old;
+    futex_table_t* new = NULL;
+    size_t old_size;
+
+    myst_spin_lock(&_resize_lock);
+
+    old = _table;
+    old_size = (size_t)1 << old->shift;
+
+    /* another thread may have already resized the table */
+    if (old->shift == MAX_BUCKETS_SHIFT ||
+        __atomic_load_n(&_num_futexes, __ATOMIC_RELAXED) <= MAX_LOAD * old_size)
+    {
+        goto done;
+    }
+
+    if (!(new = calloc(1, sizeof(futex_table_t))))
+        goto done;
+
+    new->retired = old;
+    new->shift = old->shift + 1;
+
+    /* if out of memory, keep using the old table */
+    if (!(new->buckets = calloc(2 * old_size, sizeof(futex_bucket_t))))
+    {
+        free(new);
+        goto done;
+    }
+
+    for (size_t i = 0; i < old_size; i++)
+        myst_spin_lock(&old->buckets[i].lock);
 
-    for (size_t i = 0; i < NUM_CHAINS; i++)
+    for (size_t i = 0; i < old_size; i++)
     {
-        for (futex_t* p = _chains[i]; p;)
+        for (futex_t* p = old->buckets[i].chain; p;)
         {
             futex_t* next = p->next;
-            free(p);
+            futex_bucket_t* bucket = &new->buckets[_hash(p->uaddr, new->shift)];
+
+            p->next = bucket->chain;
+            bucket->chain = p;
             p = next;
         }
+
+        old->buckets[i].chain = NULL;
     }
+
+    __atomic_store_n(&_table, new, __ATOMIC_RELEASE);
+
+    for (size_t i = 0; i < old_size; i++)
+        myst_spin_unlock(&old->buckets[i].lock);
+
+done:
+    myst_spin_unlock(&_resize_lock);
 }
 
 static futex_t* _get_futex(volatile int* uaddr)
 {
     futex_t* ret = NULL;
-    uint64_t index = ((uint64_t)uaddr >> 4) % NUM_CHAINS;
+    futex_bucket_t* bucket;
     futex_t* f;
+    bool resize = false;
 
-    _lock();
+    myst_once(&_free_futexes_once, _install_free_futexes);
 
-    if (!_installed_free_futexes)
-    {
-        myst_atexit(_free_futexes, NULL);
-        _installed_free_futexes = true;
-    }
+    bucket = _lock_bucket(uaddr);
 
-    for (futex_t* p = _chains[index]; p; p = p->next)
+    for (futex_t* p = bucket->chain; p; p = p->next)
     {
         if (p->uaddr == uaddr)
         {
@@ -105,40 +225,55 @@ static futex_t* _get_futex(volatile int* uaddr)
 
     f->refs = 1;
     f->uaddr = uaddr;
-    f->next = _chains[index];
-    _chains[index] = f;
+    f->next = bucket->chain;
+    bucket->chain = f;
 
     ret = f;
 
+    {
+        const size_t n = __atomic_add_fetch(&_num_futexes, 1, __ATOMIC_RELAXED);
+        const futex_table_t* table = _table;
+
+        if (table->shift < MAX_BUCKETS_SHIFT &&
+            n > ((size_t)MAX_LOAD << table->shift))
+        {
+            resize = true;
+        }
+    }
+
 done:
 
-    _unlock();
+    _unlock_bucket(bucket);
+
+    if (resize)
+        _resize();
 
     return ret;
 }
 
-static int _put_futex(int* uaddr)
+static int _put_futex(volatile int* uaddr)
 {
-#if 0
     int ret = -1;
-    uint64_t index = ((uint64_t)uaddr >> 2) % NUM_CHAINS;
+    futex_bucket_t* bucket;
     futex_t* prev = NULL;
 
-    myst_spin_lock(&_lock);
+    bucket = _lock_bucket(uaddr);
 
-    for (futex_t* p = _chains[index]; p; p = p->next)
+    for (futex_t* p = bucket->chain; p; p = p->next)
     {
         if (p->uaddr == uaddr)
         {
             p->refs--;
 
-            if (p->refs == 0)
+            /* free the futex unless threads were requeued onto it */
+            if (p->refs == 0 && myst_thread_queue_empty(&p->cond.queue))
             {
                 if (prev)
                     prev->next = p->next;
                 else
-                    _chains[index] = p->next;
+                    bucket->chain = p->next;
 
+                __atomic_sub_fetch(&_num_futexes, 1, __ATOMIC_RELAXED);
                 free(p);
             }
 
@@ -150,13 +285,9 @@ static int _put_futex(int* uaddr)
     }
 
 done:
-    myst_spin_unlock(&_lock);
+    _unlock_bucket(bucket);
 
     return ret;
-#else
-    (void)uaddr;
-    return 0;
-#endif
 }
 
 int myst_futex_wait(int* uaddr, int val, const struct timespec* to)
@@ -1,11 +1,198 @@
+#include <myst/eraise.h>
 #include <myst/kernel.h>
 #include <myst/kstack.h>
+#include <myst/mman.h>
+#include <myst/mmanutils.h>
+#include <myst/panic.h>
 #include <myst/spinlock.h>
 #include <myst/time.h>
 
+/*
+**==============================================================================
+**
+** Kernel stacks are allocated in chunks. The first chunks overlay the kernel
+** stacks region set up by the host. Further chunks are obtained from the
+** memory manager when the free list runs dry, until the configured limit
+** is reached. Chunks are never released, so a stack index always refers to
+** valid memory.
+**
+** The free list is a lock-free stack of stack indices. The head packs the
+** index of the top stack (plus one), the number of free stacks, and a tag
+** that is incremented by every update (to avoid the ABA problem):
+**
+**     [ tag:32 | nfree:16 | top:16 ]
+**
+** The links of the free list are kept in _next[] rather than in the stacks,
+** so a stack that comes close to overflowing cannot corrupt the free list.
+** The index of a stack is computed from its address.
+**
+**==============================================================================
+*/
+
+#define CHUNK_SIZE 64
+#define MAX_CHUNKS (MYST_KSTACKS_LIMIT / CHUNK_SIZE)
+
+MYST_STATIC_ASSERT(MYST_MAX_KSTACKS % CHUNK_SIZE == 0);
+MYST_STATIC_ASSERT(MYST_KSTACKS_LIMIT < 65536);
+
+#define HEAD(TAG, NFREE, TOP) \
+    (((uint64_t)(TAG) << 32) | ((uint64_t)(NFREE) << 16) | (uint64_t)(TOP))
+#define HEAD_TAG(HEAD) ((uint32_t)((HEAD) >> 32))
+#define HEAD_NFREE(HEAD) ((uint32_t)(((HEAD) >> 16) & 0xffff))
+#define HEAD_TOP(HEAD) ((uint32_t)((HEAD)&0xffff))
+
 static int _initialized;
-static myst_kstack_t* _head;
 static myst_spinlock_t _lock;
+static uint64_t _head;
+static myst_kstack_t* _chunks[MAX_CHUNKS];
+static size_t _nchunks;
+static uint32_t _next[MYST_KSTACKS_LIMIT]; /* index + 1 of the next stack */
+static size_t _total;
+static size_t _limit;
+static size_t _high_water;
+
+static myst_kstack_t* _kstack_at(uint32_t index)
+{
+    myst_kstack_t* chunk;
+
+    chunk = __atomic_load_n(&_chunks[index / CHUNK_SIZE], __ATOMIC_ACQUIRE);
+    return chunk + (index % CHUNK_SIZE);
+}
+
+static uint32_t _index_of(const myst_kstack_t* kstack)
+{
+    const size_t nchunks = __atomic_load_n(&_nchunks, __ATOMIC_ACQUIRE);
+    const myst_kstack_t* region = _chunks[0];
+
+    /* the first chunks are contiguous (the kernel stacks region) */
+    if (kstack >= region && kstack < region + MYST_MAX_KSTACKS)
+        return (uint32_t)(kstack - region);
+
+    for (size_t i = MYST_MAX_KSTACKS / CHUNK_SIZE; i < nchunks; i++)
+    {
+        const myst_kstack_t* chunk = _chunks[i];
+
+        if (kstack >= chunk && kstack < chunk + CHUNK_SIZE)
+            return (uint32_t)(i * CHUNK_SIZE + (size_t)(kstack - chunk));
+    }
+
+    myst_panic("not a kernel stack: %p", kstack);
+}
+
+/* push a chain of stacks (linked through _next[]) */
+static void _push(uint32_t first, uint32_t last, uint32_t count)
+{
+    uint64_t head = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+    uint64_t new_head;
+
+    do
+    {
+        __atomic_store_n(&_next[last], HEAD_TOP(head), __ATOMIC_RELAXED);
+        new_head =
+            HEAD(HEAD_TAG(head) + 1, HEAD_NFREE(head) + count, first + 1);
+    } while (!__atomic_compare_exchange_n(
+        &_head, &head, new_head, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+static myst_kstack_t* _pop(void)
+{
+    uint64_t head = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+    uint64_t new_head;
+    uint32_t index;
+
+    do
+    {
+        if (HEAD_TOP(head) == 0)
+            return NULL;
+
+        /* the stack may be popped concurrently; the tag detects this */
+        index = HEAD_TOP(head) - 1;
+        new_head = HEAD(
+            HEAD_TAG(head) + 1,
+            HEAD_NFREE(head) - 1,
+            __atomic_load_n(&_next[index], __ATOMIC_RELAXED));
+    } while (!__atomic_compare_exchange_n(
+        &_head, &head, new_head, true, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+
+    /* update the high-water mark (written only when it rises) */
+    {
+        size_t total = __atomic_load_n(&_total, __ATOMIC_RELAXED);
+        size_t in_use = total - HEAD_NFREE(new_head);
+        size_t high = __atomic_load_n(&_high_water, __ATOMIC_RELAXED);
+
+        while (in_use > high)
+        {
+            if (__atomic_compare_exchange_n(
+                    &_high_water,
+                    &high,
+                    in_use,
+                    true,
+                    __ATOMIC_RELAXED,
+                    __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+    }
+
+    return _kstack_at(index);
+}
+
+/* add a chunk of stacks to the free list (caller holds _lock) */
+static void _add_chunk(myst_kstack_t* chunk)
+{
+    const uint32_t base = _nchunks * CHUNK_SIZE;
+
+    for (uint32_t i = 0; i + 1 < CHUNK_SIZE; i++)
+        _next[base + i] = base + i + 2;
+
+    __atomic_store_n(&_chunks[_nchunks], chunk, __ATOMIC_RELEASE);
+    __atomic_store_n(&_nchunks, _nchunks + 1, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&_total, CHUNK_SIZE, __ATOMIC_RELAXED);
+
+    _push(base, base + CHUNK_SIZE - 1, CHUNK_SIZE);
+}
+
+static int _grow(void)
+{
+    int ret = 0;
+    const size_t length = CHUNK_SIZE * sizeof(myst_kstack_t);
+    const int prot = MYST_PROT_READ | MYST_PROT_WRITE;
+    const int flags = MYST_MAP_ANONYMOUS | MYST_MAP_PRIVATE;
+    myst_kstack_t* chunk;
+
+    myst_spin_lock(&_lock);
+
+    /* another thread may have grown the free list already */
+    if (HEAD_TOP(__atomic_load_n(&_head, __ATOMIC_ACQUIRE)) != 0)
+        goto done;
+
+    if ((_nchunks + 1) * CHUNK_SIZE > _limit)
+        ERAISE(-ENOMEM);
+
+    chunk = myst_mmap(NULL, length, prot, flags, -1, 0);
+
+    if ((long)chunk < 0)
+        ERAISE(-ENOMEM);
+
+    /* make the guard pages non-accessible */
+    for (size_t i = 0; i < CHUNK_SIZE; i++)
+    {
+        const size_t size = sizeof(chunk[i].guard);
+
+        if (myst_mprotect(chunk[i].guard, size, MYST_PROT_NONE) != 0)
+        {
+            myst_munmap(chunk, length);
+            ERAISE(-ENOMEM);
+        }
+    }
+
+    _add_chunk(chunk);
+
+done:
+    myst_spin_unlock(&_lock);
+    return ret;
+}
 
 void myst_init_kstacks(void)
 {
@@ -15,13 +202,21 @@ void myst_init_kstacks(void)
         {
             uint8_t* p = (uint8_t*)__myst_kernel_args.kernel_stacks_data;
 
-            for (size_t i = 0; i < MYST_MAX_KSTACKS; i++)
-            {
-                myst_kstack_t* kstack = (myst_kstack_t*)p;
-                kstack->u.next = _head;
-                _head = kstack;
+            _limit = __myst_kernel_args.max_kstacks;
 
-                p += MYST_KSTACK_SIZE;
+            if (_limit == 0)
+                _limit = MYST_DEFAULT_KSTACKS_LIMIT;
+
+            if (_limit < MYST_MAX_KSTACKS)
+                _limit = MYST_MAX_KSTACKS;
+
+            if (_limit > MYST_KSTACKS_LIMIT)
+                _limit = MYST_KSTACKS_LIMIT;
+
+            for (size_t i = 0; i < MYST_MAX_KSTACKS / CHUNK_SIZE; i++)
+            {
+                _add_chunk((myst_kstack_t*)p);
+                p += CHUNK_SIZE * MYST_KSTACK_SIZE;
             }
 
             _initialized = 1;
@@ -34,22 +229,27 @@ myst_kstack_t* myst_get_kstack(void)
 {
     myst_kstack_t* kstack;
 
-    myst_spin_lock(&_lock);
+    while (!(kstack = _pop()))
     {
-        if ((kstack = _head))
-            _head = _head->u.next;
+        if (_grow() != 0)
+            return NULL;
     }
-    myst_spin_unlock(&_lock);
 
     return kstack;
 }
 
 void myst_put_kstack(myst_kstack_t* kstack)
 {
-    myst_spin_lock(&_lock);
-    {
-        kstack->u.next = _head;
-        _head = kstack;
-    }
-    myst_spin_unlock(&_lock);
+    const uint32_t index = _index_of(kstack);
+    _push(index, index, 1);
+}
+
+void myst_get_kstack_stats(myst_kstack_stats_t* stats)
+{
+    const uint64_t head = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+
+    stats->total = __atomic_load_n(&_total, __ATOMIC_RELAXED);
+    stats->in_use = stats->total - HEAD_NFREE(head);
+    stats->high_water = __atomic_load_n(&_high_water, __ATOMIC_RELAXED);
+    stats->limit = _limit;
 }
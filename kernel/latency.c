@@ -0,0 +1,339 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <myst/defs.h>
+#include <myst/eraise.h>
+#include <myst/kernel.h>
+#include <myst/latency.h>
+#include <myst/strings.h>
+#include <myst/tcall.h>
+#include <myst/times.h>
+
+/*
+**==============================================================================
+**
+** Latency histograms:
+**
+**     Each syscall and tcall number has a histogram of its latencies with
+**     logarithmic buckets. A histogram is made up of several shards and each
+**     thread updates the shard selected by its kernel stack address, so
+**     threads rarely write to the same cache lines. Shards are updated with
+**     relaxed atomic operations and are summed when the histograms are read.
+**
+**     Histograms come from a static pool and are assigned to a call number
+**     on its first use. Tcalls are made while the allocator and the mman
+**     hold their locks, so recording never allocates memory. Samples are
+**     dropped once the pool is exhausted.
+**
+**     Latencies are recorded in ticks (see myst_times_ticks()) and converted
+**     to nanoseconds when formatted.
+**
+**==============================================================================
+*/
+
+typedef struct shard
+{
+    uint64_t counts[MYST_LATENCY_BUCKETS];
+    uint64_t ticks;
+    uint64_t max;
+} MYST_ALIGN(64) shard_t;
+
+typedef struct histogram
+{
+    shard_t shards[MYST_LATENCY_SHARDS];
+} histogram_t;
+
+static histogram_t _pool[MYST_LATENCY_MAX_HISTOGRAMS];
+static uint32_t _pool_used;
+
+/* index + 1 of the histogram of each call number (0 if none yet) */
+static uint16_t _slots[2][MYST_LATENCY_MAX_NUM];
+
+MYST_STATIC_ASSERT(MYST_LATENCY_MAX_HISTOGRAMS < UINT16_MAX);
+
+/* get the histogram of a call number (NULL if it has none) */
+static histogram_t* _find_histogram(myst_latency_kind_t kind, long num)
+{
+    uint16_t slot = __atomic_load_n(&_slots[kind][num], __ATOMIC_ACQUIRE);
+    return slot ? &_pool[slot - 1] : NULL;
+}
+
+/* get the histogram of a call number, assigning one on first use */
+static histogram_t* _get_histogram(myst_latency_kind_t kind, long num)
+{
+    histogram_t* histogram;
+    uint32_t index;
+    uint16_t slot = 0;
+
+    if ((histogram = _find_histogram(kind, num)))
+        return histogram;
+
+    if (__atomic_load_n(&_pool_used, __ATOMIC_RELAXED) >=
+        MYST_LATENCY_MAX_HISTOGRAMS)
+    {
+        return NULL;
+    }
+
+    index = __atomic_fetch_add(&_pool_used, 1, __ATOMIC_RELAXED);
+
+    if (index >= MYST_LATENCY_MAX_HISTOGRAMS)
+        return NULL;
+
+    /* if another thread assigned one first, this pool entry goes unused */
+    if (!__atomic_compare_exchange_n(
+            &_slots[kind][num],
+            &slot,
+            (uint16_t)(index + 1),
+            false,
+            __ATOMIC_RELEASE,
+            __ATOMIC_ACQUIRE))
+    {
+        return &_pool[slot - 1];
+    }
+
+    return &_pool[index];
+}
+
+MYST_INLINE size_t _bucket_of(long ticks)
+{
+    size_t bucket;
+
+    if (ticks <= 0)
+        return 0;
+
+    bucket = 64 - __builtin_clzl((uint64_t)ticks);
+
+    if (bucket >= MYST_LATENCY_BUCKETS)
+        bucket = MYST_LATENCY_BUCKETS - 1;
+
+    return bucket;
+}
+
+/* select a shard from the stack address (threads use distinct stacks) */
+MYST_INLINE size_t _shard_of(const void* sp)
+{
+    uint64_t x = (uint64_t)sp >> 16;
+    return (x ^ (x >> 4) ^ (x >> 8)) % MYST_LATENCY_SHARDS;
+}
+
+void myst_latency_record(myst_latency_kind_t kind, long num, long ticks)
+{
+    histogram_t* histogram;
+    shard_t* shard;
+    size_t bucket;
+    uint64_t max;
+
+    if (num < 0 || num >= MYST_LATENCY_MAX_NUM)
+        return;
+
+    if (!(histogram = _get_histogram(kind, num)))
+        return;
+
+    if (ticks < 0)
+        ticks = 0;
+
+    shard = &histogram->shards[_shard_of(&shard)];
+
+    bucket = _bucket_of(ticks);
+    __atomic_fetch_add(&shard->counts[bucket], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&shard->ticks, ticks, __ATOMIC_RELAXED);
+
+    max = __atomic_load_n(&shard->max, __ATOMIC_RELAXED);
+
+    while ((uint64_t)ticks > max)
+    {
+        if (__atomic_compare_exchange_n(
+                &shard->max,
+                &max,
+                ticks,
+                true,
+                __ATOMIC_RELAXED,
+                __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+}
+
+/* sum the shards of a histogram */
+static void _sum(const histogram_t* histogram, shard_t* sum)
+{
+    memset(sum, 0, sizeof(shard_t));
+
+    for (size_t i = 0; i < MYST_LATENCY_SHARDS; i++)
+    {
+        const shard_t* shard = &histogram->shards[i];
+        uint64_t max;
+
+        for (size_t j = 0; j < MYST_LATENCY_BUCKETS; j++)
+        {
+            sum->counts[j] +=
+                __atomic_load_n(&shard->counts[j], __ATOMIC_RELAXED);
+        }
+
+        sum->ticks += __atomic_load_n(&shard->ticks, __ATOMIC_RELAXED);
+
+        if ((max = __atomic_load_n(&shard->max, __ATOMIC_RELAXED)) > sum->max)
+            sum->max = max;
+    }
+}
+
+static uint64_t _ncalls(const shard_t* sum)
+{
+    uint64_t ncalls = 0;
+
+    for (size_t i = 0; i < MYST_LATENCY_BUCKETS; i++)
+        ncalls += sum->counts[i];
+
+    return ncalls;
+}
+
+/* upper bound (in ticks) of the bucket holding the given percentile */
+static uint64_t _percentile(const shard_t* sum, uint64_t ncalls, size_t pct)
+{
+    const uint64_t rank = (ncalls * pct + 99) / 100;
+    uint64_t count = 0;
+
+    for (size_t i = 0; i < MYST_LATENCY_BUCKETS; i++)
+    {
+        if ((count += sum->counts[i]) >= rank)
+        {
+            const uint64_t bound = (i == 0) ? 0 : (1UL << i) - 1;
+            return (bound < sum->max) ? bound : sum->max;
+        }
+    }
+
+    return sum->max;
+}
+
+void myst_latency_get_totals(
+    myst_latency_kind_t kind,
+    long num,
+    size_t* ncalls,
+    long* ticks)
+{
+    const histogram_t* histogram;
+    shard_t sum;
+
+    *ncalls = 0;
+    *ticks = 0;
+
+    if (num < 0 || num >= MYST_LATENCY_MAX_NUM)
+        return;
+
+    if (!(histogram = _find_histogram(kind, num)))
+        return;
+
+    _sum(histogram, &sum);
+    *ncalls = _ncalls(&sum);
+    *ticks = (long)sum.ticks;
+}
+
+void myst_latency_reset(void)
+{
+    for (size_t k = 0; k < MYST_COUNTOF(_slots); k++)
+    {
+        for (long i = 0; i < MYST_LATENCY_MAX_NUM; i++)
+        {
+            histogram_t* histogram;
+
+            if (!(histogram = _find_histogram(k, i)))
+                continue;
+
+            /* calls that are underway may still be counted after this */
+            for (size_t j = 0; j < MYST_LATENCY_SHARDS; j++)
+            {
+                shard_t* shard = &histogram->shards[j];
+
+                for (size_t b = 0; b < MYST_LATENCY_BUCKETS; b++)
+                    __atomic_store_n(&shard->counts[b], 0, __ATOMIC_RELAXED);
+
+                __atomic_store_n(&shard->ticks, 0, __ATOMIC_RELAXED);
+                __atomic_store_n(&shard->max, 0, __ATOMIC_RELAXED);
+            }
+        }
+    }
+}
+
+int myst_latency_format(myst_buf_t* buf)
+{
+    int ret = 0;
+    static const char* _kinds[] = {"syscall", "tcall"};
+    struct locals
+    {
+        shard_t sum;
+        char line[256];
+    };
+    struct locals* locals = NULL;
+
+    if (!(locals = malloc(sizeof(struct locals))))
+        ERAISE(-ENOMEM);
+
+    myst_buf_clear(buf);
+
+    ECHECK(myst_snprintf(
+        locals->line,
+        sizeof(locals->line),
+        "%-7s %-36s %10s %14s %10s %10s %10s %10s\n",
+        "kind",
+        "name",
+        "calls",
+        "total_ns",
+        "mean_ns",
+        "p50_ns",
+        "p99_ns",
+        "max_ns"));
+    ECHECK(myst_buf_append(buf, locals->line, strlen(locals->line)));
+
+    for (size_t k = 0; k < MYST_COUNTOF(_slots); k++)
+    {
+        for (long i = 0; i < MYST_LATENCY_MAX_NUM; i++)
+        {
+            const histogram_t* histogram;
+            const char* name;
+            uint64_t ncalls;
+            long total;
+
+            if (!(histogram = _find_histogram(k, i)))
+                continue;
+
+            _sum(histogram, &locals->sum);
+
+            if ((ncalls = _ncalls(&locals->sum)) == 0)
+                continue;
+
+            if (k == MYST_LATENCY_SYSCALL)
+                name = myst_syscall_str(i);
+            else
+                name = myst_tcall_str(i);
+
+            total = myst_times_ticks_to_nsecs((long)locals->sum.ticks);
+
+            ECHECK(myst_snprintf(
+                locals->line,
+                sizeof(locals->line),
+                "%-7s %-36s %10lu %14ld %10lu %10ld %10ld %10ld\n",
+                _kinds[k],
+                name,
+                ncalls,
+                total,
+                (uint64_t)total / ncalls,
+                myst_times_ticks_to_nsecs(
+                    _percentile(&locals->sum, ncalls, 50)),
+                myst_times_ticks_to_nsecs(
+                    _percentile(&locals->sum, ncalls, 99)),
+                myst_times_ticks_to_nsecs((long)locals->sum.max)));
+            ECHECK(myst_buf_append(buf, locals->line, strlen(locals->line)));
+        }
+    }
+
+done:
+
+    if (locals)
+        free(locals);
+
+    return ret;
+}
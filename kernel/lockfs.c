@@ -769,6 +769,48 @@ done:
     return ret;
 }
 
+static ssize_t _fs_preadv(
+    myst_fs_t* fs,
+    myst_file_t* file,
+    const struct iovec* iov,
+    int iovcnt,
+    off_t offset)
+{
+    int ret = 0;
+    lockfs_t* lockfs = (lockfs_t*)fs;
+
+    if (!_lockfs_valid(lockfs))
+        ERAISE(-EINVAL);
+
+    myst_mutex_lock(&lockfs->lock);
+    ret = (*lockfs->fs->fs_preadv)(lockfs->fs, file, iov, iovcnt, offset);
+    myst_mutex_unlock(&lockfs->lock);
+
+done:
+    return ret;
+}
+
+static ssize_t _fs_pwritev(
+    myst_fs_t* fs,
+    myst_file_t* file,
+    const struct iovec* iov,
+    int iovcnt,
+    off_t offset)
+{
+    int ret = 0;
+    lockfs_t* lockfs = (lockfs_t*)fs;
+
+    if (!_lockfs_valid(lockfs))
+        ERAISE(-EINVAL);
+
+    myst_mutex_lock(&lockfs->lock);
+    ret = (*lockfs->fs->fs_pwritev)(lockfs->fs, file, iov, iovcnt, offset);
+    myst_mutex_unlock(&lockfs->lock);
+
+done:
+    return ret;
+}
+
 int myst_lockfs_init(myst_fs_t* fs, myst_fs_t** lockfs_out)
 {
     int ret = 0;
@@ -843,6 +885,14 @@ int myst_lockfs_init(myst_fs_t* fs, myst_fs_t** lockfs_out)
     lockfs->base = _base;
     lockfs->magic = LOCKFS_MAGIC;
     lockfs->fs = fs;
+
+    /* these operations are optional */
+    if (fs->fs_preadv)
+        lockfs->base.fs_preadv = _fs_preadv;
+
+    if (fs->fs_pwritev)
+        lockfs->base.fs_pwritev = _fs_pwritev;
+
     *lockfs_out = &lockfs->base;
 
 done:
@@ -28,6 +28,8 @@
 #include <myst/mmanutils.h>
 #include <myst/panic.h>
 #include <myst/printf.h>
+#include <myst/spinlock.h>
+#include <myst/tcall.h>
 
 static void _dlmalloc_abort(void)
 {
@@ -107,14 +109,279 @@ static int _dlmalloc_munmap(void* addr, size_t length)
 
 #define MAX_BACKTRACE_ADDRS 16
 
+/*
+**==============================================================================
+**
+** Thread caches:
+**
+**     Small blocks are served from size-class caches that sit in front of
+**     dlmalloc, so that most malloc/free pairs never take the dlmalloc lock.
+**     Each thread hashes (by its thread-specific data pointer) to one of
+**     NUM_CACHES caches, each with its own lock. A thread that finds its
+**     cache locked by another thread goes straight to dlmalloc instead of
+**     waiting. Caches are refilled with a batch of blocks from a single
+**     dlindependent_comalloc() call and flushed with a single dlbulk_free()
+**     call.
+**
+**     Every cached block is an ordinary dlmalloc chunk whose usable size is
+**     exactly the size of its class. A block freed by myst_free() is cached
+**     only if its usable size matches a class, so blocks of any origin may
+**     be passed to myst_free(), myst_realloc(), or dlfree().
+**
+**==============================================================================
+*/
+
+#define NUM_CACHES_SHIFT 6
+#define NUM_CACHES (1 << NUM_CACHES_SHIFT)
+#define NUM_LINEAR_CLASSES 64 /* usable sizes 24, 40, ..., 1032 */
+#define NUM_CLASSES (NUM_LINEAR_CLASSES + 6)
+#define MAX_BATCH 8
+#define BATCH_BYTES (16 * 1024)
+#define MAX_CACHE_BYTES (256 * 1024)
+
+typedef struct malloc_cache
+{
+    myst_spinlock_t lock;
+    size_t bytes;
+    void* lists[NUM_CLASSES];
+    uint8_t counts[NUM_CLASSES];
+    size_t hits;
+    size_t misses;
+    size_t bypasses;
+    size_t contention;
+    size_t refills;
+    size_t flushes;
+} __attribute__((aligned(64))) malloc_cache_t;
+
+static malloc_cache_t _caches[NUM_CACHES];
+
+/* usable sizes of the classes above the linear ones (each is 16 * N + 8) */
+static const size_t _large_class_sizes[] = {1544, 2056, 3080, 4104, 6152, 8200};
+
+MYST_STATIC_ASSERT(
+    NUM_LINEAR_CLASSES + MYST_COUNTOF(_large_class_sizes) == NUM_CLASSES);
+
+static size_t _class_size(size_t c)
+{
+    if (c < NUM_LINEAR_CLASSES)
+        return 16 * (c + 1) + 8;
+
+    return _large_class_sizes[c - NUM_LINEAR_CLASSES];
+}
+
+/* get the smallest class that can hold SIZE bytes (or NUM_CLASSES) */
+static size_t _size_to_class(size_t size)
+{
+    if (size <= 24)
+        return 0;
+
+    if (size <= _class_size(NUM_LINEAR_CLASSES - 1))
+        return (size - 24 + 15) / 16;
+
+    for (size_t c = NUM_LINEAR_CLASSES; c < NUM_CLASSES; c++)
+    {
+        if (size <= _class_size(c))
+            return c;
+    }
+
+    return NUM_CLASSES;
+}
+
+/* get the class whose size is exactly USABLE (or NUM_CLASSES) */
+static size_t _usable_to_class(size_t usable)
+{
+    size_t c = _size_to_class(usable);
+
+    if (c < NUM_CLASSES && _class_size(c) == usable)
+        return c;
+
+    return NUM_CLASSES;
+}
+
+/* number of blocks moved between a cache and dlmalloc at a time */
+static size_t _batch_size(size_t c)
+{
+    size_t n = BATCH_BYTES / _class_size(c);
+
+    if (n < 2)
+        return 2;
+
+    return (n > MAX_BATCH) ? MAX_BATCH : n;
+}
+
+static malloc_cache_t* _get_cache(void)
+{
+    uint64_t tsd = 0;
+
+    /* the TSD is zero until the first thread is running */
+    myst_tcall_get_tsd(&tsd);
+
+    /* Fibonacci hashing: use the top bits of the product as the index */
+    tsd = (tsd >> 6) * 0x9e3779b97f4a7c15;
+    return &_caches[tsd >> (64 - NUM_CACHES_SHIFT)];
+}
+
+static void* _cache_alloc(size_t size)
+{
+    const size_t c = _size_to_class(size);
+    malloc_cache_t* cache = _get_cache();
+    void* chunks[MAX_BATCH];
+    size_t sizes[MAX_BATCH];
+    size_t n;
+    void* ptr;
+
+    if (c == NUM_CLASSES)
+    {
+        __atomic_fetch_add(&cache->bypasses, 1, __ATOMIC_RELAXED);
+        return dlmalloc(size);
+    }
+
+    if (!myst_spin_trylock(&cache->lock))
+    {
+        __atomic_fetch_add(&cache->contention, 1, __ATOMIC_RELAXED);
+        return dlmalloc(_class_size(c));
+    }
+
+    if ((ptr = cache->lists[c]))
+    {
+        cache->lists[c] = *(void**)ptr;
+        cache->counts[c]--;
+        cache->bytes -= _class_size(c);
+        cache->hits++;
+        myst_spin_unlock(&cache->lock);
+        return ptr;
+    }
+
+    cache->misses++;
+    cache->refills++;
+    myst_spin_unlock(&cache->lock);
+
+    /* refill with a batch of blocks obtained under one dlmalloc lock */
+    n = _batch_size(c);
+
+    for (size_t i = 0; i < n; i++)
+        sizes[i] = _class_size(c);
+
+    if (!dlindependent_comalloc(n, sizes, chunks))
+        return NULL;
+
+    /* keep the first block and cache the rest */
+    myst_spin_lock(&cache->lock);
+    {
+        for (size_t i = 1; i < n; i++)
+        {
+            *(void**)chunks[i] = cache->lists[c];
+            cache->lists[c] = chunks[i];
+            cache->counts[c]++;
+            cache->bytes += _class_size(c);
+        }
+    }
+    myst_spin_unlock(&cache->lock);
+
+    return chunks[0];
+}
+
+static void _cache_free(void* ptr)
+{
+    const size_t c = _usable_to_class(dlmalloc_usable_size(ptr));
+    malloc_cache_t* cache;
+    void* chunks[MAX_BATCH];
+    size_t n = 0;
+
+    if (c == NUM_CLASSES)
+    {
+        dlfree(ptr);
+        return;
+    }
+
+    cache = _get_cache();
+
+    if (!myst_spin_trylock(&cache->lock))
+    {
+        __atomic_fetch_add(&cache->contention, 1, __ATOMIC_RELAXED);
+        dlfree(ptr);
+        return;
+    }
+
+    /* if the cache is full, release the block directly */
+    if (cache->bytes + _class_size(c) > MAX_CACHE_BYTES)
+    {
+        myst_spin_unlock(&cache->lock);
+        dlfree(ptr);
+        return;
+    }
+
+    *(void**)ptr = cache->lists[c];
+    cache->lists[c] = ptr;
+    cache->counts[c]++;
+    cache->bytes += _class_size(c);
+
+    /* when the list exceeds two batches, take one batch off to flush */
+    if (cache->counts[c] > 2 * _batch_size(c))
+    {
+        for (n = 0; n < _batch_size(c); n++)
+        {
+            chunks[n] = cache->lists[c];
+            cache->lists[c] = *(void**)chunks[n];
+        }
+
+        cache->counts[c] -= (uint8_t)n;
+        cache->bytes -= n * _class_size(c);
+        cache->flushes++;
+    }
+
+    myst_spin_unlock(&cache->lock);
+
+    if (n)
+        dlbulk_free(chunks, n);
+}
+
+int myst_get_malloc_stats(myst_malloc_stats_t* stats)
+{
+    if (!stats)
+        return -EINVAL;
+
+    memset(stats, 0, sizeof(myst_malloc_stats_t));
+    stats->usage = dlmallinfo().uordblks;
+    stats->peak_usage = dlmalloc_max_footprint();
+
+    for (size_t i = 0; i < NUM_CACHES; i++)
+    {
+        const malloc_cache_t* cache = &_caches[i];
+
+        stats->cache_hits += cache->hits;
+        stats->cache_misses += cache->misses;
+        stats->cache_bypasses += cache->bypasses;
+        stats->cache_contention += cache->contention;
+        stats->cache_refills += cache->refills;
+        stats->cache_flushes += cache->flushes;
+        stats->cache_bytes += cache->bytes;
+    }
+
+    return 0;
+}
+
 void* myst_malloc(size_t size)
 {
-    return dlmalloc(size);
+    return _cache_alloc(size);
 }
 
 void* myst_calloc(size_t nmemb, size_t size)
 {
-    return dlcalloc(nmemb, size);
+    size_t n;
+    void* ptr;
+
+    /* dlcalloc() handles overflow and knows when memory is already zero */
+    if (__builtin_mul_overflow(nmemb, size, &n) ||
+        _size_to_class(n) == NUM_CLASSES)
+    {
+        return dlcalloc(nmemb, size);
+    }
+
+    if ((ptr = _cache_alloc(n)))
+        memset(ptr, 0, n);
+
+    return ptr;
 }
 
 void* myst_realloc(void* ptr, size_t size)
@@ -134,7 +401,8 @@ int myst_posix_memalign(void** memptr, size_t alignment, size_t size)
 
 void myst_free(void* ptr)
 {
-    dlfree(ptr);
+    if (ptr)
+        _cache_free(ptr);
 }
 
 /*
@@ -51,6 +51,7 @@
 **
 **     - The next VAD on the linked list (see description below).
 **     - The previous VAD on the linked list (see description below).
+**     - The left and right children in the VAD tree (see description below).
 **     - The starting address of the memory region.
 **     - The size of the memory region.
 **     - Memory R/W/X flags originally set by mmap/mremap.
@@ -63,57 +64,36 @@
 ** PERFORMANCE:
 ** ============
 **
-** The current implementation organizes VADs onto a simple linear linked list.
-** The time complexities of the related operations (MAP, REMAP, and UNMAP) are
-** all O(N), where N is the number of VADs in the linked list.
-**
-** In the worst case, N is the maximum number of pages, where a memory region
-** is assigned for every available page. For a 128 MB memory space, N is less
-** than 32,768.
-**
-** The MUSL memory allocator (malloc, realloc, calloc, free) uses both
-**
-**     - BREAK memory -- for allocations less than 56 pages
-**     - MAPPED memory -- for allocates greater or equal to 57 pages
-**
-** In this context, the time complexities of the mapping operations fall to
-** O(M), where M is:
-**
-**     NUM_PAGES = 32,768 pages
-**     SMALLEST_ALLOCATION = 57 pages
-**     M = NUM_PAGES / SMALLEST_ALLOCATION
-**     M = 574
-**
-** M will even be smaller when the VADs and BREAK regions are subtracted from
-** NUM_PAGES. A rough estimates puts the time complexity for the mapping
-** operations at about O(M), where M == 400.
-**
-** OPTIMIZATION:
-** =============
-**
-** To optimize performance, one might consider organizing the active VADs into
-** a balanced binary tree variant (AVL or red-black). Two operations must be
-** accounted for.
+** Assigned VADs are also organized into an AVL tree, keyed by starting
+** address. Two operations are accounted for.
 **
 **     - Address lookup -- lookup the VAD that contains the given address
 **     - Gap lookup -- find a gap greater than a given size
 **
-** For address lookup a simple AVL tree will suffice such that the key is the
-** starting address of the VAD. The lookup function should check to see if the
-** address falls within the address range given by the VAD. Address lookup will
-** be O(log 2 N).
+** Address lookup descends the tree, checking whether the address falls
+** within the range given by each VAD. Address lookup is O(log 2 N).
 **
-** Gap lookup is more complicated. The AVL tree could be extended so that each
-** node in the tree (that is each VAD) contains the maximum gap size of the
-** subtree for which it is a root. The lookup function simply looks for any
-** gap that is large enough. An alternative is to look for the best fit, but
-** this is not strictly necessary. Gap lookup will be O(log 2 N).
+** For gap lookup, each node in the tree (that is each VAD) contains the
+** maximum gap size of the subtree for which it is a root, where the gap of a
+** VAD is the distance to the next VAD (or to END for the last VAD). The lookup
+** function descends towards the leftmost VAD whose gap is large enough, so
+** it finds the same first-fit gap as a linear scan of the list would. Gap
+** lookup is O(log 2 N).
+**
+** The linked list is retained for in-order traversal (dumping, sanity checks,
+** and free-size computation) and to find the neighbors of a VAD in O(1). Any
+** operation that changes the address or size of a VAD must refresh the cached
+** gaps of that VAD and of its predecessor (see _mman_update_vad()).
+**
+** In the worst case, N is the maximum number of pages, where a memory region
+** is assigned for every available page.
 **
 **==============================================================================
 */
 
 #include <assert.h>
 #include <errno.h>
+#include <myst/bits.h>
 #include <myst/defs.h>
 #include <myst/fsgs.h>
 #include <myst/mman.h>
@@ -257,14 +237,211 @@ static void _list_remove(myst_mman_t* mman, myst_vad_t* vad)
     }
 }
 
+/*
+**==============================================================================
+**
+** _Tree functions
+**
+**==============================================================================
+*/
+
+/* Get the height of the subtree rooted at VAD */
+MYST_INLINE uint32_t _tree_height(const myst_vad_t* vad)
+{
+    return vad ? vad->height : 0;
+}
+
+/* Get the largest gap in the subtree rooted at VAD */
+MYST_INLINE uint64_t _tree_max_gap(const myst_vad_t* vad)
+{
+    return vad ? vad->max_gap : 0;
+}
+
+/* Recompute the height and largest gap of VAD from its children */
+static void _tree_fix(myst_mman_t* mman, myst_vad_t* vad)
+{
+    uint32_t lh = _tree_height(vad->left);
+    uint32_t rh = _tree_height(vad->right);
+    uint64_t gap = _get_right_gap(mman, vad);
+    uint64_t lgap = _tree_max_gap(vad->left);
+    uint64_t rgap = _tree_max_gap(vad->right);
+
+    vad->height = (lh > rh ? lh : rh) + 1;
+
+    if (lgap > gap)
+        gap = lgap;
+
+    if (rgap > gap)
+        gap = rgap;
+
+    vad->max_gap = gap;
+}
+
+/* Rotate the subtree rooted at VAD to the right and return the new root */
+static myst_vad_t* _tree_rotate_right(myst_mman_t* mman, myst_vad_t* vad)
+{
+    myst_vad_t* left = vad->left;
+
+    vad->left = left->right;
+    left->right = vad;
+    _tree_fix(mman, vad);
+    _tree_fix(mman, left);
+
+    return left;
+}
+
+/* Rotate the subtree rooted at VAD to the left and return the new root */
+static myst_vad_t* _tree_rotate_left(myst_mman_t* mman, myst_vad_t* vad)
+{
+    myst_vad_t* right = vad->right;
+
+    vad->right = right->left;
+    right->left = vad;
+    _tree_fix(mman, vad);
+    _tree_fix(mman, right);
+
+    return right;
+}
+
+/* Restore the AVL property of the subtree rooted at VAD; return new root */
+static myst_vad_t* _tree_balance(myst_mman_t* mman, myst_vad_t* vad)
+{
+    uint32_t lh;
+    uint32_t rh;
+
+    _tree_fix(mman, vad);
+
+    lh = _tree_height(vad->left);
+    rh = _tree_height(vad->right);
+
+    if (lh > rh + 1)
+    {
+        myst_vad_t* left = vad->left;
+
+        if (_tree_height(left->left) < _tree_height(left->right))
+            vad->left = _tree_rotate_left(mman, left);
+
+        return _tree_rotate_right(mman, vad);
+    }
+
+    if (rh > lh + 1)
+    {
+        myst_vad_t* right = vad->right;
+
+        if (_tree_height(right->right) < _tree_height(right->left))
+            vad->right = _tree_rotate_right(mman, right);
+
+        return _tree_rotate_left(mman, vad);
+    }
+
+    return vad;
+}
+
+/* Insert VAD into the subtree rooted at ROOT and return the new root */
+static myst_vad_t* _tree_insert(
+    myst_mman_t* mman,
+    myst_vad_t* root,
+    myst_vad_t* vad)
+{
+    if (!root)
+    {
+        vad->left = NULL;
+        vad->right = NULL;
+        _tree_fix(mman, vad);
+        return vad;
+    }
+
+    if (vad->addr < root->addr)
+        root->left = _tree_insert(mman, root->left, vad);
+    else
+        root->right = _tree_insert(mman, root->right, vad);
+
+    return _tree_balance(mman, root);
+}
+
+/* Detach the leftmost VAD of the subtree rooted at ROOT; return new root */
+static myst_vad_t* _tree_remove_min(
+    myst_mman_t* mman,
+    myst_vad_t* root,
+    myst_vad_t** min)
+{
+    if (!root->left)
+    {
+        *min = root;
+        return root->right;
+    }
+
+    root->left = _tree_remove_min(mman, root->left, min);
+
+    return _tree_balance(mman, root);
+}
+
+/* Remove VAD from the subtree rooted at ROOT and return the new root */
+static myst_vad_t* _tree_remove(
+    myst_mman_t* mman,
+    myst_vad_t* root,
+    myst_vad_t* vad)
+{
+    if (!root)
+        return NULL;
+
+    if (vad->addr < root->addr)
+    {
+        root->left = _tree_remove(mman, root->left, vad);
+    }
+    else if (vad->addr > root->addr)
+    {
+        root->right = _tree_remove(mman, root->right, vad);
+    }
+    else
+    {
+        myst_vad_t* left = root->left;
+        myst_vad_t* right = root->right;
+        myst_vad_t* min = NULL;
+
+        root->left = NULL;
+        root->right = NULL;
+
+        if (!right)
+            return left;
+
+        /* Replace ROOT with its in-order successor */
+        right = _tree_remove_min(mman, right, &min);
+        min->left = left;
+        min->right = right;
+
+        return _tree_balance(mman, min);
+    }
+
+    return _tree_balance(mman, root);
+}
+
+/* Refresh the cached gaps along the path from ROOT down to VAD */
+static void _tree_update(myst_mman_t* mman, myst_vad_t* root, myst_vad_t* vad)
+{
+    if (!root)
+        return;
+
+    if (vad->addr < root->addr)
+        _tree_update(mman, root->left, vad);
+    else if (vad->addr > root->addr)
+        _tree_update(mman, root->right, vad);
+
+    _tree_fix(mman, root);
+}
+
 /* Find a VAD that contains the given address */
-static myst_vad_t* _list_find(myst_mman_t* mman, uintptr_t addr)
+static myst_vad_t* _tree_find(myst_mman_t* mman, uintptr_t addr)
 {
-    myst_vad_t* p;
+    myst_vad_t* p = mman->vad_tree;
 
-    for (p = mman->vad_list; p; p = p->next)
+    while (p)
     {
-        if (addr >= p->addr && addr < _end(p))
+        if (addr < p->addr)
+            p = p->left;
+        else if (addr >= _end(p))
+            p = p->right;
+        else
             return p;
     }
 
@@ -272,6 +449,28 @@ static myst_vad_t* _list_find(myst_mman_t* mman, uintptr_t addr)
     return NULL;
 }
 
+/* Find the lowest VAD whose right gap is greater than or equal to SIZE */
+static myst_vad_t* _tree_find_gap(myst_mman_t* mman, size_t size)
+{
+    myst_vad_t* p = mman->vad_tree;
+
+    if (_tree_max_gap(p) < size)
+        return NULL;
+
+    while (p)
+    {
+        if (_tree_max_gap(p->left) >= size)
+            p = p->left;
+        else if (_get_right_gap(mman, p) >= size)
+            return p;
+        else
+            p = p->right;
+    }
+
+    /* Unreachable if the cached gaps are consistent */
+    return NULL;
+}
+
 /*
 **==============================================================================
 **
@@ -342,6 +541,43 @@ done:
     return vad;
 }
 
+/* Insert VAD after PREV (on both the list and the tree) */
+static void _mman_insert_vad(
+    myst_mman_t* mman,
+    myst_vad_t* prev,
+    myst_vad_t* vad)
+{
+    _list_insert_after(mman, prev, vad);
+    mman->vad_tree = _tree_insert(mman, mman->vad_tree, vad);
+
+    /* The right gap of PREV now ends at VAD */
+    if (prev)
+        _tree_update(mman, mman->vad_tree, prev);
+}
+
+/* Remove VAD (from both the list and the tree) */
+static void _mman_remove_vad(myst_mman_t* mman, myst_vad_t* vad)
+{
+    myst_vad_t* prev = vad->prev;
+
+    _list_remove(mman, vad);
+    mman->vad_tree = _tree_remove(mman, mman->vad_tree, vad);
+
+    /* The right gap of PREV now extends over the removed VAD */
+    if (prev)
+        _tree_update(mman, mman->vad_tree, prev);
+}
+
+/* Refresh the cached gaps after the address or size of VAD changed */
+static void _mman_update_vad(myst_mman_t* mman, myst_vad_t* vad)
+{
+    _tree_update(mman, mman->vad_tree, vad);
+
+    /* The right gap of the predecessor depends on the address of VAD */
+    if (vad->prev)
+        _tree_update(mman, mman->vad_tree, vad->prev);
+}
+
 /* Synchronize the MAP value to the address of the first list element */
 static void _mman_sync_top(myst_mman_t* mman)
 {
@@ -388,27 +624,21 @@ static uintptr_t _mman_find_gap(
     if (!_mman_is_sane(mman))
         goto done;
 
-    /* Look for a gap in the VAD list */
+    /* Look for a gap in the VAD tree (between HEAD and END) */
     {
         myst_vad_t* p;
 
-        /* Search for gaps between HEAD and TAIL */
-        for (p = mman->vad_list; p; p = p->next)
+        if ((p = _tree_find_gap(mman, size)))
         {
-            size_t gap = _get_right_gap(mman, p);
-
-            if (gap >= size)
-            {
-                *left = p;
-                *right = p->next;
+            *left = p;
+            *right = p->next;
 
-                addr = _end(p);
-                goto done;
-            }
+            addr = _end(p);
+            goto done;
         }
     }
 
-    /* No gaps in linked list so obtain memory from mapped memory area */
+    /* No gaps in the VAD tree so obtain memory from mapped memory area */
     {
         uintptr_t start = mman->map - size;
 
@@ -429,19 +659,70 @@ done:
     return addr;
 }
 
-#define _MMAN_MPROTECT_PAGES(MMAN, ADDR, LEN, PROT)            \
-    {                                                          \
-        if (myst_tcall_mprotect(ADDR, LEN, PROT))              \
-        {                                                      \
-            _mman_set_err(MMAN, "mprotect tcall failed");      \
-            ret = -EINVAL;                                     \
-            goto done;                                         \
-        }                                                      \
-        memset(                                                \
-            (MMAN)->prot_vector +                              \
-                ((uintptr_t)ADDR - (MMAN)->start) / PAGE_SIZE, \
-            PROT,                                              \
-            (LEN) / PAGE_SIZE);                                \
+/*
+** Change the protection of the pages in [ADDR, ADDR+LEN) to PROT. Pages whose
+** prot_vector entries already hold PROT are skipped, and each remaining run of
+** contiguous pages is changed with a single mprotect tcall. If no page needs
+** changing, the tcall is elided altogether.
+*/
+static int _mman_mprotect_pages(
+    myst_mman_t* mman,
+    void* addr,
+    size_t len,
+    int prot)
+{
+    uint8_t* vector =
+        mman->prot_vector + ((uintptr_t)addr - mman->start) / PAGE_SIZE;
+    const size_t npages = len / PAGE_SIZE;
+    size_t i = 0;
+    bool issued = false;
+
+    while (i < npages)
+    {
+        const uint8_t* p;
+        size_t first;
+        size_t last;
+
+        /* Find the first page that does not already have PROT */
+        if (!(p = myst_memcchr(vector + i, prot, npages - i)))
+            break;
+
+        first = (size_t)(p - vector);
+
+        /* Find the end of this run of pages */
+        if ((p = memchr(vector + first, prot, npages - first)))
+            last = (size_t)(p - vector);
+        else
+            last = npages;
+
+        if (myst_tcall_mprotect(
+                (uint8_t*)addr + first * PAGE_SIZE,
+                (last - first) * PAGE_SIZE,
+                prot))
+        {
+            return -EINVAL;
+        }
+
+        memset(vector + first, prot, last - first);
+        mman->mprotect_tcalls_issued++;
+        issued = true;
+        i = last;
+    }
+
+    if (!issued)
+        mman->mprotect_tcalls_elided++;
+
+    return 0;
+}
+
+#define _MMAN_MPROTECT_PAGES(MMAN, ADDR, LEN, PROT)                \
+    {                                                              \
+        if (_mman_mprotect_pages(MMAN, (void*)(ADDR), LEN, PROT))  \
+        {                                                          \
+            _mman_set_err(MMAN, "mprotect tcall failed");          \
+            ret = -EINVAL;                                         \
+            goto done;                                             \
+        }                                                          \
     }
 
 /* set each page within the range's permission tracking as prot*/
@@ -468,6 +749,179 @@ static int _mman_get_prot(
     return (myst_memcchr(start + 1, start[0], num_pages - 1) == NULL) ? 0 : -1;
 }
 
+/* set (or clear) the bits of BITMAP for the pages in [ADDR:ADDR+LEN) and keep
+ * COUNT equal to the number of bits set */
+static void _mman_set_bits(
+    myst_mman_t* mman,
+    uint8_t* bitmap,
+    size_t* count,
+    uintptr_t addr,
+    size_t len,
+    bool value)
+{
+    size_t index = (addr - mman->start) / PAGE_SIZE;
+    const size_t end = index + len / PAGE_SIZE;
+
+    /* Skip the scan in the common case where no bits are set */
+    if (!value && *count == 0)
+        return;
+
+    for (; index < end; index++)
+    {
+        if (myst_test_bit(bitmap, index) == value)
+            continue;
+
+        if (value)
+        {
+            myst_set_bit(bitmap, index);
+            (*count)++;
+        }
+        else
+        {
+            myst_clear_bit(bitmap, index);
+            (*count)--;
+        }
+    }
+}
+
+/* mark the pages in [ADDR:ADDR+LEN) as released by madvise() */
+static void _mman_set_released(myst_mman_t* mman, uintptr_t addr, size_t len)
+{
+    _mman_set_bits(
+        mman, mman->released_bitmap, &mman->released_pages, addr, len, true);
+}
+
+/* forget the released and file bits of pages being mapped or unmapped */
+static void _mman_reset_pages(myst_mman_t* mman, uintptr_t addr, size_t len)
+{
+    _mman_set_bits(
+        mman, mman->released_bitmap, &mman->released_pages, addr, len, false);
+    _mman_set_bits(
+        mman, mman->file_bitmap, &mman->file_pages, addr, len, false);
+}
+
+/* forget that the pages in [ADDR:ADDR+LEN) are known to be zero */
+static void _mman_clear_zero(myst_mman_t* mman, uintptr_t addr, size_t len)
+{
+    const size_t first = (addr - mman->start) / PAGE_SIZE;
+    const size_t end = first + len / PAGE_SIZE;
+
+    for (size_t i = first; i < end; i++)
+        myst_clear_bit(mman->zero_bitmap, i);
+}
+
+/* zero-fill newly mapped pages, skipping those known to be zero already, and
+ * then give the pages the PROT permissions */
+static int _mman_map_pages(myst_mman_t* mman, void* addr, size_t len, int prot)
+{
+    const size_t first = ((uintptr_t)addr - mman->start) / PAGE_SIZE;
+    const size_t npages = len / PAGE_SIZE;
+    bool writable = false;
+    size_t i = 0;
+
+    while (i < npages)
+    {
+        size_t j = i;
+
+        /* skip pages that have not been written since they were zeroed */
+        if (myst_test_bit(mman->zero_bitmap, first + i))
+        {
+            myst_clear_bit(mman->zero_bitmap, first + i);
+            mman->zero_fill_pages_elided++;
+            i++;
+            continue;
+        }
+
+        while (j < npages && !myst_test_bit(mman->zero_bitmap, first + j))
+            j++;
+
+        /* For readonly memory, need to set w permission first to clear the
+         * memory */
+        if (!writable)
+        {
+            if (_mman_mprotect_pages(mman, addr, len, prot | MYST_PROT_WRITE))
+                return -EINVAL;
+
+            writable = true;
+        }
+
+        memset((uint8_t*)addr + i * PAGE_SIZE, 0, (j - i) * PAGE_SIZE);
+        i = j;
+    }
+
+    if (_mman_mprotect_pages(mman, addr, len, prot))
+        return -EINVAL;
+
+    return 0;
+}
+
+/* zero-fill [ADDR:ADDR+LEN), temporarily adding write access where needed */
+static int _mman_zero_pages(myst_mman_t* mman, uintptr_t addr, size_t len)
+{
+    const uint8_t* pv = mman->prot_vector + (addr - mman->start) / PAGE_SIZE;
+    const size_t npages = len / PAGE_SIZE;
+    size_t i = 0;
+
+    /* handle each run of pages with identical permissions */
+    while (i < npages)
+    {
+        const int prot = pv[i];
+        size_t j = i + 1;
+
+        while (j < npages && pv[j] == prot)
+            j++;
+
+        void* p = (void*)(addr + i * PAGE_SIZE);
+        size_t n = (j - i) * PAGE_SIZE;
+
+        if (!(prot & MYST_PROT_WRITE))
+        {
+            if (_mman_mprotect_pages(mman, p, n, prot | MYST_PROT_WRITE))
+                return -EINVAL;
+        }
+
+        memset(p, 0, n);
+
+        if (!(prot & MYST_PROT_WRITE))
+        {
+            if (_mman_mprotect_pages(mman, p, n, prot))
+                return -EINVAL;
+        }
+
+        i = j;
+    }
+
+    return 0;
+}
+
+/* return true if every page in [START:END) is break memory or mapped */
+static bool _mman_is_mapped(myst_mman_t* mman, uintptr_t start, uintptr_t end)
+{
+    uintptr_t brk_end;
+
+    /* break memory is mapped up to the page that holds the break value */
+    if (myst_round_up(mman->brk, PAGE_SIZE, &brk_end) != 0)
+        return false;
+
+    while (start < end)
+    {
+        myst_vad_t* vad;
+
+        if (start < brk_end)
+        {
+            start = brk_end;
+            continue;
+        }
+
+        if (!(vad = _tree_find(mman, start)))
+            return false;
+
+        start = _end(vad);
+    }
+
+    return true;
+}
+
 static int _munmap(myst_mman_t* mman, void* addr, size_t length)
 {
     int ret = -1;
@@ -523,7 +977,7 @@ static int _munmap(myst_mman_t* mman, void* addr, size_t length)
     */
 
     /* Find the VAD that contains this address */
-    if (!(vad = _list_find(mman, start)))
+    if (!(vad = _tree_find(mman, start)))
     {
         _mman_set_err(mman, "address not found");
         ret = -EINVAL;
@@ -551,7 +1005,7 @@ static int _munmap(myst_mman_t* mman, void* addr, size_t length)
     {
         /* Case1: [uuuuuuuuuuuuuuuu] */
 
-        _list_remove(mman, vad);
+        _mman_remove_vad(mman, vad);
         _mman_sync_top(mman);
         _free_list_put(mman, vad);
     }
@@ -561,6 +1015,7 @@ static int _munmap(myst_mman_t* mman, void* addr, size_t length)
 
         vad->addr += length;
         vad->size -= (uint32_t)length;
+        _mman_update_vad(mman, vad);
         _mman_sync_top(mman);
     }
     else if (_end(vad) == end)
@@ -568,6 +1023,7 @@ static int _munmap(myst_mman_t* mman, void* addr, size_t length)
         /* Case3: [............uuuu] */
 
         vad->size -= (uint32_t)length;
+        _mman_update_vad(mman, vad);
     }
     else
     {
@@ -589,7 +1045,7 @@ static int _munmap(myst_mman_t* mman, void* addr, size_t length)
             goto done;
         }
 
-        _list_insert_after(mman, vad, right);
+        _mman_insert_vad(mman, vad, right);
         _mman_sync_top(mman);
     }
 
@@ -605,6 +1061,8 @@ static int _munmap(myst_mman_t* mman, void* addr, size_t length)
 
     _MMAN_MPROTECT_PAGES(mman, addr, length, MYST_PROT_NONE)
 
+    _mman_reset_pages(mman, start, length);
+
     if (!_mman_is_sane(mman))
     {
         ret = -EINVAL;
@@ -740,7 +1198,7 @@ static int _mmap(
         /* Fail if [addr:length] is not already mapped and MAP_FIXED is
          * requested.
          */
-        if ((vad = _list_find(mman, start)) && end <= _end(vad))
+        if ((vad = _tree_find(mman, start)) && end <= _end(vad))
         {
             *ptr_out = addr;
             goto done;
@@ -779,10 +1237,12 @@ static int _mmap(
             /* Coalesce with RIGHT neighbor (and release right neighbor) */
             if (right && (start + length == right->addr))
             {
-                _list_remove(mman, right);
+                _mman_remove_vad(mman, right);
                 left->size += right->size;
                 _free_list_put(mman, right);
             }
+
+            _mman_update_vad(mman, left);
         }
         else if (right && (start + length == right->addr))
         {
@@ -790,6 +1250,7 @@ static int _mmap(
 
             right->addr = start;
             right->size += (uint32_t)length;
+            _mman_update_vad(mman, right);
             _mman_sync_top(mman);
         }
         else
@@ -805,7 +1266,7 @@ static int _mmap(
                 goto done;
             }
 
-            _list_insert_after(mman, left, vad);
+            _mman_insert_vad(mman, left, vad);
             _mman_sync_top(mman);
         }
     }
@@ -829,23 +1290,12 @@ done:
     /* Zero-fill mapped memory */
     if (ptr_out && *ptr_out)
     {
-        /* For readonly memory, need to set w permission first to clear the
-         * memory */
-        if (myst_tcall_mprotect(*ptr_out, length, (prot | MYST_PROT_WRITE)))
+        if (_mman_map_pages(mman, *ptr_out, length, prot) != 0)
         {
             _mman_set_err(mman, "mprotect tcall failed");
             return -EINVAL;
         }
-        memset(*ptr_out, 0, length);
-        if (!(prot & MYST_PROT_WRITE))
-        {
-            if (myst_tcall_mprotect(*ptr_out, length, prot))
-            {
-                _mman_set_err(mman, "mprotect tcall failed");
-                return -EINVAL;
-            }
-        }
-        _MMAN_SET_PAGES_PROT(mman, *ptr_out, length, prot)
+        _mman_reset_pages(mman, (uintptr_t)*ptr_out, length);
     }
     return ret;
 }
@@ -917,8 +1367,8 @@ int myst_mman_init(myst_mman_t* mman, uintptr_t base, size_t size)
     /* Save the size of the heap */
     mman->size = size;
 
-    /* Set the start of the heap area, which follows the VADs array
-       and prot_vector */
+    /* Set the start of the heap area, which follows the VADs array,
+       the prot_vector and the released, zero and file bitmaps */
     mman->prot_vector = (uint8_t*)(base + (num_pages * sizeof(myst_vad_t)));
     /* Round start up to next 8-byte multiple */
     if (myst_round_up(
@@ -929,7 +1379,15 @@ int myst_mman_init(myst_mman_t* mman, uintptr_t base, size_t size)
         ret = -EINVAL;
         goto done;
     }
-    mman->start = (uintptr_t)mman->prot_vector + (num_pages * sizeof(uint8_t));
+    /* The released, zero and file bitmaps follow the prot vector */
+    mman->released_bitmap = mman->prot_vector + (num_pages * sizeof(uint8_t));
+    memset(mman->released_bitmap, 0, (num_pages + 7) / 8);
+    mman->zero_bitmap = mman->released_bitmap + (num_pages + 7) / 8;
+    memset(mman->zero_bitmap, 0, (num_pages + 7) / 8);
+    mman->file_bitmap = mman->zero_bitmap + (num_pages + 7) / 8;
+    memset(mman->file_bitmap, 0, (num_pages + 7) / 8);
+
+    mman->start = (uintptr_t)mman->file_bitmap + (num_pages + 7) / 8;
     /* Round start up to next page multiple */
     if (myst_round_up(
             (uint64_t)(mman->start), PAGE_SIZE, (uint64_t*)&mman->start) != 0)
@@ -948,9 +1406,17 @@ int myst_mman_init(myst_mman_t* mman, uintptr_t base, size_t size)
     /* Set the top of the mapped memory (grows negatively) */
     mman->map = mman->end;
 
-    /* Set the UNASSIGNED region as not accesible */
-    _MMAN_MPROTECT_PAGES(
-        mman, (void*)mman->start, mman->end - mman->start, MYST_PROT_NONE)
+    /* Set the UNASSIGNED region as not accesible (unconditionally, since the
+     * prot vector does not reflect the host page permissions yet) */
+    if (myst_tcall_mprotect(
+            (void*)mman->start, mman->end - mman->start, MYST_PROT_NONE))
+    {
+        _mman_set_err(mman, "mprotect tcall failed");
+        ret = -EINVAL;
+        goto done;
+    }
+    _MMAN_SET_PAGES_PROT(
+        mman, mman->start, mman->end - mman->start, MYST_PROT_NONE)
 
     /* Set pointer to the next available entry in the myst_vad_t array */
     mman->next_vad = (myst_vad_t*)base;
@@ -964,6 +1430,9 @@ int myst_mman_init(myst_mman_t* mman, uintptr_t base, size_t size)
     /* Set the myst_vad_t linked list to null */
     mman->vad_list = NULL;
 
+    /* Set the myst_vad_t tree to null */
+    mman->vad_tree = NULL;
+
     /* Sanity checks are disabled by default */
     mman->sanity = false;
 
@@ -973,17 +1442,45 @@ int myst_mman_init(myst_mman_t* mman, uintptr_t base, size_t size)
     /* Finally, set initialized to true */
     mman->initialized = 1;
 
-    /* Check sanity of mman */
-    if (!_mman_is_sane(mman))
+    /* Check sanity of mman */
+    if (!_mman_is_sane(mman))
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    ret = 0;
+
+done:
+    return ret;
+}
+
+/*
+**
+** myst_mman_set_zero_filled()
+**
+**     Declare that every page of the heap currently contains only zeros (as
+**     when the heap was loaded into the enclave), so that mapping these pages
+**     for the first time does not need to zero-fill them again. This must be
+**     called right after myst_mman_init(), before any memory is allocated.
+**
+** Parameters:
+**     [IN] mman - mman structure
+**
+*/
+void myst_mman_set_zero_filled(myst_mman_t* mman)
+{
+    bool locked = false;
+    const size_t npages = (mman->end - mman->start) / PAGE_SIZE;
+
+    _mman_lock(mman, &locked);
     {
-        ret = -EINVAL;
-        goto done;
-    }
+        memset(mman->zero_bitmap, 0xff, npages / 8);
 
-    ret = 0;
-
-done:
-    return ret;
+        for (size_t i = npages / 8 * 8; i < npages; i++)
+            myst_set_bit(mman->zero_bitmap, i);
+    }
+    _mman_unlock(mman, &locked);
 }
 
 /*
@@ -1051,11 +1548,17 @@ int myst_mman_sbrk(myst_mman_t* mman, ptrdiff_t increment, void** ptr_out)
             goto done;
         }
         if (brk_new_page_aligned > brk_old_page_aligned)
+        {
             _MMAN_MPROTECT_PAGES(
                 mman,
                 (void*)brk_old_page_aligned,
                 brk_new_page_aligned - brk_old_page_aligned,
                 MYST_PROT_READ | MYST_PROT_WRITE)
+            _mman_clear_zero(
+                mman,
+                brk_old_page_aligned,
+                brk_new_page_aligned - brk_old_page_aligned);
+        }
     }
     else
     {
@@ -1144,17 +1647,29 @@ int myst_mman_brk(myst_mman_t* mman, void* addr, void** ptr)
             goto done;
         }
         if (brk_new_page_aligned > brk_old_page_aligned)
+        {
             _MMAN_MPROTECT_PAGES(
                 mman,
                 (void*)brk_old_page_aligned,
                 brk_new_page_aligned - brk_old_page_aligned,
                 MYST_PROT_READ | MYST_PROT_WRITE)
+            _mman_clear_zero(
+                mman,
+                brk_old_page_aligned,
+                brk_new_page_aligned - brk_old_page_aligned);
+        }
         else if (brk_new_page_aligned < brk_old_page_aligned)
+        {
             _MMAN_MPROTECT_PAGES(
                 mman,
                 (void*)brk_new_page_aligned,
                 brk_old_page_aligned - brk_new_page_aligned,
                 MYST_PROT_NONE)
+            _mman_reset_pages(
+                mman,
+                brk_new_page_aligned,
+                brk_old_page_aligned - brk_new_page_aligned);
+        }
         /* Set the break value */
         mman->brk = (uintptr_t)addr;
     }
@@ -1371,7 +1886,7 @@ int myst_mman_mremap(
     uintptr_t new_end = (uintptr_t)addr + new_size;
 
     /* Find the VAD containing START */
-    if (!(vad = _list_find(mman, start)))
+    if (!(vad = _tree_find(mman, start)))
     {
         _mman_set_err(mman, "invalid addr parameter: mapping not found");
         ret = -ENOMEM;
@@ -1407,11 +1922,12 @@ int myst_mman_mremap(
                 goto done;
             }
 
-            _list_insert_after(mman, vad, right);
+            _mman_insert_vad(mman, vad, right);
             _mman_sync_top(mman);
         }
 
         vad->size = (uint32_t)(new_end - vad->addr);
+        _mman_update_vad(mman, vad);
         new_addr = addr;
 
 // ATTN: The region truncated might not have PROT_WRITE permission to
@@ -1425,6 +1941,7 @@ int myst_mman_mremap(
 #endif
 
         _MMAN_SET_PAGES_PROT(mman, new_end, old_size - new_size, MYST_PROT_NONE)
+        _mman_reset_pages(mman, new_end, old_size - new_size);
     }
     else if (new_size > old_size)
     {
@@ -1448,26 +1965,13 @@ int myst_mman_mremap(
         if (_end(vad) == old_end && _get_right_gap(mman, vad) >= delta)
         {
             vad->size += (uint32_t)delta;
-            /* Set W permission first before zeroing */
-            if (myst_tcall_mprotect(
-                    (void*)(start + old_size), delta, (prot | MYST_PROT_WRITE)))
+            /* Zero-fill the extended region and set its prot */
+            if (_mman_map_pages(mman, (void*)(start + old_size), delta, prot))
             {
                 _mman_set_err(mman, "mprotect tcall failed");
                 ret = -EINVAL;
                 goto done;
             }
-            memset((void*)(start + old_size), 0, delta);
-            if (!(prot & MYST_PROT_WRITE))
-            {
-                if (myst_tcall_mprotect((void*)(start + old_size), delta, prot))
-                {
-                    _mman_set_err(mman, "mprotect tcall failed");
-                    ret = -EINVAL;
-                    goto done;
-                }
-            }
-            /* Set prot for extended region */
-            _MMAN_SET_PAGES_PROT(mman, start + old_size, delta, prot)
             new_addr = addr;
 
             /* If VAD is now contiguous with next one, coalesce them */
@@ -1475,10 +1979,12 @@ int myst_mman_mremap(
             {
                 myst_vad_t* next = vad->next;
                 vad->size += next->size;
-                _list_remove(mman, next);
+                _mman_remove_vad(mman, next);
                 _mman_sync_top(mman);
                 _free_list_put(mman, next);
             }
+
+            _mman_update_vad(mman, vad);
         }
         else
         {
@@ -1489,28 +1995,28 @@ int myst_mman_mremap(
                 goto done;
             }
             /* If no W permission, set W permission first before copy */
-            if (!(vad->prot & MYST_PROT_WRITE))
-            {
-                if (myst_tcall_mprotect(
-                        addr, new_size, (vad->prot | MYST_PROT_WRITE)))
-                {
-                    _mman_set_err(mman, "mprotect tcall failed");
-                    ret = -EINVAL;
-                    goto done;
-                }
-            }
+            _MMAN_MPROTECT_PAGES(
+                mman, addr, new_size, (vad->prot | MYST_PROT_WRITE))
             /* Copy over data from old area */
             memcpy(addr, (void*)start, old_size);
-            if ((vad->prot | MYST_PROT_WRITE) != prot)
+            _MMAN_MPROTECT_PAGES(mman, addr, new_size, prot)
+            /* The moved pages that hold file contents still do */
+            for (size_t i = 0; mman->file_pages && i < old_size / PAGE_SIZE;
+                 i++)
             {
-                if (myst_tcall_mprotect(addr, new_size, prot))
+                const size_t index = (start - mman->start) / PAGE_SIZE + i;
+
+                if (myst_test_bit(mman->file_bitmap, index))
                 {
-                    _mman_set_err(mman, "mprotect tcall failed");
-                    ret = -EINVAL;
-                    goto done;
+                    _mman_set_bits(
+                        mman,
+                        mman->file_bitmap,
+                        &mman->file_pages,
+                        (uintptr_t)addr + i * PAGE_SIZE,
+                        PAGE_SIZE,
+                        true);
                 }
             }
-            _MMAN_SET_PAGES_PROT(mman, addr, new_size, prot)
             /* Unmap the old area */
             if (_munmap(mman, (void*)start, old_size) != 0)
             {
@@ -1623,6 +2129,244 @@ done:
     return ret;
 }
 
+/*
+**
+** myst_mman_madvise()
+**
+**     Give advice about the use of the memory region [addr:addr+len).
+**
+** Parameters:
+**     [IN] mman - mman structure
+**     [IN] addr - starting address of the memory region (page aligned)
+**     [IN] len - length of the memory region in bytes
+**     [IN] advice - MYST_MADV_DONTNEED, MYST_MADV_FREE, or other advice
+**
+** Returns:
+**     0 if operation succeeded
+**     -EINVAL if addr is not page aligned or range is out of bounds
+**     -ENOMEM if part of the range is not mapped
+**
+** Implementation:
+**     Enclave memory cannot be handed back to the host, so released pages
+**     stay committed but are recorded in the released bitmap, which lets
+**     the kernel report resident versus reserved memory. MYST_MADV_DONTNEED
+**     and MYST_MADV_FREE eagerly zero-fill the pages, so subsequent reads
+**     observe zeros as on Linux (which may discard freed pages at any time
+**     before they are written again). Pages that hold file contents (see
+**     myst_mman_set_file_pages()) are left alone, since Linux would reload
+**     them from the file. Pages count as resident again once they are
+**     remapped or written (see myst_mman_released_size()). Other advice is
+**     ignored.
+**
+*/
+int myst_mman_madvise(myst_mman_t* mman, void* addr, size_t len, int advice)
+{
+    int ret = 0;
+    uintptr_t end = 0;
+    bool locked = false;
+
+    if (len == 0)
+        return 0;
+
+    _mman_lock(mman, &locked);
+
+    _mman_clear_err(mman);
+
+    /* Check for valid mman parameter */
+    if (!mman || mman->magic != MYST_MMAN_MAGIC || !addr)
+    {
+        _mman_set_err(mman, "invalid parameter");
+        ret = -EINVAL;
+        goto done;
+    }
+
+    /* ADDR must be page aligned */
+    if ((uintptr_t)addr % PAGE_SIZE)
+    {
+        _mman_set_err(
+            mman, "bad addr parameter: must be multiple of page size");
+        ret = -EINVAL;
+        goto done;
+    }
+
+    /* Round len to multiple of page size */
+    if (myst_round_up(len, PAGE_SIZE, &len) != 0)
+    {
+        _mman_set_err(mman, "rounding error: len");
+        ret = -EINVAL;
+        goto done;
+    }
+
+    if ((uintptr_t)addr < mman->start ||
+        __builtin_add_overflow((uintptr_t)addr, len, &end) || end > mman->end)
+    {
+        _mman_set_err(mman, "bad addr parameter: addr range out of bound");
+        ret = -EINVAL;
+        goto done;
+    }
+
+    if (!_mman_is_mapped(mman, (uintptr_t)addr, end))
+    {
+        _mman_set_err(mman, "bad addr parameter: range is not mapped");
+        ret = -ENOMEM;
+        goto done;
+    }
+
+    if (advice == MYST_MADV_DONTNEED || advice == MYST_MADV_FREE)
+    {
+        const size_t first = ((uintptr_t)addr - mman->start) / PAGE_SIZE;
+        const size_t npages = len / PAGE_SIZE;
+        size_t i = 0;
+
+        /* release each run of pages that do not hold file contents */
+        while (i < npages)
+        {
+            size_t j = i;
+
+            if (myst_test_bit(mman->file_bitmap, first + i))
+            {
+                i++;
+                continue;
+            }
+
+            while (j < npages && !myst_test_bit(mman->file_bitmap, first + j))
+                j++;
+
+            uintptr_t p = (uintptr_t)addr + i * PAGE_SIZE;
+            size_t n = (j - i) * PAGE_SIZE;
+
+            if (_mman_zero_pages(mman, p, n) != 0)
+            {
+                _mman_set_err(mman, "mprotect tcall failed");
+                ret = -EINVAL;
+                goto done;
+            }
+
+            _mman_set_released(mman, p, n);
+            i = j;
+        }
+    }
+
+done:
+    _mman_unlock(mman, &locked);
+    return ret;
+}
+
+/*
+**
+** myst_mman_set_file_pages()
+**
+**     Record that the mapped pages in [addr:addr+len) hold file contents, so
+**     that myst_mman_madvise() does not discard them. The mark is cleared when
+**     the pages are unmapped or mapped again.
+**
+** Parameters:
+**     [IN] mman - mman structure
+**     [IN] addr - starting address of the memory region (page aligned)
+**     [IN] len - length of the memory region in bytes
+**
+** Returns:
+**     0 if operation succeeded
+**     -EINVAL if addr is not page aligned or range is out of bounds
+**
+*/
+int myst_mman_set_file_pages(myst_mman_t* mman, void* addr, size_t len)
+{
+    int ret = 0;
+    uintptr_t end = 0;
+    bool locked = false;
+
+    if (len == 0)
+        return 0;
+
+    _mman_lock(mman, &locked);
+
+    _mman_clear_err(mman);
+
+    if (!mman || mman->magic != MYST_MMAN_MAGIC || !addr ||
+        (uintptr_t)addr % PAGE_SIZE || myst_round_up(len, PAGE_SIZE, &len))
+    {
+        _mman_set_err(mman, "invalid parameter");
+        ret = -EINVAL;
+        goto done;
+    }
+
+    if ((uintptr_t)addr < mman->start ||
+        __builtin_add_overflow((uintptr_t)addr, len, &end) || end > mman->end)
+    {
+        _mman_set_err(mman, "bad addr parameter: addr range out of bound");
+        ret = -EINVAL;
+        goto done;
+    }
+
+    _mman_set_bits(
+        mman, mman->file_bitmap, &mman->file_pages, (uintptr_t)addr, len, true);
+
+done:
+    _mman_unlock(mman, &locked);
+    return ret;
+}
+
+/* Check the VAD subtree rooted at ROOT; count its VADs in NVADS */
+static bool _tree_is_sane(
+    myst_mman_t* mman,
+    myst_vad_t* root,
+    uintptr_t lo,
+    uintptr_t hi,
+    size_t* nvads)
+{
+    uint32_t lh;
+    uint32_t rh;
+    uint64_t max_gap;
+
+    if (!root)
+        return true;
+
+    if (!(root->addr >= lo && _end(root) <= hi))
+    {
+        _mman_set_err(mman, "unordered VAD tree");
+        return false;
+    }
+
+    if (!_tree_is_sane(mman, root->left, lo, root->addr, nvads) ||
+        !_tree_is_sane(mman, root->right, _end(root), hi, nvads))
+    {
+        return false;
+    }
+
+    lh = _tree_height(root->left);
+    rh = _tree_height(root->right);
+
+    if (root->height != (lh > rh ? lh : rh) + 1)
+    {
+        _mman_set_err(mman, "bad VAD tree height");
+        return false;
+    }
+
+    if (lh > rh + 1 || rh > lh + 1)
+    {
+        _mman_set_err(mman, "unbalanced VAD tree");
+        return false;
+    }
+
+    max_gap = _get_right_gap(mman, root);
+
+    if (_tree_max_gap(root->left) > max_gap)
+        max_gap = _tree_max_gap(root->left);
+
+    if (_tree_max_gap(root->right) > max_gap)
+        max_gap = _tree_max_gap(root->right);
+
+    if (root->max_gap != max_gap)
+    {
+        _mman_set_err(mman, "bad VAD tree gap");
+        return false;
+    }
+
+    (*nvads)++;
+    return true;
+}
+
 /*
 **
 ** myst_mman_is_sane()
@@ -1636,8 +2380,9 @@ done:
 **     true if mman is sane
 **
 ** Implementation:
-**     Checks various contraints such as ranges being correct and VAD list
-**     being sorted.
+**     Checks various contraints such as ranges being correct, VAD list
+**     being sorted, and the VAD tree being balanced and consistent with the
+**     VAD list.
 **
 */
 bool myst_mman_is_sane(myst_mman_t* mman)
@@ -1742,6 +2487,35 @@ bool myst_mman_is_sane(myst_mman_t* mman)
         }
     }
 
+    /* Verify that the tree is ordered, balanced, and matches the list */
+    {
+        size_t nvads = 0;
+        size_t count = 0;
+
+        if (!_tree_is_sane(
+                mman, mman->vad_tree, mman->start, mman->end, &nvads))
+        {
+            goto done;
+        }
+
+        for (myst_vad_t* p = mman->vad_list; p; p = p->next)
+        {
+            if (_tree_find(mman, p->addr) != p)
+            {
+                _mman_set_err(mman, "VAD list element missing from tree");
+                goto done;
+            }
+
+            count++;
+        }
+
+        if (count != nvads)
+        {
+            _mman_set_err(mman, "VAD tree and list sizes differ");
+            goto done;
+        }
+    }
+
     result = true;
 
 done:
@@ -1822,6 +2596,72 @@ done:
     return ret;
 }
 
+/* return the number of bytes reserved by break memory and mappings */
+int myst_mman_reserved_size(myst_mman_t* mman, size_t* size_out)
+{
+    int ret = 0;
+    size_t size;
+
+    if (!mman || !size_out)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    myst_spin_lock(&mman->lock);
+    {
+        size = mman->brk - mman->start;
+
+        for (myst_vad_t* p = mman->vad_list; p; p = p->next)
+            size += p->size;
+    }
+    myst_spin_unlock(&mman->lock);
+
+    *size_out = size;
+
+done:
+    return ret;
+}
+
+/* return the number of reserved bytes released by madvise() */
+int myst_mman_released_size(myst_mman_t* mman, size_t* size)
+{
+    int ret = 0;
+
+    if (!mman || !size)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    myst_spin_lock(&mman->lock);
+
+    /* Released pages are zero-filled, so a readable released page that is
+     * no longer zero has been written since and is resident again */
+    for (size_t i = 0, n = mman->released_pages; n > 0; i++)
+    {
+        const uint8_t* page = (const uint8_t*)(mman->start + i * PAGE_SIZE);
+
+        if (!myst_test_bit(mman->released_bitmap, i))
+            continue;
+
+        n--;
+
+        if ((mman->prot_vector[i] & MYST_PROT_READ) &&
+            myst_memcchr(page, 0, PAGE_SIZE))
+        {
+            myst_clear_bit(mman->released_bitmap, i);
+            mman->released_pages--;
+        }
+    }
+
+    *size = mman->released_pages * PAGE_SIZE;
+    myst_spin_unlock(&mman->lock);
+
+done:
+    return ret;
+}
+
 void myst_mman_dump_vads(myst_mman_t* mman)
 {
     if (!mman)
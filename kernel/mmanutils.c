@@ -9,16 +9,21 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <myst/cond.h>
 #include <myst/eraise.h>
 #include <myst/fdtable.h>
 #include <myst/file.h>
 #include <myst/malloc.h>
 #include <myst/mmanutils.h>
+#include <myst/mutex.h>
 #include <myst/panic.h>
 #include <myst/process.h>
+#include <myst/ramfs.h>
 #include <myst/round.h>
+#include <myst/signal.h>
 #include <myst/strings.h>
 #include <myst/syscall.h>
+#include <myst/thread.h>
 
 #define SCRUB
 
@@ -31,16 +36,67 @@ static void* _mman_end;
 typedef struct msync_mapping
 {
     struct msync_mapping* next;
+    /* the process whose fdtable holds fd */
+    pid_t pid;
     int fd;
     off_t offset;
     void* addr;
     size_t length;
+    /* hash of each page as of the last read from or write to the file */
+    uint64_t* hashes;
+    /* whether an MS_ASYNC write-back is pending for this mapping */
+    bool async;
+    /* links the pages [wfirst:wlast) into a write-back list */
+    struct msync_mapping* wnext;
+    size_t wfirst;
+    size_t wlast;
 } msync_mapping_t;
 
 /* linked list of msync mappings */
 static msync_mapping_t* _msync_mappings;
 static myst_spinlock_t _msync_mappings_lock = MYST_SPINLOCK_INITIALIZER;
 
+/* serializes write-backs with the splitting and removal of msync mappings,
+ * so that mappings collected under _msync_mappings_lock stay valid while
+ * their pages are hashed and written without holding the spinlock */
+static myst_mutex_t _msync_io_mutex;
+
+/* the thread of a process that performs its MS_ASYNC write-backs (each
+ * process flushes its own mappings since fd is resolved in its fdtable) */
+typedef struct msync_flusher
+{
+    struct msync_flusher* next;
+    pid_t pid;
+    /* the number of threads running the flusher */
+    size_t count;
+    myst_cond_t cond;
+    bool pending;
+} msync_flusher_t;
+
+/* linked list of flushers (guarded by _flushers_mutex) */
+static msync_flusher_t* _flushers;
+static myst_mutex_t _flushers_mutex;
+
+/* a copy of ramfs file data shared by the read-only private mappings of a
+ * process that map the same range of the file (see _map_ramfs_copy()) */
+typedef struct ramfs_copy
+{
+    struct ramfs_copy* next;
+    pid_t pid;
+    /* the ramfs file data at the mapped offset (identifies the range) */
+    const void* data;
+    int prot;
+    /* the mman memory holding the copy */
+    void* addr;
+    size_t length;
+    /* the number of mappings that share the copy */
+    size_t nrefs;
+} ramfs_copy_t;
+
+/* linked list of shared ramfs copies */
+static ramfs_copy_t* _ramfs_copies;
+static myst_spinlock_t _ramfs_copies_lock = MYST_SPINLOCK_INITIALIZER;
+
 static uint8_t* _min_ptr(uint8_t* x, uint8_t* y)
 {
     return (x < y) ? x : y;
@@ -67,6 +123,10 @@ int myst_setup_mman(void* data, size_t size)
     if (myst_mman_init(&_mman, (uintptr_t)_mman_start, _mman_size) != 0)
         goto done;
 
+    /* The mman region is loaded with zero pages, so the first mapping of
+     * each page need not zero-fill it */
+    myst_mman_set_zero_filled(&_mman);
+
 #ifdef SCRUB
     /* Scrubbing unmapped memory causes memory reads due to musl libc */
     _mman.scrub = true;
@@ -88,6 +148,11 @@ int myst_teardown_mman(void)
     return 0;
 }
 
+static size_t _num_pages(size_t length)
+{
+    return (length + PAGE_SIZE - 1) / PAGE_SIZE;
+}
+
 static msync_mapping_t* _new_msync_mapping(
     int fd,
     off_t offset,
@@ -99,6 +164,13 @@ static msync_mapping_t* _new_msync_mapping(
     if (!(m = calloc(1, sizeof(msync_mapping_t))))
         return NULL;
 
+    if (!(m->hashes = calloc(_num_pages(length), sizeof(uint64_t))))
+    {
+        free(m);
+        return NULL;
+    }
+
+    m->pid = myst_getpid();
     m->fd = fd;
     m->offset = offset;
     m->addr = addr;
@@ -107,6 +179,176 @@ static msync_mapping_t* _new_msync_mapping(
     return m;
 }
 
+static void _free_msync_mapping(msync_mapping_t* m)
+{
+    free(m->hashes);
+    free(m);
+}
+
+static uint64_t _rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+/* compute a 64-bit hash of a page (or the partial page at end of mapping) */
+static uint64_t _hash_page(const void* data, size_t size)
+{
+    const uint64_t prime1 = 0x9e3779b185ebca87;
+    const uint64_t prime2 = 0xc2b2ae3d27d4eb4f;
+    const uint64_t* p = data;
+    const size_t n = size / sizeof(uint64_t);
+    uint64_t h = size;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        h += p[i] * prime2;
+        h = _rotl64(h, 31) * prime1;
+    }
+
+    for (size_t i = n * sizeof(uint64_t); i < size; i++)
+    {
+        h += ((const uint8_t*)data)[i] * prime2;
+        h = _rotl64(h, 31) * prime1;
+    }
+
+    /* final avalanche */
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime1;
+    h ^= h >> 32;
+
+    return h;
+}
+
+/* get the hash of the i-th page of the mapping */
+static uint64_t _hash_mapping_page(const msync_mapping_t* m, size_t i)
+{
+    const size_t offset = i * PAGE_SIZE;
+    size_t size = m->length - offset;
+
+    if (size > PAGE_SIZE)
+        size = PAGE_SIZE;
+
+    return _hash_page((const uint8_t*)m->addr + offset, size);
+}
+
+static int _sync_file(int fd, off_t offset, const void* addr, size_t length)
+{
+    int ret = 0;
+    const uint8_t* p = (const uint8_t*)addr;
+    size_t r = length;
+    off_t o = offset;
+
+    while (r > 0)
+    {
+        ssize_t n = pwrite(fd, p, r, o);
+
+        if (n == 0)
+            break;
+        else if (n < 0)
+            ERAISE(n);
+
+        p += n;
+        o += n;
+        r -= (size_t)n;
+    }
+
+done:
+    return ret;
+}
+
+/* write back the runs of pages in [first:last) whose hash has changed (the
+ * caller holds _msync_io_mutex) */
+static int _sync_dirty_pages(msync_mapping_t* m, size_t first, size_t last)
+{
+    int ret = 0;
+    size_t i = first;
+
+    while (i < last)
+    {
+        size_t j = i;
+        uint64_t hash;
+
+        /* find the next run of dirty pages [i:j) */
+        while (j < last && (hash = _hash_mapping_page(m, j)) != m->hashes[j])
+            m->hashes[j++] = hash;
+
+        if (i == j)
+        {
+            i++;
+            continue;
+        }
+
+        const size_t offset = i * PAGE_SIZE;
+        size_t length = j * PAGE_SIZE - offset;
+
+        if (offset + length > m->length)
+            length = m->length - offset;
+
+        if ((ret = _sync_file(
+                 m->fd,
+                 m->offset + (off_t)offset,
+                 (uint8_t*)m->addr + offset,
+                 length)) != 0)
+        {
+            /* invert the hashes so that these pages are retried */
+            for (size_t k = i; k < j; k++)
+                m->hashes[k] = ~m->hashes[k];
+
+            ERAISE(ret);
+        }
+
+        /* page j (if any) was found to be clean */
+        i = (j < last) ? j + 1 : j;
+    }
+
+done:
+    return ret;
+}
+
+/* add pages [first:last) of m to a write-back list (the caller holds both
+ * _msync_io_mutex and _msync_mappings_lock) */
+static void _add_write_back(
+    msync_mapping_t** list,
+    msync_mapping_t* m,
+    size_t first,
+    size_t last)
+{
+    m->wfirst = first;
+    m->wlast = last;
+    m->wnext = *list;
+    *list = m;
+}
+
+/* perform the write-backs on the list (the caller holds _msync_io_mutex);
+ * returns the first error, while still attempting the remaining ones */
+static int _write_back(msync_mapping_t* list, bool async)
+{
+    int ret = 0;
+
+    for (msync_mapping_t* p = list; p; p = p->wnext)
+    {
+        int r;
+
+        if ((r = _sync_dirty_pages(p, p->wfirst, p->wlast)) != 0)
+        {
+            /* leave an MS_ASYNC request pending if the write-back failed */
+            if (async)
+            {
+                myst_spin_lock(&_msync_mappings_lock);
+                p->async = true;
+                myst_spin_unlock(&_msync_mappings_lock);
+            }
+
+            if (ret == 0)
+                ret = r;
+        }
+    }
+
+    return ret;
+}
+
 static ssize_t _map_file_onto_memory(
     int fd,
     off_t offset,
@@ -117,38 +359,22 @@ static ssize_t _map_file_onto_memory(
     ssize_t ret = 0;
     ssize_t bytes_read = 0;
     int flags;
-    struct locals
-    {
-        char buf[BUFSIZ];
-    };
-    struct locals* locals = NULL;
 
     if (fd < 0 || !addr || !length)
         ERAISE(-EINVAL);
 
-    if (!(locals = malloc(sizeof(struct locals))))
-        ERAISE(-ENOMEM);
-
     // ATTN: generate EACCES error if non-regular file or file not opened
     // for write when mmap_flags has MMAP_WRITE.
 
-    /* read file onto memory */
+    /* read the file directly onto memory (the fs may return short reads) */
     {
         ssize_t n;
         uint8_t* p = addr;
         size_t r = length;
-        size_t o = offset;
+        off_t o = offset;
 
-        while ((n = pread(fd, locals->buf, sizeof locals->buf, o)) > 0)
+        while (r > 0 && (n = pread(fd, p, r, o)) > 0)
         {
-            /* if copy would write past end of buffer */
-            if (r < (size_t)n)
-            {
-                memcpy(p, locals->buf, r);
-                break;
-            }
-
-            memcpy(p, locals->buf, (size_t)n);
             p += n;
             o += n;
             r -= (size_t)n;
@@ -162,32 +388,244 @@ static ssize_t _map_file_onto_memory(
     /* if file is writable, then create msync mappings for msync() */
     if ((mmap_flags & MAP_SHARED) && flags & (O_RDWR | O_WRONLY))
     {
+        msync_mapping_t* m;
+
+        /* create a new msync mapping */
+        if (!(m = _new_msync_mapping(fd, offset, addr, length)))
+            ERAISE(-ENOMEM);
+
+        /* record the file contents so that msync() can find dirty pages */
+        for (size_t i = 0; i < _num_pages(length); i++)
+            m->hashes[i] = _hash_mapping_page(m, i);
+
+        /* add the new mysnc mapping to the list */
         myst_spin_lock(&_msync_mappings_lock);
+        m->next = _msync_mappings;
+        _msync_mappings = m;
+        myst_spin_unlock(&_msync_mappings_lock);
+    }
+
+    ret = bytes_read;
+
+done:
+    return ret;
+}
+
+/*
+** Map a read-only private file mapping of a ramfs file that is still backed by
+** its myst_ramfs_set_buf() data (e.g., files of a CPIO rootfs). The file data
+** is already in enclave memory, so it is copied with a single memcpy() rather
+** than read through the fs, and mappings of the same range by the same process
+** share that copy. Return NULL if the mapping is not eligible, in which case
+** the caller maps the file as usual.
+**
+** A shared copy is ordinary mman memory. Since all of its mappings have the
+** same address, an operation that changes part of it (munmap(), mprotect(),
+** mremap() or a MAP_FIXED mapping) detaches the copy, which then behaves as if
+** the process had mapped it just once.
+*/
+static void* _map_ramfs_copy(
+    int fd,
+    size_t length,
+    int prot,
+    int flags,
+    off_t offset)
+{
+    const int rw = MYST_PROT_READ | MYST_PROT_WRITE;
+    const int tflags = MYST_MAP_ANONYMOUS | MYST_MAP_PRIVATE;
+    const pid_t pid = myst_getpid();
+    myst_fs_t* fs;
+    myst_file_t* file;
+    const void* buf;
+    size_t size;
+    size_t rlength;
+    size_t n;
+    const uint8_t* data;
+    void* ptr;
+    ramfs_copy_t* c;
+
+    if ((prot & ~MYST_PROT_EXEC) != MYST_PROT_READ || (flags & MAP_SHARED) ||
+        !(flags & MAP_PRIVATE) || offset < 0 || offset % PAGE_SIZE)
+    {
+        return NULL;
+    }
+
+    if (myst_fdtable_get_file(myst_fdtable_current(), fd, &fs, &file) != 0)
+        return NULL;
+
+    if (myst_ramfs_get_buf(fs, file, &buf, &size) != 0)
+        return NULL;
+
+    if ((size_t)offset >= size || myst_round_up(length, PAGE_SIZE, &rlength))
+        return NULL;
+
+    data = (const uint8_t*)buf + offset;
+
+    /* share the copy made by an earlier mapping of this range */
+    myst_spin_lock(&_ramfs_copies_lock);
+    {
+        for (c = _ramfs_copies; c; c = c->next)
         {
-            msync_mapping_t* m;
+            if (c->pid == pid && c->data == data && c->length == rlength &&
+                c->prot == prot)
+            {
+                c->nrefs++;
+                break;
+            }
+        }
+    }
+    myst_spin_unlock(&_ramfs_copies_lock);
+
+    if (c)
+        return c->addr;
+
+    if (!(c = calloc(1, sizeof(ramfs_copy_t))))
+        return NULL;
+
+    if (myst_mman_mmap(&_mman, NULL, rlength, rw, tflags, &ptr) != 0)
+    {
+        free(c);
+        return NULL;
+    }
+
+    /* the pages past the end of file are left zero-filled */
+    n = size - (size_t)offset;
+    memcpy(ptr, data, (n < rlength) ? n : rlength);
+
+    if (myst_mman_mprotect(&_mman, ptr, rlength, prot) != 0 ||
+        myst_mman_set_file_pages(&_mman, ptr, rlength) != 0)
+    {
+        myst_mman_munmap(&_mman, ptr, rlength);
+        free(c);
+        return NULL;
+    }
+
+    c->pid = pid;
+    c->data = data;
+    c->prot = prot;
+    c->addr = ptr;
+    c->length = rlength;
+    c->nrefs = 1;
 
-            /* create a new msync mapping */
-            if (!(m = _new_msync_mapping(fd, offset, addr, length)))
+    myst_spin_lock(&_ramfs_copies_lock);
+    c->next = _ramfs_copies;
+    _ramfs_copies = c;
+    myst_spin_unlock(&_ramfs_copies_lock);
+
+    return ptr;
+}
+
+/* stop sharing the ramfs copies that overlap [addr:addr+length] */
+static void _detach_ramfs_copies(const void* addr, size_t length)
+{
+    const uint8_t* lo = addr;
+    const uint8_t* hi = lo + length;
+    ramfs_copy_t* list = NULL;
+
+    myst_spin_lock(&_ramfs_copies_lock);
+    {
+        ramfs_copy_t* prev = NULL;
+        ramfs_copy_t* next;
+
+        for (ramfs_copy_t* p = _ramfs_copies; p; p = next)
+        {
+            const uint8_t* plo = p->addr;
+            const uint8_t* phi = plo + p->length;
+
+            next = p->next;
+
+            if (lo < phi && plo < hi)
             {
-                myst_spin_unlock(&_msync_mappings_lock);
-                ERAISE(-ENOMEM);
+                if (prev)
+                    prev->next = next;
+                else
+                    _ramfs_copies = next;
+
+                p->next = list;
+                list = p;
+            }
+            else
+            {
+                prev = p;
             }
+        }
+    }
+    myst_spin_unlock(&_ramfs_copies_lock);
 
-            /* add the new mysnc mapping to the list */
-            m->next = _msync_mappings;
-            _msync_mappings = m;
+    while (list)
+    {
+        ramfs_copy_t* next = list->next;
+        free(list);
+        list = next;
+    }
+}
+
+/* drop one reference to the ramfs copy at [addr:addr+length]; returns true
+ * if other mappings still share it (so the pages must stay mapped) */
+static bool _unref_ramfs_copy(const void* addr, size_t length)
+{
+    bool shared = false;
+
+    myst_spin_lock(&_ramfs_copies_lock);
+    {
+        for (ramfs_copy_t* p = _ramfs_copies; p; p = p->next)
+        {
+            if (p->addr == addr && p->length == length && p->nrefs > 1)
+            {
+                p->nrefs--;
+                shared = true;
+                break;
+            }
         }
-        myst_spin_unlock(&_msync_mappings_lock);
     }
+    myst_spin_unlock(&_ramfs_copies_lock);
 
-    ret = bytes_read;
+    /* otherwise the caller unmaps the pages of the (last) mapping */
+    if (!shared)
+        _detach_ramfs_copies(addr, length);
 
-done:
+    return shared;
+}
 
-    if (locals)
-        free(locals);
+/* release the ramfs copies that an exiting process did not unmap */
+static void _release_ramfs_copies(pid_t pid)
+{
+    ramfs_copy_t* list = NULL;
 
-    return ret;
+    myst_spin_lock(&_ramfs_copies_lock);
+    {
+        ramfs_copy_t* prev = NULL;
+        ramfs_copy_t* next;
+
+        for (ramfs_copy_t* p = _ramfs_copies; p; p = next)
+        {
+            next = p->next;
+
+            if (p->pid == pid)
+            {
+                if (prev)
+                    prev->next = next;
+                else
+                    _ramfs_copies = next;
+
+                p->next = list;
+                list = p;
+            }
+            else
+            {
+                prev = p;
+            }
+        }
+    }
+    myst_spin_unlock(&_ramfs_copies_lock);
+
+    while (list)
+    {
+        ramfs_copy_t* next = list->next;
+        myst_mman_munmap(&_mman, list->addr, list->length);
+        free(list);
+        list = next;
+    }
 }
 
 /* ATTN-A: fix return types for this function */
@@ -235,6 +673,11 @@ void* myst_mmap(
             return (void*)-1;
     }
 
+    /* the mman reuses existing mappings at addr (even without MAP_FIXED),
+     * so a mapping there replaces any shared ramfs copy */
+    if (addr)
+        _detach_ramfs_copies(addr, length);
+
     if (fd >= 0 && addr)
     {
         ssize_t n;
@@ -245,6 +688,8 @@ void* myst_mmap(
             return (void*)-1;
         if ((n = _map_file_onto_memory(fd, offset, addr, length, flags)) < 0)
             return (void*)-1;
+        if (myst_mman_set_file_pages(&_mman, addr, length) != 0)
+            return (void*)-1;
         if (!(prot & MYST_PROT_WRITE))
         {
             if (myst_mman_mprotect(&_mman, addr, length, prot))
@@ -257,6 +702,9 @@ void* myst_mmap(
         return addr;
     }
 
+    if (fd >= 0 && (ptr = _map_ramfs_copy(fd, length, prot, flags, offset)))
+        return ptr;
+
     int tflags = 0;
 
     if (flags & MYST_MAP_FIXED)
@@ -278,6 +726,8 @@ void* myst_mmap(
         }
         if ((n = _map_file_onto_memory(fd, offset, ptr, length, flags)) < 0)
             return (void*)(long)-n;
+        if (myst_mman_set_file_pages(&_mman, ptr, length) != 0)
+            return (void*)-1;
         if (!(prot & MYST_PROT_WRITE))
         {
             if (myst_mman_mprotect(&_mman, ptr, length, prot))
@@ -305,6 +755,9 @@ void* myst_mremap(
     if (new_address)
         return (void*)-EINVAL;
 
+    /* the mapping may move or change size, so it can no longer be shared */
+    _detach_ramfs_copies(old_address, old_size);
+
     r = myst_mman_mremap(&_mman, old_address, old_size, new_size, flags, &p);
 
     if (r != 0)
@@ -325,12 +778,72 @@ int myst_mprotect(const void* addr, const size_t len, const int prot)
     if ((prot & MYST_PROT_GROWSDOWN) && (prot & MYST_PROT_GROWSUP))
         return -EINVAL;
 
+    /* the new protection applies to every mapping of a shared ramfs copy */
+    _detach_ramfs_copies(addr, len);
+
     /* Current implementation for mprotect ignore bits beyond
        PROT_READ|PROT_WRITE|PROT_EXEC
     */
     return (myst_mman_mprotect(&_mman, (void*)addr, len, prot));
 }
 
+int myst_madvise(void* addr, size_t length, int advice)
+{
+    int ret = 0;
+
+    if ((uintptr_t)addr % PAGE_SIZE)
+        ERAISE(-EINVAL);
+
+    if (length == 0)
+        goto done;
+
+    /* ignore advice about memory not managed by the mman */
+    if ((uint8_t*)addr < (uint8_t*)_mman_start ||
+        (uint8_t*)addr >= (uint8_t*)_mman_end)
+    {
+        goto done;
+    }
+
+    /* the mman leaves pages that hold file contents alone */
+    switch (advice)
+    {
+        case MADV_DONTNEED:
+            ECHECK(myst_mman_madvise(&_mman, addr, length, MYST_MADV_DONTNEED));
+            break;
+        case MADV_FREE:
+            ECHECK(myst_mman_madvise(&_mman, addr, length, MYST_MADV_FREE));
+            break;
+        case MADV_NORMAL:
+        case MADV_RANDOM:
+        case MADV_SEQUENTIAL:
+        case MADV_WILLNEED:
+        case MADV_DONTFORK:
+        case MADV_DOFORK:
+        case MADV_MERGEABLE:
+        case MADV_UNMERGEABLE:
+        case MADV_HUGEPAGE:
+        case MADV_NOHUGEPAGE:
+        case MADV_DONTDUMP:
+        case MADV_DODUMP:
+#ifdef MADV_WIPEONFORK
+        case MADV_WIPEONFORK:
+        case MADV_KEEPONFORK:
+#endif
+#ifdef MADV_COLD
+        case MADV_COLD:
+        case MADV_PAGEOUT:
+#endif
+            /* hints that need no action, but the range must be mapped */
+            ECHECK(myst_mman_madvise(&_mman, addr, length, MYST_MADV_NORMAL));
+            break;
+        default:
+            ERAISE(-EINVAL);
+    }
+
+done:
+    return ret;
+}
+
 MYST_UNUSED
 static void _dump_msync_mappings(void)
 {
@@ -342,10 +855,43 @@ static void _dump_msync_mappings(void)
     printf("\n");
 }
 
-/* release msync mappings that are contained in the range [addr:addr+length] */
+/* release msync mappings that are contained in the range [addr:addr+length]
+ * after completing any pending MS_ASYNC write-backs of that range */
 static int _release_msync_mappings(void* addr, size_t length)
 {
     int ret = 0;
+    uint8_t* lo = addr;
+    uint8_t* hi = (uint8_t*)addr + length;
+    msync_mapping_t* list = NULL;
+
+    myst_mutex_lock(&_msync_io_mutex);
+
+    /* collect the pending write-backs of the range */
+    myst_spin_lock(&_msync_mappings_lock);
+    {
+        for (msync_mapping_t* p = _msync_mappings; p; p = p->next)
+        {
+            uint8_t* plo = p->addr;
+            uint8_t* phi = (uint8_t*)p->addr + p->length;
+            uint8_t* maxlo = _max_ptr(lo, plo);
+            uint8_t* minhi = _min_ptr(hi, phi);
+
+            if (maxlo < minhi && p->async)
+            {
+                size_t first = (maxlo - plo) / PAGE_SIZE;
+                size_t last = _num_pages(minhi - plo);
+                _add_write_back(&list, p, first, last);
+            }
+        }
+    }
+    myst_spin_unlock(&_msync_mappings_lock);
+
+    /* keep the mappings (and the caller's pages) if the write-back failed */
+    if ((ret = _write_back(list, false)) != 0)
+    {
+        myst_mutex_unlock(&_msync_io_mutex);
+        ERAISE(ret);
+    }
 
     myst_spin_lock(&_msync_mappings_lock);
     {
@@ -355,8 +901,6 @@ static int _release_msync_mappings(void* addr, size_t length)
         while (p)
         {
             msync_mapping_t* next = p->next;
-            uint8_t* lo = addr;
-            uint8_t* hi = (uint8_t*)addr + length;
             uint8_t* plo = p->addr;
             uint8_t* phi = (uint8_t*)p->addr + p->length;
             uint8_t* maxlo = _max_ptr(lo, plo);
@@ -368,6 +912,7 @@ static int _release_msync_mappings(void* addr, size_t length)
                 size_t llength = maxlo - plo;
                 size_t rlength = phi - minhi;
                 size_t roffset = p->offset + (minhi - plo);
+                size_t rpage = (minhi - plo) / PAGE_SIZE;
 
                 //     .........
                 // ..........
@@ -390,9 +935,18 @@ static int _release_msync_mappings(void* addr, size_t length)
                               minhi,     /* addr */
                               rlength))) /* length */
                     {
+                        myst_spin_unlock(&_msync_mappings_lock);
+                        myst_mutex_unlock(&_msync_io_mutex);
                         ERAISE(-ENOMEM);
                     }
 
+                    memcpy(
+                        rm->hashes,
+                        p->hashes + rpage,
+                        _num_pages(rlength) * sizeof(uint64_t));
+                    rm->pid = p->pid;
+                    rm->async = p->async;
+
                     /* insert right mapping into list */
                     rm->next = p->next;
                     p->next = rm;
@@ -412,6 +966,10 @@ static int _release_msync_mappings(void* addr, size_t length)
                 else if (rlength)
                 {
                     // printf("case3: right\n");
+                    memmove(
+                        p->hashes,
+                        p->hashes + rpage,
+                        _num_pages(rlength) * sizeof(uint64_t));
                     p->offset = roffset;
                     p->addr = minhi;
                     p->length = rlength;
@@ -425,7 +983,7 @@ static int _release_msync_mappings(void* addr, size_t length)
                     else
                         _msync_mappings = p->next;
 
-                    free(p);
+                    _free_msync_mapping(p);
                 }
             }
             else
@@ -438,7 +996,7 @@ static int _release_msync_mappings(void* addr, size_t length)
     }
     myst_spin_unlock(&_msync_mappings_lock);
 
-    goto done;
+    myst_mutex_unlock(&_msync_io_mutex);
 
 done:
     return ret;
@@ -455,10 +1013,15 @@ int myst_munmap(void* addr, size_t length)
     /* align length to a page boundary */
     ECHECK(myst_round_up(length, PAGE_SIZE, &length));
 
-    ECHECK(myst_mman_munmap(&_mman, addr, length));
+    /* keep the pages of a ramfs copy that other mappings still share */
+    if (_unref_ramfs_copy(addr, length))
+        goto done;
 
+    /* write back and remove msync mappings while the pages are still mapped */
     ECHECK(_release_msync_mappings(addr, length));
 
+    ECHECK(myst_mman_munmap(&_mman, addr, length));
+
 #if 0
     // ATTN-2AA04DD0: fails during process cleanup for unknown reasons. When
     // the process is created, we call myst_register_process_mapping() to keep
@@ -498,6 +1061,16 @@ int myst_get_free_ram(size_t* size)
     return myst_mman_free_size(&_mman, size);
 }
 
+int myst_get_reserved_ram(size_t* size)
+{
+    return myst_mman_reserved_size(&_mman, size);
+}
+
+int myst_get_released_ram(size_t* size)
+{
+    return myst_mman_released_size(&_mman, size);
+}
+
 typedef struct myst_process_mapping myst_process_mapping_t;
 
 struct myst_process_mapping
@@ -653,6 +1226,8 @@ int myst_release_process_mappings(pid_t pid)
     }
     myst_spin_unlock(&_mappings_lock);
 
+    _release_ramfs_copies(pid);
+
 done:
     return ret;
 }
@@ -717,35 +1292,145 @@ done:
     return ret;
 }
 
-static int _sync_file(int fd, off_t offset, const void* addr, size_t length)
+/* write back the dirty pages of the given process's mappings with pending
+ * MS_ASYNC requests */
+static int _flush_async_mappings(pid_t pid)
 {
     int ret = 0;
-    const uint8_t* p = (const uint8_t*)addr;
-    size_t r = length;
-    off_t o = offset;
+    msync_mapping_t* list = NULL;
 
-    while (r > 0)
+    myst_mutex_lock(&_msync_io_mutex);
+
+    myst_spin_lock(&_msync_mappings_lock);
     {
-        ssize_t n = pwrite(fd, p, r, o);
+        for (msync_mapping_t* p = _msync_mappings; p; p = p->next)
+        {
+            if (p->async && p->pid == pid)
+            {
+                p->async = false;
+                _add_write_back(&list, p, 0, _num_pages(p->length));
+            }
+        }
+    }
+    myst_spin_unlock(&_msync_mappings_lock);
 
-        if (n == 0)
-            break;
-        else if (n < 0)
-            ERAISE(n);
+    ret = _write_back(list, true);
 
-        p += n;
-        o += n;
-        r -= (size_t)n;
+    myst_mutex_unlock(&_msync_io_mutex);
+
+    return ret;
+}
+
+/* find the flusher of a process (the caller holds _flushers_mutex) */
+static msync_flusher_t* _find_flusher(pid_t pid)
+{
+    for (msync_flusher_t* p = _flushers; p; p = p->next)
+    {
+        if (p->pid == pid)
+            return p;
+    }
+
+    return NULL;
+}
+
+/* run the MS_ASYNC flusher of the calling process (returns when signaled) */
+long myst_syscall_run_msync_flusher(void)
+{
+    long ret = 0;
+    const pid_t pid = myst_getpid();
+    myst_thread_t* self = myst_thread_self();
+    msync_flusher_t* flusher;
+
+    myst_mutex_lock(&_flushers_mutex);
+
+    if (!(flusher = _find_flusher(pid)))
+    {
+        if (!(flusher = calloc(1, sizeof(msync_flusher_t))))
+        {
+            myst_mutex_unlock(&_flushers_mutex);
+            ERAISE(-ENOMEM);
+        }
+
+        flusher->pid = pid;
+        flusher->next = _flushers;
+        _flushers = flusher;
     }
 
+    flusher->count++;
+
+    /* return to user mode to handle signals (the CRT calls back) */
+    while (!myst_signal_has_active_signals(self))
+    {
+        if (flusher->pending)
+        {
+            flusher->pending = false;
+
+            /* write back without blocking msync(MS_ASYNC) callers */
+            myst_mutex_unlock(&_flushers_mutex);
+            _flush_async_mappings(pid);
+            myst_mutex_lock(&_flushers_mutex);
+        }
+        else
+        {
+            /* sleep until a request is queued or a signal arrives */
+            myst_cond_timedwait_interruptible(
+                &flusher->cond, &_flushers_mutex, NULL);
+        }
+    }
+
+    /* remove the last flusher so that msync() falls back to MS_SYNC */
+    if (--flusher->count == 0)
+    {
+        for (msync_flusher_t** pp = &_flushers; *pp; pp = &(*pp)->next)
+        {
+            if (*pp == flusher)
+            {
+                *pp = flusher->next;
+                break;
+            }
+        }
+
+        free(flusher);
+        flusher = NULL;
+    }
+
+    myst_mutex_unlock(&_flushers_mutex);
+
+    /* complete the requests the flusher did not get to */
+    if (!flusher)
+        _flush_async_mappings(pid);
+
+    ret = -EINTR;
+
 done:
     return ret;
 }
 
+/* wake the flusher of the calling process (false if it has none) */
+static bool _wake_msync_flusher(pid_t pid)
+{
+    msync_flusher_t* flusher;
+
+    myst_mutex_lock(&_flushers_mutex);
+
+    if ((flusher = _find_flusher(pid)))
+    {
+        flusher->pending = true;
+        myst_cond_signal(&flusher->cond);
+    }
+
+    myst_mutex_unlock(&_flushers_mutex);
+
+    return flusher != NULL;
+}
+
 int myst_msync(void* addr, size_t length, int flags)
 {
     int ret = 0;
     const int mask = MS_SYNC | MS_ASYNC | MS_INVALIDATE;
+    bool async = false;
+    const pid_t pid = myst_getpid();
+    msync_mapping_t* list = NULL;
 
     /* reject bad parameters and unknown flags */
     if (!addr || !length || (flags & ~mask))
@@ -755,15 +1440,24 @@ int myst_msync(void* addr, size_t length, int flags)
     if ((flags & MS_SYNC) && (flags & MS_ASYNC))
         ERAISE(-EINVAL);
 
-    // Note: Asynchronous sync (MS_ASYNC) is not supported so all syncs are
-    // treated as though they were non-asynchronous (MS_SYNC). The caller will
+    // Note: MS_ASYNC requests are handed to the flusher thread of the calling
+    // process, which the CRT starts on the first such request. While the
+    // process has no flusher, MS_ASYNC is treated as MS_SYNC. The caller will
     // be unable to detect any difference in behavior.
+    if (flags & MS_ASYNC)
+    {
+        myst_mutex_lock(&_flushers_mutex);
+        async = _find_flusher(pid) != NULL;
+        myst_mutex_unlock(&_flushers_mutex);
+    }
 
     // Note: experimentation reveals that Linux invalidates other mappings
     // of the same file, whether  MS_INVALIDATE is present or not (meaning
     // that they too are updated to reflect the contents of the file with
     // or without the MS_INVALIDATE flag).
 
+    myst_mutex_lock(&_msync_io_mutex);
+
     myst_spin_lock(&_msync_mappings_lock);
     {
         /* flush any msync mappings contained by this address range */
@@ -788,11 +1482,18 @@ int myst_msync(void* addr, size_t length, int flags)
 
             if (maxlo < minhi)
             {
-                ECHECK(_sync_file(
-                    p->fd,                     /* fd */
-                    p->offset + (maxlo - plo), /* offset */
-                    maxlo,                     /* addr */
-                    minhi - maxlo));           /* length */
+                if (async && p->pid == pid)
+                {
+                    p->async = true;
+                    continue;
+                }
+
+                /* only write back the pages that changed */
+                _add_write_back(
+                    &list,
+                    p,
+                    (maxlo - plo) / PAGE_SIZE,
+                    _num_pages(minhi - plo));
             }
         }
 
@@ -803,6 +1504,17 @@ int myst_msync(void* addr, size_t length, int flags)
     }
     myst_spin_unlock(&_msync_mappings_lock);
 
+    /* write back outside the spinlock */
+    ret = _write_back(list, false);
+
+    myst_mutex_unlock(&_msync_io_mutex);
+
+    ECHECK(ret);
+
+    /* if the flusher exited in the meantime, write back synchronously */
+    if (async && !_wake_msync_flusher(pid))
+        ECHECK(_flush_async_mappings(pid));
+
 done:
     return ret;
 }
@@ -824,6 +1536,23 @@ void myst_mman_close_notify(int fd)
     /* if file is open for write */
     if (flags & (O_RDWR | O_WRONLY))
     {
+        msync_mapping_t* list = NULL;
+
+        myst_mutex_lock(&_msync_io_mutex);
+
+        /* complete any pending MS_ASYNC write-backs */
+        myst_spin_lock(&_msync_mappings_lock);
+        {
+            for (msync_mapping_t* p = _msync_mappings; p; p = p->next)
+            {
+                if (p->fd == fd && p->async)
+                    _add_write_back(&list, p, 0, _num_pages(p->length));
+            }
+        }
+        myst_spin_unlock(&_msync_mappings_lock);
+
+        _write_back(list, false);
+
         myst_spin_lock(&_msync_mappings_lock);
         {
             msync_mapping_t* p = _msync_mappings;
@@ -840,7 +1569,7 @@ void myst_mman_close_notify(int fd)
                     else
                         _msync_mappings = p->next;
 
-                    free(p);
+                    _free_msync_mapping(p);
                 }
                 else
                 {
@@ -851,6 +1580,8 @@ void myst_mman_close_notify(int fd)
             }
         }
         myst_spin_unlock(&_msync_mappings_lock);
+
+        myst_mutex_unlock(&_msync_io_mutex);
     }
 }
 
@@ -861,4 +1592,10 @@ void myst_mman_stats(myst_mman_stats_t* buf)
     buf->map_size = _mman.end - _mman.map;
     buf->free_size = _mman.map - _mman.brk;
     buf->used_size = buf->brk_size + buf->map_size;
+    myst_mman_reserved_size(&_mman, &buf->reserved_size);
+    myst_mman_released_size(&_mman, &buf->released_size);
+    buf->resident_size = buf->reserved_size - buf->released_size;
+    buf->mprotect_tcalls_issued = _mman.mprotect_tcalls_issued;
+    buf->mprotect_tcalls_elided = _mman.mprotect_tcalls_elided;
+    buf->zero_fill_pages_elided = _mman.zero_fill_pages_elided;
 }
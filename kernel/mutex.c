@@ -66,24 +66,146 @@ int __myst_mutex_trylock(myst_mutex_t* m, myst_thread_t* self)
     return -EBUSY;
 }
 
+/*
+**==============================================================================
+**
+** Adaptive spinning:
+**
+**     Blocking requires a round trip to the host (an enclave exit on SGX),
+**     which costs far more than a typical critical section. So a thread that
+**     finds the mutex locked first spins for a bounded number of iterations.
+**     The bound is derived from a per-mutex running estimate of the spins
+**     that recent contended acquisitions needed, which tracks recent hold
+**     times. Acquisitions that end up blocking pull the estimate toward zero,
+**     so mutexes that are held for long stop spinning.
+**
+**==============================================================================
+*/
+
+#define MIN_SPINS 16
+#define MAX_SPINS 256
+
+/* statistics summed over all mutexes (updated atomically) */
+static myst_mutex_stats_t _stats;
+
+size_t myst_spin_limit(uint32_t estimate)
+{
+    size_t n = 2 * (size_t)estimate + MIN_SPINS;
+    return (n > MAX_SPINS) ? MAX_SPINS : n;
+}
+
+void myst_spin_update(uint32_t* estimate, size_t spins)
+{
+    /* move one eighth of the way toward the observed value */
+    int64_t delta = (int64_t)spins - (int64_t)*estimate;
+    *estimate = (uint32_t)((int64_t)*estimate + delta / 8);
+}
+
+bool myst_spin_wait_event(uint64_t event, size_t* spins)
+{
+    volatile int* uaddr = (volatile int*)event;
+    const size_t limit = *spins;
+
+    for (size_t i = 0; i < limit; i++)
+    {
+        int value = *uaddr;
+
+        /* a positive value is a posted wake-up (see myst_tcall_wake()) */
+        if (value > 0 && __sync_bool_compare_and_swap(uaddr, value, value - 1))
+        {
+            *spins = i + 1;
+            return true;
+        }
+
+        __asm__ __volatile__("pause" : : : "memory");
+    }
+
+    return false;
+}
+
+/* Caller manages the spinlock */
+static void _record_contended(myst_mutex_t* m, size_t spins, bool blocked)
+{
+    m->stats.locks++;
+    m->stats.contended++;
+    m->stats.spins += spins;
+    __atomic_fetch_add(&_stats.locks, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&_stats.contended, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&_stats.spins, spins, __ATOMIC_RELAXED);
+
+    if (blocked)
+    {
+        m->stats.blocked++;
+        __atomic_fetch_add(&_stats.blocked, 1, __ATOMIC_RELAXED);
+        myst_spin_update(&m->spin_estimate, 0);
+    }
+    else
+    {
+        m->stats.spun++;
+        __atomic_fetch_add(&_stats.spun, 1, __ATOMIC_RELAXED);
+        myst_spin_update(&m->spin_estimate, spins);
+    }
+}
+
 int myst_mutex_lock(myst_mutex_t* mutex)
 {
     myst_mutex_t* m = (myst_mutex_t*)mutex;
     myst_thread_t* self = myst_thread_self();
+    size_t limit;
+    size_t spins = 0;
+    bool blocked = false;
 
     if (!m)
         return -EINVAL;
 
+    myst_spin_lock(&m->lock);
+    {
+        /* Attempt to acquire lock */
+        if (__myst_mutex_trylock(m, self) == 0)
+        {
+            m->stats.locks++;
+            __atomic_fetch_add(&_stats.locks, 1, __ATOMIC_RELAXED);
+            myst_spin_unlock(&m->lock);
+            return 0;
+        }
+
+        limit = myst_spin_limit(m->spin_estimate);
+    }
+    myst_spin_unlock(&m->lock);
+
+    /* Spin while the owner may release soon and no thread is queued first */
+    while (spins < limit && !__atomic_load_n(&m->queue.front, __ATOMIC_RELAXED))
+    {
+        spins++;
+        __asm__ __volatile__("pause" : : : "memory");
+
+        if (__atomic_load_n(&m->owner, __ATOMIC_RELAXED))
+            continue;
+
+        myst_spin_lock(&m->lock);
+        {
+            if (__myst_mutex_trylock(m, self) == 0)
+            {
+                _record_contended(m, spins, false);
+                myst_spin_unlock(&m->lock);
+                return 0;
+            }
+        }
+        myst_spin_unlock(&m->lock);
+    }
+
     /* Loop until SELF obtains mutex */
     for (;;)
     {
         long r;
+        size_t n = limit;
 
         myst_spin_lock(&m->lock);
         {
             /* Attempt to acquire lock */
             if (__myst_mutex_trylock(m, self) == 0)
             {
+                _record_contended(m, spins, blocked);
                 myst_spin_unlock(&m->lock);
                 return 0;
             }
@@ -97,6 +219,16 @@ int myst_mutex_lock(myst_mutex_t* mutex)
         }
         myst_spin_unlock(&m->lock);
 
+        /* The owner may hand over the mutex soon, so spin before blocking */
+        if (myst_spin_wait_event(self->event, &n))
+        {
+            spins += n;
+            continue;
+        }
+
+        spins += n;
+        blocked = true;
+
         /* Ask host to wait for an event on this thread */
         self->signal.waiting_on_event = true;
         if ((r = myst_tcall_wait(self->event, NULL)) != 0)
@@ -120,6 +252,8 @@ int myst_mutex_trylock(myst_mutex_t* mutex)
         /* Attempt to acquire lock */
         if (__myst_mutex_trylock(m, self) == 0)
         {
+            m->stats.locks++;
+            __atomic_fetch_add(&_stats.locks, 1, __ATOMIC_RELAXED);
             myst_spin_unlock(&m->lock);
             return 0;
         }
@@ -217,3 +351,42 @@ myst_thread_t* myst_mutex_owner(myst_mutex_t* m)
 
     return owner;
 }
+
+int myst_mutex_get_stats(myst_mutex_t* m, myst_mutex_stats_t* stats)
+{
+    if (!stats)
+        return -EINVAL;
+
+    if (!m)
+    {
+        stats->locks = __atomic_load_n(&_stats.locks, __ATOMIC_RELAXED);
+        stats->contended = __atomic_load_n(&_stats.contended, __ATOMIC_RELAXED);
+        stats->spun = __atomic_load_n(&_stats.spun, __ATOMIC_RELAXED);
+        stats->blocked = __atomic_load_n(&_stats.blocked, __ATOMIC_RELAXED);
+        stats->spins = __atomic_load_n(&_stats.spins, __ATOMIC_RELAXED);
+        return 0;
+    }
+
+    myst_spin_lock(&m->lock);
+    *stats = m->stats;
+    myst_spin_unlock(&m->lock);
+
+    return 0;
+}
+
+void myst_mutex_dump_stats(myst_mutex_t* m, const char* name)
+{
+    myst_mutex_stats_t stats;
+
+    if (myst_mutex_get_stats(m, &stats) != 0)
+        return;
+
+    myst_eprintf(
+        "%s: locks=%lu contended=%lu spun=%lu blocked=%lu spins=%lu\n",
+        name ? name : "mutexes",
+        stats.locks,
+        stats.contended,
+        stats.spun,
+        stats.blocked,
+        stats.spins);
+}
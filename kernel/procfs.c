@@ -10,12 +10,14 @@
 #include <myst/file.h>
 #include <myst/fs.h>
 #include <myst/kernel.h>
+#include <myst/latency.h>
 #include <myst/mmanutils.h>
 #include <myst/mount.h>
 #include <myst/printf.h>
 #include <myst/process.h>
 #include <myst/procfs.h>
 #include <myst/strings.h>
+#include <myst/tracering.h>
 
 static int _status_vcallback(myst_buf_t* vbuf);
 
@@ -153,12 +155,16 @@ static int _meminfo_vcallback(myst_buf_t* vbuf)
     int ret = 0;
     size_t totalram;
     size_t freeram;
+    size_t reservedram;
+    size_t releasedram;
 
     if (!vbuf)
         ERAISE(-EINVAL);
 
     ECHECK(myst_get_total_ram(&totalram));
     ECHECK(myst_get_free_ram(&freeram));
+    ECHECK(myst_get_reserved_ram(&reservedram));
+    ECHECK(myst_get_released_ram(&releasedram));
 
     myst_buf_clear(vbuf);
     char tmp[128];
@@ -167,6 +173,11 @@ static int _meminfo_vcallback(myst_buf_t* vbuf)
     ECHECK(myst_buf_append(vbuf, tmp, strlen(tmp)));
     ECHECK(myst_snprintf(tmp, n, "MemFree:        %lu\n", freeram));
     ECHECK(myst_buf_append(vbuf, tmp, strlen(tmp)));
+    ECHECK(myst_snprintf(tmp, n, "MemReserved:    %lu\n", reservedram));
+    ECHECK(myst_buf_append(vbuf, tmp, strlen(tmp)));
+    ECHECK(myst_snprintf(
+        tmp, n, "MemResident:    %lu\n", reservedram - releasedram));
+    ECHECK(myst_buf_append(vbuf, tmp, strlen(tmp)));
 
 done:
 
@@ -368,6 +379,46 @@ done:
     return ret;
 }
 
+static int _syscalls_vcallback(myst_buf_t* vbuf)
+{
+    return myst_latency_format(vbuf);
+}
+
+static int _syscalls_reset_read_cb(void* buf, size_t count)
+{
+    (void)buf;
+    (void)count;
+    return 0;
+}
+
+/* writing anything to /proc/mystikos/syscalls_reset clears the histograms */
+static int _syscalls_reset_write_cb(const void* buf, size_t count)
+{
+    (void)buf;
+    myst_latency_reset();
+    return count;
+}
+
+static int _strace_dump_read_cb(void* buf, size_t count)
+{
+    (void)buf;
+    (void)count;
+    return 0;
+}
+
+/* writing anything to /proc/mystikos/strace_dump dumps the syscall trace */
+static int _strace_dump_write_cb(const void* buf, size_t count)
+{
+    int ret;
+
+    (void)buf;
+
+    if ((ret = myst_tracering_dump()) != 0)
+        return ret;
+
+    return count;
+}
+
 int create_proc_root_entries()
 {
     int ret = 0;
@@ -395,6 +446,41 @@ int create_proc_root_entries()
         ECHECK(myst_create_virtual_file(_procfs, "/self", S_IFLNK, v_cb, OPEN));
     }
 
+    /* Create /proc/mystikos/syscalls (latency histograms) */
+    {
+        myst_vcallback_t v_cb;
+        v_cb.open_cb = _syscalls_vcallback;
+        ECHECK(myst_mkdirhier("/proc/mystikos", 777));
+        ECHECK(myst_create_virtual_file(
+            _procfs, "/mystikos/syscalls", S_IFREG | S_IRUSR, v_cb, OPEN));
+    }
+
+    /* Create /proc/mystikos/syscalls_reset */
+    {
+        myst_vcallback_t v_cb;
+        v_cb.rw_callbacks.read_cb = _syscalls_reset_read_cb;
+        v_cb.rw_callbacks.write_cb = _syscalls_reset_write_cb;
+        ECHECK(myst_create_virtual_file(
+            _procfs,
+            "/mystikos/syscalls_reset",
+            S_IFREG | S_IWUSR,
+            v_cb,
+            RW));
+    }
+
+    /* Create /proc/mystikos/strace_dump */
+    {
+        myst_vcallback_t v_cb;
+        v_cb.rw_callbacks.read_cb = _strace_dump_read_cb;
+        v_cb.rw_callbacks.write_cb = _strace_dump_write_cb;
+        ECHECK(myst_create_virtual_file(
+            _procfs,
+            "/mystikos/strace_dump",
+            S_IFREG | S_IWUSR,
+            v_cb,
+            RW));
+    }
+
 done:
     return ret;
 }
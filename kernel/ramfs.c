@@ -2796,6 +2796,45 @@ done:
     return ret;
 }
 
+int myst_ramfs_get_buf(
+    myst_fs_t* fs,
+    myst_file_t* file,
+    const void** buf_out,
+    size_t* buf_size_out)
+{
+    ramfs_t* ramfs = _ramfs(fs);
+    inode_t* inode;
+    int ret = 0;
+
+    if (buf_out)
+        *buf_out = NULL;
+
+    if (buf_size_out)
+        *buf_size_out = 0;
+
+    if (!buf_out || !buf_size_out)
+        ERAISE(-EINVAL);
+
+    if (!_ramfs_valid(ramfs) || !_file_valid(file))
+        ERAISE(-ENOTSUP);
+
+    inode = file->inode;
+
+    /* only regular files still backed by myst_ramfs_set_buf() data */
+    if (!S_ISREG(inode->mode) || inode->v_type != NONE || !inode->data ||
+        inode->buf.data != inode->data)
+    {
+        ERAISE(-ENOTSUP);
+    }
+
+    *buf_out = inode->data;
+    *buf_size_out = inode->buf.size;
+
+done:
+
+    return ret;
+}
+
 int myst_create_virtual_file(
     myst_fs_t* fs,
     const char* pathname,
@@ -8,6 +8,7 @@
 #include <myst/id.h>
 #include <myst/kernel.h>
 #include <myst/mmanutils.h>
+#include <myst/mutex.h>
 #include <myst/panic.h>
 #include <myst/printf.h>
 #include <myst/strings.h>
@@ -66,11 +67,14 @@ static help_t _help[] = {
     {"cd", "change the current directory"},
     {"pwd", "print the current directory"},
     {"mem", "print memory statistics"},
+    {"locks", "print mutex contention statistics"},
     {"cont", "leave shell and ocntinue execution"},
     {"fds", "list open file descriptors"},
     {"id", "print the current UID and GID"},
     {"maxthreads", "print the maximum number of threads"},
     {"numthreads", "print the number of threads"},
+    {"threadpool", "print thread pool statistics"},
+    {"kstacks", "print kernel stack statistics"},
     {"hostname", "print the hostname"},
     {"mcheck", "check heap memory"},
     {"mdump", "print in-use malloc'd blocks"},
@@ -196,6 +200,7 @@ static void _mem_command(int argc, char** argv)
     struct locals
     {
         myst_mman_stats_t buf;
+        myst_malloc_stats_t malloc_buf;
     };
     struct locals* locals = NULL;
 
@@ -203,6 +208,7 @@ static void _mem_command(int argc, char** argv)
         myst_panic("out of memory");
 
     myst_mman_stats(&locals->buf);
+    myst_get_malloc_stats(&locals->malloc_buf);
 
     (void)argc;
     (void)argv;
@@ -222,6 +228,33 @@ static void _mem_command(int argc, char** argv)
     n = locals->buf.brk_size;
     printf("brk used     =%11zu (%zumb)\n", n, n / mb);
 
+    n = locals->buf.reserved_size;
+    printf("reserved ram =%11zu (%zumb)\n", n, n / mb);
+
+    n = locals->buf.resident_size;
+    printf("resident ram =%11zu (%zumb)\n", n, n / mb);
+
+    n = locals->buf.mprotect_tcalls_issued;
+    printf("mprotect tcalls issued =%11zu\n", n);
+
+    n = locals->buf.mprotect_tcalls_elided;
+    printf("mprotect tcalls elided =%11zu\n", n);
+
+    n = locals->buf.zero_fill_pages_elided;
+    printf("zero-fill pages elided =%11zu\n", n);
+
+    n = locals->malloc_buf.cache_hits;
+    printf("malloc cache hits      =%11zu\n", n);
+
+    n = locals->malloc_buf.cache_misses;
+    printf("malloc cache misses    =%11zu\n", n);
+
+    n = locals->malloc_buf.cache_contention;
+    printf("malloc cache contended =%11zu\n", n);
+
+    n = locals->malloc_buf.cache_bytes;
+    printf("malloc cache bytes     =%11zu\n", n);
+
     n = __myst_kernel_args.rootfs_size;
     printf("cpio size    =%11zu (%zumb)\n", n, n / mb);
 
@@ -243,6 +276,24 @@ static void _mem_command(int argc, char** argv)
         free(locals);
 }
 
+static void _locks_command(int argc, char** argv)
+{
+    myst_mutex_stats_t stats;
+
+    (void)argc;
+    (void)argv;
+
+    if (myst_mutex_get_stats(NULL, &stats) != 0)
+        myst_panic("myst_mutex_get_stats() failed");
+
+    printf("locks     =%11lu\n", stats.locks);
+    printf("contended =%11lu\n", stats.contended);
+    printf("spun      =%11lu\n", stats.spun);
+    printf("blocked   =%11lu\n", stats.blocked);
+    printf("spins     =%11lu\n", stats.spins);
+    printf("\n");
+}
+
 static void _env_command(int argc, char** argv)
 {
     (void)argc;
@@ -325,6 +376,10 @@ void myst_start_shell(const char* msg)
         {
             _mem_command(argc, argv);
         }
+        else if (strcmp(argv[0], "locks") == 0)
+        {
+            _locks_command(argc, argv);
+        }
         else if (strcmp(argv[0], "fds") == 0)
         {
             myst_fdtable_list(myst_fdtable_current());
@@ -337,6 +392,25 @@ void myst_start_shell(const char* msg)
         {
             printf("%zu\n\n", myst_get_num_threads());
         }
+        else if (strcmp(argv[0], "threadpool") == 0)
+        {
+            myst_thread_pool_stats_t stats;
+            myst_get_thread_pool_stats(&stats);
+            printf("hits   =%11zu\n", stats.hits);
+            printf("misses =%11zu\n", stats.misses);
+            printf("parked =%11zu\n", stats.parked);
+            printf("\n");
+        }
+        else if (strcmp(argv[0], "kstacks") == 0)
+        {
+            myst_kstack_stats_t stats;
+            myst_get_kstack_stats(&stats);
+            printf("total      =%11zu\n", stats.total);
+            printf("in_use     =%11zu\n", stats.in_use);
+            printf("high_water =%11zu\n", stats.high_water);
+            printf("limit      =%11zu\n", stats.limit);
+            printf("\n");
+        }
         else if (strcmp(argv[0], "id") == 0)
         {
             uid_t uid = MYST_DEFAULT_UID;
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 
+#define _GNU_SOURCE
 #include <errno.h>
 #include <limits.h>
 #include <stdlib.h>
@@ -375,6 +376,87 @@ done:
     return ret;
 }
 
+static int _sd_sendmmsg(
+    myst_sockdev_t* sd,
+    myst_sock_t* sock,
+    struct mmsghdr* msgvec,
+    unsigned int vlen,
+    int flags)
+{
+    ssize_t ret = 0;
+
+    if (!sd || !_valid_sock(sock) || (!msgvec && vlen))
+        ERAISE(-EINVAL);
+
+    /* like Linux, send at most UIO_MAXIOV messages */
+    if (vlen > UIO_MAXIOV)
+        vlen = UIO_MAXIOV;
+
+    if (vlen == 0)
+        goto done;
+
+    for (unsigned int i = 0; i < vlen; i++)
+    {
+        const struct msghdr* msg = &msgvec[i].msg_hdr;
+
+        if (msg->msg_iovlen < 0 || msg->msg_iovlen > IOV_MAX)
+            ERAISE(-EINVAL);
+
+        if (!msg->msg_iov && msg->msg_iovlen)
+            ERAISE(-EINVAL);
+    }
+
+    /* perform syscall (all messages cross to the target at once) */
+    {
+        long params[6] = {sock->fd, (long)msgvec, vlen, flags};
+        ECHECK((ret = myst_tcall(SYS_sendmmsg, params)));
+    }
+
+done:
+    return ret;
+}
+
+static int _sd_recvmmsg(
+    myst_sockdev_t* sd,
+    myst_sock_t* sock,
+    struct mmsghdr* msgvec,
+    unsigned int vlen,
+    int flags,
+    struct timespec* timeout)
+{
+    ssize_t ret = 0;
+
+    if (!sd || !_valid_sock(sock) || (!msgvec && vlen))
+        ERAISE(-EINVAL);
+
+    if (vlen > UIO_MAXIOV)
+        vlen = UIO_MAXIOV;
+
+    if (vlen == 0)
+        goto done;
+
+    for (unsigned int i = 0; i < vlen; i++)
+    {
+        const struct msghdr* msg = &msgvec[i].msg_hdr;
+
+        if (msg->msg_iovlen < 0 || msg->msg_iovlen > IOV_MAX)
+            ERAISE(-EINVAL);
+
+        if (!msg->msg_iov && msg->msg_iovlen)
+            ERAISE(-EINVAL);
+    }
+
+    /* perform syscall */
+    {
+        long params[6] = {
+            sock->fd, (long)msgvec, vlen, flags, (long)timeout};
+        ECHECK((ret = myst_tcall(SYS_recvmmsg, params)));
+    }
+
+done:
+    return ret;
+}
+
 static int _sd_shutdown(myst_sockdev_t* sd, myst_sock_t* sock, int how)
 {
     ssize_t ret = 0;
@@ -533,8 +615,14 @@ static ssize_t _sd_readv(
     if (!sd || !_valid_sock(sock))
         ERAISE(-EINVAL);
 
-    ret = myst_fdops_readv(&sd->fdops, sock, iov, iovcnt);
-    ECHECK(ret);
+    if ((!iov && iovcnt) || iovcnt < 0 || iovcnt > IOV_MAX)
+        ERAISE(-EINVAL);
+
+    /* perform syscall (the target keeps the iovec boundaries) */
+    {
+        long params[6] = {sock->fd, (long)iov, iovcnt};
+        ECHECK((ret = myst_tcall(SYS_readv, params)));
+    }
 
 done:
     return ret;
@@ -551,8 +639,14 @@ static ssize_t _sd_writev(
     if (!sd || !_valid_sock(sock))
         ERAISE(-EINVAL);
 
-    ret = myst_fdops_writev(&sd->fdops, sock, iov, iovcnt);
-    ECHECK(ret);
+    if ((!iov && iovcnt) || iovcnt < 0 || iovcnt > IOV_MAX)
+        ERAISE(-EINVAL);
+
+    /* perform syscall */
+    {
+        long params[6] = {sock->fd, (long)iov, iovcnt};
+        ECHECK((ret = myst_tcall(SYS_writev, params)));
+    }
 
 done:
     return ret;
@@ -726,6 +820,8 @@ extern myst_sockdev_t* myst_sockdev_get(void)
         .sd_recvfrom = _sd_recvfrom,
         .sd_sendmsg = _sd_sendmsg,
         .sd_recvmsg = _sd_recvmsg,
+        .sd_sendmmsg = _sd_sendmmsg,
+        .sd_recvmmsg = _sd_recvmmsg,
         .sd_shutdown = _sd_shutdown,
         .sd_getsockopt = _sd_getsockopt,
         .sd_setsockopt = _sd_setsockopt,
@@ -26,6 +26,7 @@
 #include <sys/vfs.h>
 #include <unistd.h>
 
+#include <myst/aio.h>
 #include <myst/backtrace.h>
 #include <myst/barrier.h>
 #include <myst/blkdev.h>
@@ -79,6 +80,7 @@
 #include <myst/thread.h>
 #include <myst/time.h>
 #include <myst/times.h>
+#include <myst/tracering.h>
 #include <myst/trace.h>
 #include <myst/uid_gid.h>
 
@@ -91,401 +93,6 @@
 
 long myst_syscall_isatty(int fd);
 
-typedef struct _pair
-{
-    long num;
-    const char* str;
-} pair_t;
-
-static pair_t _pairs[] = {
-    {SYS_read, "SYS_read"},
-    {SYS_write, "SYS_write"},
-    {SYS_open, "SYS_open"},
-    {SYS_close, "SYS_close"},
-    {SYS_stat, "SYS_stat"},
-    {SYS_fstat, "SYS_fstat"},
-    {SYS_lstat, "SYS_lstat"},
-    {SYS_poll, "SYS_poll"},
-    {SYS_lseek, "SYS_lseek"},
-    {SYS_mmap, "SYS_mmap"},
-    {SYS_mprotect, "SYS_mprotect"},
-    {SYS_munmap, "SYS_munmap"},
-    {SYS_brk, "SYS_brk"},
-    {SYS_rt_sigaction, "SYS_rt_sigaction"},
-    {SYS_rt_sigprocmask, "SYS_rt_sigprocmask"},
-    {SYS_rt_sigreturn, "SYS_rt_sigreturn"},
-    {SYS_ioctl, "SYS_ioctl"},
-    {SYS_pread64, "SYS_pread64"},
-    {SYS_pwrite64, "SYS_pwrite64"},
-    {SYS_readv, "SYS_readv"},
-    {SYS_writev, "SYS_writev"},
-    {SYS_access, "SYS_access"},
-    {SYS_pipe, "SYS_pipe"},
-    {SYS_select, "SYS_select"},
-    {SYS_sched_yield, "SYS_sched_yield"},
-    {SYS_mremap, "SYS_mremap"},
-    {SYS_msync, "SYS_msync"},
-    {SYS_mincore, "SYS_mincore"},
-    {SYS_madvise, "SYS_madvise"},
-    {SYS_shmget, "SYS_shmget"},
-    {SYS_shmat, "SYS_shmat"},
-    {SYS_shmctl, "SYS_shmctl"},
-    {SYS_dup, "SYS_dup"},
-    {SYS_dup2, "SYS_dup2"},
-    {SYS_pause, "SYS_pause"},
-    {SYS_nanosleep, "SYS_nanosleep"},
-    {SYS_getitimer, "SYS_getitimer"},
-    {SYS_alarm, "SYS_alarm"},
-    {SYS_setitimer, "SYS_setitimer"},
-    {SYS_getpid, "SYS_getpid"},
-    {SYS_sendfile, "SYS_sendfile"},
-    {SYS_socket, "SYS_socket"},
-    {SYS_connect, "SYS_connect"},
-    {SYS_accept, "SYS_accept"},
-    {SYS_sendto, "SYS_sendto"},
-    {SYS_recvfrom, "SYS_recvfrom"},
-    {SYS_sendmsg, "SYS_sendmsg"},
-    {SYS_recvmsg, "SYS_recvmsg"},
-    {SYS_shutdown, "SYS_shutdown"},
-    {SYS_bind, "SYS_bind"},
-    {SYS_listen, "SYS_listen"},
-    {SYS_getsockname, "SYS_getsockname"},
-    {SYS_getpeername, "SYS_getpeername"},
-    {SYS_socketpair, "SYS_socketpair"},
-    {SYS_setsockopt, "SYS_setsockopt"},
-    {SYS_getsockopt, "SYS_getsockopt"},
-    {SYS_clone, "SYS_clone"},
-    {SYS_fork, "SYS_fork"},
-    {SYS_vfork, "SYS_vfork"},
-    {SYS_execve, "SYS_execve"},
-    {SYS_exit, "SYS_exit"},
-    {SYS_wait4, "SYS_wait4"},
-    {SYS_kill, "SYS_kill"},
-    {SYS_uname, "SYS_uname"},
-    {SYS_semget, "SYS_semget"},
-    {SYS_semop, "SYS_semop"},
-    {SYS_semctl, "SYS_semctl"},
-    {SYS_shmdt, "SYS_shmdt"},
-    {SYS_msgget, "SYS_msgget"},
-    {SYS_msgsnd, "SYS_msgsnd"},
-    {SYS_msgrcv, "SYS_msgrcv"},
-    {SYS_msgctl, "SYS_msgctl"},
-    {SYS_fcntl, "SYS_fcntl"},
-    {SYS_flock, "SYS_flock"},
-    {SYS_fsync, "SYS_fsync"},
-    {SYS_fdatasync, "SYS_fdatasync"},
-    {SYS_truncate, "SYS_truncate"},
-    {SYS_ftruncate, "SYS_ftruncate"},
-    {SYS_getdents, "SYS_getdents"},
-    {SYS_getcwd, "SYS_getcwd"},
-    {SYS_chdir, "SYS_chdir"},
-    {SYS_fchdir, "SYS_fchdir"},
-    {SYS_rename, "SYS_rename"},
-    {SYS_mkdir, "SYS_mkdir"},
-    {SYS_rmdir, "SYS_rmdir"},
-    {SYS_creat, "SYS_creat"},
-    {SYS_link, "SYS_link"},
-    {SYS_unlink, "SYS_unlink"},
-    {SYS_symlink, "SYS_symlink"},
-    {SYS_readlink, "SYS_readlink"},
-    {SYS_chmod, "SYS_chmod"},
-    {SYS_fchmod, "SYS_fchmod"},
-    {SYS_chown, "SYS_chown"},
-    {SYS_fchown, "SYS_fchown"},
-    {SYS_lchown, "SYS_lchown"},
-    {SYS_umask, "SYS_umask"},
-    {SYS_gettimeofday, "SYS_gettimeofday"},
-    {SYS_getrlimit, "SYS_getrlimit"},
-    {SYS_getrusage, "SYS_getrusage"},
-    {SYS_sysinfo, "SYS_sysinfo"},
-    {SYS_times, "SYS_times"},
-    {SYS_ptrace, "SYS_ptrace"},
-    {SYS_getuid, "SYS_getuid"},
-    {SYS_syslog, "SYS_syslog"},
-    {SYS_getgid, "SYS_getgid"},
-    {SYS_setuid, "SYS_setuid"},
-    {SYS_setgid, "SYS_setgid"},
-    {SYS_geteuid, "SYS_geteuid"},
-    {SYS_getegid, "SYS_getegid"},
-    {SYS_setpgid, "SYS_setpgid"},
-    {SYS_getppid, "SYS_getppid"},
-    {SYS_getpgrp, "SYS_getpgrp"},
-    {SYS_setsid, "SYS_setsid"},
-    {SYS_setreuid, "SYS_setreuid"},
-    {SYS_setregid, "SYS_setregid"},
-    {SYS_getgroups, "SYS_getgroups"},
-    {SYS_setgroups, "SYS_setgroups"},
-    {SYS_setresuid, "SYS_setresuid"},
-    {SYS_getresuid, "SYS_getresuid"},
-    {SYS_setresgid, "SYS_setresgid"},
-    {SYS_getresgid, "SYS_getresgid"},
-    {SYS_getpgid, "SYS_getpgid"},
-    {SYS_setfsuid, "SYS_setfsuid"},
-    {SYS_setfsgid, "SYS_setfsgid"},
-    {SYS_getsid, "SYS_getsid"},
-    {SYS_capget, "SYS_capget"},
-    {SYS_capset, "SYS_capset"},
-    {SYS_rt_sigpending, "SYS_rt_sigpending"},
-    {SYS_rt_sigtimedwait, "SYS_rt_sigtimedwait"},
-    {SYS_rt_sigqueueinfo, "SYS_rt_sigqueueinfo"},
-    {SYS_rt_sigsuspend, "SYS_rt_sigsuspend"},
-    {SYS_sigaltstack, "SYS_sigaltstack"},
-    {SYS_utime, "SYS_utime"},
-    {SYS_mknod, "SYS_mknod"},
-    {SYS_uselib, "SYS_uselib"},
-    {SYS_personality, "SYS_personality"},
-    {SYS_ustat, "SYS_ustat"},
-    {SYS_statfs, "SYS_statfs"},
-    {SYS_fstatfs, "SYS_fstatfs"},
-    {SYS_sysfs, "SYS_sysfs"},
-    {SYS_getpriority, "SYS_getpriority"},
-    {SYS_setpriority, "SYS_setpriority"},
-    {SYS_sched_setparam, "SYS_sched_setparam"},
-    {SYS_sched_getparam, "SYS_sched_getparam"},
-    {SYS_sched_setscheduler, "SYS_sched_setscheduler"},
-    {SYS_sched_getscheduler, "SYS_sched_getscheduler"},
-    {SYS_sched_get_priority_max, "SYS_sched_get_priority_max"},
-    {SYS_sched_get_priority_min, "SYS_sched_get_priority_min"},
-    {SYS_sched_rr_get_interval, "SYS_sched_rr_get_interval"},
-    {SYS_mlock, "SYS_mlock"},
-    {SYS_munlock, "SYS_munlock"},
-    {SYS_mlockall, "SYS_mlockall"},
-    {SYS_munlockall, "SYS_munlockall"},
-    {SYS_vhangup, "SYS_vhangup"},
-    {SYS_modify_ldt, "SYS_modify_ldt"},
-    {SYS_pivot_root, "SYS_pivot_root"},
-    {SYS__sysctl, "SYS__sysctl"},
-    {SYS_prctl, "SYS_prctl"},
-    {SYS_arch_prctl, "SYS_arch_prctl"},
-    {SYS_adjtimex, "SYS_adjtimex"},
-    {SYS_setrlimit, "SYS_setrlimit"},
-    {SYS_chroot, "SYS_chroot"},
-    {SYS_sync, "SYS_sync"},
-    {SYS_acct, "SYS_acct"},
-    {SYS_settimeofday, "SYS_settimeofday"},
-    {SYS_mount, "SYS_mount"},
-    {SYS_umount2, "SYS_umount2"},
-    {SYS_swapon, "SYS_swapon"},
-    {SYS_swapoff, "SYS_swapoff"},
-    {SYS_reboot, "SYS_reboot"},
-    {SYS_sethostname, "SYS_sethostname"},
-    {SYS_setdomainname, "SYS_setdomainname"},
-    {SYS_iopl, "SYS_iopl"},
-    {SYS_ioperm, "SYS_ioperm"},
-    {SYS_create_module, "SYS_create_module"},
-    {SYS_init_module, "SYS_init_module"},
-    {SYS_delete_module, "SYS_delete_module"},
-    {SYS_get_kernel_syms, "SYS_get_kernel_syms"},
-    {SYS_query_module, "SYS_query_module"},
-    {SYS_quotactl, "SYS_quotactl"},
-    {SYS_nfsservctl, "SYS_nfsservctl"},
-    {SYS_getpmsg, "SYS_getpmsg"},
-    {SYS_putpmsg, "SYS_putpmsg"},
-    {SYS_afs_syscall, "SYS_afs_syscall"},
-    {SYS_tuxcall, "SYS_tuxcall"},
-    {SYS_security, "SYS_security"},
-    {SYS_gettid, "SYS_gettid"},
-    {SYS_readahead, "SYS_readahead"},
-    {SYS_setxattr, "SYS_setxattr"},
-    {SYS_lsetxattr, "SYS_lsetxattr"},
-    {SYS_fsetxattr, "SYS_fsetxattr"},
-    {SYS_getxattr, "SYS_getxattr"},
-    {SYS_lgetxattr, "SYS_lgetxattr"},
-    {SYS_fgetxattr, "SYS_fgetxattr"},
-    {SYS_listxattr, "SYS_listxattr"},
-    {SYS_llistxattr, "SYS_llistxattr"},
-    {SYS_flistxattr, "SYS_flistxattr"},
-    {SYS_removexattr, "SYS_removexattr"},
-    {SYS_lremovexattr, "SYS_lremovexattr"},
-    {SYS_fremovexattr, "SYS_fremovexattr"},
-    {SYS_tkill, "SYS_tkill"},
-    {SYS_time, "SYS_time"},
-    {SYS_futex, "SYS_futex"},
-    {SYS_sched_setaffinity, "SYS_sched_setaffinity"},
-    {SYS_sched_getaffinity, "SYS_sched_getaffinity"},
-    {SYS_set_thread_area, "SYS_set_thread_area"},
-    {SYS_io_setup, "SYS_io_setup"},
-    {SYS_io_destroy, "SYS_io_destroy"},
-    {SYS_io_getevents, "SYS_io_getevents"},
-    {SYS_io_submit, "SYS_io_submit"},
-    {SYS_io_cancel, "SYS_io_cancel"},
-    {SYS_get_thread_area, "SYS_get_thread_area"},
-    {SYS_lookup_dcookie, "SYS_lookup_dcookie"},
-    {SYS_epoll_create, "SYS_epoll_create"},
-    {SYS_epoll_ctl_old, "SYS_epoll_ctl_old"},
-    {SYS_epoll_wait_old, "SYS_epoll_wait_old"},
-    {SYS_remap_file_pages, "SYS_remap_file_pages"},
-    {SYS_getdents64, "SYS_getdents64"},
-    {SYS_set_tid_address, "SYS_set_tid_address"},
-    {SYS_restart_syscall, "SYS_restart_syscall"},
-    {SYS_semtimedop, "SYS_semtimedop"},
-    {SYS_fadvise64, "SYS_fadvise64"},
-    {SYS_timer_create, "SYS_timer_create"},
-    {SYS_timer_settime, "SYS_timer_settime"},
-    {SYS_timer_gettime, "SYS_timer_gettime"},
-    {SYS_timer_getoverrun, "SYS_timer_getoverrun"},
-    {SYS_timer_delete, "SYS_timer_delete"},
-    {SYS_clock_settime, "SYS_clock_settime"},
-    {SYS_clock_gettime, "SYS_clock_gettime"},
-    {SYS_clock_getres, "SYS_clock_getres"},
-    {SYS_clock_nanosleep, "SYS_clock_nanosleep"},
-    {SYS_exit_group, "SYS_exit_group"},
-    {SYS_epoll_wait, "SYS_epoll_wait"},
-    {SYS_epoll_ctl, "SYS_epoll_ctl"},
-    {SYS_tgkill, "SYS_tgkill"},
-    {SYS_utimes, "SYS_utimes"},
-    {SYS_vserver, "SYS_vserver"},
-    {SYS_mbind, "SYS_mbind"},
-    {SYS_set_mempolicy, "SYS_set_mempolicy"},
-    {SYS_get_mempolicy, "SYS_get_mempolicy"},
-    {SYS_mq_open, "SYS_mq_open"},
-    {SYS_mq_unlink, "SYS_mq_unlink"},
-    {SYS_mq_timedsend, "SYS_mq_timedsend"},
-    {SYS_mq_timedreceive, "SYS_mq_timedreceive"},
-    {SYS_mq_notify, "SYS_mq_notify"},
-    {SYS_mq_getsetattr, "SYS_mq_getsetattr"},
-    {SYS_kexec_load, "SYS_kexec_load"},
-    {SYS_waitid, "SYS_waitid"},
-    {SYS_add_key, "SYS_add_key"},
-    {SYS_request_key, "SYS_request_key"},
-    {SYS_keyctl, "SYS_keyctl"},
-    {SYS_ioprio_set, "SYS_ioprio_set"},
-    {SYS_ioprio_get, "SYS_ioprio_get"},
-    {SYS_inotify_init, "SYS_inotify_init"},
-    {SYS_inotify_add_watch, "SYS_inotify_add_watch"},
-    {SYS_inotify_rm_watch, "SYS_inotify_rm_watch"},
-    {SYS_migrate_pages, "SYS_migrate_pages"},
-    {SYS_openat, "SYS_openat"},
-    {SYS_mkdirat, "SYS_mkdirat"},
-    {SYS_mknodat, "SYS_mknodat"},
-    {SYS_fchownat, "SYS_fchownat"},
-    {SYS_futimesat, "SYS_futimesat"},
-    {SYS_newfstatat, "SYS_newfstatat"},
-    {SYS_unlinkat, "SYS_unlinkat"},
-    {SYS_renameat, "SYS_renameat"},
-    {SYS_linkat, "SYS_linkat"},
-    {SYS_symlinkat, "SYS_symlinkat"},
-    {SYS_readlinkat, "SYS_readlinkat"},
-    {SYS_fchmodat, "SYS_fchmodat"},
-    {SYS_faccessat, "SYS_faccessat"},
-    {SYS_pselect6, "SYS_pselect6"},
-    {SYS_ppoll, "SYS_ppoll"},
-    {SYS_unshare, "SYS_unshare"},
-    {SYS_set_robust_list, "SYS_set_robust_list"},
-    {SYS_get_robust_list, "SYS_get_robust_list"},
-    {SYS_splice, "SYS_splice"},
-    {SYS_tee, "SYS_tee"},
-    {SYS_sync_file_range, "SYS_sync_file_range"},
-    {SYS_vmsplice, "SYS_vmsplice"},
-    {SYS_move_pages, "SYS_move_pages"},
-    {SYS_utimensat, "SYS_utimensat"},
-    {SYS_epoll_pwait, "SYS_epoll_pwait"},
-    {SYS_signalfd, "SYS_signalfd"},
-    {SYS_timerfd_create, "SYS_timerfd_create"},
-    {SYS_eventfd, "SYS_eventfd"},
-    {SYS_fallocate, "SYS_fallocate"},
-    {SYS_timerfd_settime, "SYS_timerfd_settime"},
-    {SYS_timerfd_gettime, "SYS_timerfd_gettime"},
-    {SYS_accept4, "SYS_accept4"},
-    {SYS_signalfd4, "SYS_signalfd4"},
-    {SYS_eventfd2, "SYS_eventfd2"},
-    {SYS_epoll_create1, "SYS_epoll_create1"},
-    {SYS_dup3, "SYS_dup3"},
-    {SYS_pipe2, "SYS_pipe2"},
-    {SYS_inotify_init1, "SYS_inotify_init1"},
-    {SYS_preadv, "SYS_preadv"},
-    {SYS_pwritev, "SYS_pwritev"},
-    {SYS_rt_tgsigqueueinfo, "SYS_rt_tgsigqueueinfo"},
-    {SYS_perf_event_open, "SYS_perf_event_open"},
-    {SYS_recvmmsg, "SYS_recvmmsg"},
-    {SYS_fanotify_init, "SYS_fanotify_init"},
-    {SYS_fanotify_mark, "SYS_fanotify_mark"},
-    {SYS_prlimit64, "SYS_prlimit64"},
-    {SYS_name_to_handle_at, "SYS_name_to_handle_at"},
-    {SYS_open_by_handle_at, "SYS_open_by_handle_at"},
-    {SYS_clock_adjtime, "SYS_clock_adjtime"},
-    {SYS_syncfs, "SYS_syncfs"},
-    {SYS_sendmmsg, "SYS_sendmmsg"},
-    {SYS_setns, "SYS_setns"},
-    {SYS_getcpu, "SYS_getcpu"},
-    {SYS_process_vm_readv, "SYS_process_vm_readv"},
-    {SYS_process_vm_writev, "SYS_process_vm_writev"},
-    {SYS_kcmp, "SYS_kcmp"},
-    {SYS_finit_module, "SYS_finit_module"},
-    {SYS_sched_setattr, "SYS_sched_setattr"},
-    {SYS_sched_getattr, "SYS_sched_getattr"},
-    {SYS_renameat2, "SYS_renameat2"},
-    {SYS_seccomp, "SYS_seccomp"},
-    {SYS_getrandom, "SYS_getrandom"},
-    {SYS_memfd_create, "SYS_memfd_create"},
-    {SYS_kexec_file_load, "SYS_kexec_file_load"},
-    {SYS_bpf, "SYS_bpf"},
-    {SYS_execveat, "SYS_execveat"},
-    {SYS_userfaultfd, "SYS_userfaultfd"},
-    {SYS_membarrier, "SYS_membarrier"},
-    {SYS_mlock2, "SYS_mlock2"},
-    {SYS_copy_file_range, "SYS_copy_file_range"},
-    {SYS_preadv2, "SYS_preadv2"},
-    {SYS_pwritev2, "SYS_pwritev2"},
-    {SYS_pkey_mprotect, "SYS_pkey_mprotect"},
-    {SYS_pkey_alloc, "SYS_pkey_alloc"},
-    {SYS_pkey_free, "SYS_pkey_free"},
-    {SYS_statx, "SYS_statx"},
-    {SYS_io_pgetevents, "SYS_io_pgetevents"},
-    {SYS_rseq, "SYS_rseq"},
-    {SYS_myst_trace, "SYS_myst_trace"},
-    {SYS_myst_trace_ptr, "SYS_myst_trace_ptr"},
-    {SYS_myst_dump_ehdr, "SYS_myst_dump_ehdr"},
-    {SYS_myst_dump_argv, "SYS_myst_dump_argv"},
-    {SYS_myst_dump_stack, "SYS_myst_dump_stack"},
-    {SYS_myst_add_symbol_file, "SYS_myst_add_symbol_file"},
-    {SYS_myst_load_symbols, "SYS_myst_load_symbols"},
-    {SYS_myst_unload_symbols, "SYS_myst_unload_symbols"},
-    {SYS_myst_gen_creds, "SYS_myst_gen_creds"},
-    {SYS_myst_free_creds, "SYS_myst_free_creds"},
-    {SYS_myst_verify_cert, "SYS_myst_verify_cert"},
-    {SYS_myst_gen_creds_ex, "SYS_myst_gen_creds_ex"},
-    {SYS_myst_clone, "SYS_myst_clone"},
-    {SYS_myst_max_threads, "SYS_myst_max_threads"},
-    {SYS_myst_poll_wake, "SYS_myst_poll_wake"},
-    {SYS_get_process_thread_stack, "SYS_get_process_thread_stack"},
-    {SYS_myst_run_itimer, "SYS_myst_run_itimer"},
-    {SYS_myst_get_fork_info, "SYS_myst_get_fork_info"},
-    {SYS_fork_wait_exec_exit, "SYS_fork_wait_exec_exit"},
-    {SYS_myst_kill_wait_child_forks, "SYS_myst_kill_wait_child_forks"},
-    /* Open Enclave extensions */
-    {SYS_myst_oe_get_report_v2, "SYS_myst_oe_get_report_v2"},
-    {SYS_myst_oe_free_report, "SYS_myst_oe_free_report"},
-    {SYS_myst_oe_get_target_info_v2, "SYS_myst_oe_get_target_info_v2"},
-    {SYS_myst_oe_free_target_info, "SYS_myst_oe_free_target_info"},
-    {SYS_myst_oe_parse_report, "SYS_myst_oe_parse_report"},
-    {SYS_myst_oe_verify_report, "SYS_myst_oe_verify_report"},
-    {SYS_myst_oe_get_seal_key_by_policy_v2,
-     "SYS_myst_oe_get_seal_key_by_policy_v2"},
-    {SYS_myst_oe_get_public_key_by_policy,
-     "SYS_myst_oe_get_public_key_by_policy"},
-    {SYS_myst_oe_get_public_key, "SYS_myst_oe_get_public_key"},
-    {SYS_myst_oe_get_private_key_by_policy,
-     "SYS_myst_oe_get_private_key_by_policy"},
-    {SYS_myst_oe_get_private_key, "SYS_myst_oe_get_private_key"},
-    {SYS_myst_oe_free_key, "SYS_myst_oe_free_key"},
-    {SYS_myst_oe_get_seal_key_v2, "SYS_myst_oe_get_seal_key_v2"},
-    {SYS_myst_oe_free_seal_key, "SYS_myst_oe_free_seal_key"},
-    {SYS_myst_oe_generate_attestation_certificate,
-     "SYS_myst_oe_generate_attestation_certificate"},
-    {SYS_myst_oe_free_attestation_certificate,
-     "SYS_myst_oe_free_attestation_certificate"},
-    {SYS_myst_oe_verify_attestation_certificate,
-     "SYS_myst_oe_verify_attestation_certificate"},
-    {SYS_myst_oe_result_str, "SYS_myst_oe_result_str"},
-#ifdef MYST_ENABLE_GCOV
-    {SYS_myst_gcov, "SYS_myst_gcov"},
-#endif
-    {SYS_myst_unmap_on_exit, "SYS_myst_unmap_on_exit"},
-};
-
-static size_t _n_pairs = sizeof(_pairs) / sizeof(_pairs[0]);
-
 // The kernel should eventually use _bad_addr() to check all incoming addresses
 // from user space. This is a stop gap until the kernel is able to check
 // the access rights for a given address (memory obtained with mman and brk).
@@ -553,18 +160,7 @@ done:
 
 static const char* _syscall_str(long n)
 {
-    for (size_t i = 0; i < _n_pairs; i++)
-    {
-        if (n == _pairs[i].num)
-            return _pairs[i].str;
-    }
-
-    return "unknown";
-}
-
-const char* myst_syscall_str(long n)
-{
-    return _syscall_str(n);
+    return myst_syscall_str(n);
 }
 
 __attribute__((format(printf, 2, 3))) static void _strace(
@@ -1221,6 +817,33 @@ done:
     return ret;
 }
 
+/* get the file system and file of fd for preadv() or pwritev() */
+static bool _get_vectored_file(
+    int fd,
+    off_t offset,
+    myst_fs_t** fs,
+    myst_file_t** file)
+{
+    myst_fdtable_t* fdtable = myst_fdtable_current();
+    myst_fdtable_type_t type;
+    void* device = NULL;
+    void* object = NULL;
+
+    /* leave errors to be reported by the pread() and pwrite() paths */
+    if (offset < 0)
+        return false;
+
+    if (myst_fdtable_get_any(fdtable, fd, &type, &device, &object) != 0)
+        return false;
+
+    if (type != MYST_FDTABLE_TYPE_FILE)
+        return false;
+
+    *fs = device;
+    *file = object;
+    return true;
+}
+
 ssize_t myst_syscall_pwritev2(
     int fd,
     const struct iovec* iov,
@@ -1232,11 +855,20 @@ ssize_t myst_syscall_pwritev2(
     void* buf = NULL;
     ssize_t len;
     ssize_t nwritten;
+    myst_fs_t* fs;
+    myst_file_t* file;
 
     // ATTN: all flags are ignored since they are hints and have no
     // definitively perceptible effect.
     (void)flags;
 
+    /* pass the IO vector through if the file system supports it */
+    if (_get_vectored_file(fd, offset, &fs, &file) && fs->fs_pwritev)
+    {
+        ret = (*fs->fs_pwritev)(fs, file, iov, iovcnt, offset);
+        goto done;
+    }
+
     ECHECK(len = myst_iov_gather(iov, iovcnt, &buf));
     ECHECK(nwritten = myst_syscall_pwrite(fd, buf, len, offset));
     ret = nwritten;
@@ -1261,11 +893,20 @@ ssize_t myst_syscall_preadv2(
     char buf[256];
     void* ptr = NULL;
     ssize_t nread;
+    myst_fs_t* fs;
+    myst_file_t* file;
 
     // ATTN: all flags are ignored since they are hints and have no
     // definitively perceptible effect.
     (void)flags;
 
+    /* pass the IO vector through if the file system supports it */
+    if (_get_vectored_file(fd, offset, &fs, &file) && fs->fs_preadv)
+    {
+        ret = (*fs->fs_preadv)(fs, file, iov, iovcnt, offset);
+        goto done;
+    }
+
     ECHECK(len = myst_iov_len(iov, iovcnt));
 
     if (len == 0)
@@ -2609,6 +2250,43 @@ done:
     return ret;
 }
 
+long myst_syscall_sendmmsg(
+    int sockfd,
+    struct mmsghdr* msgvec,
+    unsigned int vlen,
+    int flags)
+{
+    long ret = 0;
+    myst_fdtable_t* fdtable = myst_fdtable_current();
+    myst_sockdev_t* sd;
+    myst_sock_t* sock;
+
+    ECHECK(myst_fdtable_get_sock(fdtable, sockfd, &sd, &sock));
+    ret = (*sd->sd_sendmmsg)(sd, sock, msgvec, vlen, flags);
+
+done:
+    return ret;
+}
+
+long myst_syscall_recvmmsg(
+    int sockfd,
+    struct mmsghdr* msgvec,
+    unsigned int vlen,
+    int flags,
+    struct timespec* timeout)
+{
+    long ret = 0;
+    myst_fdtable_t* fdtable = myst_fdtable_current();
+    myst_sockdev_t* sd;
+    myst_sock_t* sock;
+
+    ECHECK(myst_fdtable_get_sock(fdtable, sockfd, &sd, &sock));
+    ret = (*sd->sd_recvmmsg)(sd, sock, msgvec, vlen, flags, timeout);
+
+done:
+    return ret;
+}
+
 long myst_syscall_shutdown(int sockfd, int how)
 {
     long ret = 0;
@@ -3264,2859 +2942,4160 @@ void myst_dump_ramfs(void)
     myst_strarr_release(&paths);
 }
 
-#define BREAK(RET)           \
-    do                       \
-    {                        \
-        syscall_ret = (RET); \
-        goto done;           \
-    } while (0)
-
 typedef struct syscall_args
 {
     long n;
     long* params;
     myst_kstack_t* kstack;
+
+    /* resolved by _syscall() before calling the handler */
+    myst_thread_t* thread;
+    myst_td_t* target_td;
+    myst_td_t* crt_td;
 } syscall_args_t;
 
-/* ATTN: optimize _syscall() stack usage later */
+/* handles one syscall and returns its result */
+typedef long (*syscall_handler_t)(syscall_args_t* args);
+
+/* the syscall is forwarded to the target as is */
+#define SYSCALL_FORWARD 1
+
+/* the syscall is known but not supported (the kernel panics) */
+#define SYSCALL_UNHANDLED 2
+
+typedef struct syscall_entry
+{
+    syscall_handler_t handler;
+    uint32_t flags;
+} syscall_entry_t;
+
+static bool _set_thread_area_called;
+
+/*
+**==============================================================================
+**
+** syscall handlers:
+**
+**     Each handler decodes its own arguments from args->params, traces them
+**     with _strace() and returns its result through _return().
+**
+**==============================================================================
+*/
+
+/* ATTN: optimize the stack usage of the syscall handlers later */
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wstack-usage="
-static long _syscall(void* args_)
+
+static long _sys_myst_trace(syscall_args_t* args)
 {
-    syscall_args_t* args = (syscall_args_t*)args_;
     long n = args->n;
-    long* params = args->params;
-    long syscall_ret = 0;
-    long x1 = params[0];
-    long x2 = params[1];
-    long x3 = params[2];
-    long x4 = params[3];
-    long x5 = params[4];
-    long x6 = params[5];
-    static bool _set_thread_area_called;
-    myst_td_t* target_td = NULL;
-    myst_td_t* crt_td = NULL;
-    myst_thread_t* thread = NULL;
+    long x1 = args->params[0];
 
-    myst_times_enter_kernel(n);
+    const char* msg = (const char*)x1;
 
-    /* resolve the target-thread-descriptor and the crt-thread-descriptor */
-    if (_set_thread_area_called)
-    {
-        /* ---------- running C-runtime thread descriptor ---------- */
+    _strace(n, "msg=%s", msg);
 
-        /* get crt_td */
-        crt_td = myst_get_fsbase();
-        myst_assume(myst_valid_td(crt_td));
+    return _return(n, 0);
+}
 
-        /* get thread */
-        myst_assume(myst_tcall_get_tsd((uint64_t*)&thread) == 0);
-        myst_assume(myst_valid_thread(thread));
+static long _sys_myst_trace_ptr(syscall_args_t* args)
+{
+    long n = args->n;
+    long* params = args->params;
 
-        /* get target_td */
-        target_td = thread->target_td;
-        myst_assume(myst_valid_td(target_td));
+    printf(
+        "trace: %s: %lx %ld\n",
+        (const char*)params[0],
+        params[1],
+        params[1]);
+    return _return(n, 0);
+}
 
-        /* the syscall on the target thread descriptor */
-        myst_set_fsbase(target_td);
-    }
-    else
-    {
-        /* ---------- running target thread descriptor ---------- */
+static long _sys_myst_dump_stack(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
 
-        /* get target_td */
-        target_td = myst_get_fsbase();
-        myst_assume(myst_valid_td(target_td));
+    const void* stack = (void*)x1;
 
-        /* get thread */
-        myst_assume(myst_tcall_get_tsd((uint64_t*)&thread) == 0);
-        myst_assume(myst_valid_thread(thread));
+    _strace(n, NULL);
 
-        /* crt_td is null */
-    }
+    myst_dump_stack((void*)stack);
+    return _return(n, 0);
+}
 
-    // Process signals pending for this thread, if there is any.
-    myst_signal_process(thread);
+static long _sys_myst_dump_ehdr(syscall_args_t* args)
+{
+    long n = args->n;
+    long* params = args->params;
 
-    /* ---------- running target thread descriptor ---------- */
+    myst_dump_ehdr((void*)params[0]);
+    return _return(n, 0);
+}
 
-    myst_assume(target_td != NULL);
-    myst_assume(thread != NULL);
+static long _sys_myst_dump_argv(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int argc = (int)x1;
+    const char** argv = (const char**)x2;
+
+    printf("=== SYS_myst_dump_argv\n");
 
-    switch (n)
+    printf("argc=%d\n", argc);
+    printf("argv=%p\n", argv);
+
+    for (int i = 0; i < argc; i++)
     {
-        case SYS_myst_trace:
-        {
-            const char* msg = (const char*)x1;
+        printf("argv[%d]=%s\n", i, argv[i]);
+    }
 
-            _strace(n, "msg=%s", msg);
+    printf("argv[argc]=%p\n", argv[argc]);
 
-            BREAK(_return(n, 0));
-        }
-        case SYS_myst_trace_ptr:
-        {
-            printf(
-                "trace: %s: %lx %ld\n",
-                (const char*)params[0],
-                params[1],
-                params[1]);
-            BREAK(_return(n, 0));
-        }
-        case SYS_myst_dump_stack:
-        {
-            const void* stack = (void*)x1;
+    return _return(n, 0);
+}
 
-            _strace(n, NULL);
+static long _sys_myst_add_symbol_file(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            myst_dump_stack((void*)stack);
-            BREAK(_return(n, 0));
-        }
-        case SYS_myst_dump_ehdr:
-        {
-            myst_dump_ehdr((void*)params[0]);
-            BREAK(_return(n, 0));
-        }
-        case SYS_myst_dump_argv:
-        {
-            int argc = (int)x1;
-            const char** argv = (const char**)x2;
+    const char* path = (const char*)x1;
+    const void* text = (const void*)x2;
+    size_t text_size = (size_t)x3;
+    long ret = 0;
 
-            printf("=== SYS_myst_dump_argv\n");
+    _strace(
+        n,
+        "path=\"%s\" text=%p text_size=%zu\n",
+        path,
+        text,
+        text_size);
 
-            printf("argc=%d\n", argc);
-            printf("argv=%p\n", argv);
+    if (__myst_kernel_args.debug_symbols)
+        ret = myst_syscall_add_symbol_file(path, text, text_size);
 
-            for (int i = 0; i < argc; i++)
-            {
-                printf("argv[%d]=%s\n", i, argv[i]);
-            }
+    return _return(n, ret);
+}
 
-            printf("argv[argc]=%p\n", argv[argc]);
+static long _sys_myst_load_symbols(syscall_args_t* args)
+{
+    long n = args->n;
 
-            BREAK(_return(n, 0));
-        }
-        case SYS_myst_add_symbol_file:
-        {
-            const char* path = (const char*)x1;
-            const void* text = (const void*)x2;
-            size_t text_size = (size_t)x3;
-            long ret = 0;
+    long ret = 0;
 
-            _strace(
-                n,
-                "path=\"%s\" text=%p text_size=%zu\n",
-                path,
-                text,
-                text_size);
+    _strace(n, NULL);
 
-            if (__myst_kernel_args.debug_symbols)
-                ret = myst_syscall_add_symbol_file(path, text, text_size);
+    if (__myst_kernel_args.debug_symbols)
+        ret = myst_syscall_load_symbols();
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_myst_load_symbols:
-        {
-            long ret = 0;
+    return _return(n, ret);
+}
 
-            _strace(n, NULL);
+static long _sys_myst_unload_symbols(syscall_args_t* args)
+{
+    long n = args->n;
 
-            if (__myst_kernel_args.debug_symbols)
-                ret = myst_syscall_load_symbols();
+    long ret = 0;
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_myst_unload_symbols:
-        {
-            long ret = 0;
+    _strace(n, NULL);
 
-            _strace(n, NULL);
+    if (__myst_kernel_args.debug_symbols)
+        ret = myst_syscall_unload_symbols();
 
-            if (__myst_kernel_args.debug_symbols)
-                ret = myst_syscall_unload_symbols();
+    return _return(n, ret);
+}
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_myst_gen_creds:
-        {
-            _strace(n, NULL);
-            BREAK(_forward_syscall(MYST_TCALL_GEN_CREDS, params));
-        }
-        case SYS_myst_free_creds:
-        {
-            _strace(n, NULL);
-            BREAK(_forward_syscall(MYST_TCALL_FREE_CREDS, params));
-        }
-        case SYS_myst_gen_creds_ex:
-        {
-            _strace(n, NULL);
-            BREAK(_forward_syscall(MYST_TCALL_GEN_CREDS_EX, params));
-        }
-        case SYS_myst_verify_cert:
-        {
-            _strace(n, NULL);
-            BREAK(_forward_syscall(MYST_TCALL_VERIFY_CERT, params));
-        }
-        case SYS_myst_max_threads:
-        {
-            _strace(n, NULL);
-            BREAK(_return(n, __myst_kernel_args.max_threads));
-        }
-        case SYS_myst_poll_wake:
-        {
-            _strace(n, NULL);
-            BREAK(_return(n, myst_tcall_poll_wake()));
-        }
-#ifdef MYST_ENABLE_GCOV
-        case SYS_myst_gcov:
-        {
-            const char* func = (const char*)x1;
-            long* gcov_params = (long*)x2;
+static long _sys_myst_gen_creds(syscall_args_t* args)
+{
+    long n = args->n;
+    long* params = args->params;
 
-            _strace(n, "func=%s gcov_params=%p", func, gcov_params);
+    _strace(n, NULL);
+    return _forward_syscall(MYST_TCALL_GEN_CREDS, params);
+}
 
-            long ret = myst_gcov(func, gcov_params);
-            BREAK(_return(n, ret));
-        }
-#endif
-        case SYS_myst_unmap_on_exit:
-        {
-            void* ptr = (void*)x1;
-            size_t size = (size_t)x2;
-            myst_thread_t* process_thread = myst_find_process_thread(thread);
+static long _sys_myst_free_creds(syscall_args_t* args)
+{
+    long n = args->n;
+    long* params = args->params;
 
-            _strace(n, "ptr=%p, size=%zu", ptr, size);
+    _strace(n, NULL);
+    return _forward_syscall(MYST_TCALL_FREE_CREDS, params);
+}
 
-            BREAK(_return(
-                n, myst_syscall_unmap_on_exit(process_thread, ptr, size)));
-        }
-        case SYS_get_process_thread_stack:
-        {
-            _strace(n, NULL);
-            void** stack = (void**)x1;
-            size_t* stack_size = (size_t*)x2;
+static long _sys_myst_gen_creds_ex(syscall_args_t* args)
+{
+    long n = args->n;
+    long* params = args->params;
 
-            _strace(n, "stack=%p stack_size=%p", stack, stack_size);
+    _strace(n, NULL);
+    return _forward_syscall(MYST_TCALL_GEN_CREDS_EX, params);
+}
 
-            long ret = myst_syscall_get_process_thread_stack(stack, stack_size);
-            BREAK(_return(n, ret));
-        }
-        case SYS_read:
-        {
-            int fd = (int)x1;
-            void* buf = (void*)x2;
-            size_t count = (size_t)x3;
+static long _sys_myst_verify_cert(syscall_args_t* args)
+{
+    long n = args->n;
+    long* params = args->params;
 
-            _strace(n, "fd=%d buf=%p count=%zu", fd, buf, count);
+    _strace(n, NULL);
+    return _forward_syscall(MYST_TCALL_VERIFY_CERT, params);
+}
 
-            BREAK(_return(n, myst_syscall_read(fd, buf, count)));
-        }
-        case SYS_write:
-        {
-            int fd = (int)x1;
-            const void* buf = (const void*)x2;
-            size_t count = (size_t)x3;
+static long _sys_myst_max_threads(syscall_args_t* args)
+{
+    long n = args->n;
 
-            _strace(n, "fd=%d buf=%p count=%zu", fd, buf, count);
+    _strace(n, NULL);
+    return _return(n, __myst_kernel_args.max_threads);
+}
 
-            BREAK(_return(n, myst_syscall_write(fd, buf, count)));
-        }
-        case SYS_pread64:
-        {
-            int fd = (int)x1;
-            void* buf = (void*)x2;
-            size_t count = (size_t)x3;
-            off_t offset = (off_t)x4;
+static long _sys_myst_poll_wake(syscall_args_t* args)
+{
+    long n = args->n;
 
-            _strace(
-                n, "fd=%d buf=%p count=%zu offset=%ld", fd, buf, count, offset);
+    _strace(n, NULL);
+    return _return(n, myst_tcall_poll_wake());
+}
 
-            BREAK(_return(n, myst_syscall_pread(fd, buf, count, offset)));
-        }
-        case SYS_pwrite64:
-        {
-            int fd = (int)x1;
-            void* buf = (void*)x2;
-            size_t count = (size_t)x3;
-            off_t offset = (off_t)x4;
+#ifdef MYST_ENABLE_GCOV
+static long _sys_myst_gcov(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            _strace(
-                n, "fd=%d buf=%p count=%zu offset=%ld", fd, buf, count, offset);
+    const char* func = (const char*)x1;
+    long* gcov_params = (long*)x2;
 
-            BREAK(_return(n, myst_syscall_pwrite(fd, buf, count, offset)));
-        }
-        case SYS_open:
-        {
-            const char* path = (const char*)x1;
-            int flags = (int)x2;
-            mode_t mode = (mode_t)x3;
-            long ret;
+    _strace(n, "func=%s gcov_params=%p", func, gcov_params);
 
-            _strace(n, "path=\"%s\" flags=0%o mode=0%o", path, flags, mode);
+    long ret = myst_gcov(func, gcov_params);
+    return _return(n, ret);
+}
+#endif
 
-            ret = myst_syscall_open(path, flags, mode);
+static long _sys_myst_unmap_on_exit(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    myst_thread_t* thread = args->thread;
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_close:
-        {
-            int fd = (int)x1;
+    void* ptr = (void*)x1;
+    size_t size = (size_t)x2;
+    myst_thread_t* process_thread = myst_find_process_thread(thread);
 
-            _strace(n, "fd=%d", fd);
+    _strace(n, "ptr=%p, size=%zu", ptr, size);
 
-            BREAK(_return(n, myst_syscall_close(fd)));
-        }
-        case SYS_stat:
-        {
-            const char* pathname = (const char*)x1;
-            struct stat* statbuf = (struct stat*)x2;
+    return _return(
+        n, myst_syscall_unmap_on_exit(process_thread, ptr, size));
+}
 
-            _strace(n, "pathname=\"%s\" statbuf=%p", pathname, statbuf);
+static long _sys_get_process_thread_stack(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            BREAK(_return(n, myst_syscall_stat(pathname, statbuf)));
-        }
-        case SYS_fstat:
-        {
-            int fd = (int)x1;
-            void* statbuf = (void*)x2;
+    _strace(n, NULL);
+    void** stack = (void**)x1;
+    size_t* stack_size = (size_t*)x2;
 
-            _strace(n, "fd=%d statbuf=%p", fd, statbuf);
+    _strace(n, "stack=%p stack_size=%p", stack, stack_size);
 
-            BREAK(_return(n, myst_syscall_fstat(fd, statbuf)));
-        }
-        case SYS_lstat:
-        {
-            /* ATTN: remove this! */
-            const char* pathname = (const char*)x1;
-            struct stat* statbuf = (struct stat*)x2;
+    long ret = myst_syscall_get_process_thread_stack(stack, stack_size);
+    return _return(n, ret);
+}
 
-            _strace(n, "pathname=\"%s\" statbuf=%p", pathname, statbuf);
+static long _sys_read(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            BREAK(_return(n, myst_syscall_lstat(pathname, statbuf)));
-        }
-        case SYS_poll:
-        {
-            struct pollfd* fds = (struct pollfd*)x1;
-            nfds_t nfds = (nfds_t)x2;
-            int timeout = (int)x3;
-            long ret;
+    int fd = (int)x1;
+    void* buf = (void*)x2;
+    size_t count = (size_t)x3;
 
-            _strace(n, "fds=%p nfds=%ld timeout=%d", fds, nfds, timeout);
+    _strace(n, "fd=%d buf=%p count=%zu", fd, buf, count);
 
-            if (__myst_kernel_args.trace_syscalls && fds)
-            {
-                for (nfds_t i = 0; i < nfds; i++)
-                    myst_eprintf("fd=%d\n", fds[i].fd);
-            }
+    return _return(n, myst_syscall_read(fd, buf, count));
+}
 
-            ret = myst_syscall_poll(fds, nfds, timeout);
-            BREAK(_return(n, ret));
-        }
-        case SYS_lseek:
-        {
-            int fd = (int)x1;
-            off_t offset = (off_t)x2;
-            int whence = (int)x3;
+static long _sys_write(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            _strace(n, "fd=%d offset=%ld whence=%d", fd, offset, whence);
+    int fd = (int)x1;
+    const void* buf = (const void*)x2;
+    size_t count = (size_t)x3;
 
-            BREAK(_return(n, myst_syscall_lseek(fd, offset, whence)));
-        }
-        case SYS_mmap:
-        {
-            void* addr = (void*)x1;
-            size_t length = (size_t)x2;
-            int prot = (int)x3;
-            int flags = (int)x4;
-            int fd = (int)x5;
-            off_t offset = (off_t)x6;
-            void* ptr;
-            long ret = 0;
-
-            _strace(
-                n,
-                "addr=%lx length=%zu(%lx) prot=%d flags=%d fd=%d offset=%lu",
-                (long)addr,
-                length,
-                length,
-                prot,
-                flags,
-                fd,
-                offset);
+    _strace(n, "fd=%d buf=%p count=%zu", fd, buf, count);
 
-            ptr = myst_mmap(addr, length, prot, flags, fd, offset);
+    return _return(n, myst_syscall_write(fd, buf, count));
+}
 
-            if (ptr == MAP_FAILED || !ptr)
-            {
-                ret = -ENOMEM;
-            }
-            else
-            {
-                pid_t pid = myst_getpid();
-
-                if (myst_register_process_mapping(
-                        pid,
-                        ptr,
-                        length,
-                        // Linux ignores fd when the MAP_ANONYMOUS flag is
-                        // present
-                        flags & MAP_ANONYMOUS ? -1 : fd,
-                        offset,
-                        prot) != 0)
-                    myst_panic("failed to register process mapping");
-
-                ret = (long)ptr;
-            }
+static long _sys_pread64(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_mprotect:
-        {
-            const void* addr = (void*)x1;
-            const size_t length = (size_t)x2;
-            const int prot = (int)x3;
+    int fd = (int)x1;
+    void* buf = (void*)x2;
+    size_t count = (size_t)x3;
+    off_t offset = (off_t)x4;
 
-            _strace(
-                n,
-                "addr=%lx length=%zu(%lx) prot=%d",
-                (long)addr,
-                length,
-                length,
-                prot);
+    _strace(
+        n, "fd=%d buf=%p count=%zu offset=%ld", fd, buf, count, offset);
 
-            BREAK(_return(n, (long)myst_mprotect(addr, length, prot)));
-        }
-        case SYS_munmap:
-        {
-            void* addr = (void*)x1;
-            size_t length = (size_t)x2;
+    return _return(n, myst_syscall_pread(fd, buf, count, offset));
+}
 
-            _strace(n, "addr=%lx length=%zu(%lx)", (long)addr, length, length);
+static long _sys_pwrite64(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
 
-            // if the ummapped region overlaps the CRT thread descriptor, then
-            // postpone the unmap because unmapping now would invalidate the
-            // stack canary and would raise __stack_chk_fail(); this occurs
-            // when munmap() is called from __unmapself()
-            if (crt_td && addr && length)
-            {
-                const uint8_t* p = (const uint8_t*)crt_td;
-                const uint8_t* pend = p + sizeof(myst_td_t);
-                const uint8_t* q = (const uint8_t*)addr;
-                const uint8_t* qend = q + length;
-
-                if ((p >= q && p < qend) || (pend >= q && pend < qend))
-                {
-                    myst_thread_t* process_thread =
-                        myst_find_process_thread(thread);
-
-                    /* unmap this later when the thread exits */
-                    BREAK(_return(
-                        n,
-                        myst_syscall_unmap_on_exit(
-                            process_thread, addr, length)));
-                }
-            }
+    int fd = (int)x1;
+    void* buf = (void*)x2;
+    size_t count = (size_t)x3;
+    off_t offset = (off_t)x4;
 
-            BREAK(_return(n, (long)myst_munmap(addr, length)));
-        }
-        case SYS_brk:
-        {
-            void* addr = (void*)x1;
+    _strace(
+        n, "fd=%d buf=%p count=%zu offset=%ld", fd, buf, count, offset);
 
-            _strace(n, "addr=%lx", (long)addr);
+    return _return(n, myst_syscall_pwrite(fd, buf, count, offset));
+}
 
-            BREAK(_return(n, myst_syscall_brk(addr)));
-        }
-        case SYS_rt_sigaction:
-        {
-            int signum = (int)x1;
-            const posix_sigaction_t* act = (const posix_sigaction_t*)x2;
-            posix_sigaction_t* oldact = (posix_sigaction_t*)x3;
+static long _sys_open(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            _strace(n, "signum=%d act=%p oldact=%p", signum, act, oldact);
+    const char* path = (const char*)x1;
+    int flags = (int)x2;
+    mode_t mode = (mode_t)x3;
+    long ret;
 
-            long ret = myst_signal_sigaction(signum, act, oldact);
-            BREAK(_return(n, ret));
-        }
-        case SYS_rt_sigprocmask:
-        {
-            int how = (int)x1;
-            const sigset_t* set = (sigset_t*)x2;
-            sigset_t* oldset = (sigset_t*)x3;
+    _strace(n, "path=\"%s\" flags=0%o mode=0%o", path, flags, mode);
 
-            _strace(n, "how=%d set=%p oldset=%p", how, set, oldset);
+    ret = myst_syscall_open(path, flags, mode);
 
-            long ret = myst_signal_sigprocmask(how, set, oldset);
-            BREAK(_return(n, ret));
-        }
-        case SYS_rt_sigreturn:
-            break;
-        case SYS_ioctl:
-        {
-            int fd = (int)x1;
-            unsigned long request = (unsigned long)x2;
-            long arg = (long)x3;
-            int iarg = -1;
+    return _return(n, ret);
+}
 
-            if (request == FIONBIO && arg)
-                iarg = *(int*)arg;
+static long _sys_close(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
 
-            _strace(
-                n,
-                "fd=%d request=0x%lx arg=%lx iarg=%d",
-                fd,
-                request,
-                arg,
-                iarg);
+    int fd = (int)x1;
 
-            BREAK(_return(n, myst_syscall_ioctl(fd, request, arg)));
-        }
-        case SYS_readv:
-        {
-            int fd = (int)x1;
-            const struct iovec* iov = (const struct iovec*)x2;
-            int iovcnt = (int)x3;
+    _strace(n, "fd=%d", fd);
 
-            _strace(n, "fd=%d iov=%p iovcnt=%d", fd, iov, iovcnt);
+    return _return(n, myst_syscall_close(fd));
+}
 
-            BREAK(_return(n, myst_syscall_readv(fd, iov, iovcnt)));
-        }
-        case SYS_writev:
-        {
-            int fd = (int)x1;
-            const struct iovec* iov = (const struct iovec*)x2;
-            int iovcnt = (int)x3;
+static long _sys_stat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            _strace(n, "fd=%d iov=%p iovcnt=%d", fd, iov, iovcnt);
+    const char* pathname = (const char*)x1;
+    struct stat* statbuf = (struct stat*)x2;
 
-            BREAK(_return(n, myst_syscall_writev(fd, iov, iovcnt)));
-        }
-        case SYS_access:
-        {
-            const char* pathname = (const char*)x1;
-            int mode = (int)x2;
+    _strace(n, "pathname=\"%s\" statbuf=%p", pathname, statbuf);
 
-            _strace(n, "pathname=\"%s\" mode=%d", pathname, mode);
+    return _return(n, myst_syscall_stat(pathname, statbuf));
+}
 
-            BREAK(_return(n, myst_syscall_access(pathname, mode)));
-        }
-        case SYS_pipe:
-        {
-            int* pipefd = (int*)x1;
+static long _sys_fstat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            _strace(n, "pipefd=%p flags=%0o", pipefd, 0);
+    int fd = (int)x1;
+    void* statbuf = (void*)x2;
 
-            BREAK(_return(n, myst_syscall_pipe2(pipefd, 0)));
-        }
-        case SYS_select:
-        {
-            int nfds = (int)x1;
-            fd_set* rfds = (fd_set*)x2;
-            fd_set* wfds = (fd_set*)x3;
-            fd_set* efds = (fd_set*)x4;
-            struct timeval* timeout = (struct timeval*)x5;
-            long ret;
-
-            _strace(
-                n,
-                "nfds=%d rfds=%p wfds=%p xfds=%p timeout=%p",
-                nfds,
-                rfds,
-                wfds,
-                efds,
-                timeout);
-
-            ret = myst_syscall_select(nfds, rfds, wfds, efds, timeout);
-            BREAK(_return(n, ret));
-        }
-        case SYS_sched_yield:
-        {
-            _strace(n, NULL);
+    _strace(n, "fd=%d statbuf=%p", fd, statbuf);
 
-            BREAK(_return(n, myst_syscall_sched_yield()));
-        }
-        case SYS_mremap:
-        {
-            void* old_address = (void*)x1;
-            size_t old_size = (size_t)x2;
-            size_t new_size = (size_t)x3;
-            int flags = (int)x4;
-            void* new_address = (void*)x5;
-            long ret;
-
-            _strace(
-                n,
-                "old_address=%p "
-                "old_size=%zu "
-                "new_size=%zu "
-                "flags=%d "
-                "new_address=%p ",
-                old_address,
-                old_size,
-                new_size,
-                flags,
-                new_address);
-
-            ret = (long)myst_mremap(
-                old_address, old_size, new_size, flags, new_address);
-
-            BREAK(_return(n, ret));
-        }
-        case SYS_msync:
-        {
-            void* addr = (void*)x1;
-            size_t length = (size_t)x2;
-            int flags = (int)x3;
+    return _return(n, myst_syscall_fstat(fd, statbuf));
+}
 
-            _strace(n, "addr=%p length=%zu flags=%d ", addr, length, flags);
+static long _sys_lstat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            BREAK(_return(n, myst_msync(addr, length, flags)));
-        }
-        case SYS_mincore:
-            /* ATTN: hook up implementation */
-            break;
-        case SYS_madvise:
-        {
-            void* addr = (void*)x1;
-            size_t length = (size_t)x2;
-            int advice = (int)x3;
+    /* ATTN: remove this! */
+    const char* pathname = (const char*)x1;
+    struct stat* statbuf = (struct stat*)x2;
 
-            _strace(n, "addr=%p length=%zu advice=%d", addr, length, advice);
+    _strace(n, "pathname=\"%s\" statbuf=%p", pathname, statbuf);
 
-            BREAK(_return(n, 0));
-        }
-        case SYS_shmget:
-            break;
-        case SYS_shmat:
-            break;
-        case SYS_shmctl:
-            break;
-        case SYS_dup:
-        {
-            int oldfd = (int)x1;
-            long ret;
+    return _return(n, myst_syscall_lstat(pathname, statbuf));
+}
 
-            _strace(n, "oldfd=%d", oldfd);
+static long _sys_poll(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            ret = myst_syscall_dup(oldfd);
-            BREAK(_return(n, ret));
-        }
-        case SYS_dup2:
-        {
-            int oldfd = (int)x1;
-            int newfd = (int)x2;
-            long ret;
+    struct pollfd* fds = (struct pollfd*)x1;
+    nfds_t nfds = (nfds_t)x2;
+    int timeout = (int)x3;
+    long ret;
 
-            _strace(n, "oldfd=%d newfd=%d", oldfd, newfd);
+    _strace(n, "fds=%p nfds=%ld timeout=%d", fds, nfds, timeout);
 
-            ret = myst_syscall_dup2(oldfd, newfd);
-            BREAK(_return(n, ret));
-        }
-        case SYS_dup3:
-        {
-            int oldfd = (int)x1;
-            int newfd = (int)x2;
-            int flags = (int)x3;
-            long ret;
+    if (__myst_kernel_args.trace_syscalls && fds)
+    {
+        for (nfds_t i = 0; i < nfds; i++)
+            myst_eprintf("fd=%d\n", fds[i].fd);
+    }
 
-            _strace(n, "oldfd=%d newfd=%d flags=%o", oldfd, newfd, flags);
+    ret = myst_syscall_poll(fds, nfds, timeout);
+    return _return(n, ret);
+}
 
-            ret = myst_syscall_dup3(oldfd, newfd, flags);
-            BREAK(_return(n, ret));
-        }
-        case SYS_pause:
-            break;
-        case SYS_nanosleep:
-        {
-            const struct timespec* req = (const struct timespec*)x1;
-            struct timespec* rem = (struct timespec*)x2;
+static long _sys_lseek(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            _strace(n, "req=%p rem=%p", req, rem);
+    int fd = (int)x1;
+    off_t offset = (off_t)x2;
+    int whence = (int)x3;
 
-            BREAK(_return(n, myst_syscall_nanosleep(req, rem)));
-        }
-        case SYS_myst_run_itimer:
-        {
-            _strace(n, NULL);
-            BREAK(_return(n, myst_syscall_run_itimer()));
-        }
-        case SYS_myst_start_shell:
-        {
-            _strace(n, NULL);
+    _strace(n, "fd=%d offset=%ld whence=%d", fd, offset, whence);
 
-            if (__myst_kernel_args.shell_mode)
-                myst_start_shell("\nMystikos shell (syscall)\n");
+    return _return(n, myst_syscall_lseek(fd, offset, whence));
+}
 
-            BREAK(_return(n, 0));
-        }
-        case SYS_getitimer:
-        {
-            int which = (int)x1;
-            struct itimerval* curr_value = (void*)x2;
+static long _sys_mmap(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+    long x6 = args->params[5];
+
+    void* addr = (void*)x1;
+    size_t length = (size_t)x2;
+    int prot = (int)x3;
+    int flags = (int)x4;
+    int fd = (int)x5;
+    off_t offset = (off_t)x6;
+    void* ptr;
+    long ret = 0;
 
-            _strace(n, "which=%d curr_value=%p", which, curr_value);
+    _strace(
+        n,
+        "addr=%lx length=%zu(%lx) prot=%d flags=%d fd=%d offset=%lu",
+        (long)addr,
+        length,
+        length,
+        prot,
+        flags,
+        fd,
+        offset);
 
-            BREAK(_return(n, myst_syscall_getitimer(which, curr_value)));
-        }
-        case SYS_alarm:
-            break;
-        case SYS_setitimer:
-        {
-            int which = (int)x1;
-            const struct itimerval* new_value = (void*)x2;
-            struct itimerval* old_value = (void*)x3;
+    ptr = myst_mmap(addr, length, prot, flags, fd, offset);
 
-            _strace(
-                n,
-                "which=%d new_value=%p old_value=%p",
-                which,
-                new_value,
-                old_value);
+    if (ptr == MAP_FAILED || !ptr)
+    {
+        ret = -ENOMEM;
+    }
+    else if ((long)ptr < 0)
+    {
+        ret = (long)ptr;
+    }
+    else
+    {
+        pid_t pid = myst_getpid();
 
-            BREAK(_return(
-                n, myst_syscall_setitimer(which, new_value, old_value)));
-        }
-        case SYS_getpid:
-        {
-            _strace(n, NULL);
-            BREAK(_return(n, myst_getpid()));
-        }
-        case SYS_clone:
-        {
-            /* unsupported: using SYS_myst_clone instead */
-            break;
-        }
-        case SYS_myst_clone:
-        {
-            long* args = (long*)x1;
-            int (*fn)(void*) = (void*)args[0];
-            void* child_stack = (void*)args[1];
-            int flags = (int)args[2];
-            void* arg = (void*)args[3];
-            pid_t* ptid = (pid_t*)args[4];
-            void* newtls = (void*)args[5];
-            pid_t* ctid = (void*)args[6];
-
-            _strace(
-                n,
-                "fn=%p "
-                "child_stack=%p "
-                "flags=%x "
-                "arg=%p "
-                "ptid=%p "
-                "newtls=%p "
-                "ctid=%p",
-                fn,
-                child_stack,
-                flags,
-                arg,
-                ptid,
-                newtls,
-                ctid);
-
-            long ret = myst_syscall_clone(
-                fn, child_stack, flags, arg, ptid, newtls, ctid);
-
-            if ((flags & CLONE_VFORK))
-            {
-                // ATTN: give the thread a little time to start to avoid a
-                // syncyhronization error. This suppresses a failure in the
-                // popen test. This should be investigated later.
-                myst_sleep_msec(5);
-            }
+        if (myst_register_process_mapping(
+                pid,
+                ptr,
+                length,
+                // Linux ignores fd when the MAP_ANONYMOUS flag is
+                // present
+                flags & MAP_ANONYMOUS ? -1 : fd,
+                offset,
+                prot) != 0)
+            myst_panic("failed to register process mapping");
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_myst_get_fork_info:
-        {
-            myst_fork_info_t* arg = (myst_fork_info_t*)x1;
+        ret = (long)ptr;
+    }
 
-            _strace(n, NULL);
+    return _return(n, ret);
+}
 
-            long ret = myst_syscall_get_fork_info(thread, arg);
-            BREAK(_return(n, ret));
-        }
-        case SYS_fork_wait_exec_exit:
-        {
-            int ret = 0;
-            _strace(n, NULL);
-            myst_futex_wait(&thread->fork_exec_futex_wait, 0, NULL);
-            BREAK(_return(n, ret));
-        }
-        case SYS_myst_kill_wait_child_forks:
-        {
-            long ret = 0;
-            myst_thread_t* process = myst_find_process_thread(thread);
+static long _sys_mprotect(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    const void* addr = (void*)x1;
+    const size_t length = (size_t)x2;
+    const int prot = (int)x3;
+
+    _strace(
+        n,
+        "addr=%lx length=%zu(%lx) prot=%d",
+        (long)addr,
+        length,
+        length,
+        prot);
+
+    return _return(n, (long)myst_mprotect(addr, length, prot));
+}
 
-            _strace(n, NULL);
+static long _sys_munmap(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    myst_thread_t* thread = args->thread;
+    myst_td_t* crt_td = args->crt_td;
 
-            kill_child_fork_processes(process);
+    void* addr = (void*)x1;
+    size_t length = (size_t)x2;
 
-            while (myst_have_child_forked_processes(process))
-            {
-                myst_sleep_msec(100);
-            }
+    _strace(n, "addr=%lx length=%zu(%lx)", (long)addr, length, length);
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_fork:
-            break;
-        case SYS_vfork:
-            break;
-        case SYS_execve:
-        {
-            const char* filename = (const char*)x1;
-            char** argv = (char**)x2;
-            char** envp = (char**)x3;
+    // if the ummapped region overlaps the CRT thread descriptor, then
+    // postpone the unmap because unmapping now would invalidate the
+    // stack canary and would raise __stack_chk_fail(); this occurs
+    // when munmap() is called from __unmapself()
+    if (crt_td && addr && length)
+    {
+        const uint8_t* p = (const uint8_t*)crt_td;
+        const uint8_t* pend = p + sizeof(myst_td_t);
+        const uint8_t* q = (const uint8_t*)addr;
+        const uint8_t* qend = q + length;
 
-            _strace(n, "filename=%s argv=%p envp=%p", filename, argv, envp);
+        if ((p >= q && p < qend) || (pend >= q && pend < qend))
+        {
+            myst_thread_t* process_thread =
+                myst_find_process_thread(thread);
 
-            long ret = myst_syscall_execve(filename, argv, envp);
-            BREAK(_return(n, ret));
+            /* unmap this later when the thread exits */
+            return _return(
+                n,
+                myst_syscall_unmap_on_exit(
+                    process_thread, addr, length));
         }
-        case SYS_exit:
-        {
-            const int status = (int)x1;
-            myst_thread_t* thread = myst_thread_self();
-            myst_thread_t* process = myst_find_process_thread(thread);
+    }
 
-            _strace(n, "status=%d", status);
+    return _return(n, (long)myst_munmap(addr, length));
+}
 
-            if (!thread || thread->magic != MYST_THREAD_MAGIC)
-                myst_panic("unexpected");
+static long _sys_brk(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
 
-            process->exit_status = status;
+    void* addr = (void*)x1;
 
-            /* the kstack is freed after the long-jump below */
-            thread->kstack = args->kstack;
+    _strace(n, "addr=%lx", (long)addr);
 
-            /* If this process was created as part of a fork() and the parent is
-             * running in wait-exec mode, signal that thread for wakeup */
-            if (process->clone.flags & CLONE_VFORK)
-            {
-                myst_fork_exec_futex_wake(thread);
-            }
+    return _return(n, myst_syscall_brk(addr));
+}
 
-            /* jump back to myst_enter_kernel() */
-            myst_longjmp(&thread->jmpbuf, 1);
+static long _sys_rt_sigaction(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            /* unreachable */
-            break;
-        }
-        case SYS_wait4:
-        {
-            pid_t pid = (pid_t)x1;
-            int* wstatus = (int*)x2;
-            int options = (int)x3;
-            struct rusage* rusage = (struct rusage*)x4;
-            long ret;
-
-            ret = myst_syscall_wait4(pid, wstatus, options, rusage);
-            BREAK(_return(n, ret));
-        }
-        case SYS_kill:
-        {
-            int pid = (int)x1;
-            int sig = (int)x2;
+    int signum = (int)x1;
+    const posix_sigaction_t* act = (const posix_sigaction_t*)x2;
+    posix_sigaction_t* oldact = (posix_sigaction_t*)x3;
 
-            _strace(n, "pid=%d sig=%d", pid, sig);
+    _strace(n, "signum=%d act=%p oldact=%p", signum, act, oldact);
 
-            long ret = myst_syscall_kill(pid, sig);
-            BREAK(_return(n, ret));
-        }
-        case SYS_uname:
-        {
-            struct utsname* buf = (struct utsname*)x1;
+    long ret = myst_signal_sigaction(signum, act, oldact);
+    return _return(n, ret);
+}
 
-            BREAK(_return(n, myst_syscall_uname(buf)));
-        }
-        case SYS_semget:
-            break;
-        case SYS_semop:
-            break;
-        case SYS_semctl:
-            break;
-        case SYS_shmdt:
-            break;
-        case SYS_msgget:
-            break;
-        case SYS_msgsnd:
-            break;
-        case SYS_msgrcv:
-            break;
-        case SYS_msgctl:
-            break;
-        case SYS_fcntl:
-        {
-            int fd = (int)x1;
-            int cmd = (int)x2;
-            long arg = (long)x3;
-            long ret;
+static long _sys_rt_sigprocmask(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            const char* cmdstr = _fcntl_cmdstr(cmd);
-            _strace(n, "fd=%d cmd=%d(%s) arg=0%lo", fd, cmd, cmdstr, arg);
+    int how = (int)x1;
+    const sigset_t* set = (sigset_t*)x2;
+    sigset_t* oldset = (sigset_t*)x3;
 
-            ret = myst_syscall_fcntl(fd, cmd, arg);
-            BREAK(_return(n, ret));
-        }
-        case SYS_flock:
-        {
-            int fd = (int)x1;
-            int cmd = (int)x2;
+    _strace(n, "how=%d set=%p oldset=%p", how, set, oldset);
 
-            _strace(n, "fd=%d cmd=%d", fd, cmd);
+    long ret = myst_signal_sigprocmask(how, set, oldset);
+    return _return(n, ret);
+}
 
-            BREAK(_return(n, 0));
-        }
-        case SYS_fsync:
-        {
-            int fd = (int)x1;
+static long _sys_ioctl(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    int fd = (int)x1;
+    unsigned long request = (unsigned long)x2;
+    long arg = (long)x3;
+    int iarg = -1;
+
+    if (request == FIONBIO && arg)
+        iarg = *(int*)arg;
+
+    _strace(
+        n,
+        "fd=%d request=0x%lx arg=%lx iarg=%d",
+        fd,
+        request,
+        arg,
+        iarg);
+
+    return _return(n, myst_syscall_ioctl(fd, request, arg));
+}
 
-            _strace(n, "fd=%d", fd);
+static long _sys_readv(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            BREAK(_return(n, myst_syscall_fsync(fd)));
-        }
-        case SYS_fdatasync:
-        {
-            int fd = (int)x1;
+    int fd = (int)x1;
+    const struct iovec* iov = (const struct iovec*)x2;
+    int iovcnt = (int)x3;
 
-            _strace(n, "fd=%d", fd);
+    _strace(n, "fd=%d iov=%p iovcnt=%d", fd, iov, iovcnt);
 
-            BREAK(_return(n, myst_syscall_fdatasync(fd)));
-        }
-        case SYS_truncate:
-        {
-            const char* path = (const char*)x1;
-            off_t length = (off_t)x2;
+    return _return(n, myst_syscall_readv(fd, iov, iovcnt));
+}
 
-            _strace(n, "path=\"%s\" length=%ld", path, length);
+static long _sys_writev(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            BREAK(_return(n, myst_syscall_truncate(path, length)));
-        }
-        case SYS_ftruncate:
-        {
-            int fd = (int)x1;
-            off_t length = (off_t)x2;
+    int fd = (int)x1;
+    const struct iovec* iov = (const struct iovec*)x2;
+    int iovcnt = (int)x3;
 
-            _strace(n, "fd=%d length=%ld", fd, length);
+    _strace(n, "fd=%d iov=%p iovcnt=%d", fd, iov, iovcnt);
 
-            BREAK(_return(n, myst_syscall_ftruncate(fd, length)));
-        }
-        case SYS_getdents:
-            break;
-        case SYS_getcwd:
-        {
-            char* buf = (char*)x1;
-            size_t size = (size_t)x2;
+    return _return(n, myst_syscall_writev(fd, iov, iovcnt));
+}
 
-            _strace(n, "buf=%p size=%zu", buf, size);
+static long _sys_access(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            BREAK(_return(n, myst_syscall_getcwd(buf, size)));
-        }
-        case SYS_chdir:
-        {
-            const char* path = (const char*)x1;
+    const char* pathname = (const char*)x1;
+    int mode = (int)x2;
 
-            _strace(n, "path=\"%s\"", path);
+    _strace(n, "pathname=\"%s\" mode=%d", pathname, mode);
 
-            BREAK(_return(n, myst_syscall_chdir(path)));
-        }
-        case SYS_fchdir:
-        {
-            int fd = (int)x1;
+    return _return(n, myst_syscall_access(pathname, mode));
+}
 
-            _strace(n, "fd=%d", fd);
+static long _sys_pipe(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
 
-            BREAK(_return(n, myst_syscall_fchdir(fd)));
-        }
-        case SYS_rename:
-        {
-            const char* oldpath = (const char*)x1;
-            const char* newpath = (const char*)x2;
+    int* pipefd = (int*)x1;
 
-            _strace(n, "oldpath=\"%s\" newpath=\"%s\"", oldpath, newpath);
+    _strace(n, "pipefd=%p flags=%0o", pipefd, 0);
 
-            BREAK(_return(n, myst_syscall_rename(oldpath, newpath)));
-        }
-        case SYS_mkdir:
-        {
-            const char* pathname = (const char*)x1;
-            mode_t mode = (mode_t)x2;
+    return _return(n, myst_syscall_pipe2(pipefd, 0));
+}
 
-            _strace(n, "pathname=\"%s\" mode=0%o", pathname, mode);
+static long _sys_select(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+
+    int nfds = (int)x1;
+    fd_set* rfds = (fd_set*)x2;
+    fd_set* wfds = (fd_set*)x3;
+    fd_set* efds = (fd_set*)x4;
+    struct timeval* timeout = (struct timeval*)x5;
+    long ret;
 
-            BREAK(_return(n, myst_syscall_mkdir(pathname, mode)));
-        }
-        case SYS_rmdir:
-        {
-            const char* pathname = (const char*)x1;
+    _strace(
+        n,
+        "nfds=%d rfds=%p wfds=%p xfds=%p timeout=%p",
+        nfds,
+        rfds,
+        wfds,
+        efds,
+        timeout);
+
+    ret = myst_syscall_select(nfds, rfds, wfds, efds, timeout);
+    return _return(n, ret);
+}
 
-            _strace(n, "pathname=\"%s\"", pathname);
+static long _sys_sched_yield(syscall_args_t* args)
+{
+    long n = args->n;
 
-            BREAK(_return(n, myst_syscall_rmdir(pathname)));
-        }
-        case SYS_creat:
-        {
-            const char* pathname = (const char*)x1;
-            mode_t mode = (mode_t)x2;
+    _strace(n, NULL);
 
-            _strace(n, "pathname=\"%s\" mode=%x", pathname, mode);
+    return _return(n, myst_syscall_sched_yield());
+}
 
-            BREAK(_return(n, myst_syscall_creat(pathname, mode)));
-        }
-        case SYS_link:
-        {
-            const char* oldpath = (const char*)x1;
-            const char* newpath = (const char*)x2;
+static long _sys_mremap(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+
+    void* old_address = (void*)x1;
+    size_t old_size = (size_t)x2;
+    size_t new_size = (size_t)x3;
+    int flags = (int)x4;
+    void* new_address = (void*)x5;
+    long ret;
 
-            _strace(n, "oldpath=\"%s\" newpath=\"%s\"", oldpath, newpath);
+    _strace(
+        n,
+        "old_address=%p "
+        "old_size=%zu "
+        "new_size=%zu "
+        "flags=%d "
+        "new_address=%p ",
+        old_address,
+        old_size,
+        new_size,
+        flags,
+        new_address);
+
+    ret = (long)myst_mremap(
+        old_address, old_size, new_size, flags, new_address);
+
+    return _return(n, ret);
+}
 
-            BREAK(_return(n, myst_syscall_link(oldpath, newpath)));
-        }
-        case SYS_unlink:
-        {
-            const char* pathname = (const char*)x1;
+static long _sys_msync(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            _strace(n, "pathname=\"%s\"", pathname);
+    void* addr = (void*)x1;
+    size_t length = (size_t)x2;
+    int flags = (int)x3;
 
-            BREAK(_return(n, myst_syscall_unlink(pathname)));
-        }
-        case SYS_symlink:
-        {
-            const char* target = (const char*)x1;
-            const char* linkpath = (const char*)x2;
+    _strace(n, "addr=%p length=%zu flags=%d ", addr, length, flags);
 
-            _strace(n, "target=\"%s\" linkpath=\"%s\"", target, linkpath);
+    return _return(n, myst_msync(addr, length, flags));
+}
 
-            BREAK(_return(n, myst_syscall_symlink(target, linkpath)));
-        }
-        case SYS_readlink:
-        {
-            const char* pathname = (const char*)x1;
-            char* buf = (char*)x2;
-            size_t bufsiz = (size_t)x3;
+static long _sys_madvise(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            _strace(
-                n, "pathname=\"%s\" buf=%p bufsiz=%zu", pathname, buf, bufsiz);
+    void* addr = (void*)x1;
+    size_t length = (size_t)x2;
+    int advice = (int)x3;
 
-            BREAK(_return(n, myst_syscall_readlink(pathname, buf, bufsiz)));
-        }
-        case SYS_chmod:
-        {
-            const char* pathname = (const char*)x1;
-            mode_t mode = (mode_t)x2;
+    _strace(n, "addr=%p length=%zu advice=%d", addr, length, advice);
 
-            _strace(n, "pathname=\"%s\" mode=%o", pathname, mode);
+    return _return(n, (long)myst_madvise(addr, length, advice));
+}
 
-            BREAK(_return(n, myst_syscall_chmod(pathname, mode)));
-        }
-        case SYS_fchmod:
-        {
-            int fd = (int)x1;
-            mode_t mode = (mode_t)x2;
+static long _sys_dup(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
 
-            _strace(n, "fd=%d mode=%o", fd, mode);
+    int oldfd = (int)x1;
+    long ret;
 
-            BREAK(_return(n, myst_syscall_fchmod(fd, mode)));
-        }
-        case SYS_chown:
-        {
-            const char* pathname = (const char*)x1;
-            uid_t owner = (uid_t)x2;
-            gid_t group = (gid_t)x3;
+    _strace(n, "oldfd=%d", oldfd);
 
-            _strace(n, "pathname=%s owner=%u group=%u", pathname, owner, group);
+    ret = myst_syscall_dup(oldfd);
+    return _return(n, ret);
+}
 
-            BREAK(_return(n, myst_syscall_chown(pathname, owner, group)));
-        }
-        case SYS_fchown:
-        {
-            int fd = (int)x1;
-            uid_t owner = (uid_t)x2;
-            gid_t group = (gid_t)x3;
+static long _sys_dup2(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int oldfd = (int)x1;
+    int newfd = (int)x2;
+    long ret;
+
+    _strace(n, "oldfd=%d newfd=%d", oldfd, newfd);
+
+    ret = myst_syscall_dup2(oldfd, newfd);
+    return _return(n, ret);
+}
+
+static long _sys_dup3(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    int oldfd = (int)x1;
+    int newfd = (int)x2;
+    int flags = (int)x3;
+    long ret;
+
+    _strace(n, "oldfd=%d newfd=%d flags=%o", oldfd, newfd, flags);
+
+    ret = myst_syscall_dup3(oldfd, newfd, flags);
+    return _return(n, ret);
+}
+
+static long _sys_nanosleep(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    const struct timespec* req = (const struct timespec*)x1;
+    struct timespec* rem = (struct timespec*)x2;
+
+    _strace(n, "req=%p rem=%p", req, rem);
+
+    return _return(n, myst_syscall_nanosleep(req, rem));
+}
+
+static long _sys_myst_run_itimer(syscall_args_t* args)
+{
+    long n = args->n;
+
+    _strace(n, NULL);
+    return _return(n, myst_syscall_run_itimer());
+}
+
+static long _sys_myst_run_msync_flusher(syscall_args_t* args)
+{
+    long n = args->n;
+
+    _strace(n, NULL);
+    return _return(n, myst_syscall_run_msync_flusher());
+}
+
+static long _sys_myst_run_aio_worker(syscall_args_t* args)
+{
+    long n = args->n;
+
+    _strace(n, NULL);
+    return _return(n, myst_syscall_run_aio_worker());
+}
+
+static long _sys_myst_get_clock_page(syscall_args_t* args)
+{
+    long n = args->n;
+
+    _strace(n, NULL);
+    return _return(n, (long)__myst_kernel_args.clock_page);
+}
+
+static long _sys_myst_start_shell(syscall_args_t* args)
+{
+    long n = args->n;
+
+    _strace(n, NULL);
+
+    if (__myst_kernel_args.shell_mode)
+        myst_start_shell("\nMystikos shell (syscall)\n");
+
+    return _return(n, 0);
+}
+
+static long _sys_getitimer(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int which = (int)x1;
+    struct itimerval* curr_value = (void*)x2;
+
+    _strace(n, "which=%d curr_value=%p", which, curr_value);
+
+    return _return(n, myst_syscall_getitimer(which, curr_value));
+}
+
+static long _sys_setitimer(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    int which = (int)x1;
+    const struct itimerval* new_value = (void*)x2;
+    struct itimerval* old_value = (void*)x3;
+
+    _strace(
+        n,
+        "which=%d new_value=%p old_value=%p",
+        which,
+        new_value,
+        old_value);
+
+    return _return(
+        n, myst_syscall_setitimer(which, new_value, old_value));
+}
+
+static long _sys_getpid(syscall_args_t* args)
+{
+    long n = args->n;
+
+    _strace(n, NULL);
+    return _return(n, myst_getpid());
+}
+
+static long _sys_myst_clone(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    long* clone_args = (long*)x1;
+    int (*fn)(void*) = (void*)clone_args[0];
+    void* child_stack = (void*)clone_args[1];
+    int flags = (int)clone_args[2];
+    void* arg = (void*)clone_args[3];
+    pid_t* ptid = (pid_t*)clone_args[4];
+    void* newtls = (void*)clone_args[5];
+    pid_t* ctid = (void*)clone_args[6];
+
+    _strace(
+        n,
+        "fn=%p "
+        "child_stack=%p "
+        "flags=%x "
+        "arg=%p "
+        "ptid=%p "
+        "newtls=%p "
+        "ctid=%p",
+        fn,
+        child_stack,
+        flags,
+        arg,
+        ptid,
+        newtls,
+        ctid);
+
+    long ret = myst_syscall_clone(
+        fn, child_stack, flags, arg, ptid, newtls, ctid);
+
+    if ((flags & CLONE_VFORK))
+    {
+        // ATTN: give the thread a little time to start to avoid a
+        // syncyhronization error. This suppresses a failure in the
+        // popen test. This should be investigated later.
+        myst_sleep_msec(5);
+    }
+
+    return _return(n, ret);
+}
+
+static long _sys_myst_get_fork_info(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    myst_thread_t* thread = args->thread;
+
+    myst_fork_info_t* arg = (myst_fork_info_t*)x1;
+
+    _strace(n, NULL);
+
+    long ret = myst_syscall_get_fork_info(thread, arg);
+    return _return(n, ret);
+}
+
+static long _sys_fork_wait_exec_exit(syscall_args_t* args)
+{
+    long n = args->n;
+    myst_thread_t* thread = args->thread;
+
+    int ret = 0;
+    _strace(n, NULL);
+    myst_futex_wait(&thread->fork_exec_futex_wait, 0, NULL);
+    return _return(n, ret);
+}
+
+static long _sys_myst_kill_wait_child_forks(syscall_args_t* args)
+{
+    long n = args->n;
+    myst_thread_t* thread = args->thread;
+
+    long ret = 0;
+    myst_thread_t* process = myst_find_process_thread(thread);
+
+    _strace(n, NULL);
+
+    kill_child_fork_processes(process);
+
+    while (myst_have_child_forked_processes(process))
+    {
+        myst_sleep_msec(100);
+    }
+
+    return _return(n, ret);
+}
+
+static long _sys_execve(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    const char* filename = (const char*)x1;
+    char** argv = (char**)x2;
+    char** envp = (char**)x3;
+
+    _strace(n, "filename=%s argv=%p envp=%p", filename, argv, envp);
+
+    long ret = myst_syscall_execve(filename, argv, envp);
+    return _return(n, ret);
+}
+
+static long _sys_exit(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    const int status = (int)x1;
+    myst_thread_t* thread = myst_thread_self();
+    myst_thread_t* process = myst_find_process_thread(thread);
+
+    _strace(n, "status=%d", status);
+
+    if (!thread || thread->magic != MYST_THREAD_MAGIC)
+        myst_panic("unexpected");
+
+    process->exit_status = status;
+
+    /* the kstack is freed after the long-jump below */
+    thread->kstack = args->kstack;
+
+    /* If this process was created as part of a fork() and the parent is
+     * running in wait-exec mode, signal that thread for wakeup */
+    if (process->clone.flags & CLONE_VFORK)
+    {
+        myst_fork_exec_futex_wake(thread);
+    }
+
+    /* jump back to myst_enter_kernel() */
+    myst_longjmp(&thread->jmpbuf, 1);
+
+    /* unreachable */
+    return 0;
+}
+
+static long _sys_wait4(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    pid_t pid = (pid_t)x1;
+    int* wstatus = (int*)x2;
+    int options = (int)x3;
+    struct rusage* rusage = (struct rusage*)x4;
+    long ret;
+
+    ret = myst_syscall_wait4(pid, wstatus, options, rusage);
+    return _return(n, ret);
+}
+
+static long _sys_kill(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int pid = (int)x1;
+    int sig = (int)x2;
+
+    _strace(n, "pid=%d sig=%d", pid, sig);
+
+    long ret = myst_syscall_kill(pid, sig);
+    return _return(n, ret);
+}
+
+static long _sys_uname(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    struct utsname* buf = (struct utsname*)x1;
+
+    return _return(n, myst_syscall_uname(buf));
+}
+
+static long _sys_fcntl(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    int fd = (int)x1;
+    int cmd = (int)x2;
+    long arg = (long)x3;
+    long ret;
+
+    const char* cmdstr = _fcntl_cmdstr(cmd);
+    _strace(n, "fd=%d cmd=%d(%s) arg=0%lo", fd, cmd, cmdstr, arg);
+
+    ret = myst_syscall_fcntl(fd, cmd, arg);
+    return _return(n, ret);
+}
+
+static long _sys_flock(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int fd = (int)x1;
+    int cmd = (int)x2;
+
+    _strace(n, "fd=%d cmd=%d", fd, cmd);
+
+    return _return(n, 0);
+}
+
+static long _sys_fsync(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    int fd = (int)x1;
+
+    _strace(n, "fd=%d", fd);
+
+    return _return(n, myst_syscall_fsync(fd));
+}
+
+static long _sys_fdatasync(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    int fd = (int)x1;
+
+    _strace(n, "fd=%d", fd);
+
+    return _return(n, myst_syscall_fdatasync(fd));
+}
+
+static long _sys_truncate(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    const char* path = (const char*)x1;
+    off_t length = (off_t)x2;
+
+    _strace(n, "path=\"%s\" length=%ld", path, length);
+
+    return _return(n, myst_syscall_truncate(path, length));
+}
+
+static long _sys_ftruncate(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int fd = (int)x1;
+    off_t length = (off_t)x2;
+
+    _strace(n, "fd=%d length=%ld", fd, length);
+
+    return _return(n, myst_syscall_ftruncate(fd, length));
+}
+
+static long _sys_getcwd(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    char* buf = (char*)x1;
+    size_t size = (size_t)x2;
+
+    _strace(n, "buf=%p size=%zu", buf, size);
+
+    return _return(n, myst_syscall_getcwd(buf, size));
+}
+
+static long _sys_chdir(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    const char* path = (const char*)x1;
+
+    _strace(n, "path=\"%s\"", path);
+
+    return _return(n, myst_syscall_chdir(path));
+}
+
+static long _sys_fchdir(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    int fd = (int)x1;
+
+    _strace(n, "fd=%d", fd);
+
+    return _return(n, myst_syscall_fchdir(fd));
+}
+
+static long _sys_rename(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    const char* oldpath = (const char*)x1;
+    const char* newpath = (const char*)x2;
+
+    _strace(n, "oldpath=\"%s\" newpath=\"%s\"", oldpath, newpath);
+
+    return _return(n, myst_syscall_rename(oldpath, newpath));
+}
+
+static long _sys_mkdir(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    const char* pathname = (const char*)x1;
+    mode_t mode = (mode_t)x2;
+
+    _strace(n, "pathname=\"%s\" mode=0%o", pathname, mode);
+
+    return _return(n, myst_syscall_mkdir(pathname, mode));
+}
+
+static long _sys_rmdir(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    const char* pathname = (const char*)x1;
+
+    _strace(n, "pathname=\"%s\"", pathname);
+
+    return _return(n, myst_syscall_rmdir(pathname));
+}
+
+static long _sys_creat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    const char* pathname = (const char*)x1;
+    mode_t mode = (mode_t)x2;
+
+    _strace(n, "pathname=\"%s\" mode=%x", pathname, mode);
+
+    return _return(n, myst_syscall_creat(pathname, mode));
+}
+
+static long _sys_link(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    const char* oldpath = (const char*)x1;
+    const char* newpath = (const char*)x2;
+
+    _strace(n, "oldpath=\"%s\" newpath=\"%s\"", oldpath, newpath);
+
+    return _return(n, myst_syscall_link(oldpath, newpath));
+}
+
+static long _sys_unlink(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    const char* pathname = (const char*)x1;
+
+    _strace(n, "pathname=\"%s\"", pathname);
+
+    return _return(n, myst_syscall_unlink(pathname));
+}
+
+static long _sys_symlink(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    const char* target = (const char*)x1;
+    const char* linkpath = (const char*)x2;
+
+    _strace(n, "target=\"%s\" linkpath=\"%s\"", target, linkpath);
+
+    return _return(n, myst_syscall_symlink(target, linkpath));
+}
+
+static long _sys_readlink(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    const char* pathname = (const char*)x1;
+    char* buf = (char*)x2;
+    size_t bufsiz = (size_t)x3;
+
+    _strace(
+        n, "pathname=\"%s\" buf=%p bufsiz=%zu", pathname, buf, bufsiz);
+
+    return _return(n, myst_syscall_readlink(pathname, buf, bufsiz));
+}
+
+static long _sys_chmod(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    const char* pathname = (const char*)x1;
+    mode_t mode = (mode_t)x2;
+
+    _strace(n, "pathname=\"%s\" mode=%o", pathname, mode);
+
+    return _return(n, myst_syscall_chmod(pathname, mode));
+}
+
+static long _sys_fchmod(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int fd = (int)x1;
+    mode_t mode = (mode_t)x2;
+
+    _strace(n, "fd=%d mode=%o", fd, mode);
+
+    return _return(n, myst_syscall_fchmod(fd, mode));
+}
+
+static long _sys_chown(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    const char* pathname = (const char*)x1;
+    uid_t owner = (uid_t)x2;
+    gid_t group = (gid_t)x3;
+
+    _strace(n, "pathname=%s owner=%u group=%u", pathname, owner, group);
+
+    return _return(n, myst_syscall_chown(pathname, owner, group));
+}
+
+static long _sys_fchown(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    int fd = (int)x1;
+    uid_t owner = (uid_t)x2;
+    gid_t group = (gid_t)x3;
+
+    _strace(n, "fd=%d owner=%u group=%u", fd, owner, group);
+
+    return _return(n, myst_syscall_fchown(fd, owner, group));
+}
+
+static long _sys_fchownat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+
+    int dirfd = (int)x1;
+    const char* pathname = (const char*)x2;
+    uid_t owner = (uid_t)x3;
+    gid_t group = (gid_t)x4;
+    int flags = (int)x5;
+
+    _strace(
+        n,
+        "dirfd=%d pathname=%s owner=%u group=%u flags=%d",
+        dirfd,
+        pathname,
+        owner,
+        group,
+        flags);
+
+    return _return(
+        n,
+        myst_syscall_fchownat(dirfd, pathname, owner, group, flags));
+}
+
+static long _sys_lchown(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    const char* pathname = (const char*)x1;
+    uid_t owner = (uid_t)x2;
+    gid_t group = (gid_t)x3;
+
+    _strace(n, "pathname=%s owner=%u group=%u", pathname, owner, group);
+
+    return _return(n, myst_syscall_lchown(pathname, owner, group));
+}
+
+static long _sys_umask(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    mode_t mask = (mode_t)x1;
+
+    _strace(n, "mask=%o", mask);
+
+    return _return(n, myst_syscall_umask(mask));
+}
+
+static long _sys_gettimeofday(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    struct timeval* tv = (struct timeval*)x1;
+    struct timezone* tz = (void*)x2;
+
+    _strace(n, "tv=%p tz=%p", tv, tz);
+
+    long ret = myst_syscall_gettimeofday(tv, tz);
+    return _return(n, ret);
+}
+
+static long _sys_getrusage(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int who = (int)x1;
+    struct rusage* usage = (struct rusage*)x2;
+
+    _strace(n, "who=%d usage=%p", who, usage);
+
+    long ret = myst_syscall_getrusage(who, usage);
+    return _return(n, ret);
+}
+
+static long _sys_sysinfo(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    struct sysinfo* info = (struct sysinfo*)x1;
+    _strace(n, "info=%p", info);
+    long ret = myst_syscall_sysinfo(info);
+    return _return(n, ret);
+}
+
+static long _sys_times(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    struct tms* tm = (struct tms*)x1;
+    _strace(n, "tm=%p", tm);
+
+    long stime = myst_times_system_time();
+    long utime = myst_times_user_time();
+    if (tm != NULL)
+    {
+        tm->tms_utime = utime;
+        tm->tms_stime = stime;
+        tm->tms_cutime = 0;
+        tm->tms_cstime = 0;
+    }
+
+    return _return(n, stime + utime);
+}
+
+static long _sys_syslog(syscall_args_t* args)
+{
+    long n = args->n;
+
+    /* Ignore syslog for now */
+    return _return(n, 0);
+}
+
+static long _sys_setpgid(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    myst_thread_t* thread = args->thread;
+
+    pid_t pid = (pid_t)x1;
+    pid_t pgid = (pid_t)x2;
+    _strace(n, "pid=%u pgid=%u", pid, pgid);
+    return _return(n, myst_syscall_setpgid(pid, pgid, thread));
+}
+
+static long _sys_getpgid(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    myst_thread_t* thread = args->thread;
+
+    pid_t pid = (pid_t)x1;
+    _strace(n, "pid=%u", pid);
+    return _return(n, myst_syscall_getpgid(pid, thread));
+}
+
+static long _sys_getpgrp(syscall_args_t* args)
+{
+    long n = args->n;
+    myst_thread_t* thread = args->thread;
+
+    _strace(n, NULL);
+    return _return(n, myst_syscall_getpgid(thread->pid, thread));
+}
+
+static long _sys_getppid(syscall_args_t* args)
+{
+    long n = args->n;
+
+    _strace(n, NULL);
+    return _return(n, myst_getppid());
+}
+
+static long _sys_getsid(syscall_args_t* args)
+{
+    long n = args->n;
+
+    _strace(n, NULL);
+    return _return(n, myst_getsid());
+}
+
+static long _sys_getgroups(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    size_t size = (size_t)x1;
+    gid_t* list = (gid_t*)x2;
+    /* return the extra groups on the thread */
+    _strace(n, NULL);
+    return _return(n, myst_syscall_getgroups(size, list));
+}
+
+static long _sys_setgroups(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int size = (int)x1;
+    const gid_t* list = (const gid_t*)x2;
+
+    /* return the extra groups on the thread */
+    _strace(n, NULL);
+    return _return(n, myst_syscall_setgroups(size, list));
+}
+
+static long _sys_getuid(syscall_args_t* args)
+{
+    long n = args->n;
+
+    /* return the real uid of the thread */
+    _strace(n, NULL);
+    return _return(n, myst_syscall_getuid());
+}
+
+static long _sys_setuid(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    /* Set euid and fsuid to arg1, and if euid is already set to root
+     * also set uid and savuid of the thread */
+    uid_t uid = (uid_t)x1;
+    _strace(n, "uid=%u", uid);
+
+    return _return(n, myst_syscall_setuid(uid));
+}
+
+static long _sys_getgid(syscall_args_t* args)
+{
+    long n = args->n;
+
+    /* return the gid of the thread */
+    _strace(n, NULL);
+    return _return(n, myst_syscall_getgid());
+}
+
+static long _sys_setgid(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    /* set the effective gid (euid) of the thread, unless egid is root
+     * in which case set all gids */
+    gid_t gid = (gid_t)x1;
+    _strace(n, "gid=%u", gid);
+    return _return(n, myst_syscall_setgid(gid));
+}
+
+static long _sys_geteuid(syscall_args_t* args)
+{
+    long n = args->n;
+
+    /* return threads effective uid (euid) */
+    _strace(n, NULL);
+    return _return(n, myst_syscall_geteuid());
+}
+
+static long _sys_getegid(syscall_args_t* args)
+{
+    long n = args->n;
+
+    /* return threads effective gid (egid) */
+    _strace(n, NULL);
+    return _return(n, myst_syscall_getegid());
+}
+
+static long _sys_setreuid(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    /* set the real and effective uid of the thread */
+    uid_t ruid = (uid_t)x1;
+    uid_t euid = (uid_t)x2;
+    _strace(n, "Changing IDs to ruid=%u, euid=%u", ruid, euid);
+    return _return(n, myst_syscall_setreuid(ruid, euid));
+}
+
+static long _sys_setregid(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    /* set the real and effective uid of the thread */
+    gid_t rgid = (gid_t)x1;
+    gid_t egid = (gid_t)x2;
+    _strace(n, "Changing setting to rgid=%u, egid=%u", rgid, egid);
+    return _return(n, myst_syscall_setregid(rgid, egid));
+}
+
+static long _sys_setresuid(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    /* set the real and effective uid of the thread */
+    uid_t ruid = (uid_t)x1;
+    uid_t euid = (uid_t)x2;
+    uid_t savuid = (uid_t)x3;
+    _strace(
+        n,
+        "Changing setting to ruid=%u, euid=%u, savuid=%u",
+        ruid,
+        euid,
+        savuid);
+    return _return(n, myst_syscall_setresuid(ruid, euid, savuid));
+}
+
+static long _sys_getresuid(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    uid_t* ruid = (uid_t*)x1;
+    uid_t* euid = (uid_t*)x2;
+    uid_t* savuid = (uid_t*)x3;
+    _strace(n, NULL);
+    return _return(n, myst_syscall_getresuid(ruid, euid, savuid));
+}
+
+static long _sys_setresgid(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    /* set the real and effective uid of the thread */
+    gid_t rgid = (gid_t)x1;
+    gid_t egid = (gid_t)x2;
+    gid_t savgid = (gid_t)x3;
+    _strace(
+        n,
+        "Changing setting to rgid=%u, egid=%u, savgid=%u",
+        rgid,
+        egid,
+        savgid);
+    return _return(n, myst_syscall_setresgid(rgid, egid, savgid));
+}
+
+static long _sys_getresgid(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    gid_t* rgid = (gid_t*)x1;
+    gid_t* egid = (gid_t*)x2;
+    gid_t* savgid = (gid_t*)x3;
+    _strace(n, NULL);
+    return _return(n, myst_syscall_getresgid(rgid, egid, savgid));
+}
+
+static long _sys_setfsuid(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    uid_t fsuid = (uid_t)x1;
+    _strace(n, "fsuid=%u", fsuid);
+    return _return(n, myst_syscall_setfsuid(fsuid));
+}
+
+static long _sys_setfsgid(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    gid_t fsgid = (gid_t)x1;
+    _strace(n, "fsgid=%u", fsgid);
+    return _return(n, myst_syscall_setfsgid(fsgid));
+}
+
+static long _sys_rt_sigpending(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    sigset_t* set = (sigset_t*)x1;
+    unsigned size = (unsigned)x2;
+    return _return(n, myst_signal_sigpending(set, size));
+}
+
+static long _sys_sigaltstack(syscall_args_t* args)
+{
+    long n = args->n;
+
+    /* ATTN: support user space stack for segv handling. */
+    return _return(n, 0);
+}
+
+static long _sys_mknod(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    const char* pathname = (const char*)x1;
+    mode_t mode = (mode_t)x2;
+    dev_t dev = (dev_t)x3;
+    long ret = 0;
+
+    _strace(n, "pathname=%s mode=%d dev=%lu", pathname, mode, dev);
+
+    if (S_ISFIFO(mode))
+    {
+        /* ATTN: create a pipe here! */
+    }
+    else
+    {
+        ret = -ENOTSUP;
+    }
+
+    return _return(n, ret);
+}
+
+static long _sys_statfs(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    const char* path = (const char*)x1;
+    struct statfs* buf = (struct statfs*)x2;
+
+    _strace(n, "path=%s buf=%p", path, buf);
+
+    long ret = myst_syscall_statfs(path, buf);
+
+    return _return(n, ret);
+}
+
+static long _sys_fstatfs(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int fd = (int)x1;
+    struct statfs* buf = (struct statfs*)x2;
+
+    _strace(n, "fd=%d buf=%p", fd, buf);
+
+    long ret = myst_syscall_fstatfs(fd, buf);
+
+    return _return(n, ret);
+}
+
+static long _sys_sched_setparam(syscall_args_t* args)
+{
+    long n = args->n;
+
+    /* ATTN: support setting thread priorities. */
+    return _return(n, 0);
+}
+
+static long _sys_sched_getparam(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    pid_t pid = (pid_t)x1;
+    struct sched_param* param = (struct sched_param*)x2;
+
+    _strace(n, "pid=%d param=%p", pid, param);
+
+    // ATTN: Return the priority from SYS_sched_setparam.
+    if (param != NULL)
+    {
+        // Only memset the non reserved part of the structure
+        // This is to be defensive against different sizes of this
+        // struct in musl and glibc.
+        memset(param, 0, sizeof(*param) - 40);
+    }
+    return _return(n, 0);
+}
+
+static long _sys_sched_setscheduler(syscall_args_t* args)
+{
+    long n = args->n;
+
+    // ATTN: support different schedules, FIFO, RR, BATCH, etc.
+    // The more control we have on threads inside the kernel, the more
+    // schedulers we could support.
+    return _return(n, 0);
+}
+
+static long _sys_sched_getscheduler(syscall_args_t* args)
+{
+    long n = args->n;
+
+    /* ATTN: return the scheduler installed from sched_setscheduler. */
+    return _return(n, SCHED_OTHER);
+}
+
+static long _sys_sched_get_priority_max(syscall_args_t* args)
+{
+    long n = args->n;
+
+    /* ATTN: support thread priorities */
+    return _return(n, 0);
+}
+
+static long _sys_sched_get_priority_min(syscall_args_t* args)
+{
+    long n = args->n;
+
+    /* ATTN: support thread priorities */
+    return _return(n, 0);
+}
+
+static long _sys_mlock(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    const void* addr = (const void*)x1;
+    size_t len = (size_t)x2;
+    long ret = 0;
+
+    _strace(n, "addr=%p len=%zu\n", addr, len);
+
+    if (!addr)
+        ret = -EINVAL;
+
+    // ATTN: forward the request to target.
+    // Some targets, such as sgx, probably just ignore it.
+
+    return _return(n, ret);
+}
+
+static long _sys_prctl(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int option = (int)x1;
+    long ret = 0;
+
+    _strace(n, "option=%d\n", option);
+
+    if (option == PR_GET_NAME)
+    {
+        char* arg2 = (char*)x2;
+        if (!arg2)
+            return _return(n, -EINVAL);
+
+        // ATTN: Linux requires a 16-byte buffer:
+        const size_t n = 16;
+        myst_strlcpy(arg2, myst_get_thread_name(myst_thread_self()), n);
+    }
+    else if (option == PR_SET_NAME)
+    {
+        char* arg2 = (char*)x2;
+        if (!arg2)
+            return _return(n, -EINVAL);
+
+        ret = myst_set_thread_name(myst_thread_self(), arg2);
+    }
+    else
+    {
+        ret = -EINVAL;
+    }
+
+    return _return(n, ret);
+}
+
+static long _sys_mount(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+
+    const char* source = (const char*)x1;
+    const char* target = (const char*)x2;
+    const char* filesystemtype = (const char*)x3;
+    unsigned long mountflags = (unsigned long)x4;
+    void* data = (void*)x5;
+    long ret;
+
+    _strace(
+        n,
+        "source=%s target=%s filesystemtype=%s mountflags=%lu data=%p",
+        source,
+        target,
+        filesystemtype,
+        mountflags,
+        data);
+
+    ret = myst_syscall_mount(
+        source, target, filesystemtype, mountflags, data, false);
+
+    return _return(n, ret);
+}
+
+static long _sys_umount2(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    const char* target = (const char*)x1;
+    int flags = (int)x2;
+    long ret;
+
+    _strace(n, "target=%p flags=%d", target, flags);
+
+    ret = myst_syscall_umount2(target, flags);
+
+    return _return(n, ret);
+}
+
+static long _sys_sethostname(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    const char* name = (const char*)x1;
+    size_t len = (size_t)x2;
+
+    _strace(n, "name=\"%s\" len=%zu", name, len);
+
+    return _return(n, myst_syscall_sethostname(name, len));
+}
+
+static long _sys_gettid(syscall_args_t* args)
+{
+    long n = args->n;
+
+    _strace(n, NULL);
+    return _return(n, myst_gettid());
+}
+
+static long _sys_tkill(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int tid = (int)x1;
+    int sig = (int)x2;
+
+    _strace(n, "tid=%d sig=%d", tid, sig);
+
+    myst_thread_t* thread = myst_thread_self();
+    int tgid = thread->pid;
+
+    long ret = myst_syscall_tgkill(tgid, tid, sig);
+    return _return(n, ret);
+}
+
+static long _sys_time(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    time_t* tloc = (time_t*)x1;
+
+    _strace(n, "tloc=%p", tloc);
+    long ret = myst_syscall_time(tloc);
+    return _return(n, ret);
+}
+
+static long _sys_futex(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+    long x6 = args->params[5];
+
+    int* uaddr = (int*)x1;
+    int futex_op = (int)x2;
+    int val = (int)x3;
+    long arg = (long)x4;
+    int* uaddr2 = (int*)x5;
+    int val3 = (int)x6;
+
+    _strace(
+        n,
+        "uaddr=0x%lx(%d) futex_op=%u(%s) val=%d",
+        (long)uaddr,
+        (uaddr ? *uaddr : -1),
+        futex_op,
+        _futex_op_str(futex_op),
+        val);
+
+    return _return(
+        n,
+        myst_syscall_futex(uaddr, futex_op, val, arg, uaddr2, val3));
+}
+
+static long _sys_sched_setaffinity(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    pid_t pid = (pid_t)x1;
+    size_t cpusetsize = (pid_t)x2;
+    const cpu_set_t* mask = (const cpu_set_t*)x3;
+    long ret;
+
+    _strace(
+        n, "pid=%d cpusetsize=%zu mask=%p\n", pid, cpusetsize, mask);
+
+    ret = myst_syscall_sched_setaffinity(pid, cpusetsize, mask);
+    return _return(n, ret);
+}
+
+static long _sys_sched_getaffinity(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    pid_t pid = (pid_t)x1;
+    size_t cpusetsize = (pid_t)x2;
+    cpu_set_t* mask = (cpu_set_t*)x3;
+    long ret;
+
+    _strace(
+        n, "pid=%d cpusetsize=%zu mask=%p\n", pid, cpusetsize, mask);
+
+    /* returns the number of bytes in the kernel affinity mask */
+    ret = myst_syscall_sched_getaffinity(pid, cpusetsize, mask);
+
+    return _return(n, ret);
+}
+
+static long _sys_set_thread_area(syscall_args_t* args)
+{
+    long n = args->n;
+    long* params = args->params;
+    myst_thread_t* thread = args->thread;
+    myst_td_t* target_td = args->target_td;
+    myst_td_t* crt_td;
+
+    void* tp = (void*)params[0];
+
+    _strace(n, "tp=%p", tp);
+
+    /* ---------- running target thread descriptor ---------- */
+
+#ifdef DISABLE_MULTIPLE_SET_THREAD_AREA_SYSCALLS
+    if (_set_thread_area_called)
+        myst_panic("SYS_set_thread_area called twice");
+#endif
+
+    /* get the C-runtime thread descriptor */
+    crt_td = (myst_td_t*)tp;
+    assert(myst_valid_td(crt_td));
+
+    /* set the C-runtime thread descriptor for this thread */
+    thread->crt_td = crt_td;
+    args->crt_td = crt_td;
+
+    /* propagate the canary from the old thread descriptor */
+    crt_td->canary = target_td->canary;
+
+    _set_thread_area_called = true;
+
+    return _return(n, 0);
+}
+
+static long _sys_io_setup(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    unsigned int nr_events = (unsigned int)x1;
+    myst_aio_context_t* ctx_idp = (myst_aio_context_t*)x2;
+
+    _strace(n, "nr_events=%u ctx_idp=%p", nr_events, ctx_idp);
+
+    return _return(n, myst_syscall_io_setup(nr_events, ctx_idp));
+}
+
+static long _sys_io_destroy(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    myst_aio_context_t ctx_id = (myst_aio_context_t)x1;
+
+    _strace(n, "ctx_id=%lx", ctx_id);
+
+    return _return(n, myst_syscall_io_destroy(ctx_id));
+}
+
+static long _sys_io_submit(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    myst_aio_context_t ctx_id = (myst_aio_context_t)x1;
+    long nr = x2;
+    struct myst_iocb** iocbpp = (struct myst_iocb**)x3;
+
+    _strace(n, "ctx_id=%lx nr=%ld iocbpp=%p", ctx_id, nr, iocbpp);
+
+    return _return(n, myst_syscall_io_submit(ctx_id, nr, iocbpp));
+}
+
+static long _sys_io_cancel(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    myst_aio_context_t ctx_id = (myst_aio_context_t)x1;
+    struct myst_iocb* iocb = (struct myst_iocb*)x2;
+    struct myst_io_event* result = (struct myst_io_event*)x3;
+
+    _strace(n, "ctx_id=%lx iocb=%p result=%p", ctx_id, iocb, result);
+
+    return _return(n, myst_syscall_io_cancel(ctx_id, iocb, result));
+}
+
+static long _sys_io_getevents(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+
+    myst_aio_context_t ctx_id = (myst_aio_context_t)x1;
+    long min_nr = x2;
+    long nr = x3;
+    struct myst_io_event* events = (struct myst_io_event*)x4;
+    const struct timespec* timeout = (const struct timespec*)x5;
+    long ret;
+
+    _strace(
+        n,
+        "ctx_id=%lx min_nr=%ld nr=%ld events=%p timeout=%p",
+        ctx_id,
+        min_nr,
+        nr,
+        events,
+        timeout);
+
+    ret = myst_syscall_io_getevents(ctx_id, min_nr, nr, events, timeout);
+    return _return(n, ret);
+}
+
+static long _sys_io_pgetevents(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+    long x6 = args->params[5];
+
+    myst_aio_context_t ctx_id = (myst_aio_context_t)x1;
+    long min_nr = x2;
+    long nr = x3;
+    struct myst_io_event* events = (struct myst_io_event*)x4;
+    const struct timespec* timeout = (const struct timespec*)x5;
+    const void* usig = (const void*)x6;
+    long ret;
+
+    _strace(
+        n,
+        "ctx_id=%lx min_nr=%ld nr=%ld events=%p timeout=%p usig=%p",
+        ctx_id,
+        min_nr,
+        nr,
+        events,
+        timeout,
+        usig);
+
+    /* ATTN: ignore usig (the signal mask) */
+    ret = myst_syscall_io_getevents(ctx_id, min_nr, nr, events, timeout);
+    return _return(n, ret);
+}
+
+static long _sys_epoll_create(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+
+    int size = (int)x1;
+
+    _strace(n, "size=%d", size);
+
+    if (size <= 0)
+        return _return(n, -EINVAL);
+
+    return _return(n, myst_syscall_epoll_create1(0));
+}
 
-            _strace(n, "fd=%d owner=%u group=%u", fd, owner, group);
+static long _sys_getdents64(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            BREAK(_return(n, myst_syscall_fchown(fd, owner, group)));
-        }
-        case SYS_fchownat:
-        {
-            int dirfd = (int)x1;
-            const char* pathname = (const char*)x2;
-            uid_t owner = (uid_t)x3;
-            gid_t group = (gid_t)x4;
-            int flags = (int)x5;
+    unsigned int fd = (unsigned int)x1;
+    struct dirent* dirp = (struct dirent*)x2;
+    unsigned int count = (unsigned int)x3;
 
-            _strace(
-                n,
-                "dirfd=%d pathname=%s owner=%u group=%u flags=%d",
-                dirfd,
-                pathname,
-                owner,
-                group,
-                flags);
-
-            BREAK(_return(
-                n,
-                myst_syscall_fchownat(dirfd, pathname, owner, group, flags)));
-        }
-        case SYS_lchown:
-        {
-            const char* pathname = (const char*)x1;
-            uid_t owner = (uid_t)x2;
-            gid_t group = (gid_t)x3;
+    _strace(n, "fd=%d dirp=%p count=%u", fd, dirp, count);
 
-            _strace(n, "pathname=%s owner=%u group=%u", pathname, owner, group);
+    return _return(n, myst_syscall_getdents64((int)fd, dirp, count));
+}
 
-            BREAK(_return(n, myst_syscall_lchown(pathname, owner, group)));
-        }
-        case SYS_umask:
-        {
-            mode_t mask = (mode_t)x1;
+static long _sys_set_tid_address(syscall_args_t* args)
+{
+    long n = args->n;
+    long* params = args->params;
 
-            _strace(n, "mask=%o", mask);
+    int* tidptr = (int*)params[0];
 
-            BREAK(_return(n, myst_syscall_umask(mask)));
-        }
-        case SYS_gettimeofday:
-        {
-            struct timeval* tv = (struct timeval*)x1;
-            struct timezone* tz = (void*)x2;
+    /* ATTN: unused */
 
-            _strace(n, "tv=%p tz=%p", tv, tz);
+    _strace(n, "tidptr=%p *tidptr=%d", tidptr, tidptr ? *tidptr : -1);
 
-            long ret = myst_syscall_gettimeofday(tv, tz);
-            BREAK(_return(n, ret));
-        }
-        case SYS_getrlimit:
-            break;
-        case SYS_getrusage:
-        {
-            int who = (int)x1;
-            struct rusage* usage = (struct rusage*)x2;
+    return _return(n, myst_getpid());
+}
 
-            _strace(n, "who=%d usage=%p", who, usage);
+static long _sys_fadvise64(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int fd = (int)x1;
+    loff_t offset = (loff_t)x2;
+    loff_t len = (loff_t)x3;
+    int advice = (int)x4;
+
+    _strace(
+        n,
+        "fd=%d offset=%ld len=%ld advice=%d",
+        fd,
+        offset,
+        len,
+        advice);
+
+    /* ATTN: no-op */
+    return _return(n, 0);
+}
 
-            long ret = myst_syscall_getrusage(who, usage);
-            BREAK(_return(n, ret));
-        }
-        case SYS_sysinfo:
-        {
-            struct sysinfo* info = (struct sysinfo*)x1;
-            _strace(n, "info=%p", info);
-            long ret = myst_syscall_sysinfo(info);
-            BREAK(_return(n, ret));
-        }
-        case SYS_times:
-        {
-            struct tms* tm = (struct tms*)x1;
-            _strace(n, "tm=%p", tm);
+static long _sys_clock_settime(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            long stime = myst_times_system_time();
-            long utime = myst_times_user_time();
-            if (tm != NULL)
-            {
-                tm->tms_utime = utime;
-                tm->tms_stime = stime;
-                tm->tms_cutime = 0;
-                tm->tms_cstime = 0;
-            }
+    clockid_t clk_id = (clockid_t)x1;
+    struct timespec* tp = (struct timespec*)x2;
 
-            BREAK(_return(n, stime + utime));
-        }
-        case SYS_ptrace:
-            break;
-        case SYS_syslog:
-        {
-            /* Ignore syslog for now */
-            BREAK(_return(n, 0));
-        }
-        case SYS_setpgid:
-        {
-            pid_t pid = (pid_t)x1;
-            pid_t pgid = (pid_t)x2;
-            _strace(n, "pid=%u pgid=%u", pid, pgid);
-            BREAK(_return(n, myst_syscall_setpgid(pid, pgid, thread)));
-        }
-        case SYS_getpgid:
-        {
-            pid_t pid = (pid_t)x1;
-            _strace(n, "pid=%u", pid);
-            BREAK(_return(n, myst_syscall_getpgid(pid, thread)));
-        }
-        case SYS_getpgrp:
-        {
-            _strace(n, NULL);
-            BREAK(_return(n, myst_syscall_getpgid(thread->pid, thread)));
-        }
-        case SYS_getppid:
-        {
-            _strace(n, NULL);
-            BREAK(_return(n, myst_getppid()));
-        }
-        case SYS_getsid:
-        {
-            _strace(n, NULL);
-            BREAK(_return(n, myst_getsid()));
-        }
-        case SYS_setsid:
-            break;
-        case SYS_getgroups:
-        {
-            size_t size = (size_t)x1;
-            gid_t* list = (gid_t*)x2;
-            /* return the extra groups on the thread */
-            _strace(n, NULL);
-            BREAK(_return(n, myst_syscall_getgroups(size, list)));
-        }
-        case SYS_setgroups:
-        {
-            int size = (int)x1;
-            const gid_t* list = (const gid_t*)x2;
+    _strace(n, "clk_id=%u tp=%p", clk_id, tp);
 
-            /* return the extra groups on the thread */
-            _strace(n, NULL);
-            BREAK(_return(n, myst_syscall_setgroups(size, list)));
-        }
-        case SYS_getuid:
-        {
-            /* return the real uid of the thread */
-            _strace(n, NULL);
-            BREAK(_return(n, myst_syscall_getuid()));
-        }
-        case SYS_setuid:
-        {
-            /* Set euid and fsuid to arg1, and if euid is already set to root
-             * also set uid and savuid of the thread */
-            uid_t uid = (uid_t)x1;
-            _strace(n, "uid=%u", uid);
+    return _return(n, myst_syscall_clock_settime(clk_id, tp));
+}
 
-            BREAK(_return(n, myst_syscall_setuid(uid)));
-        }
-        case SYS_getgid:
-        {
-            /* return the gid of the thread */
-            _strace(n, NULL);
-            BREAK(_return(n, myst_syscall_getgid()));
-        }
-        case SYS_setgid:
-        {
-            /* set the effective gid (euid) of the thread, unless egid is root
-             * in which case set all gids */
-            gid_t gid = (gid_t)x1;
-            _strace(n, "gid=%u", gid);
-            BREAK(_return(n, myst_syscall_setgid(gid)));
-        }
-        case SYS_geteuid:
-        {
-            /* return threads effective uid (euid) */
-            _strace(n, NULL);
-            BREAK(_return(n, myst_syscall_geteuid()));
-        }
-        case SYS_getegid:
-        {
-            /* return threads effective gid (egid) */
-            _strace(n, NULL);
-            BREAK(_return(n, myst_syscall_getegid()));
-        }
-        case SYS_setreuid:
-        {
-            /* set the real and effective uid of the thread */
-            uid_t ruid = (uid_t)x1;
-            uid_t euid = (uid_t)x2;
-            _strace(n, "Changing IDs to ruid=%u, euid=%u", ruid, euid);
-            BREAK(_return(n, myst_syscall_setreuid(ruid, euid)));
-        }
-        case SYS_setregid:
-        {
-            /* set the real and effective uid of the thread */
-            gid_t rgid = (gid_t)x1;
-            gid_t egid = (gid_t)x2;
-            _strace(n, "Changing setting to rgid=%u, egid=%u", rgid, egid);
-            BREAK(_return(n, myst_syscall_setregid(rgid, egid)));
-        }
-        case SYS_setresuid:
-        {
-            /* set the real and effective uid of the thread */
-            uid_t ruid = (uid_t)x1;
-            uid_t euid = (uid_t)x2;
-            uid_t savuid = (uid_t)x3;
-            _strace(
-                n,
-                "Changing setting to ruid=%u, euid=%u, savuid=%u",
-                ruid,
-                euid,
-                savuid);
-            BREAK(_return(n, myst_syscall_setresuid(ruid, euid, savuid)));
-        }
-        case SYS_getresuid:
-        {
-            uid_t* ruid = (uid_t*)x1;
-            uid_t* euid = (uid_t*)x2;
-            uid_t* savuid = (uid_t*)x3;
-            _strace(n, NULL);
-            BREAK(_return(n, myst_syscall_getresuid(ruid, euid, savuid)));
-        }
-        case SYS_setresgid:
-        {
-            /* set the real and effective uid of the thread */
-            gid_t rgid = (gid_t)x1;
-            gid_t egid = (gid_t)x2;
-            gid_t savgid = (gid_t)x3;
-            _strace(
-                n,
-                "Changing setting to rgid=%u, egid=%u, savgid=%u",
-                rgid,
-                egid,
-                savgid);
-            BREAK(_return(n, myst_syscall_setresgid(rgid, egid, savgid)));
-        }
-        case SYS_getresgid:
-        {
-            gid_t* rgid = (gid_t*)x1;
-            gid_t* egid = (gid_t*)x2;
-            gid_t* savgid = (gid_t*)x3;
-            _strace(n, NULL);
-            BREAK(_return(n, myst_syscall_getresgid(rgid, egid, savgid)));
-        }
-        case SYS_setfsuid:
-        {
-            uid_t fsuid = (uid_t)x1;
-            _strace(n, "fsuid=%u", fsuid);
-            BREAK(_return(n, myst_syscall_setfsuid(fsuid)));
-        }
-        case SYS_setfsgid:
-        {
-            gid_t fsgid = (gid_t)x1;
-            _strace(n, "fsgid=%u", fsgid);
-            BREAK(_return(n, myst_syscall_setfsgid(fsgid)));
-        }
-        case SYS_capget:
-            break;
-        case SYS_capset:
-            break;
-        case SYS_rt_sigpending:
-        {
-            sigset_t* set = (sigset_t*)x1;
-            unsigned size = (unsigned)x2;
-            BREAK(_return(n, myst_signal_sigpending(set, size)));
-        }
-        case SYS_rt_sigtimedwait:
-            break;
-        case SYS_rt_sigqueueinfo:
-            break;
-        case SYS_rt_sigsuspend:
-            break;
-        case SYS_sigaltstack:
-        {
-            /* ATTN: support user space stack for segv handling. */
-            BREAK(_return(n, 0));
-        }
-        case SYS_utime:
-            break;
-        case SYS_mknod:
-        {
-            const char* pathname = (const char*)x1;
-            mode_t mode = (mode_t)x2;
-            dev_t dev = (dev_t)x3;
-            long ret = 0;
+static long _sys_clock_gettime(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            _strace(n, "pathname=%s mode=%d dev=%lu", pathname, mode, dev);
+    clockid_t clk_id = (clockid_t)x1;
+    struct timespec* tp = (struct timespec*)x2;
 
-            if (S_ISFIFO(mode))
-            {
-                /* ATTN: create a pipe here! */
-            }
-            else
-            {
-                ret = -ENOTSUP;
-            }
+    _strace(n, "clk_id=%u tp=%p", clk_id, tp);
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_uselib:
-            break;
-        case SYS_personality:
-            break;
-        case SYS_ustat:
-            break;
-        case SYS_statfs:
-        {
-            const char* path = (const char*)x1;
-            struct statfs* buf = (struct statfs*)x2;
+    return _return(n, myst_syscall_clock_gettime(clk_id, tp));
+}
 
-            _strace(n, "path=%s buf=%p", path, buf);
+static long _sys_clock_getres(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            long ret = myst_syscall_statfs(path, buf);
+    clockid_t clk_id = (clockid_t)x1;
+    struct timespec* res = (struct timespec*)x2;
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_fstatfs:
-        {
-            int fd = (int)x1;
-            struct statfs* buf = (struct statfs*)x2;
+    _strace(n, "clk_id=%u tp=%p", clk_id, res);
 
-            _strace(n, "fd=%d buf=%p", fd, buf);
+    return _return(n, myst_syscall_clock_getres(clk_id, res));
+}
 
-            long ret = myst_syscall_fstatfs(fd, buf);
+static long _sys_exit_group(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_sysfs:
-            break;
-        case SYS_getpriority:
-            break;
-        case SYS_setpriority:
-            break;
-        case SYS_sched_setparam:
-        {
-            /* ATTN: support setting thread priorities. */
-            BREAK(_return(n, 0));
-        }
-        case SYS_sched_getparam:
-        {
-            pid_t pid = (pid_t)x1;
-            struct sched_param* param = (struct sched_param*)x2;
+    int status = (int)x1;
+    _strace(n, "status=%d", status);
 
-            _strace(n, "pid=%d param=%p", pid, param);
+    myst_kill_thread_group();
+    return _return(n, 0);
+}
 
-            // ATTN: Return the priority from SYS_sched_setparam.
-            if (param != NULL)
-            {
-                // Only memset the non reserved part of the structure
-                // This is to be defensive against different sizes of this
-                // struct in musl and glibc.
-                memset(param, 0, sizeof(*param) - 40);
-            }
-            BREAK(_return(n, 0));
-        }
-        case SYS_sched_setscheduler:
-        {
-            // ATTN: support different schedules, FIFO, RR, BATCH, etc.
-            // The more control we have on threads inside the kernel, the more
-            // schedulers we could support.
-            BREAK(_return(n, 0));
-        }
-        case SYS_sched_getscheduler:
-        {
-            /* ATTN: return the scheduler installed from sched_setscheduler. */
-            BREAK(_return(n, SCHED_OTHER));
-        }
-        case SYS_sched_get_priority_max:
-        {
-            /* ATTN: support thread priorities */
-            BREAK(_return(n, 0));
-        }
-        case SYS_sched_get_priority_min:
-        {
-            /* ATTN: support thread priorities */
-            BREAK(_return(n, 0));
-        }
-        case SYS_sched_rr_get_interval:
-            break;
-        case SYS_mlock:
-        {
-            const void* addr = (const void*)x1;
-            size_t len = (size_t)x2;
-            long ret = 0;
+static long _sys_epoll_wait(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int epfd = (int)x1;
+    struct epoll_event* events = (struct epoll_event*)x2;
+    int maxevents = (int)x3;
+    int timeout = (int)x4;
+    long ret;
+
+    _strace(
+        n,
+        "edpf=%d events=%p maxevents=%d timeout=%d",
+        epfd,
+        events,
+        maxevents,
+        timeout);
+
+    ret = myst_syscall_epoll_wait(epfd, events, maxevents, timeout);
+    return _return(n, ret);
+}
+
+static long _sys_epoll_ctl(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int epfd = (int)x1;
+    int op = (int)x2;
+    int fd = (int)x3;
+    struct epoll_event* event = (struct epoll_event*)x4;
+    long ret;
+
+    _strace(n, "edpf=%d op=%d fd=%d event=%p", epfd, op, fd, event);
+
+    ret = myst_syscall_epoll_ctl(epfd, op, fd, event);
+    return _return(n, ret);
+}
+
+static long _sys_tgkill(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    int tgid = (int)x1;
+    int tid = (int)x2;
+    int sig = (int)x3;
+
+    _strace(n, "tgid=%d tid=%d sig=%d", tgid, tid, sig);
+
+    long ret = myst_syscall_tgkill(tgid, tid, sig);
+    return _return(n, ret);
+}
+
+static long _sys_mbind(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+    long x6 = args->params[5];
+
+    void* addr = (void*)x1;
+    unsigned long len = (unsigned long)x2;
+    int mode = (int)x3;
+    const unsigned long* nodemask = (const unsigned long*)x4;
+    unsigned long maxnode = (unsigned long)x5;
+    unsigned flags = (unsigned)x6;
+
+    _strace(
+        n,
+        "addr=%p len=%lu mode=%d nodemask=%p maxnode=%lu flags=%u",
+        addr,
+        len,
+        mode,
+        nodemask,
+        maxnode,
+        flags);
+
+    long ret =
+        myst_syscall_mbind(addr, len, mode, nodemask, maxnode, flags);
+    return _return(n, ret);
+}
+
+static long _sys_inotify_init(syscall_args_t* args)
+{
+    long n = args->n;
+
+    _strace(n, NULL);
+
+    long ret = myst_syscall_inotify_init1(0);
+    return _return(n, ret);
+}
+
+static long _sys_inotify_add_watch(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    int fd = (int)x1;
+    const char* pathname = (const char*)x2;
+    uint32_t mask = (uint32_t)x3;
+
+    _strace(n, "fd=%d pathname=%s mask=%x", fd, pathname, mask);
+
+    long ret = myst_syscall_inotify_add_watch(fd, pathname, mask);
+    return _return(n, ret);
+}
+
+static long _sys_inotify_rm_watch(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    int fd = (int)x1;
+    int wd = (int)x2;
+
+    _strace(n, "fd=%d wd=%d", fd, wd);
+
+    long ret = myst_syscall_inotify_rm_watch(fd, wd);
+    return _return(n, ret);
+}
+
+static long _sys_openat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int dirfd = (int)x1;
+    const char* path = (const char*)x2;
+    int flags = (int)x3;
+    mode_t mode = (mode_t)x4;
+    long ret;
+
+    _strace(
+        n,
+        "dirfd=%d path=\"%s\" flags=0%o mode=0%o",
+        dirfd,
+        path,
+        flags,
+        mode);
+
+    ret = myst_syscall_openat(dirfd, path, flags, mode);
+
+    return _return(n, ret);
+}
+
+static long _sys_futimesat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    int dirfd = (int)x1;
+    const char* pathname = (const char*)x2;
+    const struct timeval* times = (const struct timeval*)x3;
+    long ret;
+
+    _strace(n, "dirfd=%d pathname=%s times=%p", dirfd, pathname, times);
+
+    ret = myst_syscall_futimesat(dirfd, pathname, times);
+    return _return(n, ret);
+}
+
+static long _sys_newfstatat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int dirfd = (int)x1;
+    const char* pathname = (const char*)x2;
+    struct stat* statbuf = (struct stat*)x3;
+    int flags = (int)x4;
+    long ret;
+
+    _strace(
+        n,
+        "dirfd=%d pathname=%s statbuf=%p flags=%d",
+        dirfd,
+        pathname,
+        statbuf,
+        flags);
+
+    ret = myst_syscall_fstatat(dirfd, pathname, statbuf, flags);
+    return _return(n, ret);
+}
+
+static long _sys_unlinkat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    int dirfd = (int)x1;
+    const char* pathname = (const char*)x2;
+    int flags = (int)x3;
+
+    _strace(n, "dirfd=%d pathname=%s flags=%d", dirfd, pathname, flags);
+
+    return _return(n, myst_syscall_unlinkat(dirfd, pathname, flags));
+}
+
+static long _sys_renameat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int olddirfd = (int)x1;
+    const char* oldpath = (const char*)x2;
+    int newdirfd = (int)x3;
+    const char* newpath = (const char*)x4;
+
+    _strace(
+        n,
+        "olddirfd=%d oldpath=\"%s\" newdirfd=%d newpath=\"%s\"",
+        olddirfd,
+        oldpath,
+        newdirfd,
+        newpath);
+
+    return _return(
+        n,
+        myst_syscall_renameat(olddirfd, oldpath, newdirfd, newpath));
+}
+
+static long _sys_symlinkat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    const char* target = (const char*)x1;
+    int newdirfd = (int)x2;
+    const char* linkpath = (const char*)x3;
+
+    _strace(
+        n,
+        "target=%s newdirfd=%d linkpath=%s",
+        target,
+        newdirfd,
+        linkpath);
+
+    return 
+        _return(n, myst_syscall_symlinkat(target, newdirfd, linkpath));
+}
+
+static long _sys_readlinkat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int dirfd = (int)x1;
+    const char* pathname = (const char*)x2;
+    char* buf = (char*)x3;
+    size_t bufsiz = (size_t)x4;
+
+    _strace(
+        n,
+        "dirfd=%d pathname=%s buf=%p bufsize=%ld",
+        dirfd,
+        pathname,
+        buf,
+        bufsiz);
+
+    return _return(
+        n, myst_syscall_readlinkat(dirfd, pathname, buf, bufsiz));
+}
+
+static long _sys_faccessat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int dirfd = (int)x1;
+    const char* pathname = (const char*)x2;
+    int mode = (int)x3;
+    int flags = (int)x4;
+
+    _strace(
+        n,
+        "dirfd=%d pathname=%s mode=%d flags=%d",
+        dirfd,
+        pathname,
+        mode,
+        flags);
+
+    return _return(
+        n, myst_syscall_faccessat(dirfd, pathname, mode, flags));
+}
+
+static long _sys_set_robust_list(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+
+    struct myst_robust_list_head* head = (void*)x1;
+    size_t len = (size_t)x2;
+    long ret;
+
+    _strace(n, "head=%p len=%zu", head, len);
+
+    ret = myst_syscall_set_robust_list(head, len);
+    return _return(n, ret);
+}
+
+static long _sys_get_robust_list(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    int pid = (int)x1;
+    struct myst_robust_list_head** head_ptr = (void*)x2;
+    size_t* len_ptr = (size_t*)x3;
+    long ret;
+
+    _strace(n, "pid=%d head=%p len=%p", pid, head_ptr, len_ptr);
+
+    ret = myst_syscall_get_robust_list(pid, head_ptr, len_ptr);
+    return _return(n, ret);
+}
+
+static long _sys_utimensat(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int dirfd = (int)x1;
+    const char* pathname = (const char*)x2;
+    const struct timespec* times = (const struct timespec*)x3;
+    int flags = (int)x4;
+    long ret;
+
+    _strace(
+        n,
+        "dirfd=%d pathname=%s times=%p flags=%o",
+        dirfd,
+        pathname,
+        times,
+        flags);
+
+    ret = myst_syscall_utimensat(dirfd, pathname, times, flags);
+    return _return(n, ret);
+}
+
+static long _sys_epoll_pwait(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+
+    int epfd = (int)x1;
+    struct epoll_event* events = (struct epoll_event*)x2;
+    int maxevents = (int)x3;
+    int timeout = (int)x4;
+    const sigset_t* sigmask = (const sigset_t*)x5;
+    long ret;
+
+    _strace(
+        n,
+        "edpf=%d events=%p maxevents=%d timeout=%d sigmask=%p",
+        epfd,
+        events,
+        maxevents,
+        timeout,
+        sigmask);
+
+    /* ATTN: ignore sigmask */
+    ret = myst_syscall_epoll_wait(epfd, events, maxevents, timeout);
+    return _return(n, ret);
+}
+
+static long _sys_fallocate(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int fd = (int)x1;
+    int mode = (int)x2;
+    off_t offset = (off_t)x3;
+    off_t len = (off_t)x4;
+
+    _strace(
+        n, "fd=%d mode=%d offset=%ld len=%ld", fd, mode, offset, len);
 
-            _strace(n, "addr=%p len=%zu\n", addr, len);
+    /* ATTN: treated as advisory only */
+    return _return(n, 0);
+}
 
-            if (!addr)
-                ret = -EINVAL;
+static long _sys_accept4(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int sockfd = (int)x1;
+    struct sockaddr* addr = (struct sockaddr*)x2;
+    socklen_t* addrlen = (socklen_t*)x3;
+    int flags = (int)x4;
+    long ret;
+    char addrstr[MAX_IPADDR_LEN];
 
-            // ATTN: forward the request to target.
-            // Some targets, such as sgx, probably just ignore it.
+    ECHECK(_socketaddr_to_str(addr, addrstr, MAX_IPADDR_LEN));
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_munlock:
-            break;
-        case SYS_mlockall:
-            break;
-        case SYS_munlockall:
-            break;
-        case SYS_vhangup:
-            break;
-        case SYS_modify_ldt:
-            break;
-        case SYS_pivot_root:
-            break;
-        case SYS__sysctl:
-            break;
-        case SYS_prctl:
-        {
-            int option = (int)x1;
-            long ret = 0;
+    _strace(
+        n,
+        "sockfd=%d addr=%s addrlen=%p flags=%x",
+        sockfd,
+        addrstr,
+        addrlen,
+        flags);
 
-            _strace(n, "option=%d\n", option);
+    ret = myst_syscall_accept4(sockfd, addr, addrlen, flags);
+    return _return(n, ret);
 
-            if (option == PR_GET_NAME)
-            {
-                char* arg2 = (char*)x2;
-                if (!arg2)
-                    BREAK(_return(n, -EINVAL));
+done:
+    return _return(n, ret);
+}
 
-                // ATTN: Linux requires a 16-byte buffer:
-                const size_t n = 16;
-                myst_strlcpy(arg2, myst_get_thread_name(myst_thread_self()), n);
-            }
-            else if (option == PR_SET_NAME)
-            {
-                char* arg2 = (char*)x2;
-                if (!arg2)
-                    BREAK(_return(n, -EINVAL));
+static long _sys_eventfd2(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-                ret = myst_set_thread_name(myst_thread_self(), arg2);
-            }
-            else
-            {
-                ret = -EINVAL;
-            }
+    unsigned int initval = (unsigned int)x1;
+    int flags = (int)x2;
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_arch_prctl:
-        {
-            /* this is handled in myst_syscall() */
-            break;
-        }
-        case SYS_adjtimex:
-            break;
-        case SYS_setrlimit:
-            break;
-        case SYS_chroot:
-            break;
-        case SYS_sync:
-            break;
-        case SYS_acct:
-            break;
-        case SYS_settimeofday:
-            break;
-        case SYS_mount:
-        {
-            const char* source = (const char*)x1;
-            const char* target = (const char*)x2;
-            const char* filesystemtype = (const char*)x3;
-            unsigned long mountflags = (unsigned long)x4;
-            void* data = (void*)x5;
-            long ret;
-
-            _strace(
-                n,
-                "source=%s target=%s filesystemtype=%s mountflags=%lu data=%p",
-                source,
-                target,
-                filesystemtype,
-                mountflags,
-                data);
+    _strace(n, "initval=%u flags=%d", initval, flags);
 
-            ret = myst_syscall_mount(
-                source, target, filesystemtype, mountflags, data, false);
+    long ret = myst_syscall_eventfd(initval, flags);
+    return _return(n, ret);
+}
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_umount2:
-        {
-            const char* target = (const char*)x1;
-            int flags = (int)x2;
-            long ret;
+static long _sys_epoll_create1(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
 
-            _strace(n, "target=%p flags=%d", target, flags);
+    int flags = (int)x1;
 
-            ret = myst_syscall_umount2(target, flags);
+    _strace(n, "flags=%d", flags);
+    return _return(n, myst_syscall_epoll_create1(flags));
+}
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_swapon:
-            break;
-        case SYS_swapoff:
-            break;
-        case SYS_reboot:
-            break;
-        case SYS_sethostname:
-        {
-            const char* name = (const char*)x1;
-            size_t len = (size_t)x2;
+static long _sys_pipe2(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            _strace(n, "name=\"%s\" len=%zu", name, len);
+    int* pipefd = (int*)x1;
+    int flags = (int)x2;
+    long ret;
 
-            BREAK(_return(n, myst_syscall_sethostname(name, len)));
-        }
-        case SYS_setdomainname:
-            break;
-        case SYS_iopl:
-            break;
-        case SYS_ioperm:
-            break;
-        case SYS_create_module:
-            break;
-        case SYS_init_module:
-            break;
-        case SYS_delete_module:
-            break;
-        case SYS_get_kernel_syms:
-            break;
-        case SYS_query_module:
-            break;
-        case SYS_quotactl:
-            break;
-        case SYS_nfsservctl:
-            break;
-        case SYS_getpmsg:
-            break;
-        case SYS_putpmsg:
-            break;
-        case SYS_afs_syscall:
-            break;
-        case SYS_tuxcall:
-            break;
-        case SYS_security:
-            break;
-        case SYS_gettid:
-        {
-            _strace(n, NULL);
-            BREAK(_return(n, myst_gettid()));
-        }
-        case SYS_readahead:
-            break;
-        case SYS_setxattr:
-            break;
-        case SYS_lsetxattr:
-            break;
-        case SYS_fsetxattr:
-            break;
-        case SYS_getxattr:
-            break;
-        case SYS_lgetxattr:
-            break;
-        case SYS_fgetxattr:
-            break;
-        case SYS_listxattr:
-            break;
-        case SYS_llistxattr:
-            break;
-        case SYS_flistxattr:
-            break;
-        case SYS_removexattr:
-            break;
-        case SYS_lremovexattr:
-            break;
-        case SYS_fremovexattr:
-            break;
-        case SYS_tkill:
-        {
-            int tid = (int)x1;
-            int sig = (int)x2;
+    _strace(n, "pipefd=%p flags=%0o", pipefd, flags);
+    ret = myst_syscall_pipe2(pipefd, flags);
 
-            _strace(n, "tid=%d sig=%d", tid, sig);
+    if (__myst_kernel_args.trace_syscalls)
+        myst_eprintf("    pipefd[]=[%d:%d]\n", pipefd[0], pipefd[1]);
 
-            myst_thread_t* thread = myst_thread_self();
-            int tgid = thread->pid;
+    return _return(n, ret);
+}
 
-            long ret = myst_syscall_tgkill(tgid, tid, sig);
-            BREAK(_return(n, ret));
-        }
-        case SYS_time:
-        {
-            time_t* tloc = (time_t*)x1;
+static long _sys_inotify_init1(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
 
-            _strace(n, "tloc=%p", tloc);
-            long ret = myst_syscall_time(tloc);
-            BREAK(_return(n, ret));
-        }
-        case SYS_futex:
-        {
-            int* uaddr = (int*)x1;
-            int futex_op = (int)x2;
-            int val = (int)x3;
-            long arg = (long)x4;
-            int* uaddr2 = (int*)x5;
-            int val3 = (int)x6;
-
-            _strace(
-                n,
-                "uaddr=0x%lx(%d) futex_op=%u(%s) val=%d",
-                (long)uaddr,
-                (uaddr ? *uaddr : -1),
-                futex_op,
-                _futex_op_str(futex_op),
-                val);
-
-            BREAK(_return(
-                n,
-                myst_syscall_futex(uaddr, futex_op, val, arg, uaddr2, val3)));
-        }
-        case SYS_sched_setaffinity:
-        {
-            pid_t pid = (pid_t)x1;
-            size_t cpusetsize = (pid_t)x2;
-            const cpu_set_t* mask = (const cpu_set_t*)x3;
-            long ret;
+    int flags = (int)x1;
 
-            _strace(
-                n, "pid=%d cpusetsize=%zu mask=%p\n", pid, cpusetsize, mask);
+    _strace(n, "flags=%x", flags);
 
-            ret = myst_syscall_sched_setaffinity(pid, cpusetsize, mask);
-            BREAK(_return(n, ret));
-        }
-        case SYS_sched_getaffinity:
-        {
-            pid_t pid = (pid_t)x1;
-            size_t cpusetsize = (pid_t)x2;
-            cpu_set_t* mask = (cpu_set_t*)x3;
-            long ret;
+    long ret = myst_syscall_inotify_init1(flags);
+    return _return(n, ret);
+}
 
-            _strace(
-                n, "pid=%d cpusetsize=%zu mask=%p\n", pid, cpusetsize, mask);
+static long _sys_preadv(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int fd = (int)x1;
+    const struct iovec* iov = (const struct iovec*)x2;
+    int iovcnt = (int)x3;
+    off_t offset = (off_t)x4;
+
+    _strace(
+        n,
+        "fd=%d iov=%p iovcnt=%d offset=%zu",
+        fd,
+        iov,
+        iovcnt,
+        offset);
+
+    long ret = myst_syscall_preadv2(fd, iov, iovcnt, offset, 0);
+    return _return(n, ret);
+}
 
-            /* returns the number of bytes in the kernel affinity mask */
-            ret = myst_syscall_sched_getaffinity(pid, cpusetsize, mask);
+static long _sys_pwritev(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int fd = (int)x1;
+    const struct iovec* iov = (const struct iovec*)x2;
+    int iovcnt = (int)x3;
+    off_t offset = (off_t)x4;
+
+    _strace(
+        n,
+        "fd=%d iov=%p iovcnt=%d offset=%zu",
+        fd,
+        iov,
+        iovcnt,
+        offset);
+
+    long ret = myst_syscall_pwritev2(fd, iov, iovcnt, offset, 0);
+    return _return(n, ret);
+}
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_set_thread_area:
-        {
-            void* tp = (void*)params[0];
+static long _sys_prlimit64(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int pid = (int)x1;
+    int resource = (int)x2;
+    struct rlimit* new_rlim = (struct rlimit*)x3;
+    struct rlimit* old_rlim = (struct rlimit*)x4;
+
+    _strace(
+        n,
+        "pid=%d, resource=%d, new_rlim=%p, old_rlim=%p",
+        pid,
+        resource,
+        new_rlim,
+        old_rlim);
+
+    int ret = myst_syscall_prlimit64(pid, resource, new_rlim, old_rlim);
+    return _return(n, ret);
+}
 
-            _strace(n, "tp=%p", tp);
+static long _sys_getcpu(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            /* ---------- running target thread descriptor ---------- */
+    unsigned* cpu = (unsigned*)x1;
+    unsigned* node = (unsigned*)x2;
+    struct getcpu_cache* tcache = (struct getcpu_cache*)x3;
+    long ret;
 
-#ifdef DISABLE_MULTIPLE_SET_THREAD_AREA_SYSCALLS
-            if (_set_thread_area_called)
-                myst_panic("SYS_set_thread_area called twice");
-#endif
+    _strace(n, "cpu=%p node=%p, tcache=%p", cpu, node, tcache);
 
-            /* get the C-runtime thread descriptor */
-            crt_td = (myst_td_t*)tp;
-            assert(myst_valid_td(crt_td));
+    /* unused since Linux 2.6.24 */
+    (void)tcache;
 
-            /* set the C-runtime thread descriptor for this thread */
-            thread->crt_td = crt_td;
+    ret = myst_syscall_getcpu(cpu, node);
+    return _return(n, ret);
+}
 
-            /* propagate the canary from the old thread descriptor */
-            crt_td->canary = target_td->canary;
+static long _sys_getrandom(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            _set_thread_area_called = true;
+    void* buf = (void*)x1;
+    size_t buflen = (size_t)x2;
+    unsigned int flags = (unsigned int)x3;
 
-            BREAK(_return(n, 0));
-        }
-        case SYS_io_setup:
-            break;
-        case SYS_io_destroy:
-            break;
-        case SYS_io_getevents:
-            break;
-        case SYS_io_submit:
-            break;
-        case SYS_io_cancel:
-            break;
-        case SYS_get_thread_area:
-            break;
-        case SYS_lookup_dcookie:
-            break;
-        case SYS_epoll_create:
-        {
-            int size = (int)x1;
+    _strace(n, "buf=%p buflen=%zu flags=%d", buf, buflen, flags);
 
-            _strace(n, "size=%d", size);
+    return _return(n, myst_syscall_getrandom(buf, buflen, flags));
+}
 
-            if (size <= 0)
-                BREAK(_return(n, -EINVAL));
+static long _sys_membarrier(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            BREAK(_return(n, myst_syscall_epoll_create1(0)));
-        }
-        case SYS_epoll_ctl_old:
-            break;
-        case SYS_epoll_wait_old:
-            break;
-        case SYS_remap_file_pages:
-            break;
-        case SYS_getdents64:
-        {
-            unsigned int fd = (unsigned int)x1;
-            struct dirent* dirp = (struct dirent*)x2;
-            unsigned int count = (unsigned int)x3;
+    int cmd = (int)x1;
+    int flags = (int)x2;
 
-            _strace(n, "fd=%d dirp=%p count=%u", fd, dirp, count);
+    _strace(n, "cmd=%d flags=%d", cmd, flags);
+    /* membarrier syscall relies on inter-processor-interrupt and the
+     * untrusted privileged SW layer such as the hypervisor or bare
+     * metal OS to sychronize code execution across CPU cores. Not
+     * supported.
+     */
+    return _return(n, -ENOSYS);
+}
 
-            BREAK(_return(n, myst_syscall_getdents64((int)fd, dirp, count)));
-        }
-        case SYS_set_tid_address:
-        {
-            int* tidptr = (int*)params[0];
+static long _sys_preadv2(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+
+    int fd = (int)x1;
+    const struct iovec* iov = (const struct iovec*)x2;
+    int iovcnt = (int)x3;
+    off_t offset = (off_t)x4;
+    int flags = (int)x5;
+
+    _strace(
+        n,
+        "fd=%d iov=%p iovcnt=%d offset=%zu",
+        fd,
+        iov,
+        iovcnt,
+        offset);
+
+    long ret = myst_syscall_preadv2(fd, iov, iovcnt, offset, flags);
+    return _return(n, ret);
+}
 
-            /* ATTN: unused */
+static long _sys_pwritev2(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+
+    int fd = (int)x1;
+    const struct iovec* iov = (const struct iovec*)x2;
+    int iovcnt = (int)x3;
+    off_t offset = (off_t)x4;
+    int flags = (int)x5;
+
+    _strace(
+        n,
+        "fd=%d iov=%p iovcnt=%d offset=%zu",
+        fd,
+        iov,
+        iovcnt,
+        offset);
+
+    long ret = myst_syscall_pwritev2(fd, iov, iovcnt, offset, flags);
+    return _return(n, ret);
+}
 
-            _strace(n, "tidptr=%p *tidptr=%d", tidptr, tidptr ? *tidptr : -1);
+static long _sys_bind(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            BREAK(_return(n, myst_getpid()));
-        }
-        case SYS_restart_syscall:
-            break;
-        case SYS_semtimedop:
-            break;
-        case SYS_fadvise64:
-        {
-            int fd = (int)x1;
-            loff_t offset = (loff_t)x2;
-            loff_t len = (loff_t)x3;
-            int advice = (int)x4;
+    int sockfd = (int)x1;
+    const struct sockaddr* addr = (const struct sockaddr*)x2;
+    socklen_t addrlen = (socklen_t)x3;
+    long ret;
+    char addrstr[MAX_IPADDR_LEN];
 
-            _strace(
-                n,
-                "fd=%d offset=%ld len=%ld advice=%d",
-                fd,
-                offset,
-                len,
-                advice);
+    ECHECK(_socketaddr_to_str(addr, addrstr, MAX_IPADDR_LEN));
 
-            /* ATTN: no-op */
-            BREAK(_return(n, 0));
-        }
-        case SYS_timer_create:
-            break;
-        case SYS_timer_settime:
-            break;
-        case SYS_timer_gettime:
-            break;
-        case SYS_timer_getoverrun:
-            break;
-        case SYS_timer_delete:
-            break;
-        case SYS_clock_settime:
-        {
-            clockid_t clk_id = (clockid_t)x1;
-            struct timespec* tp = (struct timespec*)x2;
+    _strace(
+        n, "sockfd=%d addr=%s addrlen=%u", sockfd, addrstr, addrlen);
 
-            _strace(n, "clk_id=%u tp=%p", clk_id, tp);
+    ret = myst_syscall_bind(sockfd, addr, addrlen);
+    return _return(n, ret);
 
-            BREAK(_return(n, myst_syscall_clock_settime(clk_id, tp)));
-        }
-        case SYS_clock_gettime:
-        {
-            clockid_t clk_id = (clockid_t)x1;
-            struct timespec* tp = (struct timespec*)x2;
+done:
+    return _return(n, ret);
+}
 
-            _strace(n, "clk_id=%u tp=%p", clk_id, tp);
+static long _sys_connect(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+
+    /* connect() and bind() have the same parameters */
+    int sockfd = (int)x1;
+    const struct sockaddr* addr = (const struct sockaddr*)x2;
+    socklen_t addrlen = (socklen_t)x3;
+    long ret;
+    char addrstr[MAX_IPADDR_LEN];
 
-            BREAK(_return(n, myst_syscall_clock_gettime(clk_id, tp)));
-        }
-        case SYS_clock_getres:
-        {
-            clockid_t clk_id = (clockid_t)x1;
-            struct timespec* res = (struct timespec*)x2;
+    ECHECK(_socketaddr_to_str(addr, addrstr, MAX_IPADDR_LEN));
 
-            _strace(n, "clk_id=%u tp=%p", clk_id, res);
+    _strace(
+        n,
+        "sockfd=%d addrlen=%u family=%u ip=%s",
+        sockfd,
+        addrlen,
+        addr->sa_family,
+        addrstr);
 
-            BREAK(_return(n, myst_syscall_clock_getres(clk_id, res)));
-        }
-        case SYS_clock_nanosleep:
-            break;
-        case SYS_exit_group:
-        {
-            int status = (int)x1;
-            _strace(n, "status=%d", status);
+    ret = myst_syscall_connect(sockfd, addr, addrlen);
+    return _return(n, ret);
 
-            myst_kill_thread_group();
-            BREAK(_return(n, 0));
-        }
-        case SYS_epoll_wait:
-        {
-            int epfd = (int)x1;
-            struct epoll_event* events = (struct epoll_event*)x2;
-            int maxevents = (int)x3;
-            int timeout = (int)x4;
-            long ret;
+done:
+    return _return(n, ret);
+}
 
-            _strace(
-                n,
-                "edpf=%d events=%p maxevents=%d timeout=%d",
-                epfd,
-                events,
-                maxevents,
-                timeout);
-
-            ret = myst_syscall_epoll_wait(epfd, events, maxevents, timeout);
-            BREAK(_return(n, ret));
-        }
-        case SYS_epoll_ctl:
-        {
-            int epfd = (int)x1;
-            int op = (int)x2;
-            int fd = (int)x3;
-            struct epoll_event* event = (struct epoll_event*)x4;
-            long ret;
+static long _sys_recvfrom(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+    long x6 = args->params[5];
+
+    int sockfd = (int)x1;
+    void* buf = (void*)x2;
+    size_t len = (size_t)x3;
+    int flags = (int)x4;
+    struct sockaddr* src_addr = (struct sockaddr*)x5;
+    socklen_t* addrlen = (socklen_t*)x6;
+    long ret = 0;
+    char addrstr[MAX_IPADDR_LEN];
 
-            _strace(n, "edpf=%d op=%d fd=%d event=%p", epfd, op, fd, event);
+    ECHECK(_socketaddr_to_str(src_addr, addrstr, MAX_IPADDR_LEN));
 
-            ret = myst_syscall_epoll_ctl(epfd, op, fd, event);
-            BREAK(_return(n, ret));
-        }
-        case SYS_tgkill:
-        {
-            int tgid = (int)x1;
-            int tid = (int)x2;
-            int sig = (int)x3;
+    _strace(
+        n,
+        "sockfd=%d buf=%p len=%zu flags=%d src_addr=%s addrlen=%p",
+        sockfd,
+        buf,
+        len,
+        flags,
+        addrstr,
+        addrlen);
 
-            _strace(n, "tgid=%d tid=%d sig=%d", tgid, tid, sig);
+#ifdef MYST_NO_RECVMSG_MITIGATION
+    ret = myst_syscall_recvfrom(
+        sockfd, buf, len, flags, src_addr, addrlen);
+#else  /* MYST_NO_RECVMSG_WORKAROUND */
+    /* ATTN: this mitigation introduces a severe performance penalty */
+    // This mitigation works around a problem with a certain
+    // application that fails handle EGAIN. This should be removed
+    // when possible.
+    for (size_t i = 0; i < 10; i++)
+    {
+        ret = myst_syscall_recvfrom(
+            sockfd, buf, len, flags, src_addr, addrlen);
 
-            long ret = myst_syscall_tgkill(tgid, tid, sig);
-            BREAK(_return(n, ret));
-        }
-        case SYS_utimes:
+        if (ret != -EAGAIN)
             break;
-        case SYS_vserver:
-            break;
-        case SYS_mbind:
+
         {
-            void* addr = (void*)x1;
-            unsigned long len = (unsigned long)x2;
-            int mode = (int)x3;
-            const unsigned long* nodemask = (const unsigned long*)x4;
-            unsigned long maxnode = (unsigned long)x5;
-            unsigned flags = (unsigned)x6;
-
-            _strace(
-                n,
-                "addr=%p len=%lu mode=%d nodemask=%p maxnode=%lu flags=%u",
-                addr,
-                len,
-                mode,
-                nodemask,
-                maxnode,
-                flags);
-
-            long ret =
-                myst_syscall_mbind(addr, len, mode, nodemask, maxnode, flags);
-            BREAK(_return(n, ret));
+            struct timespec req;
+            req.tv_sec = 0;
+            req.tv_nsec = 1000000000 / 10;
+            long args[6];
+            args[0] = (long)&req;
+            args[1] = (long)NULL;
+            _forward_syscall(SYS_nanosleep, args);
+            continue;
         }
-        case SYS_set_mempolicy:
-            break;
-        case SYS_get_mempolicy:
-            break;
-        case SYS_mq_open:
-            break;
-        case SYS_mq_unlink:
-            break;
-        case SYS_mq_timedsend:
-            break;
-        case SYS_mq_timedreceive:
-            break;
-        case SYS_mq_notify:
-            break;
-        case SYS_mq_getsetattr:
-            break;
-        case SYS_kexec_load:
-            break;
-        case SYS_waitid:
-            break;
-        case SYS_add_key:
-            break;
-        case SYS_request_key:
-            break;
-        case SYS_keyctl:
-            break;
-        case SYS_ioprio_set:
-            break;
-        case SYS_ioprio_get:
-            break;
-        case SYS_inotify_init:
-        {
-            _strace(n, NULL);
+    }
+#endif /* MYST_NO_RECVMSG_WORKAROUND */
+    return _return(n, ret);
 
-            long ret = myst_syscall_inotify_init1(0);
-            BREAK(_return(n, ret));
-        }
-        case SYS_inotify_add_watch:
-        {
-            int fd = (int)x1;
-            const char* pathname = (const char*)x2;
-            uint32_t mask = (uint32_t)x3;
+done:
+    return _return(n, ret);
+}
 
-            _strace(n, "fd=%d pathname=%s mask=%x", fd, pathname, mask);
+static long _sys_sendto(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+    long x6 = args->params[5];
+
+    int sockfd = (int)x1;
+    void* buf = (void*)x2;
+    size_t len = (size_t)x3;
+    int flags = (int)x4;
+    struct sockaddr* dest_addr = (struct sockaddr*)x5;
+    socklen_t addrlen = (socklen_t)x6;
+    long ret = 0;
+    char addrstr[MAX_IPADDR_LEN];
 
-            long ret = myst_syscall_inotify_add_watch(fd, pathname, mask);
-            BREAK(_return(n, ret));
-            break;
-        }
-        case SYS_inotify_rm_watch:
-        {
-            int fd = (int)x1;
-            int wd = (int)x2;
+    ECHECK(_socketaddr_to_str(dest_addr, addrstr, MAX_IPADDR_LEN));
 
-            _strace(n, "fd=%d wd=%d", fd, wd);
+    _strace(
+        n,
+        "sockfd=%d buf=%p len=%zu flags=%d dest_addr=%s addrlen=%u",
+        sockfd,
+        buf,
+        len,
+        flags,
+        addrstr,
+        addrlen);
 
-            long ret = myst_syscall_inotify_rm_watch(fd, wd);
-            BREAK(_return(n, ret));
-            break;
-        }
-        case SYS_migrate_pages:
-            break;
-        case SYS_openat:
-        {
-            int dirfd = (int)x1;
-            const char* path = (const char*)x2;
-            int flags = (int)x3;
-            mode_t mode = (mode_t)x4;
-            long ret;
+    ret = myst_syscall_sendto(
+        sockfd, buf, len, flags, dest_addr, addrlen);
 
-            _strace(
-                n,
-                "dirfd=%d path=\"%s\" flags=0%o mode=0%o",
-                dirfd,
-                path,
-                flags,
-                mode);
+    return _return(n, ret);
+
+done:
+    return _return(n, ret);
+}
 
-            ret = myst_syscall_openat(dirfd, path, flags, mode);
+static long _sys_socket(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_mkdirat:
-            break;
-        case SYS_mknodat:
-            break;
-        case SYS_futimesat:
-        {
-            int dirfd = (int)x1;
-            const char* pathname = (const char*)x2;
-            const struct timeval* times = (const struct timeval*)x3;
-            long ret;
+    int domain = (int)x1;
+    int type = (int)x2;
+    int protocol = (int)x3;
+    long ret;
 
-            _strace(n, "dirfd=%d pathname=%s times=%p", dirfd, pathname, times);
+    _strace(n, "domain=%d type=%o protocol=%d", domain, type, protocol);
 
-            ret = myst_syscall_futimesat(dirfd, pathname, times);
-            BREAK(_return(n, ret));
-        }
-        case SYS_newfstatat:
-        {
-            int dirfd = (int)x1;
-            const char* pathname = (const char*)x2;
-            struct stat* statbuf = (struct stat*)x3;
-            int flags = (int)x4;
-            long ret;
+    ret = myst_syscall_socket(domain, type, protocol);
+    return _return(n, ret);
+}
 
-            _strace(
-                n,
-                "dirfd=%d pathname=%s statbuf=%p flags=%d",
-                dirfd,
-                pathname,
-                statbuf,
-                flags);
-
-            ret = myst_syscall_fstatat(dirfd, pathname, statbuf, flags);
-            BREAK(_return(n, ret));
-            break;
-        }
-        case SYS_unlinkat:
-        {
-            int dirfd = (int)x1;
-            const char* pathname = (const char*)x2;
-            int flags = (int)x3;
+static long _sys_accept(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            _strace(n, "dirfd=%d pathname=%s flags=%d", dirfd, pathname, flags);
+    int sockfd = (int)x1;
+    struct sockaddr* addr = (struct sockaddr*)x2;
+    socklen_t* addrlen = (socklen_t*)x3;
+    long ret;
+    char addrstr[MAX_IPADDR_LEN];
 
-            BREAK(_return(n, myst_syscall_unlinkat(dirfd, pathname, flags)));
-        }
-        case SYS_renameat:
-        {
-            int olddirfd = (int)x1;
-            const char* oldpath = (const char*)x2;
-            int newdirfd = (int)x3;
-            const char* newpath = (const char*)x4;
+    ECHECK(_socketaddr_to_str(addr, addrstr, MAX_IPADDR_LEN));
 
-            _strace(
-                n,
-                "olddirfd=%d oldpath=\"%s\" newdirfd=%d newpath=\"%s\"",
-                olddirfd,
-                oldpath,
-                newdirfd,
-                newpath);
+    _strace(
+        n, "sockfd=%d addr=%s addrlen=%p", sockfd, addrstr, addrlen);
 
-            BREAK(_return(
-                n,
-                myst_syscall_renameat(olddirfd, oldpath, newdirfd, newpath)));
-        }
-        case SYS_linkat:
-            break;
-        case SYS_symlinkat:
-        {
-            const char* target = (const char*)x1;
-            int newdirfd = (int)x2;
-            const char* linkpath = (const char*)x3;
+    ret = myst_syscall_accept4(sockfd, addr, addrlen, 0);
+    return _return(n, ret);
 
-            _strace(
-                n,
-                "target=%s newdirfd=%d linkpath=%s",
-                target,
-                newdirfd,
-                linkpath);
+done:
+    return _return(n, ret);
+}
 
-            BREAK(
-                _return(n, myst_syscall_symlinkat(target, newdirfd, linkpath)));
-        }
-        case SYS_readlinkat:
-        {
-            int dirfd = (int)x1;
-            const char* pathname = (const char*)x2;
-            char* buf = (char*)x3;
-            size_t bufsiz = (size_t)x4;
+static long _sys_sendmsg(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            _strace(
-                n,
-                "dirfd=%d pathname=%s buf=%p bufsize=%ld",
-                dirfd,
-                pathname,
-                buf,
-                bufsiz);
-
-            BREAK(_return(
-                n, myst_syscall_readlinkat(dirfd, pathname, buf, bufsiz)));
-        }
-        case SYS_fchmodat:
-            break;
-        case SYS_faccessat:
-        {
-            int dirfd = (int)x1;
-            const char* pathname = (const char*)x2;
-            int mode = (int)x3;
-            int flags = (int)x4;
+    int sockfd = (int)x1;
+    const struct msghdr* msg = (const struct msghdr*)x2;
+    int flags = (int)x3;
+    long ret;
 
-            _strace(
-                n,
-                "dirfd=%d pathname=%s mode=%d flags=%d",
-                dirfd,
-                pathname,
-                mode,
-                flags);
-
-            BREAK(_return(
-                n, myst_syscall_faccessat(dirfd, pathname, mode, flags)));
-        }
-        case SYS_pselect6:
-            break;
-        case SYS_ppoll:
-            break;
-        case SYS_unshare:
-            break;
-        case SYS_set_robust_list:
-        {
-            struct myst_robust_list_head* head = (void*)x1;
-            size_t len = (size_t)x2;
-            long ret;
+    _strace(n, "sockfd=%d msg=%p flags=%d", sockfd, msg, flags);
 
-            _strace(n, "head=%p len=%zu", head, len);
+    ret = myst_syscall_sendmsg(sockfd, msg, flags);
+    return _return(n, ret);
+}
 
-            ret = myst_syscall_set_robust_list(head, len);
-            BREAK(_return(n, ret));
-        }
-        case SYS_get_robust_list:
-        {
-            int pid = (int)x1;
-            struct myst_robust_list_head** head_ptr = (void*)x2;
-            size_t* len_ptr = (size_t*)x3;
-            long ret;
+static long _sys_recvmsg(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            _strace(n, "pid=%d head=%p len=%p", pid, head_ptr, len_ptr);
+    int sockfd = (int)x1;
+    struct msghdr* msg = (struct msghdr*)x2;
+    int flags = (int)x3;
+    long ret;
 
-            ret = myst_syscall_get_robust_list(pid, head_ptr, len_ptr);
-            BREAK(_return(n, ret));
-        }
-        case SYS_splice:
-            break;
-        case SYS_tee:
-            break;
-        case SYS_sync_file_range:
-            break;
-        case SYS_vmsplice:
-            break;
-        case SYS_move_pages:
-            break;
-        case SYS_utimensat:
-        {
-            int dirfd = (int)x1;
-            const char* pathname = (const char*)x2;
-            const struct timespec* times = (const struct timespec*)x3;
-            int flags = (int)x4;
-            long ret;
+    _strace(n, "sockfd=%d msg=%p flags=%d", sockfd, msg, flags);
 
-            _strace(
-                n,
-                "dirfd=%d pathname=%s times=%p flags=%o",
-                dirfd,
-                pathname,
-                times,
-                flags);
-
-            ret = myst_syscall_utimensat(dirfd, pathname, times, flags);
-            BREAK(_return(n, ret));
-        }
-        case SYS_epoll_pwait:
-        {
-            int epfd = (int)x1;
-            struct epoll_event* events = (struct epoll_event*)x2;
-            int maxevents = (int)x3;
-            int timeout = (int)x4;
-            const sigset_t* sigmask = (const sigset_t*)x5;
-            long ret;
-
-            _strace(
-                n,
-                "edpf=%d events=%p maxevents=%d timeout=%d sigmask=%p",
-                epfd,
-                events,
-                maxevents,
-                timeout,
-                sigmask);
-
-            /* ATTN: ignore sigmask */
-            ret = myst_syscall_epoll_wait(epfd, events, maxevents, timeout);
-            BREAK(_return(n, ret));
-        }
-        case SYS_signalfd:
-            break;
-        case SYS_timerfd_create:
-            break;
-        case SYS_eventfd:
-            break;
-        case SYS_fallocate:
-        {
-            int fd = (int)x1;
-            int mode = (int)x2;
-            off_t offset = (off_t)x3;
-            off_t len = (off_t)x4;
+    ret = myst_syscall_recvmsg(sockfd, msg, flags);
+    return _return(n, ret);
+}
 
-            _strace(
-                n, "fd=%d mode=%d offset=%ld len=%ld", fd, mode, offset, len);
+static long _sys_sendmmsg(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int sockfd = (int)x1;
+    struct mmsghdr* msgvec = (struct mmsghdr*)x2;
+    unsigned int vlen = (unsigned int)x3;
+    int flags = (int)x4;
+    long ret;
 
-            /* ATTN: treated as advisory only */
-            BREAK(_return(n, 0));
-        }
-        case SYS_timerfd_settime:
-            break;
-        case SYS_timerfd_gettime:
-            break;
-        case SYS_accept4:
-        {
-            int sockfd = (int)x1;
-            struct sockaddr* addr = (struct sockaddr*)x2;
-            socklen_t* addrlen = (socklen_t*)x3;
-            int flags = (int)x4;
-            long ret;
-            char addrstr[MAX_IPADDR_LEN];
+    _strace(
+        n, "sockfd=%d msgvec=%p vlen=%u flags=%d", sockfd, msgvec, vlen, flags);
 
-            ECHECK(_socketaddr_to_str(addr, addrstr, MAX_IPADDR_LEN));
+    ret = myst_syscall_sendmmsg(sockfd, msgvec, vlen, flags);
+    return _return(n, ret);
+}
 
-            _strace(
-                n,
-                "sockfd=%d addr=%s addrlen=%p flags=%x",
-                sockfd,
-                addrstr,
-                addrlen,
-                flags);
-
-            ret = myst_syscall_accept4(sockfd, addr, addrlen, flags);
-            BREAK(_return(n, ret));
-        }
-        case SYS_signalfd4:
-            break;
-        case SYS_eventfd2:
-        {
-            unsigned int initval = (unsigned int)x1;
-            int flags = (int)x2;
+static long _sys_recvmmsg(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+
+    int sockfd = (int)x1;
+    struct mmsghdr* msgvec = (struct mmsghdr*)x2;
+    unsigned int vlen = (unsigned int)x3;
+    int flags = (int)x4;
+    struct timespec* timeout = (struct timespec*)x5;
+    long ret;
 
-            _strace(n, "initval=%u flags=%d", initval, flags);
+    _strace(
+        n,
+        "sockfd=%d msgvec=%p vlen=%u flags=%d timeout=%p",
+        sockfd,
+        msgvec,
+        vlen,
+        flags,
+        timeout);
+
+    ret = myst_syscall_recvmmsg(sockfd, msgvec, vlen, flags, timeout);
+    return _return(n, ret);
+}
 
-            long ret = myst_syscall_eventfd(initval, flags);
-            BREAK(_return(n, ret));
-        }
-        case SYS_epoll_create1:
-        {
-            int flags = (int)x1;
+static long _sys_shutdown(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            _strace(n, "flags=%d", flags);
-            BREAK(_return(n, myst_syscall_epoll_create1(flags)));
-        }
-        case SYS_pipe2:
-        {
-            int* pipefd = (int*)x1;
-            int flags = (int)x2;
-            long ret;
+    int sockfd = (int)x1;
+    int how = (int)x2;
+    long ret;
 
-            _strace(n, "pipefd=%p flags=%0o", pipefd, flags);
-            ret = myst_syscall_pipe2(pipefd, flags);
+    _strace(n, "sockfd=%d how=%d", sockfd, how);
 
-            if (__myst_kernel_args.trace_syscalls)
-                myst_eprintf("    pipefd[]=[%d:%d]\n", pipefd[0], pipefd[1]);
+    if (__myst_kernel_args.perf)
+        myst_print_syscall_times("SYS_shutdown", 10);
 
-            BREAK(_return(n, ret));
-        }
-        case SYS_inotify_init1:
-        {
-            int flags = (int)x1;
+    ret = myst_syscall_shutdown(sockfd, how);
+    return _return(n, ret);
+}
 
-            _strace(n, "flags=%x", flags);
+static long _sys_listen(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
 
-            long ret = myst_syscall_inotify_init1(flags);
-            BREAK(_return(n, ret));
-        }
-        case SYS_preadv:
-        {
-            int fd = (int)x1;
-            const struct iovec* iov = (const struct iovec*)x2;
-            int iovcnt = (int)x3;
-            off_t offset = (off_t)x4;
+    int sockfd = (int)x1;
+    int backlog = (int)x2;
+    long ret;
 
-            _strace(
-                n,
-                "fd=%d iov=%p iovcnt=%d offset=%zu",
-                fd,
-                iov,
-                iovcnt,
-                offset);
-
-            long ret = myst_syscall_preadv2(fd, iov, iovcnt, offset, 0);
-            BREAK(_return(n, ret));
-        }
-        case SYS_pwritev:
-        {
-            int fd = (int)x1;
-            const struct iovec* iov = (const struct iovec*)x2;
-            int iovcnt = (int)x3;
-            off_t offset = (off_t)x4;
+    _strace(n, "sockfd=%d backlog=%d", sockfd, backlog);
 
-            _strace(
-                n,
-                "fd=%d iov=%p iovcnt=%d offset=%zu",
-                fd,
-                iov,
-                iovcnt,
-                offset);
-
-            long ret = myst_syscall_pwritev2(fd, iov, iovcnt, offset, 0);
-            BREAK(_return(n, ret));
-        }
-        case SYS_rt_tgsigqueueinfo:
-            break;
-        case SYS_perf_event_open:
-            break;
-        case SYS_recvmmsg:
-            break;
-        case SYS_fanotify_init:
-            break;
-        case SYS_fanotify_mark:
-            break;
-        case SYS_prlimit64:
-        {
-            int pid = (int)x1;
-            int resource = (int)x2;
-            struct rlimit* new_rlim = (struct rlimit*)x3;
-            struct rlimit* old_rlim = (struct rlimit*)x4;
+    if (__myst_kernel_args.perf)
+        myst_print_syscall_times("SYS_listen", 10);
 
-            _strace(
-                n,
-                "pid=%d, resource=%d, new_rlim=%p, old_rlim=%p",
-                pid,
-                resource,
-                new_rlim,
-                old_rlim);
+    ret = myst_syscall_listen(sockfd, backlog);
+    return _return(n, ret);
+}
 
-            int ret = myst_syscall_prlimit64(pid, resource, new_rlim, old_rlim);
-            BREAK(_return(n, ret));
-        }
-        case SYS_name_to_handle_at:
-            break;
-        case SYS_open_by_handle_at:
-            break;
-        case SYS_clock_adjtime:
-            break;
-        case SYS_syncfs:
-            break;
-        case SYS_sendmmsg:
-            break;
-        case SYS_setns:
-            break;
-        case SYS_getcpu:
-        {
-            unsigned* cpu = (unsigned*)x1;
-            unsigned* node = (unsigned*)x2;
-            struct getcpu_cache* tcache = (struct getcpu_cache*)x3;
-            long ret;
+static long _sys_getsockname(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            _strace(n, "cpu=%p node=%p, tcache=%p", cpu, node, tcache);
+    int sockfd = (int)x1;
+    struct sockaddr* addr = (struct sockaddr*)x2;
+    socklen_t* addrlen = (socklen_t*)x3;
+    long ret;
+    char addrstr[MAX_IPADDR_LEN];
 
-            /* unused since Linux 2.6.24 */
-            (void)tcache;
+    ECHECK(_socketaddr_to_str(addr, addrstr, MAX_IPADDR_LEN));
 
-            ret = myst_syscall_getcpu(cpu, node);
-            BREAK(_return(n, ret));
-        }
-        case SYS_process_vm_readv:
-            break;
-        case SYS_process_vm_writev:
-            break;
-        case SYS_kcmp:
-            break;
-        case SYS_finit_module:
-            break;
-        case SYS_sched_setattr:
-            break;
-        case SYS_sched_getattr:
-            break;
-        case SYS_renameat2:
-            break;
-        case SYS_seccomp:
-            break;
-        case SYS_getrandom:
-        {
-            void* buf = (void*)x1;
-            size_t buflen = (size_t)x2;
-            unsigned int flags = (unsigned int)x3;
+    _strace(
+        n, "sockfd=%d addr=%s addrlen=%p", sockfd, addrstr, addrlen);
 
-            _strace(n, "buf=%p buflen=%zu flags=%d", buf, buflen, flags);
+    ret = myst_syscall_getsockname(sockfd, addr, addrlen);
+    return _return(n, ret);
 
-            BREAK(_return(n, myst_syscall_getrandom(buf, buflen, flags)));
-        }
-        case SYS_memfd_create:
-            break;
-        case SYS_kexec_file_load:
-            break;
-        case SYS_bpf:
-            break;
-        case SYS_execveat:
-            break;
-        case SYS_userfaultfd:
-            break;
-        case SYS_membarrier:
-        {
-            int cmd = (int)x1;
-            int flags = (int)x2;
-
-            _strace(n, "cmd=%d flags=%d", cmd, flags);
-            /* membarrier syscall relies on inter-processor-interrupt and the
-             * untrusted privileged SW layer such as the hypervisor or bare
-             * metal OS to sychronize code execution across CPU cores. Not
-             * supported.
-             */
-            BREAK(_return(n, -ENOSYS));
-        }
-        case SYS_mlock2:
-            break;
-        case SYS_copy_file_range:
-            break;
-        case SYS_preadv2:
-        {
-            int fd = (int)x1;
-            const struct iovec* iov = (const struct iovec*)x2;
-            int iovcnt = (int)x3;
-            off_t offset = (off_t)x4;
-            int flags = (int)x5;
+done:
+    return _return(n, ret);
+}
 
-            _strace(
-                n,
-                "fd=%d iov=%p iovcnt=%d offset=%zu",
-                fd,
-                iov,
-                iovcnt,
-                offset);
-
-            long ret = myst_syscall_preadv2(fd, iov, iovcnt, offset, flags);
-            BREAK(_return(n, ret));
-        }
-        case SYS_pwritev2:
-        {
-            int fd = (int)x1;
-            const struct iovec* iov = (const struct iovec*)x2;
-            int iovcnt = (int)x3;
-            off_t offset = (off_t)x4;
-            int flags = (int)x5;
+static long _sys_getpeername(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
 
-            _strace(
-                n,
-                "fd=%d iov=%p iovcnt=%d offset=%zu",
-                fd,
-                iov,
-                iovcnt,
-                offset);
-
-            long ret = myst_syscall_pwritev2(fd, iov, iovcnt, offset, flags);
-            BREAK(_return(n, ret));
-        }
-        case SYS_pkey_mprotect:
-            break;
-        case SYS_pkey_alloc:
-            break;
-        case SYS_pkey_free:
-            break;
-        case SYS_statx:
-            break;
-        case SYS_io_pgetevents:
-            break;
-        case SYS_rseq:
-            break;
-        case SYS_bind:
-        {
-            int sockfd = (int)x1;
-            const struct sockaddr* addr = (const struct sockaddr*)x2;
-            socklen_t addrlen = (socklen_t)x3;
-            long ret;
-            char addrstr[MAX_IPADDR_LEN];
+    int sockfd = (int)x1;
+    struct sockaddr* addr = (struct sockaddr*)x2;
+    socklen_t* addrlen = (socklen_t*)x3;
+    long ret;
+    char addrstr[MAX_IPADDR_LEN];
 
-            ECHECK(_socketaddr_to_str(addr, addrstr, MAX_IPADDR_LEN));
+    ECHECK(_socketaddr_to_str(addr, addrstr, MAX_IPADDR_LEN));
 
-            _strace(
-                n, "sockfd=%d addr=%s addrlen=%u", sockfd, addrstr, addrlen);
+    _strace(
+        n, "sockfd=%d addr=%s addrlen=%p", sockfd, addrstr, addrlen);
 
-            ret = myst_syscall_bind(sockfd, addr, addrlen);
-            BREAK(_return(n, ret));
-        }
-        case SYS_connect:
-        {
-            /* connect() and bind() have the same parameters */
-            int sockfd = (int)x1;
-            const struct sockaddr* addr = (const struct sockaddr*)x2;
-            socklen_t addrlen = (socklen_t)x3;
-            long ret;
-            char addrstr[MAX_IPADDR_LEN];
+    ret = myst_syscall_getpeername(sockfd, addr, addrlen);
+    return _return(n, ret);
 
-            ECHECK(_socketaddr_to_str(addr, addrstr, MAX_IPADDR_LEN));
+done:
+    return _return(n, ret);
+}
 
-            _strace(
-                n,
-                "sockfd=%d addrlen=%u family=%u ip=%s",
-                sockfd,
-                addrlen,
-                addr->sa_family,
-                addrstr);
-
-            ret = myst_syscall_connect(sockfd, addr, addrlen);
-            BREAK(_return(n, ret));
-        }
-        case SYS_recvfrom:
-        {
-            int sockfd = (int)x1;
-            void* buf = (void*)x2;
-            size_t len = (size_t)x3;
-            int flags = (int)x4;
-            struct sockaddr* src_addr = (struct sockaddr*)x5;
-            socklen_t* addrlen = (socklen_t*)x6;
-            long ret = 0;
-            char addrstr[MAX_IPADDR_LEN];
-
-            ECHECK(_socketaddr_to_str(src_addr, addrstr, MAX_IPADDR_LEN));
-
-            _strace(
-                n,
-                "sockfd=%d buf=%p len=%zu flags=%d src_addr=%s addrlen=%p",
-                sockfd,
-                buf,
-                len,
-                flags,
-                addrstr,
-                addrlen);
+static long _sys_socketpair(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int domain = (int)x1;
+    int type = (int)x2;
+    int protocol = (int)x3;
+    int* sv = (int*)x4;
+    long ret;
 
-#ifdef MYST_NO_RECVMSG_MITIGATION
-            ret = myst_syscall_recvfrom(
-                sockfd, buf, len, flags, src_addr, addrlen);
-#else  /* MYST_NO_RECVMSG_WORKAROUND */
-            /* ATTN: this mitigation introduces a severe performance penalty */
-            // This mitigation works around a problem with a certain
-            // application that fails handle EGAIN. This should be removed
-            // when possible.
-            for (size_t i = 0; i < 10; i++)
-            {
-                ret = myst_syscall_recvfrom(
-                    sockfd, buf, len, flags, src_addr, addrlen);
-
-                if (ret != -EAGAIN)
-                    break;
-
-                {
-                    struct timespec req;
-                    req.tv_sec = 0;
-                    req.tv_nsec = 1000000000 / 10;
-                    long args[6];
-                    args[0] = (long)&req;
-                    args[1] = (long)NULL;
-                    _forward_syscall(SYS_nanosleep, args);
-                    continue;
-                }
-            }
-#endif /* MYST_NO_RECVMSG_WORKAROUND */
-            BREAK(_return(n, ret));
-        }
-        case SYS_sendto:
-        {
-            int sockfd = (int)x1;
-            void* buf = (void*)x2;
-            size_t len = (size_t)x3;
-            int flags = (int)x4;
-            struct sockaddr* dest_addr = (struct sockaddr*)x5;
-            socklen_t addrlen = (socklen_t)x6;
-            long ret = 0;
-            char addrstr[MAX_IPADDR_LEN];
-
-            ECHECK(_socketaddr_to_str(dest_addr, addrstr, MAX_IPADDR_LEN));
-
-            _strace(
-                n,
-                "sockfd=%d buf=%p len=%zu flags=%d dest_addr=%s addrlen=%u",
-                sockfd,
-                buf,
-                len,
-                flags,
-                addrstr,
-                addrlen);
-
-            ret = myst_syscall_sendto(
-                sockfd, buf, len, flags, dest_addr, addrlen);
-
-            BREAK(_return(n, ret));
-        }
-        case SYS_socket:
-        {
-            int domain = (int)x1;
-            int type = (int)x2;
-            int protocol = (int)x3;
-            long ret;
+    _strace(
+        n,
+        "domain=%d type=%d protocol=%d sv=%p",
+        domain,
+        type,
+        protocol,
+        sv);
 
-            _strace(n, "domain=%d type=%o protocol=%d", domain, type, protocol);
+    ret = myst_syscall_socketpair(domain, type, protocol, sv);
+    return _return(n, ret);
+}
 
-            ret = myst_syscall_socket(domain, type, protocol);
-            BREAK(_return(n, ret));
-        }
-        case SYS_accept:
-        {
-            int sockfd = (int)x1;
-            struct sockaddr* addr = (struct sockaddr*)x2;
-            socklen_t* addrlen = (socklen_t*)x3;
-            long ret;
-            char addrstr[MAX_IPADDR_LEN];
+static long _sys_setsockopt(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+
+    int sockfd = (int)x1;
+    int level = (int)x2;
+    int optname = (int)x3;
+    const void* optval = (const void*)x4;
+    socklen_t optlen = (socklen_t)x5;
+    long ret;
 
-            ECHECK(_socketaddr_to_str(addr, addrstr, MAX_IPADDR_LEN));
+    _strace(
+        n,
+        "sockfd=%d level=%d optname=%d optval=%p optlen=%u",
+        sockfd,
+        level,
+        optname,
+        optval,
+        optlen);
+
+    ret =
+        myst_syscall_setsockopt(sockfd, level, optname, optval, optlen);
+    return _return(n, ret);
+}
 
-            _strace(
-                n, "sockfd=%d addr=%s addrlen=%p", sockfd, addrstr, addrlen);
+static long _sys_getsockopt(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+    long x5 = args->params[4];
+
+    int sockfd = (int)x1;
+    int level = (int)x2;
+    int optname = (int)x3;
+    void* optval = (void*)x4;
+    socklen_t* optlen = (socklen_t*)x5;
+    long ret;
 
-            ret = myst_syscall_accept4(sockfd, addr, addrlen, 0);
-            BREAK(_return(n, ret));
-        }
-        case SYS_sendmsg:
-        {
-            int sockfd = (int)x1;
-            const struct msghdr* msg = (const struct msghdr*)x2;
-            int flags = (int)x3;
-            long ret;
+    _strace(
+        n,
+        "sockfd=%d level=%d optname=%d optval=%p optlen=%p",
+        sockfd,
+        level,
+        optname,
+        optval,
+        optlen);
+
+    ret =
+        myst_syscall_getsockopt(sockfd, level, optname, optval, optlen);
+    return _return(n, ret);
+}
 
-            _strace(n, "sockfd=%d msg=%p flags=%d", sockfd, msg, flags);
+static long _sys_sendfile(syscall_args_t* args)
+{
+    long n = args->n;
+    long x1 = args->params[0];
+    long x2 = args->params[1];
+    long x3 = args->params[2];
+    long x4 = args->params[3];
+
+    int out_fd = (int)x1;
+    int in_fd = (int)x2;
+    off_t* offset = (off_t*)x3;
+    size_t count = (size_t)x4;
+    off_t off = offset ? *offset : 0;
+
+    _strace(
+        n,
+        "out_fd=%d in_fd=%d offset=%p *offset=%ld count=%zu",
+        out_fd,
+        in_fd,
+        offset,
+        off,
+        count);
+
+    long ret = myst_syscall_sendfile(out_fd, in_fd, offset, count);
+    return _return(n, ret);
+}
+#pragma GCC diagnostic pop
 
-            ret = myst_syscall_sendmsg(sockfd, msg, flags);
-            BREAK(_return(n, ret));
-        }
-        case SYS_recvmsg:
-        {
-            int sockfd = (int)x1;
-            struct msghdr* msg = (struct msghdr*)x2;
-            int flags = (int)x3;
-            long ret;
+/* The syscall dispatch table (indexed by syscall number) */
+static const syscall_entry_t _syscall_table[] = {
+    [SYS_myst_trace] = {_sys_myst_trace, 0},
+    [SYS_myst_trace_ptr] = {_sys_myst_trace_ptr, 0},
+    [SYS_myst_dump_stack] = {_sys_myst_dump_stack, 0},
+    [SYS_myst_dump_ehdr] = {_sys_myst_dump_ehdr, 0},
+    [SYS_myst_dump_argv] = {_sys_myst_dump_argv, 0},
+    [SYS_myst_add_symbol_file] = {_sys_myst_add_symbol_file, 0},
+    [SYS_myst_load_symbols] = {_sys_myst_load_symbols, 0},
+    [SYS_myst_unload_symbols] = {_sys_myst_unload_symbols, 0},
+    [SYS_myst_gen_creds] = {_sys_myst_gen_creds, 0},
+    [SYS_myst_free_creds] = {_sys_myst_free_creds, 0},
+    [SYS_myst_gen_creds_ex] = {_sys_myst_gen_creds_ex, 0},
+    [SYS_myst_verify_cert] = {_sys_myst_verify_cert, 0},
+    [SYS_myst_max_threads] = {_sys_myst_max_threads, 0},
+    [SYS_myst_poll_wake] = {_sys_myst_poll_wake, 0},
+#ifdef MYST_ENABLE_GCOV
+    [SYS_myst_gcov] = {_sys_myst_gcov, 0},
+#endif
+    [SYS_myst_unmap_on_exit] = {_sys_myst_unmap_on_exit, 0},
+    [SYS_get_process_thread_stack] = {_sys_get_process_thread_stack, 0},
+    [SYS_read] = {_sys_read, 0},
+    [SYS_write] = {_sys_write, 0},
+    [SYS_pread64] = {_sys_pread64, 0},
+    [SYS_pwrite64] = {_sys_pwrite64, 0},
+    [SYS_open] = {_sys_open, 0},
+    [SYS_close] = {_sys_close, 0},
+    [SYS_stat] = {_sys_stat, 0},
+    [SYS_fstat] = {_sys_fstat, 0},
+    [SYS_lstat] = {_sys_lstat, 0},
+    [SYS_poll] = {_sys_poll, 0},
+    [SYS_lseek] = {_sys_lseek, 0},
+    [SYS_mmap] = {_sys_mmap, 0},
+    [SYS_mprotect] = {_sys_mprotect, 0},
+    [SYS_munmap] = {_sys_munmap, 0},
+    [SYS_brk] = {_sys_brk, 0},
+    [SYS_rt_sigaction] = {_sys_rt_sigaction, 0},
+    [SYS_rt_sigprocmask] = {_sys_rt_sigprocmask, 0},
+    [SYS_rt_sigreturn] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_ioctl] = {_sys_ioctl, 0},
+    [SYS_readv] = {_sys_readv, 0},
+    [SYS_writev] = {_sys_writev, 0},
+    [SYS_access] = {_sys_access, 0},
+    [SYS_pipe] = {_sys_pipe, 0},
+    [SYS_select] = {_sys_select, 0},
+    [SYS_sched_yield] = {_sys_sched_yield, 0},
+    [SYS_mremap] = {_sys_mremap, 0},
+    [SYS_msync] = {_sys_msync, 0},
+    /* ATTN: hook up implementation */
+    [SYS_mincore] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_madvise] = {_sys_madvise, 0},
+    [SYS_shmget] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_shmat] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_shmctl] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_dup] = {_sys_dup, 0},
+    [SYS_dup2] = {_sys_dup2, 0},
+    [SYS_dup3] = {_sys_dup3, 0},
+    [SYS_pause] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_nanosleep] = {_sys_nanosleep, 0},
+    [SYS_myst_run_itimer] = {_sys_myst_run_itimer, 0},
+    [SYS_myst_run_msync_flusher] = {_sys_myst_run_msync_flusher, 0},
+    [SYS_myst_run_aio_worker] = {_sys_myst_run_aio_worker, 0},
+    [SYS_myst_get_clock_page] = {_sys_myst_get_clock_page, 0},
+    [SYS_myst_start_shell] = {_sys_myst_start_shell, 0},
+    [SYS_getitimer] = {_sys_getitimer, 0},
+    [SYS_alarm] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_setitimer] = {_sys_setitimer, 0},
+    [SYS_getpid] = {_sys_getpid, 0},
+    /* unsupported: using SYS_myst_clone instead */
+    [SYS_clone] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_myst_clone] = {_sys_myst_clone, 0},
+    [SYS_myst_get_fork_info] = {_sys_myst_get_fork_info, 0},
+    [SYS_fork_wait_exec_exit] = {_sys_fork_wait_exec_exit, 0},
+    [SYS_myst_kill_wait_child_forks] = {_sys_myst_kill_wait_child_forks, 0},
+    [SYS_fork] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_vfork] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_execve] = {_sys_execve, 0},
+    [SYS_exit] = {_sys_exit, 0},
+    [SYS_wait4] = {_sys_wait4, 0},
+    [SYS_kill] = {_sys_kill, 0},
+    [SYS_uname] = {_sys_uname, 0},
+    [SYS_semget] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_semop] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_semctl] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_shmdt] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_msgget] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_msgsnd] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_msgrcv] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_msgctl] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_fcntl] = {_sys_fcntl, 0},
+    [SYS_flock] = {_sys_flock, 0},
+    [SYS_fsync] = {_sys_fsync, 0},
+    [SYS_fdatasync] = {_sys_fdatasync, 0},
+    [SYS_truncate] = {_sys_truncate, 0},
+    [SYS_ftruncate] = {_sys_ftruncate, 0},
+    [SYS_getdents] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_getcwd] = {_sys_getcwd, 0},
+    [SYS_chdir] = {_sys_chdir, 0},
+    [SYS_fchdir] = {_sys_fchdir, 0},
+    [SYS_rename] = {_sys_rename, 0},
+    [SYS_mkdir] = {_sys_mkdir, 0},
+    [SYS_rmdir] = {_sys_rmdir, 0},
+    [SYS_creat] = {_sys_creat, 0},
+    [SYS_link] = {_sys_link, 0},
+    [SYS_unlink] = {_sys_unlink, 0},
+    [SYS_symlink] = {_sys_symlink, 0},
+    [SYS_readlink] = {_sys_readlink, 0},
+    [SYS_chmod] = {_sys_chmod, 0},
+    [SYS_fchmod] = {_sys_fchmod, 0},
+    [SYS_chown] = {_sys_chown, 0},
+    [SYS_fchown] = {_sys_fchown, 0},
+    [SYS_fchownat] = {_sys_fchownat, 0},
+    [SYS_lchown] = {_sys_lchown, 0},
+    [SYS_umask] = {_sys_umask, 0},
+    [SYS_gettimeofday] = {_sys_gettimeofday, 0},
+    [SYS_getrlimit] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_getrusage] = {_sys_getrusage, 0},
+    [SYS_sysinfo] = {_sys_sysinfo, 0},
+    [SYS_times] = {_sys_times, 0},
+    [SYS_ptrace] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_syslog] = {_sys_syslog, 0},
+    [SYS_setpgid] = {_sys_setpgid, 0},
+    [SYS_getpgid] = {_sys_getpgid, 0},
+    [SYS_getpgrp] = {_sys_getpgrp, 0},
+    [SYS_getppid] = {_sys_getppid, 0},
+    [SYS_getsid] = {_sys_getsid, 0},
+    [SYS_setsid] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_getgroups] = {_sys_getgroups, 0},
+    [SYS_setgroups] = {_sys_setgroups, 0},
+    [SYS_getuid] = {_sys_getuid, 0},
+    [SYS_setuid] = {_sys_setuid, 0},
+    [SYS_getgid] = {_sys_getgid, 0},
+    [SYS_setgid] = {_sys_setgid, 0},
+    [SYS_geteuid] = {_sys_geteuid, 0},
+    [SYS_getegid] = {_sys_getegid, 0},
+    [SYS_setreuid] = {_sys_setreuid, 0},
+    [SYS_setregid] = {_sys_setregid, 0},
+    [SYS_setresuid] = {_sys_setresuid, 0},
+    [SYS_getresuid] = {_sys_getresuid, 0},
+    [SYS_setresgid] = {_sys_setresgid, 0},
+    [SYS_getresgid] = {_sys_getresgid, 0},
+    [SYS_setfsuid] = {_sys_setfsuid, 0},
+    [SYS_setfsgid] = {_sys_setfsgid, 0},
+    [SYS_capget] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_capset] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_rt_sigpending] = {_sys_rt_sigpending, 0},
+    [SYS_rt_sigtimedwait] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_rt_sigqueueinfo] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_rt_sigsuspend] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_sigaltstack] = {_sys_sigaltstack, 0},
+    [SYS_utime] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_mknod] = {_sys_mknod, 0},
+    [SYS_uselib] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_personality] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_ustat] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_statfs] = {_sys_statfs, 0},
+    [SYS_fstatfs] = {_sys_fstatfs, 0},
+    [SYS_sysfs] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_getpriority] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_setpriority] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_sched_setparam] = {_sys_sched_setparam, 0},
+    [SYS_sched_getparam] = {_sys_sched_getparam, 0},
+    [SYS_sched_setscheduler] = {_sys_sched_setscheduler, 0},
+    [SYS_sched_getscheduler] = {_sys_sched_getscheduler, 0},
+    [SYS_sched_get_priority_max] = {_sys_sched_get_priority_max, 0},
+    [SYS_sched_get_priority_min] = {_sys_sched_get_priority_min, 0},
+    [SYS_sched_rr_get_interval] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_mlock] = {_sys_mlock, 0},
+    [SYS_munlock] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_mlockall] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_munlockall] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_vhangup] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_modify_ldt] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_pivot_root] = {NULL, SYSCALL_UNHANDLED},
+    [SYS__sysctl] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_prctl] = {_sys_prctl, 0},
+    /* this is handled in myst_syscall() */
+    [SYS_arch_prctl] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_adjtimex] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_setrlimit] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_chroot] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_sync] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_acct] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_settimeofday] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_mount] = {_sys_mount, 0},
+    [SYS_umount2] = {_sys_umount2, 0},
+    [SYS_swapon] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_swapoff] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_reboot] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_sethostname] = {_sys_sethostname, 0},
+    [SYS_setdomainname] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_iopl] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_ioperm] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_create_module] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_init_module] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_delete_module] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_get_kernel_syms] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_query_module] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_quotactl] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_nfsservctl] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_getpmsg] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_putpmsg] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_afs_syscall] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_tuxcall] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_security] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_gettid] = {_sys_gettid, 0},
+    [SYS_readahead] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_setxattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_lsetxattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_fsetxattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_getxattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_lgetxattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_fgetxattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_listxattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_llistxattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_flistxattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_removexattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_lremovexattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_fremovexattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_tkill] = {_sys_tkill, 0},
+    [SYS_time] = {_sys_time, 0},
+    [SYS_futex] = {_sys_futex, 0},
+    [SYS_sched_setaffinity] = {_sys_sched_setaffinity, 0},
+    [SYS_sched_getaffinity] = {_sys_sched_getaffinity, 0},
+    [SYS_set_thread_area] = {_sys_set_thread_area, 0},
+    [SYS_io_setup] = {_sys_io_setup, 0},
+    [SYS_io_destroy] = {_sys_io_destroy, 0},
+    [SYS_io_getevents] = {_sys_io_getevents, 0},
+    [SYS_io_submit] = {_sys_io_submit, 0},
+    [SYS_io_cancel] = {_sys_io_cancel, 0},
+    [SYS_get_thread_area] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_lookup_dcookie] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_epoll_create] = {_sys_epoll_create, 0},
+    [SYS_epoll_ctl_old] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_epoll_wait_old] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_remap_file_pages] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_getdents64] = {_sys_getdents64, 0},
+    [SYS_set_tid_address] = {_sys_set_tid_address, 0},
+    [SYS_restart_syscall] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_semtimedop] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_fadvise64] = {_sys_fadvise64, 0},
+    [SYS_timer_create] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_timer_settime] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_timer_gettime] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_timer_getoverrun] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_timer_delete] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_clock_settime] = {_sys_clock_settime, 0},
+    [SYS_clock_gettime] = {_sys_clock_gettime, 0},
+    [SYS_clock_getres] = {_sys_clock_getres, 0},
+    [SYS_clock_nanosleep] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_exit_group] = {_sys_exit_group, 0},
+    [SYS_epoll_wait] = {_sys_epoll_wait, 0},
+    [SYS_epoll_ctl] = {_sys_epoll_ctl, 0},
+    [SYS_tgkill] = {_sys_tgkill, 0},
+    [SYS_utimes] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_vserver] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_mbind] = {_sys_mbind, 0},
+    [SYS_set_mempolicy] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_get_mempolicy] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_mq_open] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_mq_unlink] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_mq_timedsend] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_mq_timedreceive] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_mq_notify] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_mq_getsetattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_kexec_load] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_waitid] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_add_key] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_request_key] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_keyctl] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_ioprio_set] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_ioprio_get] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_inotify_init] = {_sys_inotify_init, 0},
+    [SYS_inotify_add_watch] = {_sys_inotify_add_watch, 0},
+    [SYS_inotify_rm_watch] = {_sys_inotify_rm_watch, 0},
+    [SYS_migrate_pages] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_openat] = {_sys_openat, 0},
+    [SYS_mkdirat] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_mknodat] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_futimesat] = {_sys_futimesat, 0},
+    [SYS_newfstatat] = {_sys_newfstatat, 0},
+    [SYS_unlinkat] = {_sys_unlinkat, 0},
+    [SYS_renameat] = {_sys_renameat, 0},
+    [SYS_linkat] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_symlinkat] = {_sys_symlinkat, 0},
+    [SYS_readlinkat] = {_sys_readlinkat, 0},
+    [SYS_fchmodat] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_faccessat] = {_sys_faccessat, 0},
+    [SYS_pselect6] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_ppoll] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_unshare] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_set_robust_list] = {_sys_set_robust_list, 0},
+    [SYS_get_robust_list] = {_sys_get_robust_list, 0},
+    [SYS_splice] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_tee] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_sync_file_range] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_vmsplice] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_move_pages] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_utimensat] = {_sys_utimensat, 0},
+    [SYS_epoll_pwait] = {_sys_epoll_pwait, 0},
+    [SYS_signalfd] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_timerfd_create] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_eventfd] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_fallocate] = {_sys_fallocate, 0},
+    [SYS_timerfd_settime] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_timerfd_gettime] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_accept4] = {_sys_accept4, 0},
+    [SYS_signalfd4] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_eventfd2] = {_sys_eventfd2, 0},
+    [SYS_epoll_create1] = {_sys_epoll_create1, 0},
+    [SYS_pipe2] = {_sys_pipe2, 0},
+    [SYS_inotify_init1] = {_sys_inotify_init1, 0},
+    [SYS_preadv] = {_sys_preadv, 0},
+    [SYS_pwritev] = {_sys_pwritev, 0},
+    [SYS_rt_tgsigqueueinfo] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_perf_event_open] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_recvmmsg] = {_sys_recvmmsg, 0},
+    [SYS_fanotify_init] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_fanotify_mark] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_prlimit64] = {_sys_prlimit64, 0},
+    [SYS_name_to_handle_at] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_open_by_handle_at] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_clock_adjtime] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_syncfs] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_sendmmsg] = {_sys_sendmmsg, 0},
+    [SYS_setns] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_getcpu] = {_sys_getcpu, 0},
+    [SYS_process_vm_readv] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_process_vm_writev] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_kcmp] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_finit_module] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_sched_setattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_sched_getattr] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_renameat2] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_seccomp] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_getrandom] = {_sys_getrandom, 0},
+    [SYS_memfd_create] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_kexec_file_load] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_bpf] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_execveat] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_userfaultfd] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_membarrier] = {_sys_membarrier, 0},
+    [SYS_mlock2] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_copy_file_range] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_preadv2] = {_sys_preadv2, 0},
+    [SYS_pwritev2] = {_sys_pwritev2, 0},
+    [SYS_pkey_mprotect] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_pkey_alloc] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_pkey_free] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_statx] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_io_pgetevents] = {_sys_io_pgetevents, 0},
+    [SYS_rseq] = {NULL, SYSCALL_UNHANDLED},
+    [SYS_bind] = {_sys_bind, 0},
+    [SYS_connect] = {_sys_connect, 0},
+    [SYS_recvfrom] = {_sys_recvfrom, 0},
+    [SYS_sendto] = {_sys_sendto, 0},
+    [SYS_socket] = {_sys_socket, 0},
+    [SYS_accept] = {_sys_accept, 0},
+    [SYS_sendmsg] = {_sys_sendmsg, 0},
+    [SYS_recvmsg] = {_sys_recvmsg, 0},
+    [SYS_shutdown] = {_sys_shutdown, 0},
+    [SYS_listen] = {_sys_listen, 0},
+    [SYS_getsockname] = {_sys_getsockname, 0},
+    [SYS_getpeername] = {_sys_getpeername, 0},
+    [SYS_socketpair] = {_sys_socketpair, 0},
+    [SYS_setsockopt] = {_sys_setsockopt, 0},
+    [SYS_getsockopt] = {_sys_getsockopt, 0},
+    [SYS_sendfile] = {_sys_sendfile, 0},
+    /* forward Open Enclave extensions to the target */
+    [SYS_myst_oe_get_report_v2] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_free_report] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_get_target_info_v2] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_free_target_info] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_parse_report] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_verify_report] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_get_seal_key_by_policy_v2] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_get_public_key_by_policy] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_get_public_key] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_get_private_key_by_policy] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_get_private_key] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_free_key] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_get_seal_key_v2] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_free_seal_key] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_generate_attestation_certificate] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_free_attestation_certificate] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_verify_attestation_certificate] = {NULL, SYSCALL_FORWARD},
+    [SYS_myst_oe_result_str] = {NULL, SYSCALL_FORWARD},
+};
 
-            _strace(n, "sockfd=%d msg=%p flags=%d", sockfd, msg, flags);
+static long _syscall(void* args_)
+{
+    syscall_args_t* args = (syscall_args_t*)args_;
+    long n = args->n;
+    long* params = args->params;
+    long syscall_ret = 0;
+    myst_td_t* target_td = NULL;
+    myst_td_t* crt_td = NULL;
+    myst_thread_t* thread = NULL;
 
-            ret = myst_syscall_recvmsg(sockfd, msg, flags);
-            BREAK(_return(n, ret));
-        }
-        case SYS_shutdown:
-        {
-            int sockfd = (int)x1;
-            int how = (int)x2;
-            long ret;
+    myst_times_enter_kernel(n);
 
-            _strace(n, "sockfd=%d how=%d", sockfd, how);
+    /* resolve the target-thread-descriptor and the crt-thread-descriptor */
+    if (_set_thread_area_called)
+    {
+        /* ---------- running C-runtime thread descriptor ---------- */
 
-            if (__myst_kernel_args.perf)
-                myst_print_syscall_times("SYS_shutdown", 10);
+        /* get crt_td */
+        crt_td = myst_get_fsbase();
+        myst_assume(myst_valid_td(crt_td));
 
-            ret = myst_syscall_shutdown(sockfd, how);
-            BREAK(_return(n, ret));
-        }
-        case SYS_listen:
-        {
-            int sockfd = (int)x1;
-            int backlog = (int)x2;
-            long ret;
+        /* get thread */
+        myst_assume(myst_tcall_get_tsd((uint64_t*)&thread) == 0);
+        myst_assume(myst_valid_thread(thread));
 
-            _strace(n, "sockfd=%d backlog=%d", sockfd, backlog);
+        /* get target_td */
+        target_td = thread->target_td;
+        myst_assume(myst_valid_td(target_td));
 
-            if (__myst_kernel_args.perf)
-                myst_print_syscall_times("SYS_listen", 10);
+        /* the syscall on the target thread descriptor */
+        myst_set_fsbase(target_td);
+    }
+    else
+    {
+        /* ---------- running target thread descriptor ---------- */
 
-            ret = myst_syscall_listen(sockfd, backlog);
-            BREAK(_return(n, ret));
-        }
-        case SYS_getsockname:
-        {
-            int sockfd = (int)x1;
-            struct sockaddr* addr = (struct sockaddr*)x2;
-            socklen_t* addrlen = (socklen_t*)x3;
-            long ret;
-            char addrstr[MAX_IPADDR_LEN];
+        /* get target_td */
+        target_td = myst_get_fsbase();
+        myst_assume(myst_valid_td(target_td));
 
-            ECHECK(_socketaddr_to_str(addr, addrstr, MAX_IPADDR_LEN));
+        /* get thread */
+        myst_assume(myst_tcall_get_tsd((uint64_t*)&thread) == 0);
+        myst_assume(myst_valid_thread(thread));
 
-            _strace(
-                n, "sockfd=%d addr=%s addrlen=%p", sockfd, addrstr, addrlen);
+        /* crt_td is null */
+    }
 
-            ret = myst_syscall_getsockname(sockfd, addr, addrlen);
-            BREAK(_return(n, ret));
-        }
-        case SYS_getpeername:
-        {
-            int sockfd = (int)x1;
-            struct sockaddr* addr = (struct sockaddr*)x2;
-            socklen_t* addrlen = (socklen_t*)x3;
-            long ret;
-            char addrstr[MAX_IPADDR_LEN];
+    // Process signals pending for this thread, if there is any.
+    myst_signal_process(thread);
 
-            ECHECK(_socketaddr_to_str(addr, addrstr, MAX_IPADDR_LEN));
+    /* ---------- running target thread descriptor ---------- */
 
-            _strace(
-                n, "sockfd=%d addr=%s addrlen=%p", sockfd, addrstr, addrlen);
+    myst_assume(target_td != NULL);
+    myst_assume(thread != NULL);
 
-            ret = myst_syscall_getpeername(sockfd, addr, addrlen);
-            BREAK(_return(n, ret));
-        }
-        case SYS_socketpair:
-        {
-            int domain = (int)x1;
-            int type = (int)x2;
-            int protocol = (int)x3;
-            int* sv = (int*)x4;
-            long ret;
+    args->thread = thread;
+    args->target_td = target_td;
+    args->crt_td = crt_td;
 
-            _strace(
-                n,
-                "domain=%d type=%d protocol=%d sv=%p",
-                domain,
-                type,
-                protocol,
-                sv);
-
-            ret = myst_syscall_socketpair(domain, type, protocol, sv);
-            BREAK(_return(n, ret));
-        }
-        case SYS_setsockopt:
-        {
-            int sockfd = (int)x1;
-            int level = (int)x2;
-            int optname = (int)x3;
-            const void* optval = (const void*)x4;
-            socklen_t optlen = (socklen_t)x5;
-            long ret;
-
-            _strace(
-                n,
-                "sockfd=%d level=%d optname=%d optval=%p optlen=%u",
-                sockfd,
-                level,
-                optname,
-                optval,
-                optlen);
-
-            ret =
-                myst_syscall_setsockopt(sockfd, level, optname, optval, optlen);
-            BREAK(_return(n, ret));
-        }
-        case SYS_getsockopt:
-        {
-            int sockfd = (int)x1;
-            int level = (int)x2;
-            int optname = (int)x3;
-            void* optval = (void*)x4;
-            socklen_t* optlen = (socklen_t*)x5;
-            long ret;
-
-            _strace(
-                n,
-                "sockfd=%d level=%d optname=%d optval=%p optlen=%p",
-                sockfd,
-                level,
-                optname,
-                optval,
-                optlen);
-
-            ret =
-                myst_syscall_getsockopt(sockfd, level, optname, optval, optlen);
-            BREAK(_return(n, ret));
-        }
-        case SYS_sendfile:
-        {
-            int out_fd = (int)x1;
-            int in_fd = (int)x2;
-            off_t* offset = (off_t*)x3;
-            size_t count = (size_t)x4;
-            off_t off = offset ? *offset : 0;
+    /* dispatch the syscall through the table */
+    {
+        const syscall_entry_t* entry = NULL;
 
-            _strace(
-                n,
-                "out_fd=%d in_fd=%d offset=%p *offset=%ld count=%zu",
-                out_fd,
-                in_fd,
-                offset,
-                off,
-                count);
+        if (n >= 0 && (size_t)n < MYST_COUNTOF(_syscall_table))
+            entry = &_syscall_table[n];
 
-            long ret = myst_syscall_sendfile(out_fd, in_fd, offset, count);
-            BREAK(_return(n, ret));
-            break;
+        if (!entry || (!entry->handler && !entry->flags))
+            myst_panic("unknown syscall: %s(): %ld", _syscall_str(n), n);
+
+        if (entry->handler)
+        {
+            syscall_ret = (*entry->handler)(args);
         }
-        /* forward Open Enclave extensions to the target */
-        case SYS_myst_oe_get_report_v2:
-        case SYS_myst_oe_free_report:
-        case SYS_myst_oe_get_target_info_v2:
-        case SYS_myst_oe_free_target_info:
-        case SYS_myst_oe_parse_report:
-        case SYS_myst_oe_verify_report:
-        case SYS_myst_oe_get_seal_key_by_policy_v2:
-        case SYS_myst_oe_get_public_key_by_policy:
-        case SYS_myst_oe_get_public_key:
-        case SYS_myst_oe_get_private_key_by_policy:
-        case SYS_myst_oe_get_private_key:
-        case SYS_myst_oe_free_key:
-        case SYS_myst_oe_get_seal_key_v2:
-        case SYS_myst_oe_free_seal_key:
-        case SYS_myst_oe_generate_attestation_certificate:
-        case SYS_myst_oe_free_attestation_certificate:
-        case SYS_myst_oe_verify_attestation_certificate:
-        case SYS_myst_oe_result_str:
+        else if (entry->flags & SYSCALL_FORWARD)
         {
             _strace(n, "forwarded");
-            BREAK(_return(n, _forward_syscall(n, params)));
+            syscall_ret = _return(n, _forward_syscall(n, params));
         }
-        default:
+        else
         {
-            myst_panic("unknown syscall: %s(): %ld", _syscall_str(n), n);
+            myst_panic("unhandled syscall: %s()", _syscall_str(n));
         }
     }
 
-    myst_panic("unhandled syscall: %s()", _syscall_str(n));
-
-done:
-
     /* ---------- running target thread descriptor ---------- */
 
     /* the C-runtime must execute on its own thread descriptor */
+    crt_td = args->crt_td;
     if (crt_td)
         myst_set_fsbase(crt_td);
 
     myst_times_leave_kernel(n);
 
+    if (__myst_kernel_args.strace_binary)
+        myst_tracering_record(thread, n, params, syscall_ret);
+
     // Process signals pending for this thread, if there is any.
     myst_signal_process(thread);
 
     return syscall_ret;
 }
-#pragma GCC diagnostic pop
 
 long myst_syscall(long n, long params[6])
 {
@@ -6134,7 +7113,11 @@ long myst_syscall(long n, long params[6])
     }
 
     if (!(kstack = myst_get_kstack()))
-        myst_panic("no more kernel stacks");
+    {
+        myst_kstack_stats_t stats;
+        myst_get_kstack_stats(&stats);
+        myst_panic("no more kernel stacks (limit=%zu)", stats.limit);
+    }
 
     syscall_args_t args = {.n = n, .params = params, .kstack = kstack};
     ret = myst_call_on_stack(myst_kstack_end(kstack), _syscall, &args);
@@ -6151,7 +7134,6 @@ long myst_syscall(long n, long params[6])
 **==============================================================================
 */
 
-static myst_spinlock_t _get_time_lock = MYST_SPINLOCK_INITIALIZER;
 static myst_spinlock_t _set_time_lock = MYST_SPINLOCK_INITIALIZER;
 
 long myst_syscall_clock_gettime(clockid_t clk_id, struct timespec* tp)
@@ -6186,11 +7168,9 @@ long myst_syscall_clock_gettime(clockid_t clk_id, struct timespec* tp)
         return 0;
     }
 
-    myst_spin_lock(&_get_time_lock);
+    /* the targets guard monotonicity themselves, so no lock is needed */
     long params[6] = {(long)clk_id, (long)tp};
-    long ret = myst_tcall(MYST_TCALL_CLOCK_GETTIME, params);
-    myst_spin_unlock(&_get_time_lock);
-    return ret;
+    return myst_tcall(MYST_TCALL_CLOCK_GETTIME, params);
 }
 
 long myst_syscall_clock_settime(clockid_t clk_id, struct timespec* tp)
@@ -6271,7 +7251,16 @@ long myst_syscall_kill(int pid, int sig)
 {
     long ret = 0;
     myst_thread_t* thread = myst_thread_self();
-    myst_thread_t* process_thread = myst_find_process_thread(thread);
+    myst_thread_t* process_thread = myst_lookup_thread_tid(pid);
+
+    /* Fast path: the tid table maps a process id to its process thread */
+    if (process_thread && myst_is_process_thread(process_thread) &&
+        process_thread->pid == pid)
+    {
+        goto found;
+    }
+
+    process_thread = myst_find_process_thread(thread);
 
     myst_spin_lock(&myst_process_list_lock);
 
@@ -6296,6 +7285,8 @@ long myst_syscall_kill(int pid, int sig)
 
     myst_spin_unlock(&myst_process_list_lock);
 
+found:
+
     // Did we finally find it?
     if (process_thread->pid == pid)
     {
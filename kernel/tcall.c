@@ -7,6 +7,7 @@
 
 #include <myst/blockdevice.h>
 #include <myst/fsgs.h>
+#include <myst/kernel.h>
 #include <myst/luks.h>
 #include <myst/sha256.h>
 #include <myst/signal.h>
@@ -77,6 +78,14 @@ long myst_tcall_wake(uint64_t event)
     return myst_tcall(MYST_TCALL_WAKE, params);
 }
 
+long myst_tcall_wake_many(const uint64_t* events, size_t count)
+{
+    long params[6] = {0};
+    params[0] = (long)events;
+    params[1] = (long)count;
+    return myst_tcall(MYST_TCALL_WAKE_MANY, params);
+}
+
 long myst_tcall_wake_wait(
     uint64_t waiter_event,
     uint64_t self_event,
@@ -109,6 +118,21 @@ long myst_tcall_set_tsd(uint64_t value)
 
 long myst_tcall_get_tsd(uint64_t* value)
 {
+    /* Without the syscall instruction (SGX), gsbase is the target thread
+     * descriptor, whose tsd field holds the value. So read it directly
+     * rather than dispatching a tcall on every myst_thread_self().
+     */
+    if (!__myst_kernel_args.have_syscall_instruction)
+    {
+        if (!value)
+            return -EINVAL;
+
+        __asm__ volatile("mov %%gs:%c1, %0"
+                         : "=r"(*value)
+                         : "i"(MYST_TD_TSD_OFFSET));
+        return 0;
+    }
+
     long params[6] = {(long)value};
     return myst_tcall(MYST_TCALL_GET_TSD, params);
 }
@@ -256,3 +280,63 @@ int myst_tcall_read_file(const char* pathname, char* data, size_t size)
     long params[6] = {(long)pathname, (long)data, (long)size};
     return myst_tcall(MYST_TCALL_READ_FILE, params);
 }
+
+#define TCALL_NAME(NAME) [NAME - MYST_TCALL_RANDOM] = #NAME
+
+/* the name of the tcall (or of the syscall forwarded to the target) */
+const char* myst_tcall_str(long n)
+{
+    static const char* _names[] = {
+        TCALL_NAME(MYST_TCALL_RANDOM),
+        TCALL_NAME(MYST_TCALL_VSNPRINTF),
+        TCALL_NAME(MYST_TCALL_WRITE_CONSOLE),
+        TCALL_NAME(MYST_TCALL_GEN_CREDS),
+        TCALL_NAME(MYST_TCALL_FREE_CREDS),
+        TCALL_NAME(MYST_TCALL_VERIFY_CERT),
+        TCALL_NAME(MYST_TCALL_GEN_CREDS_EX),
+        TCALL_NAME(MYST_TCALL_CLOCK_GETTIME),
+        TCALL_NAME(MYST_TCALL_CLOCK_SETTIME),
+        TCALL_NAME(MYST_TCALL_ISATTY),
+        TCALL_NAME(MYST_TCALL_ADD_SYMBOL_FILE),
+        TCALL_NAME(MYST_TCALL_LOAD_SYMBOLS),
+        TCALL_NAME(MYST_TCALL_UNLOAD_SYMBOLS),
+        TCALL_NAME(MYST_TCALL_CREATE_THREAD),
+        TCALL_NAME(MYST_TCALL_WAIT),
+        TCALL_NAME(MYST_TCALL_WAKE),
+        TCALL_NAME(MYST_TCALL_WAKE_WAIT),
+        TCALL_NAME(MYST_TCALL_WAKE_MANY),
+        TCALL_NAME(MYST_TCALL_SET_RUN_THREAD_FUNCTION),
+        TCALL_NAME(MYST_TCALL_TARGET_STAT),
+        TCALL_NAME(MYST_TCALL_SET_TSD),
+        TCALL_NAME(MYST_TCALL_GET_TSD),
+        TCALL_NAME(MYST_TCALL_GET_ERRNO_LOCATION),
+        TCALL_NAME(MYST_TCALL_READ_CONSOLE),
+        TCALL_NAME(MYST_TCALL_POLL_WAKE),
+        TCALL_NAME(MYST_TCALL_OPEN_BLOCK_DEVICE),
+        TCALL_NAME(MYST_TCALL_CLOSE_BLOCK_DEVICE),
+        TCALL_NAME(MYST_TCALL_READ_BLOCK_DEVICE),
+        TCALL_NAME(MYST_TCALL_WRITE_BLOCK_DEVICE),
+        TCALL_NAME(MYST_TCALL_LUKS_ENCRYPT),
+        TCALL_NAME(MYST_TCALL_LUKS_DECRYPT),
+        TCALL_NAME(MYST_TCALL_SHA256_START),
+        TCALL_NAME(MYST_TCALL_SHA256_UPDATE),
+        TCALL_NAME(MYST_TCALL_SHA256_FINISH),
+        TCALL_NAME(MYST_TCALL_VERIFY_SIGNATURE),
+        TCALL_NAME(MYST_TCALL_LOAD_FSSIG),
+        TCALL_NAME(MYST_TCALL_CLOCK_GETRES),
+        TCALL_NAME(MYST_TCALL_GCOV),
+        TCALL_NAME(MYST_TCALL_GET_FILE_SIZE),
+        TCALL_NAME(MYST_TCALL_READ_FILE),
+    };
+
+    if (n < MYST_TCALL_RANDOM)
+        return myst_syscall_str(n);
+
+    if ((size_t)(n - MYST_TCALL_RANDOM) < MYST_COUNTOF(_names) &&
+        _names[n - MYST_TCALL_RANDOM])
+    {
+        return _names[n - MYST_TCALL_RANDOM];
+    }
+
+    return "unknown";
+}
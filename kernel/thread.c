@@ -8,6 +8,7 @@
 #include <string.h>
 #include <sys/wait.h>
 
+#include <myst/aio.h>
 #include <myst/assume.h>
 #include <myst/atexit.h>
 #include <myst/atomic.h>
@@ -33,6 +34,7 @@
 #include <myst/thread.h>
 #include <myst/time.h>
 #include <myst/times.h>
+#include <myst/tracering.h>
 #include <myst/trace.h>
 
 //#define TRACE
@@ -198,6 +200,247 @@ static myst_thread_t* _put_cookie(uint64_t cookie)
     return thread;
 }
 
+/*
+**==============================================================================
+**
+** thread pool:
+**
+**     Creating a thread requires the target to create a host thread, which
+**     then enters the kernel (an enclave entry on SGX). To avoid paying this
+**     for every clone(), a host thread whose kernel thread has exited parks
+**     in the kernel, waiting on its host event, instead of returning to the
+**     target. Creating a thread hands its cookie to a parked host thread if
+**     there is one and only creates a new host thread otherwise.
+**
+**     At most __myst_kernel_args.thread_pool_size host threads are parked at
+**     a time. Parked threads only come from exited threads, so the number of
+**     running plus parked threads never exceeds the number of threads the
+**     target supports. myst_release_thread_pool() lets parked threads return
+**     to the target when the kernel shuts down.
+**
+**==============================================================================
+*/
+
+typedef struct parked_thread parked_thread_t;
+
+struct parked_thread
+{
+    parked_thread_t* next;
+    uint64_t event;
+    uint64_t cookie; /* zero if the thread is released */
+    bool resumed;
+};
+
+static parked_thread_t* _parked_threads;
+static size_t _num_parked_threads;
+static bool _thread_pool_released;
+static myst_thread_pool_stats_t _thread_pool_stats;
+static myst_spinlock_t _thread_pool_lock = MYST_SPINLOCK_INITIALIZER;
+
+/* park the calling host thread and return its next cookie (or zero) */
+static uint64_t _park_host_thread(uint64_t event)
+{
+    parked_thread_t self = {.event = event};
+
+    myst_spin_lock(&_thread_pool_lock);
+    {
+        if (_thread_pool_released ||
+            _num_parked_threads >= __myst_kernel_args.thread_pool_size)
+        {
+            myst_spin_unlock(&_thread_pool_lock);
+            return 0;
+        }
+
+        self.next = _parked_threads;
+        _parked_threads = &self;
+        _num_parked_threads++;
+    }
+    myst_spin_unlock(&_thread_pool_lock);
+
+    /* Wait for the wake-up that follows setting resumed (ignore others).
+     * Avoid myst_tcall_wait(), which processes signals for the calling
+     * thread, since the thread that last ran here has exited.
+     */
+    do
+    {
+        long params[6] = {(long)event};
+        myst_tcall(MYST_TCALL_WAIT, params);
+    } while (!__atomic_load_n(&self.resumed, __ATOMIC_ACQUIRE));
+
+    return self.cookie;
+}
+
+/* resume the given parked thread, which may be gone once resumed is set */
+static void _resume_host_thread(parked_thread_t* parked, uint64_t cookie)
+{
+    const uint64_t event = parked->event;
+
+    parked->cookie = cookie;
+    __atomic_store_n(&parked->resumed, true, __ATOMIC_RELEASE);
+    myst_tcall_wake(event);
+}
+
+/* run the thread for this cookie on a parked or a new host thread */
+static long _create_host_thread(uint64_t cookie)
+{
+    parked_thread_t* parked;
+
+    myst_spin_lock(&_thread_pool_lock);
+    {
+        if ((parked = _parked_threads))
+        {
+            _parked_threads = parked->next;
+            _num_parked_threads--;
+            _thread_pool_stats.hits++;
+        }
+        else
+        {
+            _thread_pool_stats.misses++;
+        }
+    }
+    myst_spin_unlock(&_thread_pool_lock);
+
+    if (!parked)
+        return myst_tcall_create_thread(cookie);
+
+    _resume_host_thread(parked, cookie);
+    return 0;
+}
+
+void myst_release_thread_pool(void)
+{
+    parked_thread_t* parked;
+
+    myst_spin_lock(&_thread_pool_lock);
+    {
+        parked = _parked_threads;
+        _parked_threads = NULL;
+        _num_parked_threads = 0;
+        _thread_pool_released = true;
+    }
+    myst_spin_unlock(&_thread_pool_lock);
+
+    while (parked)
+    {
+        parked_thread_t* next = parked->next;
+        _resume_host_thread(parked, 0);
+        parked = next;
+    }
+}
+
+void myst_get_thread_pool_stats(myst_thread_pool_stats_t* stats)
+{
+    myst_spin_lock(&_thread_pool_lock);
+    *stats = _thread_pool_stats;
+    stats->parked = _num_parked_threads;
+    myst_spin_unlock(&_thread_pool_lock);
+}
+
+/*
+**==============================================================================
+**
+** tid table:
+**
+**     This table maps thread ids to threads, so that looking up a thread does
+**     not require walking thread lists. A thread is added when it gets its
+**     thread id and removed when it becomes a zombie.
+**
+**     The table uses open addressing with linear probing. Writers hold a
+**     spinlock, while readers probe without locking. Since removal shifts
+**     later entries backward, a reader may miss an entry that is moving, so
+**     lookups treat a miss as a hint and fall back to the thread lists. The
+**     table size must be well above the maximum number of threads; if the
+**     table is ever half full, new threads are simply not added.
+**
+**==============================================================================
+*/
+
+#define TID_TABLE_SIZE 4096
+
+static myst_thread_t* _tid_table[TID_TABLE_SIZE];
+static size_t _tid_table_count;
+static myst_spinlock_t _tid_table_lock = MYST_SPINLOCK_INITIALIZER;
+
+MYST_STATIC_ASSERT((TID_TABLE_SIZE & (TID_TABLE_SIZE - 1)) == 0);
+
+static size_t _tid_slot(pid_t tid)
+{
+    return (size_t)tid & (TID_TABLE_SIZE - 1);
+}
+
+void myst_add_thread_tid(myst_thread_t* thread)
+{
+    myst_spin_lock(&_tid_table_lock);
+    {
+        if (_tid_table_count < TID_TABLE_SIZE / 2)
+        {
+            size_t i = _tid_slot(thread->tid);
+
+            while (_tid_table[i])
+                i = (i + 1) & (TID_TABLE_SIZE - 1);
+
+            __atomic_store_n(&_tid_table[i], thread, __ATOMIC_RELEASE);
+            _tid_table_count++;
+        }
+    }
+    myst_spin_unlock(&_tid_table_lock);
+}
+
+static void _remove_thread_tid(myst_thread_t* thread)
+{
+    const size_t mask = TID_TABLE_SIZE - 1;
+
+    myst_spin_lock(&_tid_table_lock);
+    {
+        size_t i = _tid_slot(thread->tid);
+
+        /* find the entry (if any) */
+        while (_tid_table[i] && _tid_table[i] != thread)
+            i = (i + 1) & mask;
+
+        if (_tid_table[i])
+        {
+            /* shift back later entries whose probe sequence crosses i */
+            for (size_t j = (i + 1) & mask; _tid_table[j]; j = (j + 1) & mask)
+            {
+                const size_t k = _tid_slot(_tid_table[j]->tid);
+
+                /* if k lies cyclically within (i, j], the entry stays */
+                if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+                    continue;
+
+                myst_thread_t* p = _tid_table[j];
+                __atomic_store_n(&_tid_table[i], p, __ATOMIC_RELEASE);
+                i = j;
+            }
+
+            __atomic_store_n(&_tid_table[i], NULL, __ATOMIC_RELEASE);
+            _tid_table_count--;
+        }
+    }
+    myst_spin_unlock(&_tid_table_lock);
+}
+
+myst_thread_t* myst_lookup_thread_tid(pid_t tid)
+{
+    size_t i = _tid_slot(tid);
+
+    for (size_t n = 0; n < TID_TABLE_SIZE; n++)
+    {
+        myst_thread_t* p = __atomic_load_n(&_tid_table[i], __ATOMIC_ACQUIRE);
+
+        if (!p)
+            break;
+
+        if (p->tid == tid)
+            return p;
+
+        i = (i + 1) & (TID_TABLE_SIZE - 1);
+    }
+
+    return NULL;
+}
+
 /*
 **==============================================================================
 **
@@ -240,6 +483,9 @@ static void _free_zombies(void* arg)
 
 void myst_zombify_thread(myst_thread_t* thread)
 {
+    _remove_thread_tid(thread);
+    myst_tracering_release(thread);
+
     if (myst_is_process_thread(thread))
     {
         myst_spin_lock(&myst_process_list_lock);
@@ -583,6 +829,13 @@ myst_thread_t* myst_find_thread(int tid)
     myst_thread_t* target = NULL;
     myst_thread_t* t = NULL;
 
+    /* Look up the tid table first (the target must be in this group) */
+    if ((t = myst_lookup_thread_tid(tid)) &&
+        t->thread_lock == thread->thread_lock)
+    {
+        return t;
+    }
+
     myst_spin_lock(thread->thread_lock);
 
     // Search forward in the doubly linked list for a match
@@ -730,6 +983,9 @@ static long _run_thread(void* arg_)
         thread->tid = myst_generate_tid();
     }
 
+    /* make the thread visible to myst_find_thread() */
+    myst_add_thread_tid(thread);
+
     /* set the target into the thread */
     thread->target_td = target_td;
 
@@ -854,6 +1110,9 @@ static long _run_thread(void* arg_)
 
             procfs_pid_cleanup(thread->pid);
 
+            /* release any AIO contexts the process did not destroy */
+            myst_aio_release(thread->pid);
+
             /* Send a SIGCHLD to the parent process */
             myst_syscall_kill(thread->ppid, SIGCHLD);
         }
@@ -907,23 +1166,33 @@ long myst_run_thread(uint64_t cookie, uint64_t event, pid_t target_tid)
     const size_t regular_stack_size = 8192;
     uint8_t* stack = NULL;
 
-    /* get the thread corresponding to this cookie */
-    if (!(thread = _put_cookie(cookie)))
-        ERAISE(-EINVAL);
+    /* run threads on this host thread until it is not parked */
+    while (cookie)
+    {
+        /* get the thread corresponding to this cookie */
+        if (!(thread = _put_cookie(cookie)))
+            ERAISE(-EINVAL);
 
-    /* the stack size is determined by the thread type (process or regular) */
-    if (myst_is_process_thread(thread))
-        stack_size = process_stack_size;
-    else
-        stack_size = regular_stack_size;
+        /* the stack size is determined by the thread type */
+        if (myst_is_process_thread(thread))
+            stack_size = process_stack_size;
+        else
+            stack_size = regular_stack_size;
+
+        /* allocate a new stack since the OE caller stack is very small */
+        if (!(stack = memalign(stack_alignment, stack_size)))
+            ERAISE(-ENOMEM);
 
-    /* allocate a new stack since the OE caller stack is very small */
-    if (!(stack = memalign(stack_alignment, stack_size)))
-        ERAISE(-ENOMEM);
+        /* run the thread on the transient stack */
+        struct run_thread_arg arg = {thread, cookie, event, target_tid};
+        ECHECK(myst_call_on_stack(stack + stack_size, _run_thread, &arg));
 
-    /* run the thread on the transient stack */
-    struct run_thread_arg arg = {thread, cookie, event, target_tid};
-    ECHECK(myst_call_on_stack(stack + stack_size, _run_thread, &arg));
+        free(stack);
+        stack = NULL;
+
+        /* wait in the thread pool for another thread to run */
+        cookie = _park_host_thread(event);
+    }
 
 done:
 
@@ -1009,7 +1278,7 @@ static long _syscall_clone(
 
     cookie = _get_cookie(child);
 
-    if (myst_tcall_create_thread(cookie) != 0)
+    if (_create_host_thread(cookie) != 0)
         ERAISE(-EINVAL);
 
 done:
@@ -1131,7 +1400,7 @@ static long _syscall_clone_vfork(
 
     cookie = _get_cookie(child);
 
-    if (myst_tcall_create_thread(cookie) != 0)
+    if (_create_host_thread(cookie) != 0)
         ERAISE(-EINVAL);
 
     ret = child->pid;
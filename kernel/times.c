@@ -8,25 +8,87 @@
 #include <myst/clock.h>
 #include <myst/eraise.h>
 #include <myst/kernel.h>
+#include <myst/latency.h>
 #include <myst/printf.h>
 #include <myst/syscall.h>
 #include <myst/thread.h>
 #include <myst/times.h>
 
-#define MYST_MAX_SYSCALLS 3000
-
-/* Time spent by the main thread and its children */
+/* Time spent by the main thread and its children (in ticks) */
 struct tms process_times;
 
 bool __myst_trace_syscall_times = true;
 
-typedef struct syscall_time
+/*
+**==============================================================================
+**
+** Ticks:
+**
+**     CPU time accounting takes a timestamp on every syscall entry and exit,
+**     so timestamps come from the cheapest counter available and are only
+**     converted to nanoseconds when read. When the target provides a clock
+**     page, ticks are the host's monotonic time in nanoseconds (a plain
+**     memory read). Otherwise ticks are TSC cycles, which are converted with
+**     the ratio of monotonic time to cycles elapsed since myst_times_init().
+**     Ticks need not be monotonic (the host or an unsynchronized TSC may
+**     step back), so negative intervals count as zero.
+**
+**==============================================================================
+*/
+
+static long _tsc0;
+static long _nsecs0;
+
+MYST_INLINE long _rdtsc(void)
+{
+    uint32_t lo;
+    uint32_t hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return (long)(((uint64_t)hi << 32) | lo);
+}
+
+static long _monotime(void)
+{
+    struct timespec ts;
+
+    if (myst_syscall_clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+        return 0;
+
+    return ts.tv_sec * NANO_IN_SECOND + ts.tv_nsec;
+}
+
+long myst_times_ticks(void)
 {
-    long nsec;
-    size_t ncalls;
-} syscall_time_t;
+    const struct myst_clock_page* page = __myst_kernel_args.clock_page;
+
+    if (page)
+        return *page->monotime_now;
+
+    return _rdtsc();
+}
+
+long myst_times_ticks_to_nsecs(long ticks)
+{
+    long cycles;
+    long nsecs;
+
+    if (__myst_kernel_args.clock_page)
+        return ticks;
+
+    nsecs = _monotime() - _nsecs0;
+    cycles = _rdtsc() - _tsc0;
+
+    if (nsecs <= 0 || cycles <= 0)
+        return 0;
 
-static syscall_time_t _syscall_times[MYST_MAX_SYSCALLS];
+    return (long)((double)ticks * ((double)nsecs / (double)cycles));
+}
+
+void myst_times_init(void)
+{
+    _nsecs0 = _monotime();
+    _tsc0 = _rdtsc();
+}
 
 long myst_lapsed_nsecs(const struct timespec* t0, const struct timespec* t1)
 {
@@ -40,15 +102,17 @@ MYST_INLINE void set_timespec_from_nanos(struct timespec* tp, long nanos)
     tp->tv_nsec = nanos % NANO_IN_SECOND;
 }
 
-static bool is_zero_tp(struct timespec* tp)
+MYST_INLINE long _lapsed_ticks(long t0, long t1)
 {
-    return tp->tv_sec == 0 && tp->tv_nsec == 0;
+    return (t1 > t0) ? t1 - t0 : 0;
 }
 
 void myst_times_start()
 {
     myst_thread_t* thread = myst_thread_self();
-    myst_syscall_clock_gettime(CLOCK_MONOTONIC, &thread->start_ts);
+    thread->start_ticks = myst_times_ticks();
+    thread->enter_kernel_ticks = thread->start_ticks;
+    thread->leave_kernel_ticks = 0;
 }
 
 void myst_times_enter_kernel(long syscall_num)
@@ -57,64 +121,65 @@ void myst_times_enter_kernel(long syscall_num)
 
     (void)syscall_num;
 
-    myst_syscall_clock_gettime(CLOCK_MONOTONIC, &current->enter_kernel_ts);
+    current->enter_kernel_ticks = myst_times_ticks();
 
     // Thread might be entering the kernel for the first time
-    if (is_zero_tp(&current->leave_kernel_ts))
-        current->leave_kernel_ts = current->start_ts;
+    if (current->leave_kernel_ticks == 0)
+        current->leave_kernel_ticks = current->start_ticks;
 
-    long lapsed =
-        myst_lapsed_nsecs(&current->leave_kernel_ts, &current->enter_kernel_ts);
-    myst_assume(lapsed >= 0);
+    long lapsed = _lapsed_ticks(
+        current->leave_kernel_ticks, current->enter_kernel_ticks);
 
-    __atomic_fetch_add(&process_times.tms_utime, lapsed, __ATOMIC_SEQ_CST);
+    __atomic_fetch_add(&process_times.tms_utime, lapsed, __ATOMIC_RELAXED);
 }
 
 void myst_times_leave_kernel(long syscall_num)
 {
     myst_thread_t* current = myst_thread_self();
-    myst_syscall_clock_gettime(CLOCK_MONOTONIC, &current->leave_kernel_ts);
+    current->leave_kernel_ticks = myst_times_ticks();
 
-    long lapsed =
-        myst_lapsed_nsecs(&current->enter_kernel_ts, &current->leave_kernel_ts);
+    long lapsed = _lapsed_ticks(
+        current->enter_kernel_ticks, current->leave_kernel_ticks);
 
     if (__myst_trace_syscall_times)
-    {
-        _syscall_times[syscall_num].nsec += lapsed;
-        _syscall_times[syscall_num].ncalls++;
-    }
+        myst_latency_record(MYST_LATENCY_SYSCALL, syscall_num, lapsed);
 
-    myst_assume(lapsed > 0);
-    __atomic_fetch_add(&process_times.tms_stime, lapsed, __ATOMIC_SEQ_CST);
+    __atomic_fetch_add(&process_times.tms_stime, lapsed, __ATOMIC_RELAXED);
 }
 
 long myst_times_system_time()
 {
-    return process_times.tms_stime;
+    return myst_times_ticks_to_nsecs(process_times.tms_stime);
 }
 
 long myst_times_user_time()
 {
-    return process_times.tms_utime;
+    return myst_times_ticks_to_nsecs(process_times.tms_utime);
 }
 
 long myst_times_process_time()
 {
-    return process_times.tms_stime + process_times.tms_utime +
-           process_times.tms_cstime + process_times.tms_cutime;
+    return myst_times_ticks_to_nsecs(
+        process_times.tms_stime + process_times.tms_utime +
+        process_times.tms_cstime + process_times.tms_cutime);
 }
 
-long myst_times_thread_time()
+static long _thread_time(const myst_thread_t* thread)
 {
-    myst_thread_t* current = myst_thread_self();
     long lapsed =
-        myst_lapsed_nsecs(&current->start_ts, &current->enter_kernel_ts);
-    return lapsed;
+        _lapsed_ticks(thread->start_ticks, thread->enter_kernel_ticks);
+    return myst_times_ticks_to_nsecs(lapsed);
+}
+
+long myst_times_thread_time()
+{
+    return _thread_time(myst_thread_self());
 }
 
 long myst_times_uptime()
 {
-    return process_times.tms_stime + process_times.tms_utime;
+    return myst_times_ticks_to_nsecs(
+        process_times.tms_stime + process_times.tms_utime);
 }
 
 long myst_times_get_cpu_clock_time(clockid_t clk_id, struct timespec* tp)
@@ -136,8 +201,7 @@ long myst_times_get_cpu_clock_time(clockid_t clk_id, struct timespec* tp)
             if (!t)
                 return -EINVAL;
 
-            long nanoseconds =
-                myst_lapsed_nsecs(&t->start_ts, &t->enter_kernel_ts);
+            long nanoseconds = _thread_time(t);
             set_timespec_from_nanos(tp, nanoseconds);
         }
     }
@@ -171,7 +235,7 @@ void myst_print_syscall_times(const char* message, size_t count)
     size_t ntimes = 0;
     struct locals
     {
-        times_t times[MYST_MAX_SYSCALLS];
+        times_t times[MYST_LATENCY_MAX_NUM];
     };
     struct locals* locals = NULL;
     double nsecs = 0;
@@ -199,14 +263,20 @@ void myst_print_syscall_times(const char* message, size_t count)
         }
     }
 
-    for (size_t i = 0; i < MYST_MAX_SYSCALLS; i++)
+    for (size_t i = 0; i < MYST_LATENCY_MAX_NUM; i++)
     {
-        if (_syscall_times[i].nsec)
+        size_t ncalls;
+        long ticks;
+
+        myst_latency_get_totals(MYST_LATENCY_SYSCALL, i, &ncalls, &ticks);
+
+        if (ticks)
         {
+            long nsec = myst_times_ticks_to_nsecs(ticks);
             locals->times[ntimes].num = i;
-            locals->times[ntimes].nsec = _syscall_times[i].nsec;
-            locals->times[ntimes].ncalls = _syscall_times[i].ncalls;
-            nsecs += (double)_syscall_times[i].nsec;
+            locals->times[ntimes].nsec = nsec;
+            locals->times[ntimes].ncalls = ncalls;
+            nsecs += (double)nsec;
             ntimes++;
         }
     }
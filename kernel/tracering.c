@@ -0,0 +1,282 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <stdlib.h>
+#include <string.h>
+#include <syscall.h>
+
+#include <myst/eraise.h>
+#include <myst/kernel.h>
+#include <myst/spinlock.h>
+#include <myst/tcall.h>
+#include <myst/thread.h>
+#include <myst/times.h>
+#include <myst/tracering.h>
+
+/*
+**==============================================================================
+**
+** Each thread writes its records into a ring that only it updates: the
+** record is filled in and then the head is advanced (with release order).
+** The dumper copies records without stopping the writers and afterwards
+** discards any record the writer may have overwritten during the copy.
+**
+** Rings are never freed. The ring of an exiting thread is kept on the list
+** (so its records can still be dumped) and is reused by a new thread once
+** its records have been dumped. Once the number of rings reaches MAX_RINGS,
+** a new thread instead takes the free ring whose last record is the oldest.
+** Each ring records the pid of its owner, so a ring only ever holds
+** undumped records of one process.
+**
+**==============================================================================
+*/
+
+#define MAX_RINGS 256
+
+MYST_STATIC_ASSERT((MYST_TRACE_RING_SIZE & (MYST_TRACE_RING_SIZE - 1)) == 0);
+
+typedef struct myst_trace_ring
+{
+    struct myst_trace_ring* next;
+
+    /* non-zero while owned by a thread */
+    int in_use;
+
+    /* the process of the owner (guarded by _dump_lock) */
+    pid_t pid;
+
+    /* number of records ever written (updated only by the owner) */
+    uint64_t head;
+
+    /* number of records already written to the trace file */
+    uint64_t dumped;
+
+    myst_trace_record_t records[MYST_TRACE_RING_SIZE];
+} myst_trace_ring_t;
+
+static myst_trace_ring_t* _rings;
+static myst_spinlock_t _dump_lock = MYST_SPINLOCK_INITIALIZER;
+
+static bool _acquire_ring(myst_trace_ring_t* ring)
+{
+    int expected = 0;
+
+    return __atomic_compare_exchange_n(
+        &ring->in_use, &expected, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+/* give a ring to a thread of the given process */
+static myst_trace_ring_t* _assign_ring(myst_trace_ring_t* ring, pid_t pid)
+{
+    myst_spin_lock(&_dump_lock);
+    {
+        /* drop any records of the previous owner that were not dumped */
+        ring->dumped = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+        ring->pid = pid;
+    }
+    myst_spin_unlock(&_dump_lock);
+
+    return ring;
+}
+
+static myst_trace_ring_t* _get_ring(pid_t pid)
+{
+    myst_trace_ring_t* ring;
+    size_t nrings = 0;
+
+    /* reuse the ring of an exited thread if all its records were dumped */
+    for (ring = __atomic_load_n(&_rings, __ATOMIC_ACQUIRE); ring;
+         ring = ring->next)
+    {
+        const uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+
+        if (__atomic_load_n(&ring->dumped, __ATOMIC_RELAXED) == head &&
+            _acquire_ring(ring))
+        {
+            return _assign_ring(ring, pid);
+        }
+
+        nrings++;
+    }
+
+    /* past the limit, overwrite the ring of an exited thread whose last
+     * record is the oldest (retrying if another thread takes it first) */
+    while (nrings >= MAX_RINGS)
+    {
+        myst_trace_ring_t* oldest = NULL;
+        uint64_t oldest_ticks = 0;
+
+        for (ring = __atomic_load_n(&_rings, __ATOMIC_ACQUIRE); ring;
+             ring = ring->next)
+        {
+            const uint64_t mask = MYST_TRACE_RING_SIZE - 1;
+            uint64_t head;
+            uint64_t ticks;
+
+            if (__atomic_load_n(&ring->in_use, __ATOMIC_ACQUIRE))
+                continue;
+
+            head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+            ticks = head ? ring->records[(head - 1) & mask].leave_ticks : 0;
+
+            if (!oldest || ticks < oldest_ticks)
+            {
+                oldest = ring;
+                oldest_ticks = ticks;
+            }
+        }
+
+        if (!oldest)
+            break;
+
+        if (_acquire_ring(oldest))
+            return _assign_ring(oldest, pid);
+    }
+
+    if (!(ring = calloc(1, sizeof(myst_trace_ring_t))))
+        return NULL;
+
+    ring->in_use = 1;
+    ring->pid = pid;
+    ring->next = __atomic_load_n(&_rings, __ATOMIC_RELAXED);
+
+    while (!__atomic_compare_exchange_n(
+        &_rings, &ring->next, ring, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        ;
+
+    return ring;
+}
+
+void myst_tracering_record(
+    myst_thread_t* thread,
+    long n,
+    const long params[6],
+    long ret)
+{
+    myst_trace_ring_t* ring = thread->trace_ring;
+    myst_trace_record_t* record;
+    uint64_t head;
+
+    if (!ring && !(ring = thread->trace_ring = _get_ring(thread->pid)))
+        return;
+
+    head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    record = &ring->records[head & (MYST_TRACE_RING_SIZE - 1)];
+
+    record->tid = (uint32_t)thread->tid;
+    record->num = (uint32_t)n;
+    memcpy(record->params, params, sizeof(record->params));
+    record->ret = ret;
+    record->enter_ticks = (uint64_t)thread->enter_kernel_ticks;
+    record->leave_ticks = (uint64_t)thread->leave_kernel_ticks;
+
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+void myst_tracering_release(myst_thread_t* thread)
+{
+    myst_trace_ring_t* ring = thread->trace_ring;
+
+    if (ring)
+    {
+        thread->trace_ring = NULL;
+        __atomic_store_n(&ring->in_use, 0, __ATOMIC_RELEASE);
+    }
+}
+
+static int _write(const void* data, size_t size)
+{
+    int ret = 0;
+    const uint8_t* p = data;
+
+    while (size)
+    {
+        long params[6] = {__myst_kernel_args.strace_binary_fd, (long)p, size};
+        long n = myst_tcall(SYS_write, params);
+
+        if (n <= 0)
+            ERAISE(n == 0 ? -EIO : (int)n);
+
+        p += n;
+        size -= n;
+    }
+
+done:
+    return ret;
+}
+
+/* dump the new records of one ring (the caller holds _dump_lock) */
+static int _dump_ring(myst_trace_ring_t* ring, myst_trace_record_t* buf)
+{
+    int ret = 0;
+    const uint64_t size = MYST_TRACE_RING_SIZE;
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint64_t start = ring->dumped;
+    uint64_t valid;
+    myst_trace_header_t header;
+
+    if (head - start > size)
+        start = head - size;
+
+    for (uint64_t i = start; i < head; i++)
+        buf[i - start] = ring->records[i & (size - 1)];
+
+    /* records the owner may have overwritten during the copy are dropped */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    valid = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    valid = (valid >= size) ? valid - size + 1 : 0;
+
+    if (valid > start)
+    {
+        buf += (valid < head ? valid : head) - start;
+        start = (valid < head) ? valid : head;
+    }
+
+    __atomic_store_n(&ring->dumped, head, __ATOMIC_RELAXED);
+
+    if (start == head)
+        goto done;
+
+    memset(&header, 0, sizeof(header));
+    header.magic = MYST_TRACE_MAGIC;
+    header.version = MYST_TRACE_VERSION;
+    header.record_size = sizeof(myst_trace_record_t);
+    header.nrecords = head - start;
+    header.pid = (uint32_t)ring->pid;
+
+    /* the tick rate (ticks are nanoseconds when the clock page is used) */
+    header.nsecs_div = 1000000000;
+    header.nsecs_mul = myst_times_ticks_to_nsecs(header.nsecs_div);
+
+    ECHECK(_write(&header, sizeof(header)));
+    ECHECK(_write(buf, header.nrecords * sizeof(myst_trace_record_t)));
+
+done:
+    return ret;
+}
+
+int myst_tracering_dump(void)
+{
+    int ret = 0;
+    myst_trace_record_t* buf = NULL;
+
+    if (!__myst_kernel_args.strace_binary)
+        return 0;
+
+    if (!(buf = malloc(MYST_TRACE_RING_SIZE * sizeof(myst_trace_record_t))))
+        return -ENOMEM;
+
+    myst_spin_lock(&_dump_lock);
+
+    for (myst_trace_ring_t* ring = __atomic_load_n(&_rings, __ATOMIC_ACQUIRE);
+         ring;
+         ring = ring->next)
+    {
+        ECHECK(_dump_ring(ring, buf));
+    }
+
+done:
+    myst_spin_unlock(&_dump_lock);
+    free(buf);
+    return ret;
+}
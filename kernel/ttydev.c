@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 
+#define _GNU_SOURCE
 #include <fcntl.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -136,8 +138,18 @@ static ssize_t _td_writev(
     if (!ttydev || !_valid_tty(tty))
         ERAISE(-EINVAL);
 
-    ret = myst_fdops_writev(&ttydev->fdops, tty, iov, iovcnt);
-    ECHECK(ret);
+    /* like _td_write(), only standard output and error are writable */
+    if (tty->fd != STDOUT_FILENO && tty->fd != STDERR_FILENO)
+        ERAISE(-EINVAL);
+
+    if ((!iov && iovcnt) || iovcnt < 0 || iovcnt > IOV_MAX)
+        ERAISE(-EINVAL);
+
+    /* write the IO vector to the host console in a single call */
+    {
+        long params[6] = {tty->fd, (long)iov, iovcnt};
+        ECHECK((ret = myst_tcall(SYS_writev, params)));
+    }
 
 done:
 
@@ -186,6 +186,16 @@ long myst_tcall_wake(uint64_t event)
     return -ENOTSUP;
 }
 
+/* Must be overriden by enclave application */
+MYST_WEAK
+long myst_tcall_wake_many(const uint64_t* events, size_t count)
+{
+    (void)events;
+    (void)count;
+    assert("sgx: unimplemented: implement in enclave" == NULL);
+    return -ENOTSUP;
+}
+
 /* Must be overriden by enclave application */
 MYST_WEAK
 long myst_tcall_wake_wait(
@@ -448,6 +458,12 @@ long myst_tcall(long n, long params[6])
             const struct timespec* timeout = (const struct timespec*)x3;
             return myst_tcall_wake_wait(waiter_event, self_event, timeout);
         }
+        case MYST_TCALL_WAKE_MANY:
+        {
+            const uint64_t* events = (const uint64_t*)x1;
+            size_t count = (size_t)x2;
+            return myst_tcall_wake_many(events, count);
+        }
         case MYST_TCALL_SET_RUN_THREAD_FUNCTION:
         {
             myst_run_thread_t function = (myst_run_thread_t)x1;
@@ -581,6 +597,8 @@ long myst_tcall(long n, long params[6])
         }
         case SYS_read:
         case SYS_write:
+        case SYS_readv:
+        case SYS_writev:
         case SYS_close:
         case SYS_nanosleep:
         case SYS_fcntl:
@@ -593,6 +611,8 @@ long myst_tcall(long n, long params[6])
         case SYS_accept4:
         case SYS_sendmsg:
         case SYS_recvmsg:
+        case SYS_sendmmsg:
+        case SYS_recvmmsg:
         case SYS_shutdown:
         case SYS_listen:
         case SYS_getsockname:
@@ -611,6 +631,8 @@ long myst_tcall(long n, long params[6])
         case SYS_dup:
         case SYS_pread64:
         case SYS_pwrite64:
+        case SYS_preadv:
+        case SYS_pwritev:
         case SYS_link:
         case SYS_unlink:
         case SYS_mkdir:
@@ -57,6 +57,25 @@ long myst_tcall_wake(uint64_t event)
     return ret;
 }
 
+long myst_tcall_wake_many(const uint64_t* events, size_t count)
+{
+    long ret = 0;
+
+    if (!events || count > MYST_WAKE_MANY_MAX)
+        return -EINVAL;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        long r;
+
+        /* keep waking the other events even if one of them fails */
+        if ((r = myst_tcall_wake(events[i])) > 0)
+            ret += r;
+    }
+
+    return ret;
+}
+
 long myst_tcall_wake_wait(
     uint64_t waiter_event,
     uint64_t self_event,
@@ -0,0 +1,378 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+/* the Linux AIO ABI (see <linux/aio_abi.h>) */
+
+typedef unsigned long aio_context_t;
+
+enum
+{
+    IOCB_CMD_PREAD = 0,
+    IOCB_CMD_PWRITE = 1,
+    IOCB_CMD_FSYNC = 2,
+    IOCB_CMD_PREADV = 7,
+};
+
+#define IOCB_FLAG_RESFD (1 << 0)
+
+struct iocb
+{
+    uint64_t aio_data;
+    uint32_t aio_key;
+    uint32_t aio_rw_flags;
+    uint16_t aio_lio_opcode;
+    int16_t aio_reqprio;
+    uint32_t aio_fildes;
+    uint64_t aio_buf;
+    uint64_t aio_nbytes;
+    int64_t aio_offset;
+    uint64_t aio_reserved2;
+    uint32_t aio_flags;
+    uint32_t aio_resfd;
+};
+
+struct io_event
+{
+    uint64_t data;
+    uint64_t obj;
+    int64_t res;
+    int64_t res2;
+};
+
+struct aio_ring
+{
+    unsigned id;
+    unsigned nr;
+    unsigned head;
+    unsigned tail;
+    unsigned magic;
+    unsigned compat_features;
+    unsigned incompat_features;
+    unsigned header_length;
+    struct io_event io_events[];
+};
+
+#define AIO_RING_MAGIC 0xa10a10a1
+
+#ifndef AIO_FILE
+#define AIO_FILE "/aio"
+#endif
+
+#define NREQS 16
+#define BLKSIZE 4096
+
+static long _io_setup(unsigned nr, aio_context_t* ctx)
+{
+    long r = syscall(SYS_io_setup, nr, ctx);
+    return r < 0 ? -errno : r;
+}
+
+static long _io_destroy(aio_context_t ctx)
+{
+    long r = syscall(SYS_io_destroy, ctx);
+    return r < 0 ? -errno : r;
+}
+
+static long _io_submit(aio_context_t ctx, long nr, struct iocb** iocbs)
+{
+    long r = syscall(SYS_io_submit, ctx, nr, iocbs);
+    return r < 0 ? -errno : r;
+}
+
+static long _io_cancel(aio_context_t ctx, struct iocb* iocb)
+{
+    struct io_event event;
+    long r = syscall(SYS_io_cancel, ctx, iocb, &event);
+    return r < 0 ? -errno : r;
+}
+
+static long _io_getevents(
+    aio_context_t ctx,
+    long min_nr,
+    long nr,
+    struct io_event* events,
+    struct timespec* timeout)
+{
+    long r = syscall(SYS_io_getevents, ctx, min_nr, nr, events, timeout);
+    return r < 0 ? -errno : r;
+}
+
+static void _prep(
+    struct iocb* iocb,
+    int opcode,
+    int fd,
+    void* buf,
+    size_t nbytes,
+    off_t offset)
+{
+    memset(iocb, 0, sizeof(struct iocb));
+    iocb->aio_lio_opcode = opcode;
+    iocb->aio_fildes = fd;
+    iocb->aio_buf = (uint64_t)buf;
+    iocb->aio_nbytes = nbytes;
+    iocb->aio_offset = offset;
+    iocb->aio_data = offset;
+}
+
+static void test_setup_and_destroy(void)
+{
+    aio_context_t ctx = 0;
+    struct aio_ring* ring;
+
+    assert(_io_setup(0, &ctx) == -EINVAL);
+    assert(_io_setup(NREQS, &ctx) == 0);
+    assert(ctx != 0);
+
+    /* the context must be zero on input */
+    assert(_io_setup(NREQS, &ctx) == -EINVAL);
+
+    ring = (struct aio_ring*)ctx;
+    assert(ring->magic == AIO_RING_MAGIC);
+    assert(ring->nr >= NREQS);
+    assert(ring->head == ring->tail);
+
+    assert(_io_destroy(ctx) == 0);
+    assert(_io_destroy(ctx) == -EINVAL);
+
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
+static void test_write_read(void)
+{
+    aio_context_t ctx = 0;
+    static char bufs[NREQS][BLKSIZE];
+    struct iocb iocbs[NREQS];
+    struct iocb* ptrs[NREQS];
+    struct io_event events[NREQS];
+    uint64_t count = 0;
+    int fd;
+    int efd;
+    long n = 0;
+
+    assert((fd = open(AIO_FILE, O_CREAT | O_RDWR | O_TRUNC, 0666)) >= 0);
+    assert((efd = eventfd(0, 0)) >= 0);
+    assert(_io_setup(NREQS, &ctx) == 0);
+
+    /* write the blocks and have each completion signal the eventfd */
+    for (size_t i = 0; i < NREQS; i++)
+    {
+        memset(bufs[i], 'a' + i, BLKSIZE);
+        _prep(&iocbs[i], IOCB_CMD_PWRITE, fd, bufs[i], BLKSIZE, i * BLKSIZE);
+        iocbs[i].aio_flags = IOCB_FLAG_RESFD;
+        iocbs[i].aio_resfd = efd;
+        ptrs[i] = &iocbs[i];
+    }
+
+    assert(_io_submit(ctx, NREQS, ptrs) == NREQS);
+
+    while (count < NREQS)
+    {
+        uint64_t value;
+        assert(read(efd, &value, sizeof(value)) == sizeof(value));
+        count += value;
+    }
+
+    assert(count == NREQS);
+    assert(_io_getevents(ctx, NREQS, NREQS, events, NULL) == NREQS);
+
+    for (size_t i = 0; i < NREQS; i++)
+    {
+        const size_t j = events[i].data / BLKSIZE;
+
+        assert(events[i].res == BLKSIZE);
+        assert(events[i].obj == (uint64_t)&iocbs[j]);
+    }
+
+    /* read the blocks back */
+    for (size_t i = 0; i < NREQS; i++)
+    {
+        memset(bufs[i], 0, BLKSIZE);
+        _prep(&iocbs[i], IOCB_CMD_PREAD, fd, bufs[i], BLKSIZE, i * BLKSIZE);
+    }
+
+    assert(_io_submit(ctx, NREQS, ptrs) == NREQS);
+
+    /* wait for at least one at a time */
+    while (n < NREQS)
+    {
+        long r = _io_getevents(ctx, 1, NREQS, events, NULL);
+        assert(r > 0);
+
+        for (long i = 0; i < r; i++)
+        {
+            const size_t j = events[i].data / BLKSIZE;
+
+            assert(events[i].res == BLKSIZE);
+            assert(bufs[j][0] == 'a' + (char)j);
+            assert(bufs[j][BLKSIZE - 1] == 'a' + (char)j);
+        }
+
+        n += r;
+    }
+
+    /* nothing is left: the wait times out */
+    {
+        struct timespec timeout = {0, 10 * 1000 * 1000};
+        assert(_io_getevents(ctx, 1, NREQS, events, &timeout) == 0);
+    }
+
+    assert(_io_destroy(ctx) == 0);
+    close(efd);
+    close(fd);
+
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
+static void test_preadv_fsync(void)
+{
+    aio_context_t ctx = 0;
+    char data[] = "0123456789abcdefghij";
+    char a[10];
+    char b[10];
+    struct iovec iov[2] = {{a, sizeof(a)}, {b, sizeof(b)}};
+    struct iocb iocbs[2];
+    struct iocb* ptrs[2] = {&iocbs[0], &iocbs[1]};
+    struct io_event events[2];
+    int fd;
+
+    assert((fd = open(AIO_FILE, O_CREAT | O_RDWR | O_TRUNC, 0666)) >= 0);
+    assert(write(fd, data, 20) == 20);
+    assert(_io_setup(4, &ctx) == 0);
+
+    _prep(&iocbs[0], IOCB_CMD_FSYNC, fd, NULL, 0, 0);
+    _prep(&iocbs[1], IOCB_CMD_PREADV, fd, iov, 2, 0);
+    assert(_io_submit(ctx, 2, ptrs) == 2);
+    assert(_io_getevents(ctx, 2, 2, events, NULL) == 2);
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        if (events[i].obj == (uint64_t)&iocbs[0])
+            assert(events[i].res == 0);
+        else
+            assert(events[i].res == 20);
+    }
+
+    assert(memcmp(a, "0123456789", 10) == 0);
+    assert(memcmp(b, "abcdefghij", 10) == 0);
+
+    assert(_io_destroy(ctx) == 0);
+    close(fd);
+
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
+static void test_close_after_submit(void)
+{
+    aio_context_t ctx = 0;
+    static char buf[BLKSIZE];
+    static char check[BLKSIZE];
+    struct iocb iocb;
+    struct iocb* ptr = &iocb;
+    struct io_event event;
+    uint64_t value;
+    int fd;
+    int efd;
+    int other;
+
+    assert((fd = open(AIO_FILE, O_CREAT | O_RDWR | O_TRUNC, 0666)) >= 0);
+    assert((efd = eventfd(0, 0)) >= 0);
+    assert(_io_setup(1, &ctx) == 0);
+
+    memset(buf, 'x', BLKSIZE);
+    _prep(&iocb, IOCB_CMD_PWRITE, fd, buf, BLKSIZE, 0);
+    iocb.aio_flags = IOCB_FLAG_RESFD;
+    iocb.aio_resfd = efd;
+    assert(_io_submit(ctx, 1, &ptr) == 1);
+
+    /* the request holds the file, so closing the descriptors and reusing
+     * their numbers does not redirect the write or the eventfd signal */
+    close(fd);
+    close(efd);
+    assert((other = eventfd(0, EFD_NONBLOCK)) == fd || other == efd);
+
+    assert(_io_getevents(ctx, 1, 1, &event, NULL) == 1);
+    assert(event.res == BLKSIZE);
+    assert(read(other, &value, sizeof(value)) == -1 && errno == EAGAIN);
+
+    assert((fd = open(AIO_FILE, O_RDONLY)) >= 0);
+    assert(read(fd, check, BLKSIZE) == BLKSIZE);
+    assert(memcmp(buf, check, BLKSIZE) == 0);
+
+    assert(_io_destroy(ctx) == 0);
+    close(other);
+    close(fd);
+
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
+static void test_errors(void)
+{
+    aio_context_t ctx = 0;
+    struct iocb iocb;
+    struct iocb* ptr = &iocb;
+    struct io_event event;
+    char buf[16];
+    long r;
+    int fd;
+
+    assert((fd = open(AIO_FILE, O_CREAT | O_RDWR | O_TRUNC, 0666)) >= 0);
+    assert(_io_setup(1, &ctx) == 0);
+
+    /* bad file descriptor */
+    _prep(&iocb, IOCB_CMD_PREAD, 9999, buf, sizeof(buf), 0);
+    assert(_io_submit(ctx, 1, &ptr) == -EBADF);
+
+    /* unknown opcode */
+    _prep(&iocb, 99, fd, buf, sizeof(buf), 0);
+    assert(_io_submit(ctx, 1, &ptr) == -EINVAL);
+
+    /* the eventfd is not an eventfd */
+    _prep(&iocb, IOCB_CMD_PREAD, fd, buf, sizeof(buf), 0);
+    iocb.aio_flags = IOCB_FLAG_RESFD;
+    iocb.aio_resfd = fd;
+    assert(_io_submit(ctx, 1, &ptr) == -EINVAL);
+
+    /* a request that already completed cannot be canceled */
+    _prep(&iocb, IOCB_CMD_PREAD, fd, buf, sizeof(buf), 0);
+    assert(_io_submit(ctx, 1, &ptr) == 1);
+    assert(_io_getevents(ctx, 1, 1, &event, NULL) == 1);
+    assert(event.res == 0);
+    r = _io_cancel(ctx, &iocb);
+    assert(r == -EINVAL || r == -EAGAIN);
+
+    /* bad context */
+    assert(_io_submit(0, 1, &ptr) == -EINVAL);
+    assert(_io_getevents(0, 1, 1, &event, NULL) == -EINVAL);
+
+    assert(_io_destroy(ctx) == 0);
+    close(fd);
+
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
+int main(int argc, const char* argv[])
+{
+    test_setup_and_destroy();
+    test_write_read();
+    test_preadv_fsync();
+    test_close_after_submit();
+    test_errors();
+
+    printf("=== passed all tests (%s)\n", argv[0]);
+
+    return 0;
+}
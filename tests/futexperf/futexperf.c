@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/*
+** Futex ping-pong benchmark: each pair of threads passes a token back and
+** forth through its own futex word with FUTEX_WAIT and FUTEX_WAKE. Running
+** with more pairs shows how the futex implementation scales with many
+** independent futexes.
+*/
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define FUTEX_WAIT 0
+#define FUTEX_WAKE 1
+
+#define DEFAULT_MAX_PAIRS 16
+#define ITERATIONS 20000
+
+/* one futex word per cache line */
+typedef struct word
+{
+    int value;
+} __attribute__((aligned(64))) word_t;
+
+static word_t* _words;
+
+static uint64_t _nsec(void)
+{
+    struct timespec ts;
+    assert(clock_gettime(CLOCK_MONOTONIC, &ts) == 0);
+    return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+/* thread 2*i and thread 2*i+1 share _words[i] and take turns */
+static void* _thread(void* arg)
+{
+    const size_t index = (size_t)arg;
+    int* uaddr = &_words[index / 2].value;
+    const int self = (int)(index % 2);
+
+    for (size_t i = 0; i < ITERATIONS; i++)
+    {
+        /* wait for this thread's turn */
+        while (__atomic_load_n(uaddr, __ATOMIC_ACQUIRE) != self)
+            syscall(SYS_futex, uaddr, FUTEX_WAIT, !self, NULL, NULL, 0);
+
+        /* pass the turn to the other thread */
+        __atomic_store_n(uaddr, !self, __ATOMIC_RELEASE);
+        syscall(SYS_futex, uaddr, FUTEX_WAKE, 1, NULL, NULL, 0);
+    }
+
+    return NULL;
+}
+
+static void _bench(size_t npairs)
+{
+    pthread_t threads[2 * npairs];
+    uint64_t start;
+    uint64_t elapsed;
+
+    assert((_words = calloc(npairs, sizeof(word_t))));
+
+    start = _nsec();
+
+    for (size_t i = 0; i < 2 * npairs; i++)
+        assert(pthread_create(&threads[i], NULL, _thread, (void*)i) == 0);
+
+    for (size_t i = 0; i < 2 * npairs; i++)
+        assert(pthread_join(threads[i], NULL) == 0);
+
+    elapsed = _nsec() - start;
+
+    printf(
+        "=== futex ping-pong: pairs=%zu total=%lums avg=%luns\n",
+        npairs,
+        elapsed / 1000000,
+        elapsed / ITERATIONS);
+
+    free(_words);
+    _words = NULL;
+}
+
+int main(int argc, const char* argv[])
+{
+    size_t max = DEFAULT_MAX_PAIRS;
+
+    if (argc == 2)
+        max = strtoul(argv[1], NULL, 10);
+
+    for (size_t npairs = 1; npairs <= max; npairs *= 2)
+        _bench(npairs);
+
+    printf("=== passed test (%s)\n", argv[0]);
+
+    return 0;
+}
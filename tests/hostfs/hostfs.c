@@ -171,6 +171,44 @@ int main(int argc, const char* argv[])
         assert(close(fd) == 0);
     }
 
+    /* test pwritev() */
+    {
+        struct iovec iov[2];
+        const int iovcnt = sizeof(iov) / sizeof(iov[0]);
+
+        iov[0].iov_base = (void*)ALPHA;
+        iov[0].iov_len = 3;
+        iov[1].iov_base = (void*)(ALPHA + 3);
+        iov[1].iov_len = 4;
+
+        assert((fd = open(filename, O_RDWR, 0)) >= 0);
+        assert(pwritev(fd, iov, iovcnt, 0) == 7);
+
+        /* the file offset is unchanged */
+        assert(lseek(fd, 0, SEEK_CUR) == 0);
+        assert(close(fd) == 0);
+    }
+
+    /* test preadv() */
+    {
+        char buf1[5];
+        char buf2[5];
+        struct iovec iov[2];
+        const int iovcnt = sizeof(iov) / sizeof(iov[0]);
+
+        iov[0].iov_base = buf1;
+        iov[0].iov_len = sizeof(buf1);
+        iov[1].iov_base = buf2;
+        iov[1].iov_len = sizeof(buf2);
+
+        assert((fd = open(filename, O_RDONLY, 0)) >= 0);
+        assert(preadv(fd, iov, iovcnt, 2) == sizeof(buf1) + sizeof(buf2));
+        assert(memcmp(buf1, ALPHA + 2, sizeof(buf1)) == 0);
+        assert(memcmp(buf2, "hijkl", sizeof(buf2)) == 0);
+        assert(lseek(fd, 0, SEEK_CUR) == 0);
+        assert(close(fd) == 0);
+    }
+
     /* test unlink() */
     {
         assert(access(filename, R_OK) == 0);
@@ -0,0 +1,236 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/*
+** Multi-threaded benchmark for the kernel allocator (kernel/malloc.c). The
+** kernel allocator is compiled into this program with its standard entry
+** points renamed, so that it does not replace the host allocator.
+*/
+
+#define _GNU_SOURCE
+
+/* musl's <limits.h> defines PAGE_SIZE but glibc's does not */
+#define PAGE_SIZE 4096
+#define malloc kernel_malloc
+#define free kernel_free
+#define calloc kernel_calloc
+#define realloc kernel_realloc
+#define memalign kernel_memalign
+#define posix_memalign kernel_posix_memalign
+#include "../../kernel/malloc.c"
+#undef malloc
+#undef free
+#undef calloc
+#undef realloc
+#undef memalign
+#undef posix_memalign
+#undef abort
+#undef sched_yield
+#undef mmap
+#undef mremap
+#undef munmap
+#undef fprintf
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_MAX_THREADS 16
+#define ITERATIONS 1000000
+#define SLOTS 64
+
+/*
+**==============================================================================
+**
+** Definitions needed by kernel/malloc.c (the test doesn't link the kernel)
+**
+**==============================================================================
+*/
+
+myst_kernel_args_t __myst_kernel_args;
+
+static __thread uint64_t _tsd;
+
+long myst_tcall_get_tsd(uint64_t* value)
+{
+    /* give each thread a distinct value, like a kernel thread pointer */
+    if (!_tsd)
+        _tsd = (uint64_t)&_tsd;
+
+    *value = _tsd;
+    return 0;
+}
+
+void* myst_mmap(
+    void* addr,
+    size_t length,
+    int prot,
+    int flags,
+    int fd,
+    off_t offset)
+{
+    void* ptr = mmap(addr, length, prot, flags, fd, offset);
+    return (ptr == MAP_FAILED) ? (void*)-ENOMEM : ptr;
+}
+
+void* myst_mremap(
+    void* old_address,
+    size_t old_size,
+    size_t new_size,
+    int flags,
+    void* new_address)
+{
+    void* ptr = mremap(old_address, old_size, new_size, flags, new_address);
+    return (ptr == MAP_FAILED) ? (void*)-ENOMEM : ptr;
+}
+
+int myst_munmap(void* addr, size_t length)
+{
+    return munmap(addr, length) == 0 ? 0 : -EINVAL;
+}
+
+void __myst_panic(
+    const char* file,
+    size_t line,
+    const char* func,
+    const char* format,
+    ...)
+{
+    fprintf(stderr, "panic: %s(%zu): %s(): %s\n", file, line, func, format);
+    abort();
+}
+
+int myst_eprintf(const char* format, ...)
+{
+    (void)format;
+    return 0;
+}
+
+void* myst_debug_malloc(size_t size)
+{
+    return myst_malloc(size);
+}
+
+void myst_debug_free(void* ptr)
+{
+    myst_free(ptr);
+}
+
+void* myst_debug_calloc(size_t nmemb, size_t size)
+{
+    return myst_calloc(nmemb, size);
+}
+
+void* myst_debug_realloc(void* ptr, size_t size)
+{
+    return myst_realloc(ptr, size);
+}
+
+void* myst_debug_memalign(size_t alignment, size_t size)
+{
+    return myst_memalign(alignment, size);
+}
+
+int myst_debug_posix_memalign(void** memptr, size_t alignment, size_t size)
+{
+    return myst_posix_memalign(memptr, alignment, size);
+}
+
+/*
+**==============================================================================
+**
+** Benchmark
+**
+**==============================================================================
+*/
+
+static uint64_t _nsec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+/* sizes typical of kernel allocations (e.g., struct locals, path buffers) */
+static const size_t _sizes[] = {16, 48, 128, 256, 512, 1024, 4096, 4200};
+
+/* allocate and free blocks, keeping up to SLOTS blocks live at a time */
+static void* _thread(void* arg)
+{
+    void* slots[SLOTS] = {NULL};
+    unsigned int seed = (unsigned int)(uintptr_t)arg;
+
+    for (size_t i = 0; i < ITERATIONS; i++)
+    {
+        size_t slot = (size_t)rand_r(&seed) % SLOTS;
+
+        if (slots[slot])
+        {
+            myst_free(slots[slot]);
+            slots[slot] = NULL;
+        }
+        else
+        {
+            size_t size = _sizes[(size_t)rand_r(&seed) % MYST_COUNTOF(_sizes)];
+            assert((slots[slot] = myst_malloc(size)));
+            memset(slots[slot], 0xAB, size);
+        }
+    }
+
+    for (size_t i = 0; i < SLOTS; i++)
+        myst_free(slots[i]);
+
+    return NULL;
+}
+
+static void _bench(size_t nthreads)
+{
+    pthread_t threads[nthreads];
+    uint64_t start;
+    uint64_t elapsed;
+
+    start = _nsec();
+
+    for (size_t i = 0; i < nthreads; i++)
+        assert(pthread_create(&threads[i], NULL, _thread, (void*)i) == 0);
+
+    for (size_t i = 0; i < nthreads; i++)
+        assert(pthread_join(threads[i], NULL) == 0);
+
+    elapsed = _nsec() - start;
+
+    printf(
+        "=== malloc/free: threads=%zu total=%lums avg=%luns\n",
+        nthreads,
+        elapsed / 1000000,
+        elapsed / (nthreads * ITERATIONS));
+}
+
+int main(int argc, const char* argv[])
+{
+    size_t max = DEFAULT_MAX_THREADS;
+    myst_malloc_stats_t stats;
+
+    if (argc == 2)
+        max = strtoul(argv[1], NULL, 10);
+
+    for (size_t n = 1; n <= max; n *= 2)
+        _bench(n);
+
+    assert(myst_get_malloc_stats(&stats) == 0);
+    printf(
+        "=== cache: hits=%zu misses=%zu bypasses=%zu contention=%zu "
+        "refills=%zu flushes=%zu bytes=%zu\n",
+        stats.cache_hits,
+        stats.cache_misses,
+        stats.cache_bypasses,
+        stats.cache_contention,
+        stats.cache_refills,
+        stats.cache_flushes,
+        stats.cache_bytes);
+
+    printf("=== passed test (%s)\n", argv[0]);
+    return 0;
+}
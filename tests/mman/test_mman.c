@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <assert.h>
+#include <errno.h>
 #include <limits.h>
 #include <malloc.h>
 #include <stdbool.h>
@@ -12,6 +13,7 @@
 #include <unistd.h>
 
 #include <myst/mman.h>
+#include <myst/strings.h>
 
 #define D(X)
 
@@ -19,9 +21,13 @@
 #define PAGE_SIZE 4096
 #endif
 
+/* number of calls to myst_tcall_mprotect() */
+static size_t _num_mprotect_tcalls;
+
 /* the test doesn't link the kernel so we provide this definition */
 int myst_tcall_mprotect(void* addr, size_t len, int prot)
 {
+    _num_mprotect_tcalls++;
     return mprotect(addr, len, prot);
 }
 
@@ -1225,6 +1231,223 @@ void test_prot_vector()
     printf("=== passed test (%s)\n", __FUNCTION__);
 }
 
+/*
+** test_mprotect_elision()
+**
+**     Test that mprotect tcalls are only issued for pages whose permission
+**     changes, with one tcall per contiguous run of such pages.
+**
+*/
+void test_mprotect_elision()
+{
+    myst_mman_t h;
+    const size_t heap_size = 64 * 1024 * 1024;
+    const int rw = MYST_PROT_READ | MYST_PROT_WRITE;
+    uint8_t* addr;
+    size_t ntcalls;
+    size_t issued;
+    size_t elided;
+
+    assert(_init_mman(&h, heap_size) == 0);
+
+    assert((addr = _mman_mmap(&h, NULL, 16 * PAGE_SIZE)));
+
+    /* The pages are already read-write so no tcall is needed */
+    ntcalls = _num_mprotect_tcalls;
+    elided = h.mprotect_tcalls_elided;
+    assert(myst_mman_mprotect(&h, addr, 16 * PAGE_SIZE, rw) == 0);
+    assert(_num_mprotect_tcalls == ntcalls);
+    assert(h.mprotect_tcalls_elided == elided + 1);
+
+    /* Make pages 2-3 and 8-11 read-only */
+    assert(myst_mman_mprotect(&h, addr + 2 * PAGE_SIZE, 2 * PAGE_SIZE, 1) == 0);
+    assert(myst_mman_mprotect(&h, addr + 8 * PAGE_SIZE, 4 * PAGE_SIZE, 1) == 0);
+
+    /* Restoring the whole range takes exactly one tcall per changed run */
+    ntcalls = _num_mprotect_tcalls;
+    issued = h.mprotect_tcalls_issued;
+    assert(myst_mman_mprotect(&h, addr, 16 * PAGE_SIZE, rw) == 0);
+    assert(_num_mprotect_tcalls == ntcalls + 2);
+    assert(h.mprotect_tcalls_issued == issued + 2);
+
+    /* The restored pages are writable again */
+    memset(addr, 0xAB, 16 * PAGE_SIZE);
+
+    assert(_mman_unmap(&h, addr, 16 * PAGE_SIZE) == 0);
+
+    /* Unmapping pages that are already inaccessible issues no tcall */
+    ntcalls = _num_mprotect_tcalls;
+    assert(myst_mman_mprotect(&h, addr, 16 * PAGE_SIZE, 0) == 0);
+    assert(_num_mprotect_tcalls == ntcalls);
+
+    assert(myst_mman_is_sane(&h));
+
+    _free_mman(&h);
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
+/*
+**==============================================================================
+**
+** test_madvise()
+**
+**     Test that MADV_DONTNEED zero-fills pages, that MADV_FREE preserves them,
+**     and that released pages are counted until they are unmapped.
+**
+*/
+void test_madvise()
+{
+    myst_mman_t h;
+    const size_t heap_size = 64 * 1024 * 1024;
+    uint8_t* addr;
+    size_t reserved;
+    size_t released;
+
+    assert(_init_mman(&h, heap_size) == 0);
+
+    assert((addr = _mman_mmap(&h, NULL, 16 * PAGE_SIZE)));
+    memset(addr, 0xAB, 16 * PAGE_SIZE);
+
+    assert(myst_mman_reserved_size(&h, &reserved) == 0);
+    assert(reserved == 16 * PAGE_SIZE);
+
+    /* MADV_DONTNEED zero-fills pages 0-3 (including a read-only page) */
+    assert(myst_mman_mprotect(&h, addr + PAGE_SIZE, PAGE_SIZE, 1) == 0);
+    assert(
+        myst_mman_madvise(&h, addr, 4 * PAGE_SIZE, MYST_MADV_DONTNEED) == 0);
+    assert(myst_memcchr(addr, 0, 4 * PAGE_SIZE) == NULL);
+    assert(addr[4 * PAGE_SIZE] == 0xAB);
+
+    /* The permissions are unchanged */
+    {
+        int prot;
+        bool consistent;
+
+        assert(
+            myst_mman_get_prot(
+                &h, addr + PAGE_SIZE, PAGE_SIZE, &prot, &consistent) == 0);
+        assert(consistent && prot == 1);
+    }
+
+    /* MADV_FREE zero-fills pages 8-11 too */
+    assert(
+        myst_mman_madvise(
+            &h, addr + 8 * PAGE_SIZE, 4 * PAGE_SIZE, MYST_MADV_FREE) == 0);
+    assert(myst_memcchr(addr + 8 * PAGE_SIZE, 0, 4 * PAGE_SIZE) == NULL);
+    assert(addr[12 * PAGE_SIZE] == 0xAB);
+
+    /* Releasing pages again does not count them twice */
+    assert(myst_mman_madvise(&h, addr, 2 * PAGE_SIZE, MYST_MADV_FREE) == 0);
+    assert(myst_mman_released_size(&h, &released) == 0);
+    assert(released == 8 * PAGE_SIZE);
+
+    /* Writing to a released page makes it resident again */
+    addr[2 * PAGE_SIZE] = 1;
+    assert(myst_mman_released_size(&h, &released) == 0);
+    assert(released == 7 * PAGE_SIZE);
+
+    /* Unmapping released pages removes them from the count */
+    assert(_mman_unmap(&h, addr + 8 * PAGE_SIZE, 8 * PAGE_SIZE) == 0);
+    assert(myst_mman_released_size(&h, &released) == 0);
+    assert(released == 3 * PAGE_SIZE);
+
+    /* Unmapped ranges are rejected */
+    assert(
+        myst_mman_madvise(&h, addr, 16 * PAGE_SIZE, MYST_MADV_DONTNEED) ==
+        -ENOMEM);
+
+    /* Remapping the unmapped pages does not make them released */
+    assert(_mman_mmap(&h, NULL, 8 * PAGE_SIZE) == addr + 8 * PAGE_SIZE);
+    assert(myst_mman_released_size(&h, &released) == 0);
+    assert(released == 3 * PAGE_SIZE);
+
+    /* Pages that hold file contents keep them */
+    memset(addr + 8 * PAGE_SIZE, 0xCD, 4 * PAGE_SIZE);
+    assert(myst_mman_set_file_pages(&h, addr + 8 * PAGE_SIZE, PAGE_SIZE) == 0);
+    assert(
+        myst_mman_madvise(
+            &h, addr + 8 * PAGE_SIZE, 4 * PAGE_SIZE, MYST_MADV_DONTNEED) == 0);
+    assert(myst_memcchr(addr + 8 * PAGE_SIZE, 0xCD, PAGE_SIZE) == NULL);
+    assert(myst_memcchr(addr + 9 * PAGE_SIZE, 0, 3 * PAGE_SIZE) == NULL);
+    assert(myst_mman_released_size(&h, &released) == 0);
+    assert(released == 6 * PAGE_SIZE);
+
+    assert(_mman_unmap(&h, addr, 16 * PAGE_SIZE) == 0);
+    assert(myst_mman_released_size(&h, &released) == 0);
+    assert(released == 0);
+    assert(h.file_pages == 0);
+
+    assert(myst_mman_is_sane(&h));
+
+    _free_mman(&h);
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
+/*
+**==============================================================================
+**
+** test_zero_fill_elision()
+**
+**     Test that pages known to be zero are not zero-filled again when mapped,
+**     and that reused pages are zero-filled.
+**
+*/
+void test_zero_fill_elision()
+{
+    myst_mman_t h;
+    const size_t heap_size = 64 * 1024 * 1024;
+    const int flags = MYST_MAP_ANONYMOUS | MYST_MAP_PRIVATE;
+    void* base;
+    uint8_t* addr;
+    void* ptr;
+
+    assert((base = memalign(PAGE_SIZE, heap_size)));
+    memset(base, 0, heap_size);
+    assert(myst_mman_init(&h, (uintptr_t)base, heap_size) == 0);
+    myst_mman_set_sanity(&h, true);
+    myst_mman_set_zero_filled(&h);
+
+    /* The pages of the first mapping are pristine */
+    assert((addr = _mman_mmap(&h, NULL, 16 * PAGE_SIZE)));
+    assert(h.zero_fill_pages_elided == 16);
+    assert(myst_memcchr(addr, 0, 16 * PAGE_SIZE) == NULL);
+    memset(addr, 0xAB, 16 * PAGE_SIZE);
+    assert(_mman_unmap(&h, addr, 16 * PAGE_SIZE) == 0);
+
+    /* Remapping the same pages must zero-fill them */
+    assert(_mman_mmap(&h, NULL, 16 * PAGE_SIZE) == addr);
+    assert(h.zero_fill_pages_elided == 16);
+    assert(myst_memcchr(addr, 0, 16 * PAGE_SIZE) == NULL);
+
+    /* Growing the mapping in place zero-fills the reused tail */
+    memset(addr + 8 * PAGE_SIZE, 0xAB, 8 * PAGE_SIZE);
+    assert(_mman_unmap(&h, addr + 8 * PAGE_SIZE, 8 * PAGE_SIZE) == 0);
+    assert(
+        myst_mman_mremap(
+            &h,
+            addr,
+            8 * PAGE_SIZE,
+            16 * PAGE_SIZE,
+            MYST_MREMAP_MAYMOVE,
+            &ptr) == 0);
+    assert(ptr == addr);
+    assert(h.zero_fill_pages_elided == 16);
+    assert(myst_memcchr(addr, 0, 16 * PAGE_SIZE) == NULL);
+
+    /* Read-only pristine pages are mapped without write access */
+    assert(
+        myst_mman_mmap(&h, NULL, 4 * PAGE_SIZE, MYST_PROT_READ, flags, &ptr) ==
+        0);
+    assert(h.zero_fill_pages_elided == 16 + 4);
+    assert(myst_memcchr(ptr, 0, 4 * PAGE_SIZE) == NULL);
+    assert(myst_mman_munmap(&h, ptr, 4 * PAGE_SIZE) == 0);
+
+    assert(myst_mman_is_sane(&h));
+
+    free(base);
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
 void test_mman(void)
 {
     test_mman_1();
@@ -1241,4 +1464,7 @@ void test_mman(void)
     test_out_of_memory();
     test_mman_randomly();
     test_prot_vector();
+    test_mprotect_elision();
+    test_madvise();
+    test_zero_fill_elision();
 }
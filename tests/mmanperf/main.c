@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <assert.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <myst/mman.h>
+
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 4096
+#endif
+
+#define DEFAULT_MAX 100000
+
+/* the test doesn't link the kernel so we provide this definition: measure
+ * the VAD bookkeeping only (N split mappings would also exceed the host's
+ * vm.max_map_count) */
+int myst_tcall_mprotect(void* addr, size_t len, int prot)
+{
+    (void)addr;
+    (void)len;
+    (void)prot;
+    return 0;
+}
+
+static uint64_t _nsec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+static void* _mmap(myst_mman_t* mman, size_t length)
+{
+    const int prot = MYST_PROT_READ | MYST_PROT_WRITE;
+    const int flags = MYST_MAP_ANONYMOUS | MYST_MAP_PRIVATE;
+    void* ptr = NULL;
+
+    if (myst_mman_mmap(mman, NULL, length, prot, flags, &ptr) != 0)
+    {
+        fprintf(stderr, "myst_mman_mmap() failed: %s\n", mman->err);
+        abort();
+    }
+
+    return ptr;
+}
+
+static void _munmap(myst_mman_t* mman, void* addr, size_t length)
+{
+    if (myst_mman_munmap(mman, addr, length) != 0)
+    {
+        fprintf(stderr, "myst_mman_munmap() failed: %s\n", mman->err);
+        abort();
+    }
+}
+
+/*
+** Create N one-page VADs separated by one-page gaps, then time N mmap/munmap
+** pairs against that layout. Each two-page mapping fits no gap, so every pair
+** performs a full gap lookup and an address lookup over N VADs.
+*/
+static void _bench(size_t n)
+{
+    /* 2N pages for the layout, plus room for the measured mappings */
+    const size_t size = (2 * n + 16) * PAGE_SIZE;
+    /* Leave room for the VADs array and prot vector (one of each per page) */
+    const size_t total = size + (size / PAGE_SIZE / 32 + 2) * PAGE_SIZE;
+    myst_mman_t mman;
+    void* base;
+    uint8_t* layout;
+    uint64_t start;
+    uint64_t elapsed;
+
+    if (!(base = memalign(PAGE_SIZE, total)))
+    {
+        fprintf(stderr, "memalign() failed: size=%zu\n", total);
+        abort();
+    }
+
+    assert(myst_mman_init(&mman, (uintptr_t)base, total) == 0);
+
+    /* Map 2N pages as a single coalesced region */
+    layout = _mmap(&mman, 2 * n * PAGE_SIZE);
+
+    /* Unmap every other page, leaving N VADs and N - 1 interior gaps */
+    for (size_t i = 0; i < n; i++)
+        _munmap(&mman, layout + (2 * i + 1) * PAGE_SIZE, PAGE_SIZE);
+
+    start = _nsec();
+
+    for (size_t i = 0; i < n; i++)
+    {
+        void* ptr = _mmap(&mman, 2 * PAGE_SIZE);
+        _munmap(&mman, ptr, 2 * PAGE_SIZE);
+    }
+
+    elapsed = _nsec() - start;
+
+    printf(
+        "=== mmap/munmap pairs: n=%zu total=%lums avg=%luns\n",
+        n,
+        elapsed / 1000000,
+        elapsed / n);
+
+    free(base);
+}
+
+int main(int argc, const char* argv[])
+{
+    size_t max = DEFAULT_MAX;
+
+    if (argc == 2)
+        max = strtoul(argv[1], NULL, 10);
+
+    for (size_t n = 10; n <= max; n *= 10)
+        _bench(n);
+
+    printf("=== passed test (%s)\n", argv[0]);
+    return 0;
+}
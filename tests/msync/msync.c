@@ -78,6 +78,70 @@ static bool _check_page(uint8_t page[PAGE_SIZE], uint8_t byte)
     return true;
 }
 
+/* wait for the file to contain BYTE at page INDEX (written asynchronously) */
+static bool _wait_for_page(int fd, size_t index, uint8_t byte)
+{
+    uint8_t page[PAGE_SIZE];
+
+    for (size_t i = 0; i < 1000; i++)
+    {
+        const off_t offset = (off_t)(index * PAGE_SIZE);
+
+        if (pread(fd, page, PAGE_SIZE, offset) == PAGE_SIZE &&
+            _check_page(page, byte))
+        {
+            return true;
+        }
+
+        usleep(10000);
+    }
+
+    return false;
+}
+
+static void _test_ms_async(void)
+{
+    const size_t num_pages = 8;
+    uint8_t page[PAGE_SIZE];
+    int fd;
+    int rfd;
+
+    assert((fd = open("/msync_async", O_CREAT | O_TRUNC | O_RDWR, 0666)) >= 0);
+    assert((rfd = open("/msync_async", O_RDONLY)) >= 0);
+
+    memset(page, 0, sizeof(page));
+
+    for (size_t i = 0; i < num_pages; i++)
+        assert(_writen(fd, page, sizeof(page)) == 0);
+
+    const size_t length = num_pages * PAGE_SIZE;
+    const int prot = PROT_READ | PROT_WRITE;
+    uint8_t* addr = mmap(NULL, length, prot, MAP_SHARED, fd, 0);
+    assert(addr != MAP_FAILED);
+
+    /* the first request starts the flusher, later ones are asynchronous */
+    for (uint8_t byte = 1; byte <= 3; byte++)
+    {
+        memset(addr + 1 * PAGE_SIZE, byte, PAGE_SIZE);
+        memset(addr + 5 * PAGE_SIZE, byte, PAGE_SIZE);
+        assert(msync(addr, length, MS_ASYNC) == 0);
+
+        assert(_wait_for_page(rfd, 1, byte));
+        assert(_wait_for_page(rfd, 5, byte));
+        assert(_wait_for_page(rfd, 2, 0));
+    }
+
+    /* unmapping completes any write-back that is still pending */
+    memset(addr + 7 * PAGE_SIZE, 0xff, PAGE_SIZE);
+    assert(msync(addr, length, MS_ASYNC) == 0);
+    assert(munmap(addr, length) == 0);
+    assert(pread(rfd, page, PAGE_SIZE, 7 * PAGE_SIZE) == PAGE_SIZE);
+    assert(_check_page(page, 0xff));
+
+    assert(close(rfd) == 0);
+    assert(close(fd) == 0);
+}
+
 int main(int argc, const char* argv[])
 {
     const size_t num_pages = 8;
@@ -176,6 +240,8 @@ int main(int argc, const char* argv[])
         assert(close(fd) == 0);
     }
 
+    _test_ms_async();
+
     printf("=== passed test (%s)\n", argv[0]);
 
     return 0;
@@ -128,6 +128,44 @@ int test_fdatasync()
     close(fd);
 }
 
+static void _read_syscall_latencies(char* buf, size_t size)
+{
+    int fd;
+    size_t len = 0;
+    ssize_t n;
+
+    fd = open("/proc/mystikos/syscalls", O_RDONLY);
+    assert(fd > 0);
+
+    while ((n = read(fd, buf + len, size - len - 1)) > 0)
+        len += n;
+
+    assert(len > 0);
+    buf[len] = '\0';
+    close(fd);
+}
+
+int test_syscall_latencies()
+{
+    int fd;
+    static char buf[64 * 1024];
+
+    getppid();
+
+    _read_syscall_latencies(buf, sizeof(buf));
+    assert(strstr(buf, "p99_ns") != NULL);
+    assert(strstr(buf, "SYS_getppid ") != NULL);
+
+    /* reset the histograms */
+    fd = open("/proc/mystikos/syscalls_reset", O_WRONLY);
+    assert(fd > 0);
+    assert(write(fd, "1", 1) == 1);
+    close(fd);
+
+    _read_syscall_latencies(buf, sizeof(buf));
+    assert(strstr(buf, "SYS_getppid ") == NULL);
+}
+
 int main(int argc, const char* argv[])
 {
     test_meminfo();
@@ -136,6 +174,7 @@ int main(int argc, const char* argv[])
     test_maps();
     test_cpuinfo();
     test_fdatasync();
+    test_syscall_latencies();
 
     printf("\n=== passed test (%s)\n", argv[0]);
     return 0;
@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 4096
+#endif
+
+/* a rootfs file of 10000 bytes (see Makefile) */
+static const char _path[] = "/data/file";
+static uint8_t _data[3 * PAGE_SIZE];
+static size_t _size;
+
+static uint8_t* _map(void* addr, int prot, int flags)
+{
+    int fd;
+    uint8_t* p;
+
+    assert((fd = open(_path, O_RDONLY)) >= 0);
+    p = mmap(addr, sizeof(_data), prot, flags, fd, 0);
+    assert(p != MAP_FAILED);
+    assert(close(fd) == 0);
+
+    return p;
+}
+
+/* check the file contents (and the zero-filled tail of the last page) */
+static void _check(const uint8_t* p)
+{
+    assert(memcmp(p, _data, sizeof(_data)) == 0);
+}
+
+static void _test_shared(void)
+{
+    uint8_t* p = _map(NULL, PROT_READ, MAP_PRIVATE);
+    uint8_t* q = _map(NULL, PROT_READ, MAP_PRIVATE);
+
+    _check(p);
+    _check(q);
+
+    /* unmapping one mapping leaves the other intact */
+    assert(munmap(p, sizeof(_data)) == 0);
+    _check(q);
+    assert(munmap(q, sizeof(_data)) == 0);
+
+    /* executable mappings are eligible too */
+    p = _map(NULL, PROT_READ | PROT_EXEC, MAP_PRIVATE);
+    _check(p);
+    assert(munmap(p, sizeof(_data)) == 0);
+
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
+static void _test_partial_unmap(void)
+{
+    uint8_t* p = _map(NULL, PROT_READ, MAP_PRIVATE);
+
+    assert(munmap(p + PAGE_SIZE, PAGE_SIZE) == 0);
+    assert(memcmp(p, _data, PAGE_SIZE) == 0);
+    assert(memcmp(p + 2 * PAGE_SIZE, _data + 2 * PAGE_SIZE, PAGE_SIZE) == 0);
+    assert(munmap(p, PAGE_SIZE) == 0);
+    assert(munmap(p + 2 * PAGE_SIZE, PAGE_SIZE) == 0);
+
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
+static void _test_mprotect(void)
+{
+    uint8_t* p = _map(NULL, PROT_READ, MAP_PRIVATE);
+
+    /* private mappings may be made writable (the file is not changed) */
+    assert(mprotect(p, sizeof(_data), PROT_READ | PROT_WRITE) == 0);
+    p[0] = ~_data[0];
+    assert(munmap(p, sizeof(_data)) == 0);
+
+    p = _map(NULL, PROT_READ, MAP_PRIVATE);
+    _check(p);
+    assert(munmap(p, sizeof(_data)) == 0);
+
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
+static void _test_mremap(void)
+{
+    uint8_t* p = _map(NULL, PROT_READ, MAP_PRIVATE);
+    uint8_t* q;
+
+    q = mremap(p, sizeof(_data), 2 * sizeof(_data), MREMAP_MAYMOVE);
+    assert(q != MAP_FAILED);
+
+    /* the file data was kept (the pages past the end of file are not
+     * accessed, since Linux raises SIGBUS for them) */
+    _check(q);
+
+    assert(munmap(q, 2 * sizeof(_data)) == 0);
+
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
+static void _test_map_fixed(void)
+{
+    const int prot = PROT_READ | PROT_WRITE;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED;
+    uint8_t* p = _map(NULL, PROT_READ, MAP_PRIVATE);
+    uint8_t* q;
+
+    /* an anonymous mapping replaces the middle page */
+    q = mmap(p + PAGE_SIZE, PAGE_SIZE, prot, flags, -1, 0);
+    assert(q == p + PAGE_SIZE);
+
+    for (size_t i = 0; i < PAGE_SIZE; i++)
+        assert(q[i] == 0);
+
+    q[0] = 1;
+    assert(memcmp(p, _data, PAGE_SIZE) == 0);
+
+    /* a file mapping replaces the whole range */
+    q = _map(p, PROT_READ, MAP_PRIVATE | MAP_FIXED);
+    assert(q == p);
+    _check(q);
+
+    assert(munmap(p, sizeof(_data)) == 0);
+
+    printf("=== passed test (%s)\n", __FUNCTION__);
+}
+
+int main(int argc, const char* argv[])
+{
+    int fd;
+    struct stat st;
+    ssize_t n;
+
+    assert((fd = open(_path, O_RDONLY)) >= 0);
+    assert(fstat(fd, &st) == 0);
+    _size = (size_t)st.st_size;
+    assert(_size > 2 * PAGE_SIZE && _size < sizeof(_data));
+    assert((n = read(fd, _data, sizeof(_data))) == (ssize_t)_size);
+    assert(close(fd) == 0);
+
+    _test_shared();
+    _test_partial_unmap();
+    _test_mprotect();
+    _test_mremap();
+    _test_map_fixed();
+
+    printf("=== passed test (%s)\n", argv[0]);
+
+    return 0;
+}
@@ -4,6 +4,7 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 
+#define _GNU_SOURCE
 #include <assert.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -226,6 +227,84 @@ static void* _cli_thread_func(void* arg)
     return NULL;
 }
 
+/* send a batch of datagrams with sendmmsg() and receive with recvmmsg() */
+static void _test_mmsg(void)
+{
+    static const char* strs[] = {"red", "green", "blue"};
+    const size_t n = sizeof(strs) / sizeof(strs[0]);
+    int rsock;
+    int ssock;
+    struct sockaddr_in addr;
+    struct iovec send_iov[4];
+    struct mmsghdr send_vec[3];
+    char bufs[3][16];
+    struct iovec recv_iov[3];
+    struct sockaddr_in names[3];
+    struct mmsghdr recv_vec[3];
+
+    assert((rsock = socket(AF_INET, SOCK_DGRAM, 0)) >= 0);
+    assert((ssock = socket(AF_INET, SOCK_DGRAM, 0)) >= 0);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port + 1);
+    assert(bind(rsock, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+
+    /* the last message is split across two iovec elements */
+    memset(send_vec, 0, sizeof(send_vec));
+
+    for (size_t i = 0; i < n; i++)
+    {
+        send_iov[i].iov_base = (void*)strs[i];
+        send_iov[i].iov_len = strlen(strs[i]);
+        send_vec[i].msg_hdr.msg_name = &addr;
+        send_vec[i].msg_hdr.msg_namelen = sizeof(addr);
+        send_vec[i].msg_hdr.msg_iov = &send_iov[i];
+        send_vec[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    send_iov[2].iov_len = 2;
+    send_iov[3].iov_base = (void*)(strs[2] + 2);
+    send_iov[3].iov_len = 2;
+    send_vec[2].msg_hdr.msg_iovlen = 2;
+
+    assert(sendmmsg(ssock, send_vec, n, 0) == (int)n);
+
+    for (size_t i = 0; i < n; i++)
+        assert(send_vec[i].msg_len == strlen(strs[i]));
+
+    memset(bufs, 0, sizeof(bufs));
+    memset(recv_vec, 0, sizeof(recv_vec));
+
+    for (size_t i = 0; i < n; i++)
+    {
+        recv_iov[i].iov_base = bufs[i];
+        recv_iov[i].iov_len = sizeof(bufs[i]);
+        recv_vec[i].msg_hdr.msg_name = &names[i];
+        recv_vec[i].msg_hdr.msg_namelen = sizeof(names[i]);
+        recv_vec[i].msg_hdr.msg_iov = &recv_iov[i];
+        recv_vec[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    assert(recvmmsg(rsock, recv_vec, n, MSG_WAITFORONE, NULL) == (int)n);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        assert(recv_vec[i].msg_len == strlen(strs[i]));
+        assert(strcmp(bufs[i], strs[i]) == 0);
+        assert(recv_vec[i].msg_hdr.msg_namelen == sizeof(names[i]));
+        assert(names[i].sin_family == AF_INET);
+    }
+
+    /* nothing is left to receive */
+    assert(recvmmsg(rsock, recv_vec, n, MSG_DONTWAIT, NULL) == -1);
+    assert(errno == EAGAIN);
+
+    assert(close(ssock) == 0);
+    assert(close(rsock) == 0);
+}
+
 int main(int argc, const char* argv[])
 {
     pthread_t srv_thread;
@@ -238,6 +317,8 @@ int main(int argc, const char* argv[])
     pthread_join(cli_thread, NULL);
     pthread_join(srv_thread, NULL);
 
+    _test_mmsg();
+
     printf("=== passed test (%s)\n", argv[0]);
     return 0;
 }
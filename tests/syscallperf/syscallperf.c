@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/*
+** System call latency benchmark: measures the round trip of system calls
+** that do little work in the kernel, so that the cost of entering the kernel
+** and of looking up the current thread dominates.
+*/
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define FUTEX_WAIT 0
+#define FUTEX_WAKE 1
+
+#define DEFAULT_ITERATIONS 1000000
+
+static size_t _iterations = DEFAULT_ITERATIONS;
+static int _futex_word;
+
+static uint64_t _nsec(void)
+{
+    struct timespec ts;
+    assert(clock_gettime(CLOCK_MONOTONIC, &ts) == 0);
+    return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+static void _getpid(void)
+{
+    syscall(SYS_getpid);
+}
+
+static void _gettid(void)
+{
+    syscall(SYS_gettid);
+}
+
+static void _getuid(void)
+{
+    syscall(SYS_getuid);
+}
+
+/* wake a futex that has no waiters */
+static void _futex_wake(void)
+{
+    syscall(SYS_futex, &_futex_word, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+/* wait on a futex whose value differs (returns EAGAIN immediately) */
+static void _futex_wait(void)
+{
+    syscall(SYS_futex, &_futex_word, FUTEX_WAIT, 1, NULL, NULL, 0);
+}
+
+/* the clock functions are answered by the C runtime without a syscall */
+static void _clock_gettime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+}
+
+static void _gettimeofday(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+}
+
+static void _time(void)
+{
+    time(NULL);
+}
+
+static void _bench(const char* name, void (*func)(void))
+{
+    uint64_t start;
+    uint64_t elapsed;
+
+    start = _nsec();
+
+    for (size_t i = 0; i < _iterations; i++)
+        (*func)();
+
+    elapsed = _nsec() - start;
+
+    printf(
+        "=== %s: iterations=%zu total=%lums avg=%luns\n",
+        name,
+        _iterations,
+        elapsed / 1000000,
+        elapsed / _iterations);
+}
+
+int main(int argc, const char* argv[])
+{
+    if (argc == 2)
+        _iterations = strtoul(argv[1], NULL, 10);
+
+    assert(_iterations > 0);
+
+    _bench("getpid", _getpid);
+    _bench("gettid", _gettid);
+    _bench("getuid", _getuid);
+    _bench("futex-wake", _futex_wake);
+    _bench("futex-wait", _futex_wait);
+    _bench("clock_gettime", _clock_gettime);
+    _bench("gettimeofday", _gettimeofday);
+    _bench("time", _time);
+
+    printf("=== passed test (%s)\n", argv[0]);
+
+    return 0;
+}
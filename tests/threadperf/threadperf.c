@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/*
+** Thread creation benchmark: measures the latency of pthread_create() plus
+** pthread_join() for a thread that does nothing, first one thread at a time
+** and then in bursts (as in thread-per-request servers and OpenMP regions).
+*/
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_ITERATIONS 1000
+#define BURST 8
+
+static uint64_t _nsec(void)
+{
+    struct timespec ts;
+    assert(clock_gettime(CLOCK_MONOTONIC, &ts) == 0);
+    return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+static void* _thread(void* arg)
+{
+    return arg;
+}
+
+static void _bench(size_t iterations, size_t burst)
+{
+    pthread_t threads[BURST];
+    uint64_t start;
+    uint64_t elapsed;
+
+    start = _nsec();
+
+    for (size_t i = 0; i < iterations; i += burst)
+    {
+        for (size_t j = 0; j < burst; j++)
+            assert(pthread_create(&threads[j], NULL, _thread, NULL) == 0);
+
+        for (size_t j = 0; j < burst; j++)
+            assert(pthread_join(threads[j], NULL) == 0);
+    }
+
+    elapsed = _nsec() - start;
+
+    printf(
+        "=== create/join: burst=%zu threads=%zu total=%lums avg=%luns\n",
+        burst,
+        iterations,
+        elapsed / 1000000,
+        elapsed / iterations);
+}
+
+int main(int argc, const char* argv[])
+{
+    size_t iterations = DEFAULT_ITERATIONS;
+
+    if (argc == 2)
+        iterations = strtoul(argv[1], NULL, 10);
+
+    _bench(iterations, 1);
+    _bench(iterations, BURST);
+
+    printf("=== passed test (%s)\n", argv[0]);
+
+    return 0;
+}
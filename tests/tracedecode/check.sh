@@ -0,0 +1,36 @@
+#!/bin/bash
+#
+# Usage: check.sh <strace-text> <chrome-json>
+#
+# Check the output of "myst trace-decode" for the tracedecode program: the
+# getpid() calls of the parent and the child must both be decoded, and each
+# must be attributed to the process whose pid it returned.
+
+grep -q "getpid(" $1
+if [ "$?" != "0" ]; then
+    echo "check.sh: no getpid() calls in $1"
+    exit 1
+fi
+
+awk '
+/"name":"getpid"/ {
+    match($0, /"pid":[0-9]+/); pid = substr($0, RSTART + 6, RLENGTH - 6)
+    match($0, /"ret":[0-9]+/); ret = substr($0, RSTART + 6, RLENGTH - 6)
+    if (pid != ret) {
+        print "check.sh: getpid() = " ret " in pid " pid
+        bad = 1
+    }
+    pids[pid] = 1
+}
+END {
+    n = 0
+    for (p in pids) n++
+    if (n < 2) {
+        print "check.sh: expected getpid() calls of two processes"
+        bad = 1
+    }
+    exit bad
+}' $2
+if [ "$?" != "0" ]; then
+    exit 1
+fi
@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <assert.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* check.sh expects the traced getpid() calls of both processes to be
+ * attributed to the process that made them */
+
+int main(int argc, const char* argv[])
+{
+    pid_t pid;
+    int wstatus;
+    char* child_argv[] = {"/bin/tracedecode", "child", NULL};
+
+    assert(syscall(SYS_getpid) > 0);
+
+    if (argc == 2 && strcmp(argv[1], "child") == 0)
+        return 0;
+
+    assert(posix_spawn(&pid, child_argv[0], NULL, NULL, child_argv, NULL) == 0);
+    assert(waitpid(pid, &wstatus, 0) == pid);
+    assert(WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0);
+
+    printf("=== passed test (%s)\n", argv[0]);
+
+    return 0;
+}
@@ -29,6 +29,50 @@
         }                                                   \
     } while (0)
 
+static const struct
+{
+    const char* name;
+    uint32_t flag;
+} _switchless_calls[] = {
+    {"read", SWITCHLESS_READ},
+    {"write", SWITCHLESS_WRITE},
+    {"recvfrom", SWITCHLESS_RECVFROM},
+    {"sendto", SWITCHLESS_SENDTO},
+    {"recvmsg", SWITCHLESS_RECVMSG},
+    {"sendmsg", SWITCHLESS_SENDMSG},
+};
+
+static json_result_t _extract_switchless_call(
+    json_type_t type,
+    const json_union_t* un,
+    uint32_t* calls)
+{
+    json_result_t ret = JSON_FAILED;
+
+    if (type != JSON_TYPE_STRING)
+        CONFIG_RAISE(JSON_TYPE_MISMATCH);
+
+    for (size_t i = 0; i < MYST_COUNTOF(_switchless_calls); i++)
+    {
+        if (strcmp(un->string, _switchless_calls[i].name) == 0)
+        {
+            *calls |= _switchless_calls[i].flag;
+            ret = JSON_OK;
+            goto done;
+        }
+    }
+
+    fprintf(
+        stderr,
+        "ERROR: Configuration: HostSwitchlessCalls must be one of read, "
+        "write, recvfrom, sendto, recvmsg or sendmsg: %s\n",
+        un->string);
+    CONFIG_RAISE(JSON_OUT_OF_BOUNDS);
+
+done:
+    return ret;
+}
+
 static json_result_t _extract_mem_size(
     json_type_t type,
     const json_union_t* un,
@@ -174,6 +218,43 @@ static json_result_t _json_read_callback(
 
                 parsed_data->max_affinity_cpus = (size_t)un->integer;
             }
+            else if (json_match(parser, "ThreadPoolSize") == JSON_OK)
+            {
+                if (type != JSON_TYPE_INTEGER)
+                    CONFIG_RAISE(JSON_TYPE_MISMATCH);
+
+                if (un->integer < 0)
+                    CONFIG_RAISE(JSON_OUT_OF_BOUNDS);
+
+                parsed_data->thread_pool_size = (size_t)un->integer;
+            }
+            else if (json_match(parser, "MaxKernelStacks") == JSON_OK)
+            {
+                if (type != JSON_TYPE_INTEGER)
+                    CONFIG_RAISE(JSON_TYPE_MISMATCH);
+
+                if (un->integer < 0)
+                    CONFIG_RAISE(JSON_OUT_OF_BOUNDS);
+
+                parsed_data->max_kstacks = (size_t)un->integer;
+            }
+            else if (json_match(parser, "HostSwitchlessWorkers") == JSON_OK)
+            {
+                if (type != JSON_TYPE_INTEGER)
+                    CONFIG_RAISE(JSON_TYPE_MISMATCH);
+
+                if (un->integer < 0 || un->integer > UINT32_MAX)
+                    CONFIG_RAISE(JSON_OUT_OF_BOUNDS);
+
+                parsed_data->host_switchless_workers = (uint32_t)un->integer;
+            }
+            else if (json_match(parser, "HostSwitchlessCalls") == JSON_OK)
+            {
+                ret = _extract_switchless_call(
+                    type, un, &parsed_data->host_switchless_calls);
+                if (ret != JSON_OK)
+                    CONFIG_RAISE(ret);
+            }
             else if (json_match(parser, "ApplicationPath") == JSON_OK)
             {
                 if (type == JSON_TYPE_STRING)
@@ -336,6 +417,11 @@ static json_result_t _json_read_callback(
                     parser->path[0].size, sizeof(myst_mount_point_config_t));
                 parsed_data->mounts.mounts_count = parser->path[0].size;
             }
+            else if (json_match(parser, "HostSwitchlessCalls") == JSON_OK)
+            {
+                /* the list replaces the default (all calls) */
+                parsed_data->host_switchless_calls = 0;
+            }
             else if (json_match(parser, "Mount.Flags") == JSON_OK)
             {
                 parsed_data->mounts.mounts[parser->path[0].index].flags =
@@ -371,6 +457,7 @@ int parse_config(config_parsed_data_t* parsed_data)
     {
         parsed_data->oe_num_user_threads = ENCLAVE_MAX_THREADS;
         parsed_data->oe_num_stack_pages = ENCLAVE_STACK_SIZE / PAGE_SIZE;
+        parsed_data->host_switchless_calls = SWITCHLESS_ALL;
     }
 
     if ((ret = json_parser_init(
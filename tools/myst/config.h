@@ -25,6 +25,15 @@
 
 #define ENCLAVE_DEBUG true
 
+/* host calls that may be made switchless (see HostSwitchlessCalls) */
+#define SWITCHLESS_READ 0x01
+#define SWITCHLESS_WRITE 0x02
+#define SWITCHLESS_RECVFROM 0x04
+#define SWITCHLESS_SENDTO 0x08
+#define SWITCHLESS_RECVMSG 0x10
+#define SWITCHLESS_SENDMSG 0x20
+#define SWITCHLESS_ALL 0x3f
+
 typedef struct _config_parsed_data_t
 {
     // The version at the start of the configuration tells the parser which
@@ -57,6 +66,18 @@ typedef struct _config_parsed_data_t
     /* maximum number of CPUs in the kernel (for thread affinity) */
     size_t max_affinity_cpus;
 
+    /* maximum number of exited host threads kept for reuse */
+    size_t thread_pool_size;
+
+    /* maximum number of kernel stacks (grown on demand) */
+    size_t max_kstacks;
+
+    /* number of host threads serving switchless calls (zero disables) */
+    uint32_t host_switchless_workers;
+
+    /* host calls made switchless (a mask of SWITCHLESS_* flags) */
+    uint32_t host_switchless_calls;
+
     // Internal data
     void* buffer;
     size_t buffer_length;
@@ -8,10 +8,7 @@
 #include <myst/syscall.h>
 #include <stdio.h>
 
-static long _realtime0 = 0;
-static long _monotime0 = 0;
-static volatile long* _monotime_now = 0;
-static long _realtime_delta = 0;
+static struct myst_clock_page _clock_page;
 static long enc_clock_res = 0;
 
 int myst_setup_clock(struct clock_ctrl* ctrl)
@@ -25,19 +22,21 @@ int myst_setup_clock(struct clock_ctrl* ctrl)
         // Copy the starting values into enclave to isolate them
         // From attacks. Note the starting clocks don't account for
         // the time spent in entering the enclave.
-        _realtime0 = ctrl->realtime0;
-        _monotime0 = ctrl->monotime0;
+        _clock_page.realtime0 = ctrl->realtime0;
+        _clock_page.monotime0 = ctrl->monotime0;
 
-        if (_realtime0 <= 0 || _monotime0 <= 0)
+        if (_clock_page.realtime0 <= 0 || _clock_page.monotime0 <= 0)
             goto done;
 
+        _clock_page.monotime_prev = _clock_page.monotime0;
+
         // If ctrl is outside of the enclave, ctrl->now
-        // should be outside too. _monotime_now is a host address. The address
+        // should be outside too. monotime_now is a host address. The address
         // is saved in the enclave, but we are still subject to malicious host's
         // manipulating of the value at the address, including but not limited
         // to, decreaing the value over time, i.e., a clock goes backward. Both
         // _get_monotime and _get_realtime are guarded against such attacks.
-        _monotime_now = &ctrl->now;
+        _clock_page.monotime_now = &ctrl->now;
 
         enc_clock_res = (long)ctrl->interval;
 
@@ -47,33 +46,16 @@ done:
     return ret;
 }
 
-static void _check(bool overflowed)
+/* Return the clock page (null if the clock was not set up) */
+struct myst_clock_page* myst_get_clock_page(void)
 {
-    if (overflowed)
-    {
-        fprintf(stderr, "clock overflow\n");
-        oe_abort();
-    }
+    return _clock_page.monotime_now ? &_clock_page : NULL;
 }
 
 /* Return monotonic clock in nanoseconds since a starting point */
 static long _get_monotime()
 {
-    static long prev = 0;
-    if (prev == 0)
-        prev = _monotime0;
-    long now = *_monotime_now;
-    if (now > prev)
-    {
-        prev = now;
-        return now;
-    }
-    else
-    {
-        // maintain monotonicity.
-        // TODO: issue a warning. Host might be playing tricks.
-        return ++prev;
-    }
+    return myst_clock_page_monotime(&_clock_page);
 }
 
 static long _get_boottime()
@@ -85,12 +67,14 @@ static long _get_boottime()
 /* Return realtime clock in nanoseconds since the epoch */
 static long _get_realtime()
 {
-    // Derive the realtime clock from the monotonic clock.
-    // Any adjustment to the system clock is invisible to the
-    // enclave application once it is launched.
-    long ret = _get_monotime() - _monotime0;
-    _check(__builtin_saddl_overflow(ret, _realtime0, &ret));
-    _check(__builtin_saddl_overflow(ret, _realtime_delta, &ret));
+    long ret = myst_clock_page_realtime(&_clock_page);
+
+    if (ret < 0)
+    {
+        fprintf(stderr, "clock overflow\n");
+        oe_abort();
+    }
+
     return ret;
 }
 
@@ -147,12 +131,15 @@ long myst_tcall_clock_settime(clockid_t clk_id, struct timespec* tp)
             return 0; // trying to set clock backward, make it no-op
 
         /* possible overflow, make it no-op */
-        if (__builtin_add_overflow(
-                _realtime_delta, (new_time - cur_time), &_realtime_delta))
+        long delta = _clock_page.realtime_delta;
+        if (__builtin_add_overflow(delta, (new_time - cur_time), &delta))
         {
             return -EINVAL; // possible overflow, make it no-op
         }
 
+        /* the C runtime reads the delta without a lock */
+        __atomic_store_n(&_clock_page.realtime_delta, delta, __ATOMIC_RELAXED);
+
         return 0;
     }
 
@@ -49,6 +49,8 @@ extern const void* __oe_get_heap_base(void);
 
 long myst_tcall_isatty(int fd);
 
+void myst_set_switchless_calls(uint32_t calls);
+
 long _exception_handler_syscall(long n, long params[6])
 {
     return (*_kargs.myst_syscall)(n, params);
@@ -467,6 +469,8 @@ static long _enter(void* arg_)
     bool perf = false;
     bool report_native_tids = false;
     size_t max_affinity_cpus = options ? options->max_affinity_cpus : 0;
+    size_t thread_pool_size = options ? options->thread_pool_size : 0;
+    size_t max_kstacks = 0;
     const char* rootfs = NULL;
     config_parsed_data_t parsed_config;
     bool have_config = false;
@@ -600,6 +604,24 @@ static long _enter(void* arg_)
         max_affinity_cpus = parsed_config.max_affinity_cpus;
     }
 
+    // Override thread pool size if present in config
+    if (have_config && parsed_config.thread_pool_size)
+    {
+        thread_pool_size = parsed_config.thread_pool_size;
+    }
+
+    // Get the kernel stacks limit if present in config
+    if (have_config && parsed_config.max_kstacks)
+    {
+        max_kstacks = parsed_config.max_kstacks;
+    }
+
+    // Use switchless I/O calls if the host started worker threads for them
+    if (have_config && parsed_config.host_switchless_workers)
+    {
+        myst_set_switchless_calls(parsed_config.host_switchless_calls);
+    }
+
     // record the configuration for which fork mode
     if (have_config && parsed_config.fork_mode)
     {
@@ -727,6 +749,16 @@ static long _enter(void* arg_)
         _kargs.start_time_sec = arg->start_time_sec;
         _kargs.start_time_nsec = arg->start_time_nsec;
         _kargs.report_native_tids = report_native_tids;
+        _kargs.thread_pool_size = thread_pool_size;
+        _kargs.max_kstacks = max_kstacks;
+        _kargs.clock_page = myst_get_clock_page();
+
+        /* binary syscall traces expose syscall arguments to the host */
+        if (tee_debug_mode && options && options->strace_binary)
+        {
+            _kargs.strace_binary = true;
+            _kargs.strace_binary_fd = options->strace_binary_fd;
+        }
 
         /* set ehdr and verify that the kernel is an ELF image */
         {
@@ -767,6 +799,16 @@ done:
     return ret;
 }
 
+/* Thread events are host memory that the kernel spins on and updates in
+ * place (see myst_spin_wait_event()), so reject events that are not fully
+ * outside the enclave.
+ */
+static bool _valid_event(uint64_t event)
+{
+    return event && (event % sizeof(int)) == 0 &&
+           oe_is_outside_enclave((const void*)event, sizeof(int));
+}
+
 int myst_enter_ecall(
     struct myst_options* options,
     struct myst_shm* shared_memory,
@@ -796,6 +838,9 @@ int myst_enter_ecall(
         .start_time_nsec = start_time_nsec,
     };
 
+    if (!_valid_event(event))
+        return -1;
+
     /* prevent this function from being called more than once */
     if (__sync_fetch_and_add(&myst_enter_ecall_lock, 1) != 0)
     {
@@ -818,6 +863,9 @@ int myst_enter_ecall(
 
 long myst_run_thread_ecall(uint64_t cookie, uint64_t event, pid_t target_tid)
 {
+    if (!_valid_event(event))
+        return -EINVAL;
+
     return myst_run_thread(cookie, event, target_tid);
 }
 
@@ -919,6 +967,19 @@ long myst_tcall_wake(uint64_t event)
     return retval;
 }
 
+long myst_tcall_wake_many(const uint64_t* events, size_t count)
+{
+    long retval = -EINVAL;
+
+    if (!events || count > MYST_WAKE_MANY_MAX)
+        return -EINVAL;
+
+    if (myst_wake_many_ocall(&retval, events, count) != OE_OK)
+        return -EINVAL;
+
+    return retval;
+}
+
 long myst_tcall_wake_wait(
     uint64_t waiter_event,
     uint64_t self_event,
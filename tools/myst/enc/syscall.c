@@ -15,6 +15,7 @@
 #include <myst/iov.h>
 #include <myst/syscall.h>
 #include <myst/tcall.h>
+#include "../config.h"
 #include "myst_t.h"
 
 #define RETURN(EXPR) return ((EXPR) == OE_OK ? ret : -EINVAL)
@@ -25,10 +26,124 @@
 // to diagnose the issue.
 #define DOWNSIZE_OCALL_OUTPUT_LENGTHS
 
+/* calls that use the switchless variant of their ocall (SWITCHLESS_*) */
+static uint32_t _switchless_calls;
+
+void myst_set_switchless_calls(uint32_t calls)
+{
+    _switchless_calls = calls;
+}
+
+/* make the switchless variant of the ocall if enabled for this call */
+#define OCALL(FLAG, NAME, ...)                      \
+    ((_switchless_calls & (FLAG))                   \
+         ? NAME##_switchless_ocall(__VA_ARGS__)     \
+         : NAME##_ocall(__VA_ARGS__))
+
+/*
+**==============================================================================
+**
+** I/O arenas:
+**
+**     The buffers of forwarded reads and writes (vectored ones included) of
+**     up to IO_ARENA_SIZE bytes are passed in an arena of host memory rather
+**     than being marshalled by the edge routines. An arena is allocated once
+**     and checked to lie outside the enclave when it is created, so the host
+**     reads and writes it in place and the payload crosses the boundary with
+**     a single copy (between the arena and the caller's buffers).
+**
+**     A call holds an arena only while it is underway. A thread makes one
+**     forwarded call at a time, so there are about as many arenas as threads
+**     that make calls at once. Arenas are never freed.
+**
+**==============================================================================
+*/
+
+#define IO_ARENA_SIZE (256 * 1024)
+
+typedef struct io_arena
+{
+    struct io_arena* next;
+
+    /* non-zero while held by a call */
+    int in_use;
+
+    /* IO_ARENA_SIZE bytes of host memory */
+    void* data;
+} io_arena_t;
+
+static io_arena_t* _io_arenas;
+
+/* get an unused arena or return null if size is too big for an arena */
+static io_arena_t* _get_io_arena(size_t size)
+{
+    io_arena_t* arena;
+    void* data;
+
+    if (size == 0 || size > IO_ARENA_SIZE)
+        return NULL;
+
+    for (arena = __atomic_load_n(&_io_arenas, __ATOMIC_ACQUIRE); arena;
+         arena = arena->next)
+    {
+        int expected = 0;
+
+        if (__atomic_compare_exchange_n(
+                &arena->in_use,
+                &expected,
+                1,
+                false,
+                __ATOMIC_ACQUIRE,
+                __ATOMIC_RELAXED))
+        {
+            return arena;
+        }
+    }
+
+    if (!(data = oe_host_malloc(IO_ARENA_SIZE)))
+        return NULL;
+
+    /* the host accesses the arena in place so all of it must be outside */
+    if (!oe_is_outside_enclave(data, IO_ARENA_SIZE))
+    {
+        oe_host_free(data);
+        return NULL;
+    }
+
+    if (!(arena = calloc(1, sizeof(io_arena_t))))
+    {
+        oe_host_free(data);
+        return NULL;
+    }
+
+    arena->in_use = 1;
+    arena->data = data;
+    arena->next = __atomic_load_n(&_io_arenas, __ATOMIC_RELAXED);
+
+    while (!__atomic_compare_exchange_n(
+        &_io_arenas,
+        &arena->next,
+        arena,
+        true,
+        __ATOMIC_RELEASE,
+        __ATOMIC_RELAXED))
+        ;
+
+    return arena;
+}
+
+static void _put_io_arena(io_arena_t* arena)
+{
+    if (arena)
+        __atomic_store_n(&arena->in_use, 0, __ATOMIC_RELEASE);
+}
+
 static long _read(int fd, void* buf, size_t count)
 {
     long ret = 0;
     long retval;
+    io_arena_t* arena = NULL;
+    oe_result_t result;
 
     if (fd < 0 || (!buf && count) || count > SSIZE_MAX)
     {
@@ -36,7 +151,17 @@ static long _read(int fd, void* buf, size_t count)
         goto done;
     }
 
-    if (myst_read_ocall(&retval, fd, buf, count) != OE_OK)
+    if ((arena = _get_io_arena(count)))
+    {
+        result = OCALL(
+            SWITCHLESS_READ, myst_read_arena, &retval, fd, arena->data, count);
+    }
+    else
+    {
+        result = OCALL(SWITCHLESS_READ, myst_read, &retval, fd, buf, count);
+    }
+
+    if (result != OE_OK)
     {
         ret = -EINVAL;
         goto done;
@@ -55,9 +180,13 @@ static long _read(int fd, void* buf, size_t count)
         goto done;
     }
 
+    if (arena)
+        memcpy(buf, arena->data, retval);
+
     ret = retval;
 
 done:
+    _put_io_arena(arena);
     return ret;
 }
 
@@ -65,6 +194,8 @@ static long _write(int fd, const void* buf, size_t count)
 {
     long ret = 0;
     long retval;
+    io_arena_t* arena = NULL;
+    oe_result_t result;
 
     if (fd < 0 || (!buf && count) || count > SSIZE_MAX)
     {
@@ -72,7 +203,23 @@ static long _write(int fd, const void* buf, size_t count)
         goto done;
     }
 
-    if (myst_write_ocall(&retval, fd, buf, count) != OE_OK)
+    if ((arena = _get_io_arena(count)))
+    {
+        memcpy(arena->data, buf, count);
+        result = OCALL(
+            SWITCHLESS_WRITE,
+            myst_write_arena,
+            &retval,
+            fd,
+            arena->data,
+            count);
+    }
+    else
+    {
+        result = OCALL(SWITCHLESS_WRITE, myst_write, &retval, fd, buf, count);
+    }
+
+    if (result != OE_OK)
     {
         ret = -EINVAL;
         goto done;
@@ -94,6 +241,273 @@ static long _write(int fd, const void* buf, size_t count)
     ret = retval;
 
 done:
+    _put_io_arena(arena);
+    return ret;
+}
+
+/* iovec arrays up to this length keep their lengths on the stack */
+#define IOV_LENS_STACK_COUNT 32
+
+/* get the total length of an iovec array and a copy of its lengths, which
+ * is put in BUF if it has room for IOVCNT lengths and malloc'd otherwise */
+static long _get_iov_lens(
+    const struct iovec* iov,
+    int iovcnt,
+    size_t buf[IOV_LENS_STACK_COUNT],
+    size_t** lens)
+{
+    size_t len = 0;
+
+    *lens = NULL;
+
+    if (iovcnt < 0 || iovcnt > IOV_MAX || (!iov && iovcnt))
+        return -EINVAL;
+
+    if (iovcnt == 0)
+        return 0;
+
+    if (iovcnt <= IOV_LENS_STACK_COUNT)
+        *lens = buf;
+    else if (!(*lens = malloc((size_t)iovcnt * sizeof(size_t))))
+        return -ENOMEM;
+
+    for (int i = 0; i < iovcnt; i++)
+    {
+        const struct iovec* v = &iov[i];
+
+        if ((!v->iov_base && v->iov_len) || v->iov_len > SSIZE_MAX - len)
+        {
+            if (*lens != buf)
+                free(*lens);
+
+            *lens = NULL;
+            return -EINVAL;
+        }
+
+        (*lens)[i] = v->iov_len;
+        len += v->iov_len;
+    }
+
+    return (long)len;
+}
+
+/* perform readv(), or preadv() if offset is non-null */
+static long _readv(
+    int fd,
+    const struct iovec* iov,
+    int iovcnt,
+    const off_t* offset)
+{
+    long ret = 0;
+    long retval;
+    size_t lens_buf[IOV_LENS_STACK_COUNT];
+    size_t* lens = NULL;
+    io_arena_t* arena = NULL;
+    void* buf = NULL;
+    long len;
+    oe_result_t r;
+
+    if (fd < 0)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    if ((len = _get_iov_lens(iov, iovcnt, lens_buf, &lens)) < 0)
+    {
+        ret = len;
+        goto done;
+    }
+
+    if (iovcnt == 0)
+        goto done;
+
+    /* the host reads into the arena, which is scattered directly */
+    if ((arena = _get_io_arena((size_t)len)))
+    {
+        if (offset)
+        {
+            r = myst_preadv_arena_ocall(
+                &retval, fd, arena->data, len, lens, iovcnt, *offset);
+        }
+        else
+        {
+            r = myst_readv_arena_ocall(
+                &retval, fd, arena->data, len, lens, iovcnt);
+        }
+
+        buf = arena->data;
+    }
+    else
+    {
+        if (len && !(buf = malloc((size_t)len)))
+        {
+            ret = -ENOMEM;
+            goto done;
+        }
+
+        if (offset)
+            r = myst_preadv_ocall(&retval, fd, buf, len, lens, iovcnt, *offset);
+        else
+            r = myst_readv_ocall(&retval, fd, buf, len, lens, iovcnt);
+    }
+
+    if (r != OE_OK)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    if (retval < 0)
+    {
+        ret = retval;
+        goto done;
+    }
+
+    /* guard against host setting the return value greater than len */
+    if (retval > len)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    if ((ret = myst_iov_scatter(iov, iovcnt, buf, (size_t)retval)) < 0)
+        goto done;
+
+    ret = retval;
+
+done:
+
+    if (lens && lens != lens_buf)
+        free(lens);
+
+    if (arena)
+        _put_io_arena(arena);
+    else if (buf)
+        free(buf);
+
+    return ret;
+}
+
+/* perform writev(), or pwritev() if offset is non-null */
+static long _writev(
+    int fd,
+    const struct iovec* iov,
+    int iovcnt,
+    const off_t* offset)
+{
+    long ret = 0;
+    long retval;
+    size_t lens_buf[IOV_LENS_STACK_COUNT];
+    size_t* lens = NULL;
+    io_arena_t* arena = NULL;
+    void* buf = NULL;
+    long len;
+    oe_result_t r;
+
+    if (fd < 0)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    if ((len = _get_iov_lens(iov, iovcnt, lens_buf, &lens)) < 0)
+    {
+        ret = len;
+        goto done;
+    }
+
+    if (iovcnt == 0)
+        goto done;
+
+    if ((arena = _get_io_arena((size_t)len)))
+    {
+        uint8_t* p = arena->data;
+
+        /* gather the elements straight into the arena */
+        for (int i = 0; i < iovcnt; i++)
+        {
+            if (iov[i].iov_len)
+            {
+                memcpy(p, iov[i].iov_base, iov[i].iov_len);
+                p += iov[i].iov_len;
+            }
+        }
+
+        if (offset)
+        {
+            r = myst_pwritev_arena_ocall(
+                &retval, fd, arena->data, len, lens, iovcnt, *offset);
+        }
+        else
+        {
+            r = myst_writev_arena_ocall(
+                &retval, fd, arena->data, len, lens, iovcnt);
+        }
+    }
+    else if (iovcnt == 1)
+    {
+        /* a single element needs no gathering */
+        if (offset)
+        {
+            r = myst_pwritev_ocall(
+                &retval, fd, iov[0].iov_base, len, lens, 1, *offset);
+        }
+        else
+        {
+            r = myst_writev_ocall(&retval, fd, iov[0].iov_base, len, lens, 1);
+        }
+    }
+    else
+    {
+        if ((len = myst_iov_gather(iov, iovcnt, &buf)) < 0)
+        {
+            ret = len;
+            goto done;
+        }
+
+        if (offset)
+        {
+            r = myst_pwritev_ocall(
+                &retval, fd, buf, len, lens, iovcnt, *offset);
+        }
+        else
+        {
+            r = myst_writev_ocall(&retval, fd, buf, len, lens, iovcnt);
+        }
+    }
+
+    if (r != OE_OK)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    if (retval < 0)
+    {
+        ret = retval;
+        goto done;
+    }
+
+    /* guard against host returning a size bigger than the buffers */
+    if (retval > len)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    ret = retval;
+
+done:
+
+    if (lens && lens != lens_buf)
+        free(lens);
+
+    _put_io_arena(arena);
+
+    if (buf)
+        free(buf);
+
     return ret;
 }
 
@@ -183,6 +597,8 @@ static long _recvfrom(
     long ret = 0;
     socklen_t n;
     long retval;
+    io_arena_t* arena = NULL;
+    oe_result_t result;
 
     if (sockfd < 0 || (!buf && len) || len > SSIZE_MAX)
     {
@@ -192,8 +608,36 @@ static long _recvfrom(
 
     n = addrlen ? *addrlen : 0;
 
-    if (myst_recvfrom_ocall(
-            &retval, sockfd, buf, len, flags, src_addr, &n, n) != OE_OK)
+    if ((arena = _get_io_arena(len)))
+    {
+        result = OCALL(
+            SWITCHLESS_RECVFROM,
+            myst_recvfrom_arena,
+            &retval,
+            sockfd,
+            arena->data,
+            len,
+            flags,
+            src_addr,
+            &n,
+            n);
+    }
+    else
+    {
+        result = OCALL(
+            SWITCHLESS_RECVFROM,
+            myst_recvfrom,
+            &retval,
+            sockfd,
+            buf,
+            len,
+            flags,
+            src_addr,
+            &n,
+            n);
+    }
+
+    if (result != OE_OK)
     {
         ret = -EINVAL;
         goto done;
@@ -227,9 +671,13 @@ static long _recvfrom(
         goto done;
     }
 
+    if (arena)
+        memcpy(buf, arena->data, retval);
+
     ret = retval;
 
 done:
+    _put_io_arena(arena);
     return ret;
 }
 
@@ -243,6 +691,8 @@ static long _sendto(
 {
     long ret = 0;
     long retval;
+    io_arena_t* arena = NULL;
+    oe_result_t result;
 
     if (sockfd < 0 || (!buf && len) || len > SSIZE_MAX)
     {
@@ -250,8 +700,35 @@ static long _sendto(
         goto done;
     }
 
-    if (myst_sendto_ocall(
-            &retval, sockfd, buf, len, flags, dest_addr, addrlen) != OE_OK)
+    if ((arena = _get_io_arena(len)))
+    {
+        memcpy(arena->data, buf, len);
+        result = OCALL(
+            SWITCHLESS_SENDTO,
+            myst_sendto_arena,
+            &retval,
+            sockfd,
+            arena->data,
+            len,
+            flags,
+            dest_addr,
+            addrlen);
+    }
+    else
+    {
+        result = OCALL(
+            SWITCHLESS_SENDTO,
+            myst_sendto,
+            &retval,
+            sockfd,
+            buf,
+            len,
+            flags,
+            dest_addr,
+            addrlen);
+    }
+
+    if (result != OE_OK)
     {
         ret = -EINVAL;
         goto done;
@@ -273,6 +750,7 @@ static long _sendto(
     ret = retval;
 
 done:
+    _put_io_arena(arena);
     return ret;
 }
 
@@ -346,7 +824,9 @@ static long _sendmsg(int sockfd, const struct msghdr* msg, int flags)
         goto done;
     }
 
-    if (myst_sendmsg_ocall(
+    if (OCALL(
+            SWITCHLESS_SENDMSG,
+            myst_sendmsg,
             &retval,
             sockfd,
             msg->msg_name,
@@ -418,7 +898,9 @@ static long _recvmsg(int sockfd, struct msghdr* msg, int flags)
     namelen = msg->msg_namelen;
     controllen = msg->msg_controllen;
 
-    if (myst_recvmsg_ocall(
+    if (OCALL(
+            SWITCHLESS_RECVMSG,
+            myst_recvmsg,
             &retval,
             sockfd,
             msg->msg_name,
@@ -506,6 +988,298 @@ done:
     return ret;
 }
 
+/* lay out the messages of sendmmsg/recvmmsg in one flat data buffer */
+static long _layout_mmsghdrs(
+    const struct mmsghdr* msgvec,
+    unsigned int vlen,
+    struct myst_mmsghdr* layout,
+    size_t* data_size)
+{
+    size_t size = 0;
+
+    for (unsigned int i = 0; i < vlen; i++)
+    {
+        const struct msghdr* msg = &msgvec[i].msg_hdr;
+        struct myst_mmsghdr* m = &layout[i];
+        ssize_t len;
+
+        if ((len = myst_iov_len(msg->msg_iov, msg->msg_iovlen)) < 0)
+            return len;
+
+        m->namelen = msg->msg_name ? msg->msg_namelen : 0;
+        m->controllen = msg->msg_control ? msg->msg_controllen : 0;
+        m->len = (size_t)len;
+        m->msg_flags = msg->msg_flags;
+        m->msg_len = 0;
+
+        /* each term is at most SSIZE_MAX so the sums cannot overflow */
+        m->name_offset = size;
+        size += m->namelen;
+        m->buf_offset = size;
+        size += m->len;
+        m->control_offset = size;
+        size += m->controllen;
+
+        if (size > SSIZE_MAX)
+            return -EINVAL;
+    }
+
+    *data_size = size;
+    return 0;
+}
+
+static long _sendmmsg(
+    int sockfd,
+    struct mmsghdr* msgvec,
+    unsigned int vlen,
+    int flags)
+{
+    long ret = 0;
+    long retval;
+    struct myst_mmsghdr* hdrs = NULL;
+    struct myst_mmsghdr* layout;
+    uint8_t* data = NULL;
+    size_t size;
+
+    if (sockfd < 0 || !msgvec || vlen == 0 || vlen > UIO_MAXIOV)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    /* the host may change hdrs[] so keep a private copy of the layout */
+    if (!(hdrs = calloc(2 * vlen, sizeof(struct myst_mmsghdr))))
+    {
+        ret = -ENOMEM;
+        goto done;
+    }
+
+    layout = hdrs + vlen;
+
+    if ((ret = _layout_mmsghdrs(msgvec, vlen, layout, &size)) < 0)
+        goto done;
+
+    memcpy(hdrs, layout, vlen * sizeof(struct myst_mmsghdr));
+
+    if (size && !(data = malloc(size)))
+    {
+        ret = -ENOMEM;
+        goto done;
+    }
+
+    /* copy the messages onto the data buffer */
+    for (unsigned int i = 0; i < vlen; i++)
+    {
+        const struct msghdr* msg = &msgvec[i].msg_hdr;
+        const struct myst_mmsghdr* m = &layout[i];
+        uint8_t* p = data + m->buf_offset;
+
+        if (m->namelen)
+            memcpy(data + m->name_offset, msg->msg_name, m->namelen);
+
+        for (int j = 0; j < (int)msg->msg_iovlen; j++)
+        {
+            const struct iovec* v = &msg->msg_iov[j];
+
+            if (v->iov_len)
+            {
+                memcpy(p, v->iov_base, v->iov_len);
+                p += v->iov_len;
+            }
+        }
+
+        if (m->controllen)
+            memcpy(data + m->control_offset, msg->msg_control, m->controllen);
+    }
+
+    if (myst_sendmmsg_ocall(
+            &retval, sockfd, hdrs, vlen, data, size, flags) != OE_OK)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    if (retval < 0)
+    {
+        ret = retval;
+        goto done;
+    }
+
+    /* guard against the host returning too many messages */
+    if (retval > vlen)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    /* guard against the host returning sizes bigger than the messages */
+    for (long i = 0; i < retval; i++)
+    {
+        if (hdrs[i].msg_len > layout[i].len)
+        {
+            ret = -EINVAL;
+            goto done;
+        }
+
+        msgvec[i].msg_len = hdrs[i].msg_len;
+    }
+
+    ret = retval;
+
+done:
+
+    if (hdrs)
+        free(hdrs);
+
+    if (data)
+        free(data);
+
+    return ret;
+}
+
+static long _recvmmsg(
+    int sockfd,
+    struct mmsghdr* msgvec,
+    unsigned int vlen,
+    int flags,
+    const struct timespec* timeout)
+{
+    long ret = 0;
+    long retval;
+    struct myst_mmsghdr* hdrs = NULL;
+    struct myst_mmsghdr* layout;
+    uint8_t* data = NULL;
+    size_t size;
+
+    if (sockfd < 0 || !msgvec || vlen == 0 || vlen > UIO_MAXIOV)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    /* the host may change hdrs[] so keep a private copy of the layout */
+    if (!(hdrs = calloc(2 * vlen, sizeof(struct myst_mmsghdr))))
+    {
+        ret = -ENOMEM;
+        goto done;
+    }
+
+    layout = hdrs + vlen;
+
+    if ((ret = _layout_mmsghdrs(msgvec, vlen, layout, &size)) < 0)
+        goto done;
+
+    memcpy(hdrs, layout, vlen * sizeof(struct myst_mmsghdr));
+
+    if (size && !(data = malloc(size)))
+    {
+        ret = -ENOMEM;
+        goto done;
+    }
+
+    if (myst_recvmmsg_ocall(
+            &retval,
+            sockfd,
+            hdrs,
+            vlen,
+            data,
+            size,
+            flags,
+            (const struct myst_timespec*)timeout) != OE_OK)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    if (retval < 0)
+    {
+        ret = retval;
+        goto done;
+    }
+
+    /* guard against the host returning too many messages */
+    if (retval > vlen)
+    {
+        ret = -EINVAL;
+        goto done;
+    }
+
+    for (long i = 0; i < retval; i++)
+    {
+        struct msghdr* msg = &msgvec[i].msg_hdr;
+        const struct myst_mmsghdr* m = &layout[i];
+        socklen_t namelen = hdrs[i].namelen;
+        socklen_t controllen = hdrs[i].controllen;
+        int msg_flags = hdrs[i].msg_flags;
+        long r;
+
+        /* guard against the host returning too large a size */
+        if (namelen > sizeof(struct sockaddr_storage) ||
+            hdrs[i].msg_len > m->len)
+        {
+            ret = -EINVAL;
+            goto done;
+        }
+
+#ifdef DOWNSIZE_OCALL_OUTPUT_LENGTHS
+        if (namelen > m->namelen)
+            namelen = m->namelen;
+
+        if (controllen > m->controllen)
+        {
+            controllen = m->controllen;
+            msg_flags |= MSG_CTRUNC;
+        }
+#endif
+
+        /* note: the lengths may legitimately be bigger due to truncation */
+        if (m->namelen)
+        {
+            memcpy(
+                msg->msg_name,
+                data + m->name_offset,
+                namelen < m->namelen ? namelen : m->namelen);
+        }
+
+        if (m->controllen)
+        {
+            memcpy(
+                msg->msg_control,
+                data + m->control_offset,
+                controllen < m->controllen ? controllen : m->controllen);
+        }
+
+        msg->msg_namelen = msg->msg_name ? namelen : 0;
+        msg->msg_controllen = msg->msg_control ? controllen : 0;
+        msg->msg_flags = msg_flags;
+
+        /* scatter the received bytes onto the iovec buffers */
+        if ((r = myst_iov_scatter(
+                 msg->msg_iov,
+                 (int)msg->msg_iovlen,
+                 data + m->buf_offset,
+                 hdrs[i].msg_len)) < 0)
+        {
+            ret = r;
+            goto done;
+        }
+
+        msgvec[i].msg_len = hdrs[i].msg_len;
+    }
+
+    ret = retval;
+
+done:
+
+    if (hdrs)
+        free(hdrs);
+
+    if (data)
+        free(data);
+
+    return ret;
+}
+
 static long _shutdown(int sockfd, int how)
 {
     long ret;
@@ -980,6 +1754,8 @@ static long _pread64(int fd, void* buf, size_t count, off_t offset)
 {
     long ret = 0;
     long retval;
+    io_arena_t* arena = NULL;
+    oe_result_t result;
 
     if (fd < 0 || (!buf && count) || count > SSIZE_MAX)
     {
@@ -987,7 +1763,17 @@ static long _pread64(int fd, void* buf, size_t count, off_t offset)
         goto done;
     }
 
-    if (myst_pread64_ocall(&retval, fd, buf, count, offset) != OE_OK)
+    if ((arena = _get_io_arena(count)))
+    {
+        result = myst_pread64_arena_ocall(
+            &retval, fd, arena->data, count, offset);
+    }
+    else
+    {
+        result = myst_pread64_ocall(&retval, fd, buf, count, offset);
+    }
+
+    if (result != OE_OK)
     {
         ret = -EINVAL;
         goto done;
@@ -1006,9 +1792,13 @@ static long _pread64(int fd, void* buf, size_t count, off_t offset)
         goto done;
     }
 
+    if (arena)
+        memcpy(buf, arena->data, retval);
+
     ret = retval;
 
 done:
+    _put_io_arena(arena);
     return ret;
 }
 #endif
@@ -1018,6 +1808,8 @@ static long _pwrite64(int fd, const void* buf, size_t count, off_t offset)
 {
     long ret = 0;
     long retval;
+    io_arena_t* arena = NULL;
+    oe_result_t result;
 
     if (fd < 0 || (!buf && count) || count > SSIZE_MAX)
     {
@@ -1025,7 +1817,18 @@ static long _pwrite64(int fd, const void* buf, size_t count, off_t offset)
         goto done;
     }
 
-    if (myst_pwrite64_ocall(&retval, fd, buf, count, offset) != OE_OK)
+    if ((arena = _get_io_arena(count)))
+    {
+        memcpy(arena->data, buf, count);
+        result = myst_pwrite64_arena_ocall(
+            &retval, fd, arena->data, count, offset);
+    }
+    else
+    {
+        result = myst_pwrite64_ocall(&retval, fd, buf, count, offset);
+    }
+
+    if (result != OE_OK)
     {
         ret = -EINVAL;
         goto done;
@@ -1047,6 +1850,7 @@ static long _pwrite64(int fd, const void* buf, size_t count, off_t offset)
     ret = retval;
 
 done:
+    _put_io_arena(arena);
     return ret;
 }
 #endif
@@ -1620,6 +2424,14 @@ long myst_handle_tcall(long n, long params[6])
         {
             return _write((int)a, (const void*)b, (size_t)c);
         }
+        case SYS_readv:
+        {
+            return _readv((int)a, (const struct iovec*)b, (int)c, NULL);
+        }
+        case SYS_writev:
+        {
+            return _writev((int)a, (const struct iovec*)b, (int)c, NULL);
+        }
         case SYS_close:
         {
             return _close((int)a);
@@ -1680,6 +2492,20 @@ long myst_handle_tcall(long n, long params[6])
         {
             return _recvmsg((int)a, (struct msghdr*)b, (int)c);
         }
+        case SYS_sendmmsg:
+        {
+            return _sendmmsg(
+                (int)a, (struct mmsghdr*)b, (unsigned int)c, (int)d);
+        }
+        case SYS_recvmmsg:
+        {
+            return _recvmmsg(
+                (int)a,
+                (struct mmsghdr*)b,
+                (unsigned int)c,
+                (int)d,
+                (const struct timespec*)e);
+        }
         case SYS_shutdown:
         {
             return _shutdown((int)a, (int)b);
@@ -1764,6 +2590,16 @@ long myst_handle_tcall(long n, long params[6])
         {
             return _pwrite64((int)a, (const void*)b, (size_t)c, (off_t)d);
         }
+        case SYS_preadv:
+        {
+            off_t offset = (off_t)d;
+            return _readv((int)a, (const struct iovec*)b, (int)c, &offset);
+        }
+        case SYS_pwritev:
+        {
+            off_t offset = (off_t)d;
+            return _writev((int)a, (const struct iovec*)b, (int)c, &offset);
+        }
         case SYS_link:
         {
             return _link((const char*)a, (const char*)b);
@@ -34,6 +34,7 @@
 #include <openenclave/bits/sgx/sgxproperties.h>
 #include <openenclave/host.h>
 
+#include "../config.h"
 #include "../shared.h"
 #include "exec.h"
 #include "myst_u.h"
@@ -119,6 +120,11 @@ long myst_wake_ocall(uint64_t event)
     return myst_tcall_wake(event);
 }
 
+long myst_wake_many_ocall(const uint64_t* events, size_t count)
+{
+    return myst_tcall_wake_many(events, count);
+}
+
 long myst_wake_wait_ocall(
     uint64_t waiter_event,
     uint64_t self_event,
@@ -128,6 +134,28 @@ long myst_wake_wait_ocall(
     return myst_tcall_wake_wait(waiter_event, self_event, ts);
 }
 
+/* get the number of switchless worker threads from the configuration */
+static uint32_t _get_switchless_workers(void)
+{
+    const region_details* details = get_region_details();
+    config_parsed_data_t parsed_data = {0};
+    uint32_t workers = 0;
+
+    if (!details->config.buffer)
+        return 0;
+
+    if (parse_config_from_buffer(
+            details->config.buffer,
+            details->config.buffer_size,
+            &parsed_data) == 0)
+    {
+        workers = parsed_data.host_switchless_workers;
+        free_config(&parsed_data);
+    }
+
+    return workers;
+}
+
 int exec_launch_enclave(
     const char* enc_path,
     oe_enclave_type_t type,
@@ -145,13 +173,30 @@ int exec_launch_enclave(
     myst_buf_t mount_mappings_buf = MYST_BUF_INITIALIZER;
     pid_t target_tid = (pid_t)syscall(SYS_gettid);
     struct timespec start_time;
+    oe_enclave_setting_context_switchless_t switchless = {0};
+    oe_enclave_setting_t setting;
+    uint32_t nsettings = 0;
 
     /* get the start time and pass it into the kernel */
     if (clock_gettime(CLOCK_REALTIME, &start_time) != 0)
         _err("clock_gettime() failed");
 
+    /* Start host worker threads to serve switchless ocalls if configured */
+    if ((switchless.max_host_workers = _get_switchless_workers()))
+    {
+        setting.setting_type = OE_ENCLAVE_SETTING_CONTEXT_SWITCHLESS;
+        setting.u.context_switchless_setting = &switchless;
+        nsettings = 1;
+    }
+
     /* Load the enclave: calls oe_load_extra_enclave_data_hook() */
-    r = oe_create_myst_enclave(enc_path, type, flags, NULL, 0, &_enclave);
+    r = oe_create_myst_enclave(
+        enc_path,
+        type,
+        flags,
+        nsettings ? &setting : NULL,
+        nsettings,
+        &_enclave);
 
     if (r != OE_OK)
         _err("failed to load enclave: result=%s", oe_result_str(r));
@@ -327,6 +372,40 @@ int exec_action(int argc, const char* argv[], const char* envp[])
             }
         }
 
+        /* Get --thread-pool-size */
+        {
+            const char* arg = NULL;
+
+            if ((cli_getopt(&argc, argv, "--thread-pool-size", &arg) == 0))
+            {
+                char* end = NULL;
+                size_t val = strtoull(arg, &end, 10);
+
+                if (!end || *end != '\0')
+                {
+                    fprintf(
+                        stderr,
+                        "%s: bad --thread-pool-size=%s option\n",
+                        argv[0],
+                        arg);
+                    return 1;
+                }
+
+                options.thread_pool_size = val;
+            }
+        }
+
+        /* Get --strace-binary option */
+        if (get_strace_binary_opts(
+                &argc,
+                argv,
+                &options.strace_binary,
+                &options.strace_binary_fd) != 0)
+        {
+            fprintf(stderr, "%s: bad --strace-binary option\n", argv[0]);
+            return 1;
+        }
+
         if (get_fork_mode_opts(&argc, argv, &options.fork_mode) != 0)
         {
             fprintf(
@@ -80,7 +80,10 @@ struct options
     bool memcheck;
     bool perf;
     bool report_native_tids;
+    bool strace_binary;
+    int strace_binary_fd;
     size_t max_affinity_cpus;
+    size_t thread_pool_size;
     char rootfs[PATH_MAX];
     size_t heap_size;
     const char* app_config_path;
@@ -132,6 +135,13 @@ static void _get_options(
     if (cli_getopt(argc, argv, "--report-native-tids", NULL) == 0)
         opts->report_native_tids = true;
 
+    /* Get --strace-binary option */
+    if (get_strace_binary_opts(
+            argc, argv, &opts->strace_binary, &opts->strace_binary_fd) != 0)
+    {
+        _err("bad --strace-binary option");
+    }
+
     if (get_fork_mode_opts(argc, argv, &opts->fork_mode) != 0)
         _err(
             "%s: invalid --fork-mode option. Only \"none\" and "
@@ -154,6 +164,22 @@ static void _get_options(
         }
     }
 
+    /* Get --thread-pool-size */
+    {
+        const char* arg = NULL;
+
+        if ((cli_getopt(argc, argv, "--thread-pool-size", &arg) == 0))
+        {
+            char* end = NULL;
+            size_t val = strtoull(arg, &end, 10);
+
+            if (!end || *end != '\0')
+                _err("bad --thread-pool-size=%s option", arg);
+
+            opts->thread_pool_size = val;
+        }
+    }
+
     /* determine whether debug symbols are needed */
     {
         int r;
@@ -357,6 +383,9 @@ static int _enter_kernel(
 
     kernel_args.perf = options->perf;
 
+    kernel_args.strace_binary = options->strace_binary;
+    kernel_args.strace_binary_fd = options->strace_binary_fd;
+
     /* pass the start time into the kernel */
     {
         struct timespec start_time;
@@ -373,6 +402,8 @@ static int _enter_kernel(
 
     kernel_args.report_native_tids = options->report_native_tids;
 
+    kernel_args.thread_pool_size = options->thread_pool_size;
+
     /* Resolve the the kernel entry point */
     const elf_ehdr_t* ehdr = kernel_args.kernel_data;
     entry = (myst_kernel_entry_t)((uint8_t*)ehdr + ehdr->e_entry);
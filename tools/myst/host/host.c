@@ -36,6 +36,7 @@
 #include "package.h"
 #include "regions.h"
 #include "sign.h"
+#include "tracedecode.h"
 #include "utils.h"
 
 _Static_assert(sizeof(struct myst_timespec) == sizeof(struct timespec), "");
@@ -381,6 +382,8 @@ Where <action> is one of:\n\
                      pieces during in the process\n\
     dump-sgx      -- dump the SGX enclave configuration along with the\n\
                      packaging configuration from an SGX packaged executable\n\
+    trace-decode  -- render a binary syscall trace (see --strace-binary) as\n\
+                     strace text or as a Chrome trace-event timeline\n\
 \n\
 "
 
@@ -457,6 +460,10 @@ static int _main(int argc, const char* argv[], const char* envp[])
         extern int fssig_action(int argc, const char* argv[]);
         return fssig_action(argc, argv);
     }
+    else if (strcmp(argv[1], "trace-decode") == 0)
+    {
+        return trace_decode_action(argc, argv);
+    }
     else
     {
         fprintf(stderr, USAGE, argv[0]);
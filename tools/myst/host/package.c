@@ -598,6 +598,17 @@ int _exec_package(
     if (cli_getopt(&argc, argv, "--perf", NULL) == 0)
         options.perf = true;
 
+    /* Get --strace-binary option */
+    if (get_strace_binary_opts(
+            &argc,
+            argv,
+            &options.strace_binary,
+            &options.strace_binary_fd) != 0)
+    {
+        fprintf(stderr, "%s: bad --strace-binary option\n", argv[0]);
+        goto done;
+    }
+
     /* Get --report-native-tids option */
     if (cli_getopt(&argc, argv, "--report-native-tids", NULL) == 0)
         options.report_native_tids = true;
@@ -625,6 +636,29 @@ int _exec_package(
         }
     }
 
+    /* Get --thread-pool-size */
+    {
+        const char* arg = NULL;
+
+        if ((cli_getopt(&argc, argv, "--thread-pool-size", &arg) == 0))
+        {
+            char* end = NULL;
+            size_t val = strtoull(arg, &end, 10);
+
+            if (!end || *end != '\0')
+            {
+                fprintf(
+                    stderr,
+                    "%s: bad --thread-pool-size=%s option\n",
+                    argv[0],
+                    arg);
+                goto done;
+            }
+
+            options.thread_pool_size = val;
+        }
+    }
+
     /* Get --rootfs=<path> option if any  */
     {
         const char* arg = NULL;
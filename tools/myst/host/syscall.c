@@ -1,14 +1,17 @@
 #define _GNU_SOURCE
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <myst/assume.h>
 #include <myst/defs.h>
 #include <sched.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <sys/syscall.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "myst_u.h"
@@ -78,6 +81,78 @@ long myst_write_ocall(int fd, const void* buf, size_t count)
     RETURN(write(fd, buf, count));
 }
 
+/* split buf into an iovec array with the given element lengths */
+static struct iovec* _make_iov(
+    const void* buf,
+    size_t len,
+    const size_t* iov_lens,
+    int iovcnt)
+{
+    struct iovec* iov;
+    const uint8_t* p = buf;
+    size_t rem = len;
+
+    if (iovcnt <= 0 || iovcnt > IOV_MAX)
+        return NULL;
+
+    if (!(iov = calloc((size_t)iovcnt, sizeof(struct iovec))))
+        return NULL;
+
+    for (int i = 0; i < iovcnt; i++)
+    {
+        if (iov_lens[i] > rem)
+        {
+            free(iov);
+            return NULL;
+        }
+
+        iov[i].iov_base = (void*)p;
+        iov[i].iov_len = iov_lens[i];
+        p += iov_lens[i];
+        rem -= iov_lens[i];
+    }
+
+    return iov;
+}
+
+long myst_readv_ocall(
+    int fd,
+    void* buf,
+    size_t len,
+    const size_t* iov_lens,
+    int iovcnt)
+{
+    struct iovec* iov;
+    long ret;
+
+    if (!(iov = _make_iov(buf, len, iov_lens, iovcnt)))
+        return -EINVAL;
+
+    ret = readv(fd, iov, iovcnt);
+    ret = (ret < 0) ? -errno : ret;
+    free(iov);
+    return ret;
+}
+
+long myst_writev_ocall(
+    int fd,
+    const void* buf,
+    size_t len,
+    const size_t* iov_lens,
+    int iovcnt)
+{
+    struct iovec* iov;
+    long ret;
+
+    if (!(iov = _make_iov(buf, len, iov_lens, iovcnt)))
+        return -EINVAL;
+
+    ret = writev(fd, iov, iovcnt);
+    ret = (ret < 0) ? -errno : ret;
+    free(iov);
+    return ret;
+}
+
 long myst_close_ocall(int fd)
 {
     RETURN(close(fd));
@@ -236,6 +311,368 @@ done:
     return ret;
 }
 
+/* check that the given range lies within the data buffer */
+static bool _within(size_t offset, size_t size, size_t data_size)
+{
+    return offset <= data_size && size <= data_size - offset;
+}
+
+/* build the host message vector of sendmmsg/recvmmsg */
+static int _init_mmsghdrs(
+    struct myst_mmsghdr* msgvec,
+    unsigned int vlen,
+    void* data,
+    size_t data_size,
+    struct mmsghdr* vec,
+    struct iovec* iov)
+{
+    uint8_t* p = data;
+
+    for (unsigned int i = 0; i < vlen; i++)
+    {
+        const struct myst_mmsghdr* m = &msgvec[i];
+        struct msghdr* msg = &vec[i].msg_hdr;
+
+        if (!_within(m->name_offset, m->namelen, data_size) ||
+            !_within(m->buf_offset, m->len, data_size) ||
+            !_within(m->control_offset, m->controllen, data_size))
+        {
+            return -EINVAL;
+        }
+
+        iov[i].iov_base = p + m->buf_offset;
+        iov[i].iov_len = m->len;
+        msg->msg_name = m->namelen ? p + m->name_offset : NULL;
+        msg->msg_namelen = m->namelen;
+        msg->msg_iov = &iov[i];
+        msg->msg_iovlen = 1;
+        msg->msg_control = m->controllen ? p + m->control_offset : NULL;
+        msg->msg_controllen = m->controllen;
+        msg->msg_flags = m->msg_flags;
+        vec[i].msg_len = 0;
+    }
+
+    return 0;
+}
+
+long myst_sendmmsg_ocall(
+    int sockfd,
+    struct myst_mmsghdr* msgvec,
+    unsigned int vlen,
+    const void* data,
+    size_t data_size,
+    int flags)
+{
+    long ret = 0;
+    struct mmsghdr* vec = NULL;
+    struct iovec* iov = NULL;
+    int n;
+
+    if (!(vec = calloc(vlen, sizeof(struct mmsghdr))) ||
+        !(iov = calloc(vlen, sizeof(struct iovec))))
+    {
+        ret = -ENOMEM;
+        goto done;
+    }
+
+    if ((ret = _init_mmsghdrs(
+             msgvec, vlen, (void*)data, data_size, vec, iov)) != 0)
+        goto done;
+
+    if ((n = sendmmsg(sockfd, vec, vlen, flags)) < 0)
+    {
+        ret = -errno;
+        goto done;
+    }
+
+    for (int i = 0; i < n; i++)
+        msgvec[i].msg_len = vec[i].msg_len;
+
+    ret = n;
+
+done:
+    free(vec);
+    free(iov);
+    return ret;
+}
+
+long myst_recvmmsg_ocall(
+    int sockfd,
+    struct myst_mmsghdr* msgvec,
+    unsigned int vlen,
+    void* data,
+    size_t data_size,
+    int flags,
+    const struct myst_timespec* timeout)
+{
+    long ret = 0;
+    struct mmsghdr* vec = NULL;
+    struct iovec* iov = NULL;
+    struct timespec ts;
+    int n;
+
+    if (!(vec = calloc(vlen, sizeof(struct mmsghdr))) ||
+        !(iov = calloc(vlen, sizeof(struct iovec))))
+    {
+        ret = -ENOMEM;
+        goto done;
+    }
+
+    if ((ret = _init_mmsghdrs(msgvec, vlen, data, data_size, vec, iov)) != 0)
+        goto done;
+
+    if (timeout)
+    {
+        ts.tv_sec = timeout->tv_sec;
+        ts.tv_nsec = timeout->tv_nsec;
+    }
+
+    if ((n = recvmmsg(sockfd, vec, vlen, flags, timeout ? &ts : NULL)) < 0)
+    {
+        ret = -errno;
+        goto done;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        msgvec[i].namelen = vec[i].msg_hdr.msg_namelen;
+        msgvec[i].controllen = vec[i].msg_hdr.msg_controllen;
+        msgvec[i].msg_flags = vec[i].msg_hdr.msg_flags;
+        msgvec[i].msg_len = vec[i].msg_len;
+    }
+
+    ret = n;
+
+done:
+    free(vec);
+    free(iov);
+    return ret;
+}
+
+/*
+**==============================================================================
+**
+** switchless variants (served by the host worker threads)
+**
+**==============================================================================
+*/
+
+long myst_read_switchless_ocall(int fd, void* buf, size_t count)
+{
+    return myst_read_ocall(fd, buf, count);
+}
+
+long myst_write_switchless_ocall(int fd, const void* buf, size_t count)
+{
+    return myst_write_ocall(fd, buf, count);
+}
+
+long myst_recvfrom_switchless_ocall(
+    int sockfd,
+    void* buf,
+    size_t len,
+    int flags,
+    struct sockaddr* src_addr,
+    socklen_t* addrlen,
+    socklen_t src_addr_size)
+{
+    return myst_recvfrom_ocall(
+        sockfd, buf, len, flags, src_addr, addrlen, src_addr_size);
+}
+
+long myst_sendto_switchless_ocall(
+    int sockfd,
+    const void* buf,
+    size_t len,
+    int flags,
+    const struct sockaddr* dest_addr,
+    socklen_t addrlen)
+{
+    return myst_sendto_ocall(sockfd, buf, len, flags, dest_addr, addrlen);
+}
+
+long myst_sendmsg_switchless_ocall(
+    int sockfd,
+    const void* msg_name,
+    socklen_t msg_namelen,
+    const void* buf,
+    size_t len,
+    const void* msg_control,
+    socklen_t msg_controllen,
+    int msg_flags,
+    int flags)
+{
+    return myst_sendmsg_ocall(
+        sockfd,
+        msg_name,
+        msg_namelen,
+        buf,
+        len,
+        msg_control,
+        msg_controllen,
+        msg_flags,
+        flags);
+}
+
+long myst_recvmsg_switchless_ocall(
+    int sockfd,
+    void* msg_name,
+    socklen_t msg_namelen,
+    socklen_t* msg_namelen_out,
+    void* buf,
+    size_t len,
+    void* msg_control,
+    socklen_t msg_controllen,
+    socklen_t* msg_controllen_out,
+    int* msg_flags,
+    int flags)
+{
+    return myst_recvmsg_ocall(
+        sockfd,
+        msg_name,
+        msg_namelen,
+        msg_namelen_out,
+        buf,
+        len,
+        msg_control,
+        msg_controllen,
+        msg_controllen_out,
+        msg_flags,
+        flags);
+}
+
+/*
+**==============================================================================
+**
+** I/O arena variants (the buffer is the caller's arena of host memory)
+**
+**==============================================================================
+*/
+
+long myst_read_arena_ocall(int fd, void* arena, size_t count)
+{
+    return myst_read_ocall(fd, arena, count);
+}
+
+long myst_write_arena_ocall(int fd, const void* arena, size_t count)
+{
+    return myst_write_ocall(fd, arena, count);
+}
+
+long myst_pread64_arena_ocall(int fd, void* arena, size_t count, off_t offset)
+{
+    return myst_pread64_ocall(fd, arena, count, offset);
+}
+
+long myst_pwrite64_arena_ocall(
+    int fd,
+    const void* arena,
+    size_t count,
+    off_t offset)
+{
+    return myst_pwrite64_ocall(fd, arena, count, offset);
+}
+
+long myst_readv_arena_ocall(
+    int fd,
+    void* arena,
+    size_t len,
+    const size_t* iov_lens,
+    int iovcnt)
+{
+    return myst_readv_ocall(fd, arena, len, iov_lens, iovcnt);
+}
+
+long myst_writev_arena_ocall(
+    int fd,
+    const void* arena,
+    size_t len,
+    const size_t* iov_lens,
+    int iovcnt)
+{
+    return myst_writev_ocall(fd, arena, len, iov_lens, iovcnt);
+}
+
+long myst_preadv_arena_ocall(
+    int fd,
+    void* arena,
+    size_t len,
+    const size_t* iov_lens,
+    int iovcnt,
+    off_t offset)
+{
+    return myst_preadv_ocall(fd, arena, len, iov_lens, iovcnt, offset);
+}
+
+long myst_pwritev_arena_ocall(
+    int fd,
+    const void* arena,
+    size_t len,
+    const size_t* iov_lens,
+    int iovcnt,
+    off_t offset)
+{
+    return myst_pwritev_ocall(fd, arena, len, iov_lens, iovcnt, offset);
+}
+
+long myst_recvfrom_arena_ocall(
+    int sockfd,
+    void* arena,
+    size_t len,
+    int flags,
+    struct sockaddr* src_addr,
+    socklen_t* addrlen,
+    socklen_t src_addr_size)
+{
+    return myst_recvfrom_ocall(
+        sockfd, arena, len, flags, src_addr, addrlen, src_addr_size);
+}
+
+long myst_sendto_arena_ocall(
+    int sockfd,
+    const void* arena,
+    size_t len,
+    int flags,
+    const struct sockaddr* dest_addr,
+    socklen_t addrlen)
+{
+    return myst_sendto_ocall(sockfd, arena, len, flags, dest_addr, addrlen);
+}
+
+long myst_read_arena_switchless_ocall(int fd, void* arena, size_t count)
+{
+    return myst_read_ocall(fd, arena, count);
+}
+
+long myst_write_arena_switchless_ocall(int fd, const void* arena, size_t count)
+{
+    return myst_write_ocall(fd, arena, count);
+}
+
+long myst_recvfrom_arena_switchless_ocall(
+    int sockfd,
+    void* arena,
+    size_t len,
+    int flags,
+    struct sockaddr* src_addr,
+    socklen_t* addrlen,
+    socklen_t src_addr_size)
+{
+    return myst_recvfrom_ocall(
+        sockfd, arena, len, flags, src_addr, addrlen, src_addr_size);
+}
+
+long myst_sendto_arena_switchless_ocall(
+    int sockfd,
+    const void* arena,
+    size_t len,
+    int flags,
+    const struct sockaddr* dest_addr,
+    socklen_t addrlen)
+{
+    return myst_sendto_ocall(sockfd, arena, len, flags, dest_addr, addrlen);
+}
+
 long myst_shutdown_ocall(int sockfd, int how)
 {
     RETURN(shutdown(sockfd, how));
@@ -354,6 +791,46 @@ long myst_pwrite64_ocall(int fd, const void* buf, size_t count, off_t offset)
     RETURN(pwrite(fd, buf, count, offset));
 }
 
+long myst_preadv_ocall(
+    int fd,
+    void* buf,
+    size_t len,
+    const size_t* iov_lens,
+    int iovcnt,
+    off_t offset)
+{
+    struct iovec* iov;
+    long ret;
+
+    if (!(iov = _make_iov(buf, len, iov_lens, iovcnt)))
+        return -EINVAL;
+
+    ret = preadv(fd, iov, iovcnt, offset);
+    ret = (ret < 0) ? -errno : ret;
+    free(iov);
+    return ret;
+}
+
+long myst_pwritev_ocall(
+    int fd,
+    const void* buf,
+    size_t len,
+    const size_t* iov_lens,
+    int iovcnt,
+    off_t offset)
+{
+    struct iovec* iov;
+    long ret;
+
+    if (!(iov = _make_iov(buf, len, iov_lens, iovcnt)))
+        return -EINVAL;
+
+    ret = pwritev(fd, iov, iovcnt, offset);
+    ret = (ret < 0) ? -errno : ret;
+    free(iov);
+    return ret;
+}
+
 long myst_link_ocall(const char* oldpath, const char* newpath)
 {
     RETURN(link(oldpath, newpath));
@@ -0,0 +1,240 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <myst/errno.h>
+#include <myst/syscallstr.h>
+#include <myst/tracering.h>
+
+#include "tracedecode.h"
+#include "utils.h"
+
+#define USAGE_FORMAT \
+    "\n\
+\n\
+Usage: %s trace-decode [options] <tracefile>\n\
+\n\
+Where:\n\
+    trace-decode         -- render a binary syscall trace written with\n\
+                            --strace-binary=<tracefile> as strace text on\n\
+                            standard output\n\
+\n\
+Options:\n\
+    --help               -- this message\n\
+    --chrome <json>      -- also write a Chrome trace-event timeline to\n\
+                            <json> (for chrome://tracing or Perfetto)\n\
+\n\
+"
+
+typedef struct trace
+{
+    myst_trace_header_t header;
+    myst_trace_record_t* records;
+} trace_t;
+
+static const char* _name(uint32_t num)
+{
+    const char* name = myst_syscall_str(num);
+
+    /* strace prints the bare syscall name */
+    if (strncmp(name, "SYS_", 4) == 0)
+        name += 4;
+
+    return name;
+}
+
+static double _usecs(const myst_trace_header_t* header, uint64_t ticks)
+{
+    if (header->nsecs_div == 0)
+        return (double)ticks / 1000.0;
+
+    return (double)ticks * (double)header->nsecs_mul /
+           (double)header->nsecs_div / 1000.0;
+}
+
+/* read all the dumps in the trace file (each is a header plus records) */
+static int _read_traces(FILE* is, trace_t** traces_out, size_t* ntraces_out)
+{
+    trace_t* traces = NULL;
+    size_t ntraces = 0;
+    myst_trace_header_t header;
+
+    while (fread(&header, sizeof(header), 1, is) == 1)
+    {
+        trace_t* trace;
+
+        if (header.magic != MYST_TRACE_MAGIC ||
+            header.version != MYST_TRACE_VERSION ||
+            header.record_size != sizeof(myst_trace_record_t))
+        {
+            fprintf(stderr, "bad trace header\n");
+            goto failed;
+        }
+
+        if (!(traces = realloc(traces, (ntraces + 1) * sizeof(trace_t))))
+            goto failed;
+
+        trace = &traces[ntraces++];
+        trace->header = header;
+
+        if (!(trace->records = calloc(header.nrecords, header.record_size)))
+            goto failed;
+
+        if (fread(trace->records, header.record_size, header.nrecords, is) !=
+            header.nrecords)
+        {
+            fprintf(stderr, "truncated trace file\n");
+            goto failed;
+        }
+    }
+
+    *traces_out = traces;
+    *ntraces_out = ntraces;
+    return 0;
+
+failed:
+
+    for (size_t i = 0; i < ntraces; i++)
+        free(traces[i].records);
+
+    free(traces);
+    return -1;
+}
+
+static void _print_strace(const trace_t* trace)
+{
+    const myst_trace_header_t* header = &trace->header;
+
+    for (uint64_t i = 0; i < header->nrecords; i++)
+    {
+        const myst_trace_record_t* r = &trace->records[i];
+        const double usecs = _usecs(header, r->leave_ticks - r->enter_ticks);
+
+        printf("[pid %5u] %s(", r->tid, _name(r->num));
+
+        for (size_t j = 0; j < MYST_COUNTOF(r->params); j++)
+            printf("%s%#" PRIx64, j ? ", " : "", (uint64_t)r->params[j]);
+
+        if (r->ret < 0 && r->ret >= -4095)
+        {
+            printf(
+                ") = -1 %s (%s) <%.6f>\n",
+                myst_error_name(-r->ret),
+                strerror((int)-r->ret),
+                usecs / 1000000.0);
+        }
+        else
+        {
+            printf(") = %" PRId64 " <%.6f>\n", r->ret, usecs / 1000000.0);
+        }
+    }
+}
+
+static int _write_chrome(
+    const char* path,
+    const trace_t* traces,
+    size_t ntraces)
+{
+    FILE* os;
+    bool first = true;
+
+    if (!(os = fopen(path, "w")))
+        return -1;
+
+    fprintf(os, "{\"traceEvents\":[\n");
+
+    for (size_t i = 0; i < ntraces; i++)
+    {
+        const myst_trace_header_t* header = &traces[i].header;
+
+        for (uint64_t j = 0; j < header->nrecords; j++)
+        {
+            const myst_trace_record_t* r = &traces[i].records[j];
+
+            fprintf(
+                os,
+                "%s{\"name\":\"%s\",\"cat\":\"syscall\",\"ph\":\"X\","
+                "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%u,\"tid\":%u,"
+                "\"args\":{\"ret\":%" PRId64 "}}",
+                first ? "" : ",\n",
+                _name(r->num),
+                _usecs(header, r->enter_ticks),
+                _usecs(header, r->leave_ticks - r->enter_ticks),
+                header->pid,
+                r->tid,
+                r->ret);
+            first = false;
+        }
+    }
+
+    fprintf(os, "\n]}\n");
+
+    if (fclose(os) != 0)
+        return -1;
+
+    return 0;
+}
+
+int trace_decode_action(int argc, const char* argv[])
+{
+    int ret = 1;
+    const char* chrome = NULL;
+    FILE* is = NULL;
+    trace_t* traces = NULL;
+    size_t ntraces = 0;
+
+    if (cli_getopt(&argc, argv, "--help", NULL) == 0 ||
+        cli_getopt(&argc, argv, "-h", NULL) == 0)
+    {
+        fprintf(stderr, USAGE_FORMAT, argv[0]);
+        return 0;
+    }
+
+    cli_getopt(&argc, argv, "--chrome", &chrome);
+
+    if (argc != 3)
+    {
+        fprintf(stderr, USAGE_FORMAT, argv[0]);
+        return 1;
+    }
+
+    if (!(is = fopen(argv[2], "rb")))
+    {
+        fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[2]);
+        goto done;
+    }
+
+    if (_read_traces(is, &traces, &ntraces) != 0)
+    {
+        fprintf(stderr, "%s: cannot read %s\n", argv[0], argv[2]);
+        goto done;
+    }
+
+    for (size_t i = 0; i < ntraces; i++)
+        _print_strace(&traces[i]);
+
+    if (chrome && _write_chrome(chrome, traces, ntraces) != 0)
+    {
+        fprintf(stderr, "%s: cannot write %s\n", argv[0], chrome);
+        goto done;
+    }
+
+    ret = 0;
+
+done:
+
+    if (is)
+        fclose(is);
+
+    for (size_t i = 0; i < ntraces; i++)
+        free(traces[i].records);
+
+    free(traces);
+
+    return ret;
+}
@@ -0,0 +1,9 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef _MYST_HOST_TRACEDECODE_H
+#define _MYST_HOST_TRACEDECODE_H
+
+int trace_decode_action(int argc, const char* argv[]);
+
+#endif /* _MYST_HOST_TRACEDECODE_H */
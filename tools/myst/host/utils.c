@@ -4,6 +4,7 @@
 #define _XOPEN_SOURCE 500
 #include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <ftw.h>
 #include <libgen.h>
 #include <limits.h>
@@ -323,6 +324,31 @@ int cli_get_mount_mapping_opts(
     return 0;
 }
 
+int get_strace_binary_opts(
+    int* argc,
+    const char* argv[],
+    bool* strace_binary,
+    int* fd)
+{
+    const char* arg = NULL;
+
+    *strace_binary = false;
+    *fd = -1;
+
+    if (cli_getopt(argc, argv, "--strace-binary", &arg) == 0)
+    {
+        if (arg == NULL)
+            return -1;
+
+        if ((*fd = open(arg, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+            return -1;
+
+        *strace_binary = true;
+    }
+
+    return 0;
+}
+
 int get_fork_mode_opts(
     int* argc,
     const char* argv[],
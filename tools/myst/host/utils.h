@@ -55,6 +55,13 @@ int get_fork_mode_opts(
     const char* argv[],
     myst_fork_mode_t* fork_mode);
 
+/* handle --strace-binary=<file> by creating <file> for the kernel */
+int get_strace_binary_opts(
+    int* argc,
+    const char* argv[],
+    bool* strace_binary,
+    int* fd);
+
 long myst_add_symbol_file_by_path(
     const char* path,
     const void* text_data,
@@ -21,6 +21,7 @@
 #define LRU_LIST_SIZE 2
 #define MAX_LRU_CHAINS 32
 #define FREE_LIST_SIZE 64
+#define MAX_GETN_BLOCKS 2048 /* one megabyte per device read */
 
 typedef struct cache_block cache_block_t;
 
@@ -358,6 +359,52 @@ done:
     return ret;
 }
 
+static int _getn(
+    myst_blkdev_t* dev,
+    uint64_t blkno,
+    void* data,
+    size_t nblocks)
+{
+    int ret = 0;
+    blkdev_t* impl = (blkdev_t*)dev;
+    myst_block_t* p = data;
+
+    if (!dev || !data)
+        ERAISE(-EINVAL);
+
+    /* ephemeral writes only live in the cache, so read block-by-block */
+    if (impl->ephemeral)
+    {
+        for (size_t i = 0; i < nblocks; i++)
+            ECHECK(_get(dev, blkno + i, &p[i]));
+
+        goto done;
+    }
+
+    /* read straight into the caller's buffer, bypassing the read caches */
+    while (nblocks)
+    {
+        const uint64_t rawblkno = blkno + impl->blkno_offset;
+        size_t count = nblocks;
+        ssize_t n;
+
+        if (count > MAX_GETN_BLOCKS)
+            count = MAX_GETN_BLOCKS;
+
+        ECHECK(n = myst_read_block_device(impl->fd, rawblkno, p, count));
+
+        if (n == 0)
+            ERAISE(-EIO);
+
+        blkno += (size_t)n;
+        p += n;
+        nblocks -= (size_t)n;
+    }
+
+done:
+    return ret;
+}
+
 static int _put(myst_blkdev_t* dev, uint64_t blkno, const void* data)
 {
     int ret = 0;
@@ -415,6 +462,7 @@ int myst_rawblkdev_open(
     impl->base.close = _close;
     impl->base.get = _get;
     impl->base.put = _put;
+    impl->base.getn = _getn;
     impl->ephemeral = ephemeral;
     impl->blkno_offset = blkno_offset;
     impl->fd = fd;
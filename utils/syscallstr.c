@@ -0,0 +1,416 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <stddef.h>
+#include <syscall.h>
+
+#include <myst/syscallext.h>
+#include <myst/syscallstr.h>
+#include <myst/tee.h>
+
+typedef struct _pair
+{
+    long num;
+    const char* str;
+} pair_t;
+
+static pair_t _pairs[] = {
+    {SYS_read, "SYS_read"},
+    {SYS_write, "SYS_write"},
+    {SYS_open, "SYS_open"},
+    {SYS_close, "SYS_close"},
+    {SYS_stat, "SYS_stat"},
+    {SYS_fstat, "SYS_fstat"},
+    {SYS_lstat, "SYS_lstat"},
+    {SYS_poll, "SYS_poll"},
+    {SYS_lseek, "SYS_lseek"},
+    {SYS_mmap, "SYS_mmap"},
+    {SYS_mprotect, "SYS_mprotect"},
+    {SYS_munmap, "SYS_munmap"},
+    {SYS_brk, "SYS_brk"},
+    {SYS_rt_sigaction, "SYS_rt_sigaction"},
+    {SYS_rt_sigprocmask, "SYS_rt_sigprocmask"},
+    {SYS_rt_sigreturn, "SYS_rt_sigreturn"},
+    {SYS_ioctl, "SYS_ioctl"},
+    {SYS_pread64, "SYS_pread64"},
+    {SYS_pwrite64, "SYS_pwrite64"},
+    {SYS_readv, "SYS_readv"},
+    {SYS_writev, "SYS_writev"},
+    {SYS_access, "SYS_access"},
+    {SYS_pipe, "SYS_pipe"},
+    {SYS_select, "SYS_select"},
+    {SYS_sched_yield, "SYS_sched_yield"},
+    {SYS_mremap, "SYS_mremap"},
+    {SYS_msync, "SYS_msync"},
+    {SYS_mincore, "SYS_mincore"},
+    {SYS_madvise, "SYS_madvise"},
+    {SYS_shmget, "SYS_shmget"},
+    {SYS_shmat, "SYS_shmat"},
+    {SYS_shmctl, "SYS_shmctl"},
+    {SYS_dup, "SYS_dup"},
+    {SYS_dup2, "SYS_dup2"},
+    {SYS_pause, "SYS_pause"},
+    {SYS_nanosleep, "SYS_nanosleep"},
+    {SYS_getitimer, "SYS_getitimer"},
+    {SYS_alarm, "SYS_alarm"},
+    {SYS_setitimer, "SYS_setitimer"},
+    {SYS_getpid, "SYS_getpid"},
+    {SYS_sendfile, "SYS_sendfile"},
+    {SYS_socket, "SYS_socket"},
+    {SYS_connect, "SYS_connect"},
+    {SYS_accept, "SYS_accept"},
+    {SYS_sendto, "SYS_sendto"},
+    {SYS_recvfrom, "SYS_recvfrom"},
+    {SYS_sendmsg, "SYS_sendmsg"},
+    {SYS_recvmsg, "SYS_recvmsg"},
+    {SYS_shutdown, "SYS_shutdown"},
+    {SYS_bind, "SYS_bind"},
+    {SYS_listen, "SYS_listen"},
+    {SYS_getsockname, "SYS_getsockname"},
+    {SYS_getpeername, "SYS_getpeername"},
+    {SYS_socketpair, "SYS_socketpair"},
+    {SYS_setsockopt, "SYS_setsockopt"},
+    {SYS_getsockopt, "SYS_getsockopt"},
+    {SYS_clone, "SYS_clone"},
+    {SYS_fork, "SYS_fork"},
+    {SYS_vfork, "SYS_vfork"},
+    {SYS_execve, "SYS_execve"},
+    {SYS_exit, "SYS_exit"},
+    {SYS_wait4, "SYS_wait4"},
+    {SYS_kill, "SYS_kill"},
+    {SYS_uname, "SYS_uname"},
+    {SYS_semget, "SYS_semget"},
+    {SYS_semop, "SYS_semop"},
+    {SYS_semctl, "SYS_semctl"},
+    {SYS_shmdt, "SYS_shmdt"},
+    {SYS_msgget, "SYS_msgget"},
+    {SYS_msgsnd, "SYS_msgsnd"},
+    {SYS_msgrcv, "SYS_msgrcv"},
+    {SYS_msgctl, "SYS_msgctl"},
+    {SYS_fcntl, "SYS_fcntl"},
+    {SYS_flock, "SYS_flock"},
+    {SYS_fsync, "SYS_fsync"},
+    {SYS_fdatasync, "SYS_fdatasync"},
+    {SYS_truncate, "SYS_truncate"},
+    {SYS_ftruncate, "SYS_ftruncate"},
+    {SYS_getdents, "SYS_getdents"},
+    {SYS_getcwd, "SYS_getcwd"},
+    {SYS_chdir, "SYS_chdir"},
+    {SYS_fchdir, "SYS_fchdir"},
+    {SYS_rename, "SYS_rename"},
+    {SYS_mkdir, "SYS_mkdir"},
+    {SYS_rmdir, "SYS_rmdir"},
+    {SYS_creat, "SYS_creat"},
+    {SYS_link, "SYS_link"},
+    {SYS_unlink, "SYS_unlink"},
+    {SYS_symlink, "SYS_symlink"},
+    {SYS_readlink, "SYS_readlink"},
+    {SYS_chmod, "SYS_chmod"},
+    {SYS_fchmod, "SYS_fchmod"},
+    {SYS_chown, "SYS_chown"},
+    {SYS_fchown, "SYS_fchown"},
+    {SYS_lchown, "SYS_lchown"},
+    {SYS_umask, "SYS_umask"},
+    {SYS_gettimeofday, "SYS_gettimeofday"},
+    {SYS_getrlimit, "SYS_getrlimit"},
+    {SYS_getrusage, "SYS_getrusage"},
+    {SYS_sysinfo, "SYS_sysinfo"},
+    {SYS_times, "SYS_times"},
+    {SYS_ptrace, "SYS_ptrace"},
+    {SYS_getuid, "SYS_getuid"},
+    {SYS_syslog, "SYS_syslog"},
+    {SYS_getgid, "SYS_getgid"},
+    {SYS_setuid, "SYS_setuid"},
+    {SYS_setgid, "SYS_setgid"},
+    {SYS_geteuid, "SYS_geteuid"},
+    {SYS_getegid, "SYS_getegid"},
+    {SYS_setpgid, "SYS_setpgid"},
+    {SYS_getppid, "SYS_getppid"},
+    {SYS_getpgrp, "SYS_getpgrp"},
+    {SYS_setsid, "SYS_setsid"},
+    {SYS_setreuid, "SYS_setreuid"},
+    {SYS_setregid, "SYS_setregid"},
+    {SYS_getgroups, "SYS_getgroups"},
+    {SYS_setgroups, "SYS_setgroups"},
+    {SYS_setresuid, "SYS_setresuid"},
+    {SYS_getresuid, "SYS_getresuid"},
+    {SYS_setresgid, "SYS_setresgid"},
+    {SYS_getresgid, "SYS_getresgid"},
+    {SYS_getpgid, "SYS_getpgid"},
+    {SYS_setfsuid, "SYS_setfsuid"},
+    {SYS_setfsgid, "SYS_setfsgid"},
+    {SYS_getsid, "SYS_getsid"},
+    {SYS_capget, "SYS_capget"},
+    {SYS_capset, "SYS_capset"},
+    {SYS_rt_sigpending, "SYS_rt_sigpending"},
+    {SYS_rt_sigtimedwait, "SYS_rt_sigtimedwait"},
+    {SYS_rt_sigqueueinfo, "SYS_rt_sigqueueinfo"},
+    {SYS_rt_sigsuspend, "SYS_rt_sigsuspend"},
+    {SYS_sigaltstack, "SYS_sigaltstack"},
+    {SYS_utime, "SYS_utime"},
+    {SYS_mknod, "SYS_mknod"},
+    {SYS_uselib, "SYS_uselib"},
+    {SYS_personality, "SYS_personality"},
+    {SYS_ustat, "SYS_ustat"},
+    {SYS_statfs, "SYS_statfs"},
+    {SYS_fstatfs, "SYS_fstatfs"},
+    {SYS_sysfs, "SYS_sysfs"},
+    {SYS_getpriority, "SYS_getpriority"},
+    {SYS_setpriority, "SYS_setpriority"},
+    {SYS_sched_setparam, "SYS_sched_setparam"},
+    {SYS_sched_getparam, "SYS_sched_getparam"},
+    {SYS_sched_setscheduler, "SYS_sched_setscheduler"},
+    {SYS_sched_getscheduler, "SYS_sched_getscheduler"},
+    {SYS_sched_get_priority_max, "SYS_sched_get_priority_max"},
+    {SYS_sched_get_priority_min, "SYS_sched_get_priority_min"},
+    {SYS_sched_rr_get_interval, "SYS_sched_rr_get_interval"},
+    {SYS_mlock, "SYS_mlock"},
+    {SYS_munlock, "SYS_munlock"},
+    {SYS_mlockall, "SYS_mlockall"},
+    {SYS_munlockall, "SYS_munlockall"},
+    {SYS_vhangup, "SYS_vhangup"},
+    {SYS_modify_ldt, "SYS_modify_ldt"},
+    {SYS_pivot_root, "SYS_pivot_root"},
+    {SYS__sysctl, "SYS__sysctl"},
+    {SYS_prctl, "SYS_prctl"},
+    {SYS_arch_prctl, "SYS_arch_prctl"},
+    {SYS_adjtimex, "SYS_adjtimex"},
+    {SYS_setrlimit, "SYS_setrlimit"},
+    {SYS_chroot, "SYS_chroot"},
+    {SYS_sync, "SYS_sync"},
+    {SYS_acct, "SYS_acct"},
+    {SYS_settimeofday, "SYS_settimeofday"},
+    {SYS_mount, "SYS_mount"},
+    {SYS_umount2, "SYS_umount2"},
+    {SYS_swapon, "SYS_swapon"},
+    {SYS_swapoff, "SYS_swapoff"},
+    {SYS_reboot, "SYS_reboot"},
+    {SYS_sethostname, "SYS_sethostname"},
+    {SYS_setdomainname, "SYS_setdomainname"},
+    {SYS_iopl, "SYS_iopl"},
+    {SYS_ioperm, "SYS_ioperm"},
+    {SYS_create_module, "SYS_create_module"},
+    {SYS_init_module, "SYS_init_module"},
+    {SYS_delete_module, "SYS_delete_module"},
+    {SYS_get_kernel_syms, "SYS_get_kernel_syms"},
+    {SYS_query_module, "SYS_query_module"},
+    {SYS_quotactl, "SYS_quotactl"},
+    {SYS_nfsservctl, "SYS_nfsservctl"},
+    {SYS_getpmsg, "SYS_getpmsg"},
+    {SYS_putpmsg, "SYS_putpmsg"},
+    {SYS_afs_syscall, "SYS_afs_syscall"},
+    {SYS_tuxcall, "SYS_tuxcall"},
+    {SYS_security, "SYS_security"},
+    {SYS_gettid, "SYS_gettid"},
+    {SYS_readahead, "SYS_readahead"},
+    {SYS_setxattr, "SYS_setxattr"},
+    {SYS_lsetxattr, "SYS_lsetxattr"},
+    {SYS_fsetxattr, "SYS_fsetxattr"},
+    {SYS_getxattr, "SYS_getxattr"},
+    {SYS_lgetxattr, "SYS_lgetxattr"},
+    {SYS_fgetxattr, "SYS_fgetxattr"},
+    {SYS_listxattr, "SYS_listxattr"},
+    {SYS_llistxattr, "SYS_llistxattr"},
+    {SYS_flistxattr, "SYS_flistxattr"},
+    {SYS_removexattr, "SYS_removexattr"},
+    {SYS_lremovexattr, "SYS_lremovexattr"},
+    {SYS_fremovexattr, "SYS_fremovexattr"},
+    {SYS_tkill, "SYS_tkill"},
+    {SYS_time, "SYS_time"},
+    {SYS_futex, "SYS_futex"},
+    {SYS_sched_setaffinity, "SYS_sched_setaffinity"},
+    {SYS_sched_getaffinity, "SYS_sched_getaffinity"},
+    {SYS_set_thread_area, "SYS_set_thread_area"},
+    {SYS_io_setup, "SYS_io_setup"},
+    {SYS_io_destroy, "SYS_io_destroy"},
+    {SYS_io_getevents, "SYS_io_getevents"},
+    {SYS_io_submit, "SYS_io_submit"},
+    {SYS_io_cancel, "SYS_io_cancel"},
+    {SYS_get_thread_area, "SYS_get_thread_area"},
+    {SYS_lookup_dcookie, "SYS_lookup_dcookie"},
+    {SYS_epoll_create, "SYS_epoll_create"},
+    {SYS_epoll_ctl_old, "SYS_epoll_ctl_old"},
+    {SYS_epoll_wait_old, "SYS_epoll_wait_old"},
+    {SYS_remap_file_pages, "SYS_remap_file_pages"},
+    {SYS_getdents64, "SYS_getdents64"},
+    {SYS_set_tid_address, "SYS_set_tid_address"},
+    {SYS_restart_syscall, "SYS_restart_syscall"},
+    {SYS_semtimedop, "SYS_semtimedop"},
+    {SYS_fadvise64, "SYS_fadvise64"},
+    {SYS_timer_create, "SYS_timer_create"},
+    {SYS_timer_settime, "SYS_timer_settime"},
+    {SYS_timer_gettime, "SYS_timer_gettime"},
+    {SYS_timer_getoverrun, "SYS_timer_getoverrun"},
+    {SYS_timer_delete, "SYS_timer_delete"},
+    {SYS_clock_settime, "SYS_clock_settime"},
+    {SYS_clock_gettime, "SYS_clock_gettime"},
+    {SYS_clock_getres, "SYS_clock_getres"},
+    {SYS_clock_nanosleep, "SYS_clock_nanosleep"},
+    {SYS_exit_group, "SYS_exit_group"},
+    {SYS_epoll_wait, "SYS_epoll_wait"},
+    {SYS_epoll_ctl, "SYS_epoll_ctl"},
+    {SYS_tgkill, "SYS_tgkill"},
+    {SYS_utimes, "SYS_utimes"},
+    {SYS_vserver, "SYS_vserver"},
+    {SYS_mbind, "SYS_mbind"},
+    {SYS_set_mempolicy, "SYS_set_mempolicy"},
+    {SYS_get_mempolicy, "SYS_get_mempolicy"},
+    {SYS_mq_open, "SYS_mq_open"},
+    {SYS_mq_unlink, "SYS_mq_unlink"},
+    {SYS_mq_timedsend, "SYS_mq_timedsend"},
+    {SYS_mq_timedreceive, "SYS_mq_timedreceive"},
+    {SYS_mq_notify, "SYS_mq_notify"},
+    {SYS_mq_getsetattr, "SYS_mq_getsetattr"},
+    {SYS_kexec_load, "SYS_kexec_load"},
+    {SYS_waitid, "SYS_waitid"},
+    {SYS_add_key, "SYS_add_key"},
+    {SYS_request_key, "SYS_request_key"},
+    {SYS_keyctl, "SYS_keyctl"},
+    {SYS_ioprio_set, "SYS_ioprio_set"},
+    {SYS_ioprio_get, "SYS_ioprio_get"},
+    {SYS_inotify_init, "SYS_inotify_init"},
+    {SYS_inotify_add_watch, "SYS_inotify_add_watch"},
+    {SYS_inotify_rm_watch, "SYS_inotify_rm_watch"},
+    {SYS_migrate_pages, "SYS_migrate_pages"},
+    {SYS_openat, "SYS_openat"},
+    {SYS_mkdirat, "SYS_mkdirat"},
+    {SYS_mknodat, "SYS_mknodat"},
+    {SYS_fchownat, "SYS_fchownat"},
+    {SYS_futimesat, "SYS_futimesat"},
+    {SYS_newfstatat, "SYS_newfstatat"},
+    {SYS_unlinkat, "SYS_unlinkat"},
+    {SYS_renameat, "SYS_renameat"},
+    {SYS_linkat, "SYS_linkat"},
+    {SYS_symlinkat, "SYS_symlinkat"},
+    {SYS_readlinkat, "SYS_readlinkat"},
+    {SYS_fchmodat, "SYS_fchmodat"},
+    {SYS_faccessat, "SYS_faccessat"},
+    {SYS_pselect6, "SYS_pselect6"},
+    {SYS_ppoll, "SYS_ppoll"},
+    {SYS_unshare, "SYS_unshare"},
+    {SYS_set_robust_list, "SYS_set_robust_list"},
+    {SYS_get_robust_list, "SYS_get_robust_list"},
+    {SYS_splice, "SYS_splice"},
+    {SYS_tee, "SYS_tee"},
+    {SYS_sync_file_range, "SYS_sync_file_range"},
+    {SYS_vmsplice, "SYS_vmsplice"},
+    {SYS_move_pages, "SYS_move_pages"},
+    {SYS_utimensat, "SYS_utimensat"},
+    {SYS_epoll_pwait, "SYS_epoll_pwait"},
+    {SYS_signalfd, "SYS_signalfd"},
+    {SYS_timerfd_create, "SYS_timerfd_create"},
+    {SYS_eventfd, "SYS_eventfd"},
+    {SYS_fallocate, "SYS_fallocate"},
+    {SYS_timerfd_settime, "SYS_timerfd_settime"},
+    {SYS_timerfd_gettime, "SYS_timerfd_gettime"},
+    {SYS_accept4, "SYS_accept4"},
+    {SYS_signalfd4, "SYS_signalfd4"},
+    {SYS_eventfd2, "SYS_eventfd2"},
+    {SYS_epoll_create1, "SYS_epoll_create1"},
+    {SYS_dup3, "SYS_dup3"},
+    {SYS_pipe2, "SYS_pipe2"},
+    {SYS_inotify_init1, "SYS_inotify_init1"},
+    {SYS_preadv, "SYS_preadv"},
+    {SYS_pwritev, "SYS_pwritev"},
+    {SYS_rt_tgsigqueueinfo, "SYS_rt_tgsigqueueinfo"},
+    {SYS_perf_event_open, "SYS_perf_event_open"},
+    {SYS_recvmmsg, "SYS_recvmmsg"},
+    {SYS_fanotify_init, "SYS_fanotify_init"},
+    {SYS_fanotify_mark, "SYS_fanotify_mark"},
+    {SYS_prlimit64, "SYS_prlimit64"},
+    {SYS_name_to_handle_at, "SYS_name_to_handle_at"},
+    {SYS_open_by_handle_at, "SYS_open_by_handle_at"},
+    {SYS_clock_adjtime, "SYS_clock_adjtime"},
+    {SYS_syncfs, "SYS_syncfs"},
+    {SYS_sendmmsg, "SYS_sendmmsg"},
+    {SYS_setns, "SYS_setns"},
+    {SYS_getcpu, "SYS_getcpu"},
+    {SYS_process_vm_readv, "SYS_process_vm_readv"},
+    {SYS_process_vm_writev, "SYS_process_vm_writev"},
+    {SYS_kcmp, "SYS_kcmp"},
+    {SYS_finit_module, "SYS_finit_module"},
+    {SYS_sched_setattr, "SYS_sched_setattr"},
+    {SYS_sched_getattr, "SYS_sched_getattr"},
+    {SYS_renameat2, "SYS_renameat2"},
+    {SYS_seccomp, "SYS_seccomp"},
+    {SYS_getrandom, "SYS_getrandom"},
+    {SYS_memfd_create, "SYS_memfd_create"},
+    {SYS_kexec_file_load, "SYS_kexec_file_load"},
+    {SYS_bpf, "SYS_bpf"},
+    {SYS_execveat, "SYS_execveat"},
+    {SYS_userfaultfd, "SYS_userfaultfd"},
+    {SYS_membarrier, "SYS_membarrier"},
+    {SYS_mlock2, "SYS_mlock2"},
+    {SYS_copy_file_range, "SYS_copy_file_range"},
+    {SYS_preadv2, "SYS_preadv2"},
+    {SYS_pwritev2, "SYS_pwritev2"},
+    {SYS_pkey_mprotect, "SYS_pkey_mprotect"},
+    {SYS_pkey_alloc, "SYS_pkey_alloc"},
+    {SYS_pkey_free, "SYS_pkey_free"},
+    {SYS_statx, "SYS_statx"},
+    {SYS_io_pgetevents, "SYS_io_pgetevents"},
+    {SYS_rseq, "SYS_rseq"},
+    {SYS_myst_trace, "SYS_myst_trace"},
+    {SYS_myst_trace_ptr, "SYS_myst_trace_ptr"},
+    {SYS_myst_dump_ehdr, "SYS_myst_dump_ehdr"},
+    {SYS_myst_dump_argv, "SYS_myst_dump_argv"},
+    {SYS_myst_dump_stack, "SYS_myst_dump_stack"},
+    {SYS_myst_add_symbol_file, "SYS_myst_add_symbol_file"},
+    {SYS_myst_load_symbols, "SYS_myst_load_symbols"},
+    {SYS_myst_unload_symbols, "SYS_myst_unload_symbols"},
+    {SYS_myst_gen_creds, "SYS_myst_gen_creds"},
+    {SYS_myst_free_creds, "SYS_myst_free_creds"},
+    {SYS_myst_verify_cert, "SYS_myst_verify_cert"},
+    {SYS_myst_gen_creds_ex, "SYS_myst_gen_creds_ex"},
+    {SYS_myst_clone, "SYS_myst_clone"},
+    {SYS_myst_max_threads, "SYS_myst_max_threads"},
+    {SYS_myst_poll_wake, "SYS_myst_poll_wake"},
+    {SYS_get_process_thread_stack, "SYS_get_process_thread_stack"},
+    {SYS_myst_run_itimer, "SYS_myst_run_itimer"},
+    {SYS_myst_run_msync_flusher, "SYS_myst_run_msync_flusher"},
+    {SYS_myst_get_clock_page, "SYS_myst_get_clock_page"},
+    {SYS_myst_run_aio_worker, "SYS_myst_run_aio_worker"},
+    {SYS_myst_get_fork_info, "SYS_myst_get_fork_info"},
+    {SYS_fork_wait_exec_exit, "SYS_fork_wait_exec_exit"},
+    {SYS_myst_kill_wait_child_forks, "SYS_myst_kill_wait_child_forks"},
+    /* Open Enclave extensions */
+    {SYS_myst_oe_get_report_v2, "SYS_myst_oe_get_report_v2"},
+    {SYS_myst_oe_free_report, "SYS_myst_oe_free_report"},
+    {SYS_myst_oe_get_target_info_v2, "SYS_myst_oe_get_target_info_v2"},
+    {SYS_myst_oe_free_target_info, "SYS_myst_oe_free_target_info"},
+    {SYS_myst_oe_parse_report, "SYS_myst_oe_parse_report"},
+    {SYS_myst_oe_verify_report, "SYS_myst_oe_verify_report"},
+    {SYS_myst_oe_get_seal_key_by_policy_v2,
+     "SYS_myst_oe_get_seal_key_by_policy_v2"},
+    {SYS_myst_oe_get_public_key_by_policy,
+     "SYS_myst_oe_get_public_key_by_policy"},
+    {SYS_myst_oe_get_public_key, "SYS_myst_oe_get_public_key"},
+    {SYS_myst_oe_get_private_key_by_policy,
+     "SYS_myst_oe_get_private_key_by_policy"},
+    {SYS_myst_oe_get_private_key, "SYS_myst_oe_get_private_key"},
+    {SYS_myst_oe_free_key, "SYS_myst_oe_free_key"},
+    {SYS_myst_oe_get_seal_key_v2, "SYS_myst_oe_get_seal_key_v2"},
+    {SYS_myst_oe_free_seal_key, "SYS_myst_oe_free_seal_key"},
+    {SYS_myst_oe_generate_attestation_certificate,
+     "SYS_myst_oe_generate_attestation_certificate"},
+    {SYS_myst_oe_free_attestation_certificate,
+     "SYS_myst_oe_free_attestation_certificate"},
+    {SYS_myst_oe_verify_attestation_certificate,
+     "SYS_myst_oe_verify_attestation_certificate"},
+    {SYS_myst_oe_result_str, "SYS_myst_oe_result_str"},
+    {SYS_myst_gcov, "SYS_myst_gcov"},
+    {SYS_myst_unmap_on_exit, "SYS_myst_unmap_on_exit"},
+};
+
+static size_t _n_pairs = sizeof(_pairs) / sizeof(_pairs[0]);
+
+const char* myst_syscall_str(long n)
+{
+    for (size_t i = 0; i < _n_pairs; i++)
+    {
+        if (n == _pairs[i].num)
+            return _pairs[i].str;
+    }
+
+    return "unknown";
+}